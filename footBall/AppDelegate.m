@@ -14,6 +14,8 @@
 #import "APIRequestInterceptor.h"
 #import "AuthManager.h"
 #import "PagFilePreloader.h"
+#import "SDImageManager.h"
+#import "APIConnectionManager.h"
 #import <DoraemonKit/DoraemonManager.h>
 
 #ifdef DEBUG
@@ -86,9 +88,35 @@
             // 从AuthManager获取token
             return [[AuthManager sharedManager] getToken];
         }];
+    // Token过期时间（JWT exp），即将过期时主动刷新，已过期时挂起请求等待刷新
+    authInterceptor.tokenExpirationProvider = ^NSDate *{
+        return [AuthManager sharedManager].tokenExpirationDate;
+    };
+    // 401或Token过期时刷新Token（拦截器保证同一时间只刷新一次，期间的请求挂起等待）
+    authInterceptor.tokenRefreshHandler = ^(APITokenRefreshCompletionBlock completion) {
+        [[AuthManager sharedManager] refreshTokenWithCompletion:^(BOOL success, NSError *error) {
+            completion(success, error);
+        }];
+    };
+    // 刷新接口的地址每次判断时从当前路由表获取（切换环境或更新路径配置后仍然准确）
+    authInterceptor.refreshURLProvider = ^NSString *{
+        return [[APIEnvironmentManager sharedManager].routeTable URLStringForPathName:APIPathNameAuthRefresh
+                                                                              subPath:nil
+                                                                       pathParameters:nil
+                                                                                error:nil];
+    };
     [apiManager addInterceptor:authInterceptor];
     NSLog(@"✅ 认证拦截器已配置，将自动添加Authorization请求头");
     
+    // 初始化图片管理器（图片下载接入请求调度器，需在首次加载图片前完成）
+    [SDImageManager sharedManager];
+    
+    // 预连接API服务器和图片CDN（DNS、TCP、TLS握手提前完成，切换环境后自动重新预连接）
+    [[APIConnectionManager sharedManager] preconnectCurrentEnvironment];
+    
+    // 恢复离线写请求队列（上次未发送的写请求从持久化数据恢复并开始重放，需在认证拦截器配置之后）
+    [APIOutbox sharedOutbox];
+    
     // Debug模式下添加日志拦截器
     #ifdef DEBUG
         APILoggingInterceptor *loggingInterceptor = 
@@ -13,6 +13,11 @@ NS_ASSUME_NONNULL_BEGIN
 typedef void(^AuthLoginSuccessBlock)(NSDictionary *response);
 /// 登录失败回调
 typedef void(^AuthLoginFailureBlock)(NSError *error);
+/// Token刷新回调
+typedef void(^AuthRefreshCompletionBlock)(BOOL success, NSError * _Nullable error);
+
+/// 会话过期通知（刷新Token被服务器拒绝，Token已清除，需要重新登录）
+FOUNDATION_EXPORT NSString *const AuthManagerSessionDidExpireNotification;
 
 /// 认证管理器 - 统一管理用户认证和Token
 @interface AuthManager : NSObject
@@ -26,6 +31,16 @@ typedef void(^AuthLoginFailureBlock)(NSError *error);
 /// 当前Authorization头（格式：Bearer {token}）
 @property (nonatomic, strong, nullable, readonly) NSString *authorizationHeader;
 
+/// 刷新Token（登录/刷新响应中的refreshToken，可能为空）
+@property (nonatomic, strong, nullable, readonly) NSString *refreshToken;
+
+/// Token过期时间（解析JWT的exp，非JWT或没有exp时为nil）
+@property (nonatomic, strong, nullable, readonly) NSDate *tokenExpirationDate;
+
+/// 当前用户标识（登录响应中的用户ID，其次是JWT的sub；都没有时为本次登录生成的UUID）
+/// 刷新Token后保持不变，用于按用户分区的本地数据（如响应缓存），未登录时为nil
+@property (nonatomic, copy, nullable, readonly) NSString *userIdentifier;
+
 /// 是否已登录
 @property (nonatomic, assign, readonly) BOOL isLoggedIn;
 
@@ -47,6 +62,12 @@ typedef void(^AuthLoginFailureBlock)(NSError *error);
                     success:(nullable AuthLoginSuccessBlock)success
                     failure:(nullable AuthLoginFailureBlock)failure;
 
+/// 刷新Token（请求APIPathNameAuthRefresh，成功后保存新Token）
+/// 服务器拒绝刷新（401/403/400）时清除Token并发送 AuthManagerSessionDidExpireNotification
+/// @note 一般不直接调用，由 APIAuthenticationInterceptor 保证同一时间只有一次刷新
+/// @param completion 完成回调
+- (void)refreshTokenWithCompletion:(nullable AuthRefreshCompletionBlock)completion;
+
 /// 保存Token
 /// @param token Token字符串
 - (void)saveToken:(NSString *)token;
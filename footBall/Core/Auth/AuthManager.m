@@ -9,15 +9,24 @@
 #import "APIManager.h"
 #import "APIEnvironmentManager.h"
 #import "APIPathNames.h"
+#import "APIResponseCache.h"
+#import "APIOutbox.h"
 
 // Token存储Key
 static NSString *const kTokenKey = @"AuthManager_Token";
 static NSString *const kAuthorizationHeaderKey = @"AuthManager_AuthorizationHeader";
+static NSString *const kRefreshTokenKey = @"AuthManager_RefreshToken";
+static NSString *const kUserIdentifierKey = @"AuthManager_UserIdentifier";
+
+NSString *const AuthManagerSessionDidExpireNotification = @"AuthManagerSessionDidExpireNotification";
 
 @interface AuthManager ()
 
 @property (nonatomic, strong, nullable) NSString *token;
 @property (nonatomic, strong, nullable) NSString *authorizationHeader;
+@property (nonatomic, strong, nullable) NSString *refreshToken;
+@property (nonatomic, strong, nullable) NSDate *tokenExpirationDate;
+@property (nonatomic, copy, nullable) NSString *userIdentifier;
 
 @end
 
@@ -101,51 +110,14 @@ static NSString *const kAuthorizationHeaderKey = @"AuthManager_AuthorizationHead
                                          success:^(id responseObject) {
         NSLog(@"✅ 登录成功");
         
-        // 解析响应数据，提取token
-        NSDictionary *response = nil;
-        if ([responseObject isKindOfClass:[NSDictionary class]]) {
-            response = (NSDictionary *)responseObject;
-        } else if ([responseObject isKindOfClass:[NSData class]]) {
-            NSError *jsonError = nil;
-            response = [NSJSONSerialization JSONObjectWithData:(NSData *)responseObject
-                                                       options:NSJSONReadingMutableContainers
-                                                         error:&jsonError];
-            if (jsonError) {
-                NSLog(@"⚠️ 解析响应数据失败: %@", jsonError.localizedDescription);
-            }
-        }
-        
-        // 提取token（支持多种可能的字段名）
-        NSString *token = nil;
-        NSString *authorization = nil;
-        
-        if (response) {
-            // 尝试从不同字段获取token
-            token = response[@"token"] ?: 
-                   response[@"accessToken"] ?: 
-                   response[@"access_token"] ?:
-                   response[@"data"][@"token"] ?:
-                   response[@"data"][@"accessToken"] ?:
-                   response[@"data"][@"access_token"];
-            
-            // 尝试获取Authorization头
-            authorization = response[@"authorization"] ?:
-                           response[@"Authorization"] ?:
-                           response[@"data"][@"authorization"] ?:
-                           response[@"data"][@"Authorization"];
-        }
+        // 解析响应数据，提取并保存token（新的登录会话，不沿用之前的用户标识）
+        NSDictionary *response = [self dictionaryFromResponseObject:responseObject];
+        self.userIdentifier = nil;
+        // 即使没有token，也认为登录成功（可能服务器返回方式不同）
+        [self saveTokenFromResponse:response];
         
-        // 保存token或authorization
-        if (token && token.length > 0) {
-            [self saveToken:token];
-            NSLog(@"✅ Token已保存");
-        } else if (authorization && authorization.length > 0) {
-            [self saveAuthorizationHeader:authorization];
-            NSLog(@"✅ Authorization头已保存");
-        } else {
-            NSLog(@"⚠️ 响应中未找到token或authorization字段");
-            // 即使没有token，也认为登录成功（可能服务器返回方式不同）
-        }
+        // 该用户之前留下的离线写请求继续发送（其他用户的写请求不会在这个Token下重放）
+        [[APIOutbox sharedOutbox] flush];
         
         if (success) {
             success(response ?: @{});
@@ -159,12 +131,68 @@ static NSString *const kAuthorizationHeaderKey = @"AuthManager_AuthorizationHead
     }];
 }
 
+- (void)refreshTokenWithCompletion:(nullable AuthRefreshCompletionBlock)completion {
+    if (!self.isLoggedIn && self.refreshToken.length == 0) {
+        if (completion) {
+            NSError *error = [NSError errorWithDomain:@"AuthManagerErrorDomain"
+                                                  code:-1
+                                              userInfo:@{NSLocalizedDescriptionKey: @"未登录，无法刷新Token"}];
+            completion(NO, error);
+        }
+        return;
+    }
+    
+    NSLog(@"🔑 开始刷新Token...");
+    
+    // 有refreshToken时放在请求体中，否则服务器通过当前Authorization头识别会话
+    NSDictionary *parameters = self.refreshToken.length > 0 ? @{@"refresh_token": self.refreshToken} : nil;
+    
+    [[APIManager sharedManager] POSTWithPathName:APIPathNameAuthRefresh
+                                         subPath:nil
+                                      parameters:parameters
+                                         headers:nil
+                                         success:^(id responseObject) {
+        NSDictionary *response = [self dictionaryFromResponseObject:responseObject];
+        if ([self saveTokenFromResponse:response]) {
+            NSLog(@"✅ Token刷新成功");
+            if (completion) {
+                completion(YES, nil);
+            }
+            return;
+        }
+        
+        NSError *error = [NSError errorWithDomain:@"AuthManagerErrorDomain"
+                                              code:-1
+                                          userInfo:@{NSLocalizedDescriptionKey: @"刷新响应中未找到token"}];
+        if (completion) {
+            completion(NO, error);
+        }
+    } failure:^(NSError *error) {
+        NSLog(@"❌ Token刷新失败: %@", error.localizedDescription);
+        
+        // 服务器明确拒绝刷新：会话已失效，清除Token并通知重新登录（网络错误时保留Token，下次请求再尝试）
+        APIError *apiError = [error isKindOfClass:[APIError class]] ? (APIError *)error : [APIError errorFromNSError:error];
+        if (apiError.code == APIErrorCodeUnauthorized ||
+            apiError.code == APIErrorCodeForbidden ||
+            apiError.code == APIErrorCodeBadRequest) {
+            [self clearToken];
+            [[NSNotificationCenter defaultCenter] postNotificationName:AuthManagerSessionDidExpireNotification object:self];
+        }
+        
+        if (completion) {
+            completion(NO, error);
+        }
+    }];
+}
+
 - (void)saveToken:(NSString *)token {
     if (!token || token.length == 0) {
         return;
     }
     
     _token = token;
+    _tokenExpirationDate = [self expirationDateForToken:token];
+    [self updateUserIdentifierWithToken:token];
     
     // 自动生成Authorization头
     _authorizationHeader = [NSString stringWithFormat:@"Bearer %@", token];
@@ -190,6 +218,8 @@ static NSString *const kAuthorizationHeaderKey = @"AuthManager_AuthorizationHead
     } else {
         _token = authorizationHeader;
     }
+    _tokenExpirationDate = [self expirationDateForToken:_token];
+    [self updateUserIdentifierWithToken:_token];
     
     // 保存到本地
     [[NSUserDefaults standardUserDefaults] setObject:_token forKey:kTokenKey];
@@ -202,12 +232,20 @@ static NSString *const kAuthorizationHeaderKey = @"AuthManager_AuthorizationHead
 - (void)clearToken {
     _token = nil;
     _authorizationHeader = nil;
+    _refreshToken = nil;
+    _tokenExpirationDate = nil;
+    _userIdentifier = nil;
     
     // 清除本地存储
     [[NSUserDefaults standardUserDefaults] removeObjectForKey:kTokenKey];
     [[NSUserDefaults standardUserDefaults] removeObjectForKey:kAuthorizationHeaderKey];
+    [[NSUserDefaults standardUserDefaults] removeObjectForKey:kRefreshTokenKey];
+    [[NSUserDefaults standardUserDefaults] removeObjectForKey:kUserIdentifierKey];
     [[NSUserDefaults standardUserDefaults] synchronize];
     
+    // 清除该用户的响应缓存（缓存按用户分区，登出后不应继续保留用户数据）
+    [[APIResponseCache sharedCache] removeAllEntries];
+    
     NSLog(@"🗑️ Token已清除");
 }
 
@@ -233,8 +271,162 @@ static NSString *const kAuthorizationHeaderKey = @"AuthManager_AuthorizationHead
         } else {
             _authorizationHeader = [NSString stringWithFormat:@"Bearer %@", savedToken];
         }
+        _tokenExpirationDate = [self expirationDateForToken:savedToken];
         NSLog(@"📂 已从本地加载Token");
     }
+    
+    _refreshToken = [[NSUserDefaults standardUserDefaults] stringForKey:kRefreshTokenKey];
+    _userIdentifier = [[NSUserDefaults standardUserDefaults] stringForKey:kUserIdentifierKey];
+    
+    // 升级前保存的Token没有用户标识
+    if (_token.length > 0 && _userIdentifier.length == 0) {
+        [self updateUserIdentifierWithToken:_token];
+    }
+}
+
+/// 将响应对象转换为字典（支持NSDictionary和JSON NSData）
+- (nullable NSDictionary *)dictionaryFromResponseObject:(nullable id)responseObject {
+    if ([responseObject isKindOfClass:[NSDictionary class]]) {
+        return (NSDictionary *)responseObject;
+    }
+    
+    if ([responseObject isKindOfClass:[NSData class]]) {
+        NSError *jsonError = nil;
+        NSDictionary *response = [NSJSONSerialization JSONObjectWithData:(NSData *)responseObject
+                                                                 options:NSJSONReadingMutableContainers
+                                                                   error:&jsonError];
+        if (jsonError) {
+            NSLog(@"⚠️ 解析响应数据失败: %@", jsonError.localizedDescription);
+        }
+        return [response isKindOfClass:[NSDictionary class]] ? response : nil;
+    }
+    
+    return nil;
+}
+
+/// 从登录/刷新响应中提取并保存token、authorization和refreshToken
+/// @return 是否保存了token或authorization
+- (BOOL)saveTokenFromResponse:(nullable NSDictionary *)response {
+    // 提取token（支持多种可能的字段名）
+    NSString *token = nil;
+    NSString *authorization = nil;
+    NSString *refreshToken = nil;
+    id userId = nil;
+    
+    if (response) {
+        // 尝试从不同字段获取token
+        token = response[@"token"] ?:
+               response[@"accessToken"] ?:
+               response[@"access_token"] ?:
+               response[@"data"][@"token"] ?:
+               response[@"data"][@"accessToken"] ?:
+               response[@"data"][@"access_token"];
+        
+        // 尝试获取Authorization头
+        authorization = response[@"authorization"] ?:
+                       response[@"Authorization"] ?:
+                       response[@"data"][@"authorization"] ?:
+                       response[@"data"][@"Authorization"];
+        
+        // 尝试获取refreshToken
+        refreshToken = response[@"refreshToken"] ?:
+                      response[@"refresh_token"] ?:
+                      response[@"data"][@"refreshToken"] ?:
+                      response[@"data"][@"refresh_token"];
+        
+        // 尝试获取用户ID（可能是数字）
+        userId = response[@"userId"] ?:
+                response[@"user_id"] ?:
+                response[@"data"][@"userId"] ?:
+                response[@"data"][@"user_id"] ?:
+                response[@"data"][@"user"][@"id"];
+    }
+    
+    // 保存refreshToken（刷新响应未返回新的refreshToken时沿用旧值）
+    if ([refreshToken isKindOfClass:[NSString class]] && refreshToken.length > 0) {
+        _refreshToken = refreshToken;
+        [[NSUserDefaults standardUserDefaults] setObject:refreshToken forKey:kRefreshTokenKey];
+    }
+    
+    // 保存token或authorization
+    BOOL saved = NO;
+    if ([token isKindOfClass:[NSString class]] && token.length > 0) {
+        [self saveToken:token];
+        NSLog(@"✅ Token已保存");
+        saved = YES;
+    } else if ([authorization isKindOfClass:[NSString class]] && authorization.length > 0) {
+        [self saveAuthorizationHeader:authorization];
+        NSLog(@"✅ Authorization头已保存");
+        saved = YES;
+    }
+    
+    if (!saved) {
+        NSLog(@"⚠️ 响应中未找到token或authorization字段");
+        return NO;
+    }
+    
+    // 响应中明确的用户ID优先于从Token推断的标识
+    if ([userId isKindOfClass:[NSString class]] || [userId isKindOfClass:[NSNumber class]]) {
+        NSString *identifier = [userId description];
+        if (identifier.length > 0) {
+            [self saveUserIdentifier:identifier];
+        }
+    }
+    return YES;
+}
+
+/// 根据Token更新用户标识：JWT的sub优先；没有sub时沿用当前标识（刷新Token），当前也没有时生成新的UUID
+- (void)updateUserIdentifierWithToken:(nullable NSString *)token {
+    NSString *subject = [self claimsForToken:token][@"sub"];
+    if ([subject isKindOfClass:[NSNumber class]]) {
+        subject = [(NSNumber *)subject stringValue];
+    }
+    if ([subject isKindOfClass:[NSString class]] && subject.length > 0) {
+        [self saveUserIdentifier:subject];
+    } else if (self.userIdentifier.length == 0) {
+        [self saveUserIdentifier:[NSUUID UUID].UUIDString];
+    }
+}
+
+- (void)saveUserIdentifier:(NSString *)userIdentifier {
+    if ([userIdentifier isEqualToString:self.userIdentifier]) {
+        return;
+    }
+    self.userIdentifier = userIdentifier;
+    [[NSUserDefaults standardUserDefaults] setObject:userIdentifier forKey:kUserIdentifierKey];
+}
+
+/// 解析JWT payload中的exp（秒级时间戳），非JWT时返回nil
+- (nullable NSDate *)expirationDateForToken:(nullable NSString *)token {
+    NSDictionary *claims = [self claimsForToken:token];
+    if (![claims[@"exp"] isKindOfClass:[NSNumber class]]) {
+        return nil;
+    }
+    
+    return [NSDate dateWithTimeIntervalSince1970:[claims[@"exp"] doubleValue]];
+}
+
+/// 解析JWT payload，非JWT时返回nil
+- (nullable NSDictionary *)claimsForToken:(nullable NSString *)token {
+    NSArray<NSString *> *segments = [token componentsSeparatedByString:@"."];
+    if (segments.count != 3) {
+        return nil;
+    }
+    
+    // base64url -> base64，并补齐padding
+    NSMutableString *payload = [[[segments[1] stringByReplacingOccurrencesOfString:@"-" withString:@"+"]
+                                 stringByReplacingOccurrencesOfString:@"_" withString:@"/"] mutableCopy];
+    while (payload.length % 4 != 0) {
+        [payload appendString:@"="];
+    }
+    
+    NSData *payloadData = [[NSData alloc] initWithBase64EncodedString:payload options:0];
+    if (!payloadData) {
+        return nil;
+    }
+    
+    NSDictionary *claims = [NSJSONSerialization JSONObjectWithData:payloadData options:0 error:nil];
+    return [claims isKindOfClass:[NSDictionary class]] ? claims : nil;
 }
 
 @end
@@ -8,6 +8,8 @@
 #import <UIKit/UIKit.h>
 #import <QMUIKit/QMUIKit.h>
 
+@class APICancellationScope;
+
 NS_ASSUME_NONNULL_BEGIN
 
 /// 基础视图控制器 - 集成QMUI、多语言和主题支持
@@ -26,6 +28,13 @@ NS_ASSUME_NONNULL_BEGIN
 /// 是否启用空状态视图（默认NO）
 @property (nonatomic, assign) BOOL enableEmptyView;
 
+/// 页面请求的取消作用域，页面离开（出栈或被关闭）或释放时取消其中的请求
+/// 通过 [APIRequestOptions optionsWithOwner:self] 绑定请求，被取消的请求不再回调（不会再更新已离开页面的HUD）
+@property (nonatomic, strong, readonly) APICancellationScope *requestScope;
+
+/// 页面离开时是否取消绑定的请求（默认YES，只是被其他页面覆盖时不取消）
+@property (nonatomic, assign) BOOL cancelsRequestsOnDisappear;
+
 /// 设置导航栏标题（自动本地化）
 /// @param titleKey 本地化字符串的key
 - (void)setNavigationTitleKey:(NSString *)titleKey;
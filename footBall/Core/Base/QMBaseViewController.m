@@ -11,6 +11,7 @@
 #import "NavigationBarManager.h"
 #import "UINavigationController+NavigationBar.h"
 #import <MBProgressHUD/MBProgressHUD.h>
+#import "APICancellationScope.h"
 
 @interface QMBaseViewController ()
 
@@ -23,6 +24,12 @@
 
 #pragma mark - Lifecycle
 
+- (void)didInitialize {
+    [super didInitialize];
+    
+    self.cancelsRequestsOnDisappear = YES;
+}
+
 - (void)viewDidLoad {
     [super viewDidLoad];
     
@@ -67,6 +74,22 @@
     }
 }
 
+- (void)viewDidDisappear:(BOOL)animated {
+    [super viewDidDisappear:animated];
+    
+    // 页面离开（出栈或被关闭）时取消绑定的请求，只是被其他页面覆盖时保留
+    BOOL isLeaving = self.isMovingFromParentViewController || self.isBeingDismissed || self.navigationController.isBeingDismissed;
+    if (self.cancelsRequestsOnDisappear && isLeaving) {
+        [self.requestScope cancel];
+    }
+}
+
+#pragma mark - Network
+
+- (APICancellationScope *)requestScope {
+    return [APICancellationScope scopeForOwner:self];
+}
+
 #pragma mark - QMUIEmptyView
 
 - (void)showEmptyView {
@@ -15,6 +15,8 @@ NS_ASSUME_NONNULL_BEGIN
 typedef void(^SDImageLoadCompletionBlock)(UIImage * _Nullable image, NSError * _Nullable error, SDImageCacheType cacheType, NSURL * _Nullable imageURL);
 /// 图片加载进度回调
 typedef void(^SDImageLoadProgressBlock)(NSInteger receivedSize, NSInteger expectedSize, NSURL * _Nullable targetURL);
+/// 图片变体地址生成（按图片服务的裁剪参数拼接指定像素尺寸的地址）
+typedef NSString * _Nonnull (^SDImageVariantURLBuilder)(NSString *URLString, CGSize pixelSize);
 
 /// SDWebImage管理器 - 封装图片加载功能
 @interface SDImageManager : NSObject
@@ -28,6 +30,10 @@ typedef void(^SDImageLoadProgressBlock)(NSInteger receivedSize, NSInteger expect
 /// 设置失败占位图（全局默认失败占位图）
 @property (nonatomic, strong, nullable) UIImage *failurePlaceholderImage;
 
+/// 图片变体地址生成（可选，如追加 ?w=像素宽度，由图片服务决定）
+/// 设置后为UIImageView加载图片时按视图尺寸和网络质量请求合适尺寸：网络良好时按屏幕倍数，3G级别最多2倍，2G级别1倍
+@property (nonatomic, copy, nullable) SDImageVariantURLBuilder imageVariantURLBuilder;
+
 /// 设置图片缓存配置
 /// @param maxMemoryCost 内存缓存大小（字节，默认50MB）
 /// @param maxDiskSize 磁盘缓存大小（字节，默认100MB）
@@ -82,14 +88,20 @@ typedef void(^SDImageLoadProgressBlock)(NSInteger receivedSize, NSInteger expect
                   options:(SDWebImageOptions)options
                 completed:(nullable SDImageLoadCompletionBlock)completed;
 
-/// 预加载图片
+/// 预加载图片（网络质量为2G级别时不预加载）
 /// @param URLString 图片URL字符串
 - (void)preloadImageWithURLString:(NSString *)URLString;
 
-/// 预加载多张图片
-/// @param URLStrings 图片URL字符串数组
+/// 预加载多张图片（按网络质量减少数量：3G级别只预加载前一半，2G级别不预加载）
+/// @param URLStrings 图片URL字符串数组（按优先顺序）
 - (void)preloadImagesWithURLStrings:(NSArray<NSString *> *)URLStrings;
 
+/// 按视图尺寸和网络质量生成图片变体地址
+/// @param URLString 图片URL字符串
+/// @param pointSize 显示尺寸（点）
+/// @return 未设置imageVariantURLBuilder或尺寸为空时返回原地址
+- (NSString *)imageVariantURLStringForURLString:(NSString *)URLString pointSize:(CGSize)pointSize;
+
 /// 下载图片（不缓存到ImageView）
 /// @param URLString 图片URL字符串
 /// @param progress 进度回调
@@ -98,6 +110,10 @@ typedef void(^SDImageLoadProgressBlock)(NSInteger receivedSize, NSInteger expect
                                               progress:(nullable SDImageLoadProgressBlock)progress
                                              completed:(nullable SDImageLoadCompletionBlock)completed;
 
+/// 预连接图片CDN（DNS解析、TCP和TLS握手），连接保留在图片下载会话中供后续下载复用
+/// @param URLString 图片CDN地址
+- (void)preconnectToURLString:(NSString *)URLString;
+
 /// 获取缓存中的图片
 /// @param URLString 图片URL字符串
 /// @param completion 完成回调
@@ -6,6 +6,9 @@
 //
 
 #import "SDImageManager.h"
+#import "SDImageSchedulerOperation.h"
+#import "APIConnectionManager.h"
+#import "APINetworkQualityEstimator.h"
 
 @interface SDImageManager ()
 
@@ -28,6 +31,12 @@
 - (instancetype)init {
     self = [super init];
     if (self) {
+        // 图片下载使用统一的会话配置，并由请求调度器统一调度，与API请求共享每个主机的并发名额
+        // 下载器创建后不再读取sessionConfiguration，需在首次使用SDWebImageDownloader之前设置
+        SDWebImageDownloaderConfig *downloaderConfig = [SDWebImageDownloaderConfig defaultDownloaderConfig];
+        downloaderConfig.sessionConfiguration = [[APIConnectionManager sharedManager] sessionConfiguration];
+        downloaderConfig.operationClass = [SDImageSchedulerOperation class];
+        
         _imageCache = [SDImageCache sharedImageCache];
         _imageManager = [SDWebImageManager sharedManager];
         _placeholderImage = nil;
@@ -67,7 +76,8 @@
     
     NSURL *url = nil;
     if ([URLString isKindOfClass:[NSString class]] && URLString.length > 0) {
-        url = [NSURL URLWithString:URLString];
+        // 按视图尺寸和网络质量请求合适尺寸的图片
+        url = [NSURL URLWithString:[self imageVariantURLStringForURLString:URLString pointSize:imageView.bounds.size]];
     }
     
     if (!url) {
@@ -162,25 +172,56 @@
 }
 
 - (void)preloadImageWithURLString:(NSString *)URLString {
+    // 2G级别的网络不预加载，名额和带宽留给可见图片
+    if ([[APINetworkQualityEstimator sharedEstimator] adjustedPrefetchCount:1] == 0) {
+        return;
+    }
+    
     NSURL *url = nil;
     if ([URLString isKindOfClass:[NSString class]] && URLString.length > 0) {
         url = [NSURL URLWithString:URLString];
     }
     
     if (url) {
+        // 预加载使用低优先级，进入调度器的预加载通道，不与可见图片争抢名额
         [self.imageManager loadImageWithURL:url
-                                     options:SDWebImageHighPriority
+                                     options:SDWebImageLowPriority
                                     progress:nil
                                    completed:nil];
     }
 }
 
 - (void)preloadImagesWithURLStrings:(NSArray<NSString *> *)URLStrings {
-    for (NSString *URLString in URLStrings) {
+    NSUInteger count = [[APINetworkQualityEstimator sharedEstimator] adjustedPrefetchCount:URLStrings.count];
+    for (NSString *URLString in [URLStrings subarrayWithRange:NSMakeRange(0, count)]) {
         [self preloadImageWithURLString:URLString];
     }
 }
 
+- (NSString *)imageVariantURLStringForURLString:(NSString *)URLString pointSize:(CGSize)pointSize {
+    if (!self.imageVariantURLBuilder || pointSize.width <= 0 || pointSize.height <= 0) {
+        return URLString;
+    }
+    
+    CGFloat scale = [self imageScaleForNetworkQuality];
+    CGSize pixelSize = CGSizeMake(ceil(pointSize.width * scale), ceil(pointSize.height * scale));
+    return self.imageVariantURLBuilder(URLString, pixelSize) ?: URLString;
+}
+
+/// 按网络质量选择图片倍数（网络差时用低倍图，减少下载量）
+- (CGFloat)imageScaleForNetworkQuality {
+    CGFloat screenScale = [UIScreen mainScreen].scale;
+    switch ([APINetworkQualityEstimator sharedEstimator].quality) {
+        case APINetworkQualityPoor:
+            return 1.0;
+        case APINetworkQualityModerate:
+            return MIN(screenScale, 2.0);
+        case APINetworkQualityUnknown:
+        case APINetworkQualityGood:
+            return screenScale;
+    }
+}
+
 - (id<SDWebImageOperation>)downloadImageWithURLString:(NSString *)URLString
                                               progress:(SDImageLoadProgressBlock)progress
                                              completed:(SDImageLoadCompletionBlock)completed {
@@ -223,6 +264,33 @@
                                        completed:completionBlock];
 }
 
+- (void)preconnectToURLString:(NSString *)URLString {
+    NSURL *url = [NSURL URLWithString:URLString];
+    if (url.host.length == 0) {
+        return;
+    }
+    
+    // 在图片下载器的会话上发送HEAD请求，建立的连接留给后续图片下载复用
+    SDWebImageDownloaderRequestModifier *requestModifier = [SDWebImageDownloaderRequestModifier requestModifierWithBlock:^NSURLRequest * _Nullable(NSURLRequest * _Nonnull request) {
+        NSMutableURLRequest *mutableRequest = [request mutableCopy];
+        mutableRequest.HTTPMethod = @"HEAD";
+        return [mutableRequest copy];
+    }];
+    
+    [[SDWebImageDownloader sharedDownloader] downloadImageWithURL:url
+                                                          options:SDWebImageDownloaderLowPriority
+                                                          context:@{SDWebImageContextDownloadRequestModifier: requestModifier}
+                                                         progress:nil
+                                                        completed:^(UIImage * _Nullable image, NSData * _Nullable data, NSError * _Nullable error, BOOL finished) {
+        // HEAD没有图片数据，下载器总会返回错误；不是网络错误就说明连接已建立
+        if ([error.domain isEqualToString:NSURLErrorDomain]) {
+            NSLog(@"⚠️ 图片CDN预连接失败: %@, %@", url.host, error.localizedDescription);
+        } else {
+            NSLog(@"🔌 图片CDN预连接完成: %@", url.host);
+        }
+    }];
+}
+
 - (void)getCachedImageWithURLString:(NSString *)URLString
                           completion:(void(^)(UIImage * _Nullable image))completion {
     NSURL *url = nil;
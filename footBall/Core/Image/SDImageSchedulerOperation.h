@@ -0,0 +1,20 @@
+//
+//  SDImageSchedulerOperation.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import <SDWebImage/SDWebImage.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 图片下载操作 - 由 APIRequestScheduler 统一调度
+/// 作为 SDWebImageDownloaderConfig.operationClass 使用：SDWebImageLowPriority（预加载）进入预加载通道，其他下载进入可见内容通道，
+/// 与API请求共享每个主机的并发名额
+@interface SDImageSchedulerOperation : SDWebImageDownloaderOperation
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,145 @@
+//
+//  SDImageSchedulerOperation.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "SDImageSchedulerOperation.h"
+#import "APIRequestScheduler.h"
+#import "APIManager.h"
+
+static void *SDImageSchedulerOperationFinishedContext = &SDImageSchedulerOperationFinishedContext;
+
+@interface SDImageSchedulerOperation ()
+
+@property (nonatomic, strong, nullable) APIScheduledJob *job; // 仍在调度器中排队的任务（开始下载后清空）
+@property (nonatomic, strong, nullable) APIScheduledJob *slotJob; // 占用名额的任务，操作结束时释放
+@property (nonatomic, strong, nullable) NSURLSessionTask *registeredTask; // 登记到请求登记表的预加载task（父类结束时会清空dataTask）
+@property (nonatomic, assign, getter=isDownloadStarted) BOOL downloadStarted;
+@property (nonatomic, assign, getter=isObservingFinished) BOOL observingFinished;
+@property (nonatomic, assign, getter=isOperationFinished) BOOL operationFinished;
+
+@end
+
+@implementation SDImageSchedulerOperation
+
+- (void)dealloc {
+    if (self.isObservingFinished) {
+        [self removeObserver:self forKeyPath:@"isFinished" context:SDImageSchedulerOperationFinishedContext];
+    }
+}
+
+- (void)start {
+    if (self.isCancelled) {
+        [super start];
+        return;
+    }
+    
+    // 下载结束（成功、失败、取消）时释放名额
+    // 通过isFinished的KVO而不是completionBlock：SDWebImageDownloader用completionBlock清理URLOperations，不能覆盖
+    [self addObserver:self forKeyPath:@"isFinished" options:0 context:SDImageSchedulerOperationFinishedContext];
+    self.observingFinished = YES;
+    
+    // 预加载（SDWebImageLowPriority）进入预加载通道，其他进入可见内容通道
+    APIRequestPriority priority = self.queuePriority <= NSOperationQueuePriorityLow
+        ? APIRequestPriorityPrefetch
+        : APIRequestPriorityVisibleContent;
+    
+    __weak typeof(self) weakSelf = self;
+    APIScheduledJob *job = [[APIRequestScheduler sharedScheduler] scheduleJobWithHost:self.request.URL.host
+                                                                             priority:priority
+                                                                         startHandler:^(APIScheduledJob *job) {
+        [weakSelf startDownload];
+    }];
+    
+    BOOL finished = NO;
+    @synchronized (self) {
+        self.slotJob = job;
+        if (!self.isDownloadStarted) {
+            self.job = job;
+        }
+        finished = self.isOperationFinished;
+    }
+    
+    // 调度期间操作已经结束
+    if (finished) {
+        [self finishSlotJob];
+    }
+}
+
+- (void)cancel {
+    [super cancel];
+    
+    // 仍在调度器中排队：移出队列，并结束操作（否则下载队列的名额一直被占用）
+    BOOL queued = NO;
+    @synchronized (self) {
+        if (!self.isDownloadStarted && self.job) {
+            self.job = nil;
+            self.downloadStarted = YES;
+            queued = YES;
+        }
+    }
+    if (queued) {
+        [self finishSlotJob];
+        [super start];
+    }
+}
+
+- (void)observeValueForKeyPath:(NSString *)keyPath
+                      ofObject:(id)object
+                        change:(NSDictionary<NSKeyValueChangeKey, id> *)change
+                       context:(void *)context {
+    if (context != SDImageSchedulerOperationFinishedContext) {
+        [super observeValueForKeyPath:keyPath ofObject:object change:change context:context];
+        return;
+    }
+    
+    if (self.isFinished) {
+        @synchronized (self) {
+            self.operationFinished = YES;
+        }
+        [self finishSlotJob];
+    }
+}
+
+#pragma mark - Private Methods
+
+- (void)startDownload {
+    @synchronized (self) {
+        if (self.isDownloadStarted) {
+            return;
+        }
+        self.downloadStarted = YES;
+        self.job = nil;
+    }
+    [super start];
+    
+    // 预加载登记到请求登记表，可以通过 cancelRequestsWithTag:APITaskTagImagePrefetch 或 cancelAllRequests 取消
+    NSURLSessionTask *dataTask = self.dataTask;
+    if (dataTask && self.queuePriority <= NSOperationQueuePriorityLow) {
+        @synchronized (self) {
+            if (self.isOperationFinished) {
+                return;
+            }
+            self.registeredTask = dataTask;
+            [[APIManager sharedManager].taskRegistry registerTask:dataTask tags:[NSSet setWithObject:APITaskTagImagePrefetch]];
+        }
+    }
+}
+
+/// 释放调度器名额并移出请求登记表（只释放一次）
+- (void)finishSlotJob {
+    APIScheduledJob *job = nil;
+    NSURLSessionTask *registeredTask = nil;
+    @synchronized (self) {
+        job = self.slotJob;
+        self.slotJob = nil;
+        registeredTask = self.registeredTask;
+        self.registeredTask = nil;
+    }
+    [job finish];
+    [[APIManager sharedManager].taskRegistry unregisterTask:registeredTask];
+}
+
+@end
@@ -8,9 +8,13 @@
 #import <Foundation/Foundation.h>
 #import "APIServerConfig.h"
 #import "APIPathConfig.h"
+#import "APIRouteTable.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
+/// 环境切换完成通知（object为APIEnvironmentManager）
+FOUNDATION_EXPORT NSString *const APIEnvironmentDidChangeNotification;
+
 /// API环境管理器 - 协调服务器地址和路径配置
 /// 分层设计：
 /// 1. APIServerConfigManager - 服务器地址层（管理不同环境的服务器地址）
@@ -22,25 +26,35 @@ NS_ASSUME_NONNULL_BEGIN
 /// 单例
 + (instancetype)sharedManager;
 
-/// 当前环境（默认：Test）
+/// 当前环境（默认：Test，修改后路由表随之失效）
 @property (nonatomic, assign) APIEnvironment currentEnvironment;
 
 /// 当前环境的基础URL（Base URL）- 从 APIServerConfigManager 获取
 @property (nonatomic, strong, readonly) NSString *currentBaseURL;
 
+/// 当前环境的图片CDN地址 - 从 APIServerConfigManager 获取（未配置时为nil）
+@property (nonatomic, strong, readonly, nullable) NSString *currentImageCDNURL;
+
+/// 当前环境的服务端是否部署了批量接口 - 从 APIServerConfigManager 获取
+@property (nonatomic, assign, readonly) BOOL currentEnvironmentSupportsBatchRequests;
+
 /// 获取指定环境的Base URL（从 APIServerConfigManager 获取）
 /// @param environment 环境类型
 - (NSString *)baseURLForEnvironment:(APIEnvironment)environment;
 
-/// 获取指定路径名称的完整URL（服务器地址 + 路径）
+/// 获取指定路径名称的完整URL（服务器地址 + 路径，从 routeTable 获取；路径模板需要参数时使用 routeTable 传入）
 /// @param pathName 路径名称（如：@"user"）
 - (NSString *)fullURLForPathName:(NSString *)pathName;
 
+/// 当前环境的路由表（路径模板和Base URL预先编译拼接，首次访问时编译）
+/// 切换环境、服务器地址或路径配置变化时整体失效，下次访问重新编译；返回的路由表不可变，可以在任意线程使用
+@property (nonatomic, strong, readonly) APIRouteTable *routeTable;
+
 /// 获取指定路径名称的路径值（从 APIPathConfigManager 获取）
 /// @param pathName 路径名称
 - (NSString *)pathForPathName:(NSString *)pathName;
 
-/// 切换环境
+/// 切换环境（切换后发送 APIEnvironmentDidChangeNotification）
 /// @param environment 目标环境
 - (void)switchToEnvironment:(APIEnvironment)environment;
 
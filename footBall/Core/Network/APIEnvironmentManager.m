@@ -9,7 +9,11 @@
 #import "APIServerConfig.h"
 #import "APIPathConfig.h"
 
-@interface APIEnvironmentManager ()
+NSString *const APIEnvironmentDidChangeNotification = @"APIEnvironmentDidChangeNotification";
+
+@interface APIEnvironmentManager () {
+    APIRouteTable *_routeTable; // 当前环境的路由表，失效时为nil（读写都在 @synchronized(self) 中）
+}
 
 @end
 
@@ -46,37 +50,70 @@
         #ifdef DEBUG
             [[APIServerConfigManager sharedManager] syncServerURLsFromEnvironmentHostManager];
         #endif
+        
+        // 服务器地址或路径配置变化时路由表失效
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(invalidateRouteTable)
+                                                     name:APIServerConfigDidChangeNotification
+                                                   object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(invalidateRouteTable)
+                                                     name:APIPathConfigDidChangeNotification
+                                                   object:nil];
     }
     return self;
 }
 
+- (void)setCurrentEnvironment:(APIEnvironment)currentEnvironment {
+    // 环境和路由表一起切换，读取方不会拿到新环境下的旧路由表
+    @synchronized (self) {
+        _currentEnvironment = currentEnvironment;
+        _routeTable = nil;
+    }
+}
+
+- (APIRouteTable *)routeTable {
+    @synchronized (self) {
+        if (!_routeTable) {
+            _routeTable = [[APIRouteTable alloc] initWithBaseURL:self.currentBaseURL
+                                                     pathConfigs:[[APIPathConfigManager sharedManager] allPathConfigs]];
+        }
+        return _routeTable;
+    }
+}
+
+- (void)invalidateRouteTable {
+    @synchronized (self) {
+        _routeTable = nil;
+    }
+}
+
 - (NSString *)currentBaseURL {
     return [self baseURLForEnvironment:self.currentEnvironment];
 }
 
+- (nullable NSString *)currentImageCDNURL {
+    return [[APIServerConfigManager sharedManager] imageCDNURLForEnvironment:self.currentEnvironment];
+}
+
+- (BOOL)currentEnvironmentSupportsBatchRequests {
+    return [[APIServerConfigManager sharedManager] supportsBatchRequestsForEnvironment:self.currentEnvironment];
+}
+
 - (NSString *)baseURLForEnvironment:(APIEnvironment)environment {
     // 从 APIServerConfigManager 获取服务器地址
     return [[APIServerConfigManager sharedManager] serverURLForEnvironment:environment];
 }
 
 - (NSString *)fullURLForPathName:(NSString *)pathName {
-    NSString *baseURL = self.currentBaseURL;
-    NSString *path = [self pathForPathName:pathName];
-    
-    if (!path) {
-        NSLog(@"⚠️ 未找到路径名称: %@", pathName);
-        return baseURL;
+    APIRouteTable *routeTable = self.routeTable;
+    NSError *error = nil;
+    NSString *URLString = [routeTable URLStringForPathName:pathName subPath:nil pathParameters:nil error:&error];
+    if (!URLString) {
+        NSLog(@"⚠️ %@", error.localizedDescription);
+        return routeTable.baseURL;
     }
-    
-    // 确保baseURL不以/结尾，path以/开头
-    if ([baseURL hasSuffix:@"/"]) {
-        baseURL = [baseURL substringToIndex:baseURL.length - 1];
-    }
-    if (![path hasPrefix:@"/"]) {
-        path = [NSString stringWithFormat:@"/%@", path];
-    }
-    
-    return [NSString stringWithFormat:@"%@%@", baseURL, path];
+    return URLString;
 }
 
 - (NSString *)pathForPathName:(NSString *)pathName {
@@ -100,6 +137,8 @@
     
     NSLog(@"✅ API环境已切换为: %@", [APIEnvironmentManager displayNameForEnvironment:environment]);
     NSLog(@"📍 Base URL: %@", self.currentBaseURL);
+    
+    [[NSNotificationCenter defaultCenter] postNotificationName:APIEnvironmentDidChangeNotification object:self];
 }
 
 + (NSString *)displayNameForEnvironment:(APIEnvironment)environment {
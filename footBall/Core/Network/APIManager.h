@@ -9,6 +9,16 @@
 #import <AFNetworking/AFNetworking.h>
 #import "APIRequestInterceptor.h"
 #import "APIError.h"
+#import "APIRetryPolicy.h"
+#import "APIRequestBudget.h"
+#import "APILatencyTracker.h"
+#import "APIRequestOptions.h"
+#import "APIRequestScheduler.h"
+#import "APIPayloadCodec.h"
+#import "APIBodyCompressor.h"
+#import "APIDownloadManager.h"
+#import "APITaskRegistry.h"
+#import "APIBatchRequest.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -27,6 +37,10 @@ typedef void(^APISuccessBlock)(id _Nullable responseObject);
 typedef void(^APIFailureBlock)(NSError *error);
 /// 网络请求进度回调
 typedef void(^APIProgressBlock)(NSProgress *progress);
+/// 本地缓存数据回调
+typedef void(^APICachedResponseBlock)(id responseObject);
+/// 网络数据回调（changed表示与本地缓存相比数据是否变化，没有缓存时为YES）
+typedef void(^APIRefreshedResponseBlock)(id _Nullable responseObject, BOOL changed);
 
 /// API管理器 - 封装AFNetworking
 @interface APIManager : NSObject
@@ -34,25 +48,98 @@ typedef void(^APIProgressBlock)(NSProgress *progress);
 /// 单例
 + (instancetype)sharedManager;
 
-/// 基础URL（已废弃，使用APIEnvironmentManager管理）
+/// 基础URL（已废弃，不再参与地址拼接，相对路径统一按 APIEnvironmentManager 的路由表拼接）
 @property (nonatomic, strong) NSString *baseURL DEPRECATED_MSG_ATTRIBUTE("使用 APIEnvironmentManager 管理环境配置");
 
 /// 请求超时时间（默认30秒）
 @property (nonatomic, assign) NSTimeInterval timeoutInterval;
 
+/// 是否按网络质量放宽超时（默认：YES）
+/// 网络质量为3G级别时超时和截止时间为配置值的1.5倍，2G级别时为2倍，避免慢速网络上本可以成功的请求超时，见 APINetworkQualityEstimator
+@property (nonatomic, assign) BOOL adaptsTimeoutToNetworkQuality;
+
+/// 按网络质量调整后的请求超时时间（API请求、文件上传下载使用）
+@property (nonatomic, assign, readonly) NSTimeInterval effectiveTimeoutInterval;
+
 /// 最大重试次数（默认：3次，0表示不重试）
 @property (nonatomic, assign) NSInteger maxRetryCount;
 
-/// 重试间隔（默认：2秒）
-@property (nonatomic, assign) NSTimeInterval retryInterval;
+/// 重试间隔（已废弃，重试等待时间由retryPolicy计算）
+@property (nonatomic, assign) NSTimeInterval retryInterval DEPRECATED_MSG_ATTRIBUTE("使用 retryPolicy 配置重试等待时间");
+
+/// 重试策略（默认：APIBackoffRetryPolicy，指数退避 + 随机抖动）
+@property (nonatomic, strong) id<APIRetryPolicy> retryPolicy;
+
+/// 重试预算（默认：重试数不超过请求数的10%），预算耗尽时失败请求不再重试
+@property (nonatomic, strong) APIRequestBudget *retryBudget;
+
+/// 是否启用熔断器（默认：YES）
+/// 按 APIPathConfigManager 中注册的路径名称统计，接口持续失败或变慢时快速失败（APIErrorCodeCircuitOpen），详见 APICircuitBreaker
+@property (nonatomic, assign) BOOL circuitBreakerEnabled;
+
+/// 对冲请求的延迟分位（默认：0.95）
+/// 对 APIPathConfig.hedgingEnabled 的路径，GET请求超过该路径最近延迟的这个分位仍未返回时，在新连接上再发一次，先返回的生效
+@property (nonatomic, assign) double hedgingPercentile;
+
+/// 对冲预算（默认：对冲请求不超过请求数的5%）
+@property (nonatomic, strong) APIRequestBudget *hedgeBudget;
+
+/// 各路径名称的请求延迟统计（用于计算对冲时机）
+@property (nonatomic, strong, readonly) APILatencyTracker *latencyTracker;
+
+/// 单个请求的截止时间（秒，默认：45），包括所有重试和等待时间；每次尝试的超时不超过剩余时间
+@property (nonatomic, assign) NSTimeInterval requestDeadline;
 
 /// 公共请求头
 @property (nonatomic, strong) NSDictionary<NSString *, NSString *> *commonHeaders;
 
+/// 是否合并相同的进行中GET请求（默认：YES）
+/// URL、规范化参数和认证相关请求头都相同的GET请求共享一次网络调用，成功/失败回调由同一个响应统一分发
+@property (nonatomic, assign) BOOL coalescesIdenticalGETRequests;
+
+/// 参与GET请求合并判定的请求头（默认：Authorization、Cookie、Accept、Accept-Language）
+@property (nonatomic, copy) NSArray<NSString *> *coalescingHeaderFields;
+
+/// 是否为路径名称GET请求启用响应缓存（默认：YES）
+/// 遵循Cache-Control/ETag/Last-Modified，过期后使用If-None-Match重新验证，详见 APIResponseCache
+@property (nonatomic, assign) BOOL responseCacheEnabled;
+
+/// 流式请求每批回调的元素数量（默认：20）
+@property (nonatomic, assign) NSUInteger streamingBatchSize;
+
+/// 请求/响应体编解码器（默认：nil，即JSON）
+/// 设置为 APIMessagePackCodec 后请求体使用MessagePack编码，并通过Accept优先请求MessagePack响应；
+/// 响应按Content-Type解码（服务端仍返回JSON时照常解析），回调拿到的Foundation对象和模型不变
+/// @note 只对默认的请求序列化器生效；流式请求始终使用JSON
+@property (nonatomic, strong, nullable) id<APIPayloadCodec> payloadCodec;
+
+/// 请求体压缩方式（默认：APIContentEncodingNone，不压缩；开启前需确认服务端支持解压请求体）
+/// 不小于 requestBodyCompressionThreshold 的请求体压缩后发送并设置Content-Encoding，uploadFile:只压缩可压缩的文件类型且不超过 uploadCompressionMaxLength 的文件
+/// 响应压缩由NSURLSession自动协商（Accept-Encoding: br, gzip, deflate）并解压；各路径压缩前后的字节数见 APICompressionStatistics
+/// @note 只对默认的请求序列化器生效
+@property (nonatomic, assign) APIContentEncoding requestBodyEncoding;
+
+/// 请求体压缩阈值（字节，默认：1024）
+@property (nonatomic, assign) NSUInteger requestBodyCompressionThreshold;
+
+/// uploadFile: 压缩的文件大小上限（字节，默认：1MB）
+/// 上传表单在调用线程读出并压缩，超过上限的文件不压缩，直接流式上传，避免大文件阻塞调用线程（通常是主线程）
+@property (nonatomic, assign) NSUInteger uploadCompressionMaxLength;
+
+/// 当前环境部署了服务端批量接口时，批量请求是否合并为一次调用（默认：YES），详见 batchGETWithItems:options:completion:
+@property (nonatomic, assign) BOOL batchEndpointEnabled;
+
 /// 请求拦截器数组（按顺序执行）
 @property (nonatomic, strong) NSArray<id<APIRequestInterceptor>> *interceptors;
 
-/// 统一错误处理回调
+/// 请求登记表（进行中的请求、标签和实时统计）
+@property (nonatomic, strong, readonly) APITaskRegistry *taskRegistry;
+
+/// 共用的会话（API请求和文件传输共用，同一主机的请求复用HTTP/2连接），回调在响应处理队列
+/// 供不经过 APIManager 发起请求的模块（如分片上传）创建task，创建的task需要自行登记到 taskRegistry
+@property (nonatomic, strong, readonly) AFHTTPSessionManager *sessionManager;
+
+/// 统一错误处理回调（主线程）
 @property (nonatomic, copy, nullable) void(^errorHandler)(APIError *error);
 
 /// 添加拦截器
@@ -76,10 +163,30 @@ typedef void(^APIProgressBlock)(NSProgress *progress);
 /// @param headers 请求头（会与公共请求头合并）
 /// @param success 成功回调
 /// @param failure 失败回调
+/// @note GET请求命中进行中的相同请求时返回的是共享的task，取消它会同时取消所有合并的调用方
+- (NSURLSessionDataTask *)requestWithMethod:(HTTPMethod)method
+                                   URLString:(NSString *)URLString
+                                  parameters:(nullable id)parameters
+                                     headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                     success:(nullable APISuccessBlock)success
+                                     failure:(nullable APIFailureBlock)failure;
+
+/// 通用请求方法（带请求选项）
+/// 所有请求由 APIRequestScheduler 按优先级和主机并发名额启动，返回的task可能仍在排队
+/// 响应在后台队列处理（指定 responseModelClass 时包括模型映射），回调总是在主线程
+/// 有拦截器异步完成（如请求签名）时返回nil，拦截器完成后照常发起请求并回调
+/// @param method 请求方法
+/// @param URLString 请求路径（相对或绝对）
+/// @param parameters 请求参数
+/// @param headers 请求头（会与公共请求头合并）
+/// @param options 请求选项（如优先级、响应模型类），nil时使用默认配置
+/// @param success 成功回调（指定响应模型类时收到模型对象）
+/// @param failure 失败回调
 - (NSURLSessionDataTask *)requestWithMethod:(HTTPMethod)method
                                    URLString:(NSString *)URLString
                                   parameters:(nullable id)parameters
                                      headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                     options:(nullable APIRequestOptions *)options
                                      success:(nullable APISuccessBlock)success
                                      failure:(nullable APIFailureBlock)failure;
 
@@ -112,18 +219,93 @@ typedef void(^APIProgressBlock)(NSProgress *progress);
                           failure:(nullable APIFailureBlock)failure;
 
 /// 使用路径名称发起GET请求（推荐使用）
+/// 启用响应缓存时：新鲜缓存直接返回（不发起请求，返回nil）；处于stale-while-revalidate窗口内时先返回旧数据并在后台重新验证
 /// @param pathName 路径名称（如：@"user"）
 /// @param subPath 子路径（可选，如：@"/profile"）
 /// @param parameters 请求参数
 /// @param headers 请求头
 /// @param success 成功回调
 /// @param failure 失败回调
-- (NSURLSessionDataTask *)GETWithPathName:(NSString *)pathName
-                                   subPath:(nullable NSString *)subPath
-                                parameters:(nullable id)parameters
-                                   headers:(nullable NSDictionary<NSString *, NSString *> *)headers
-                                   success:(nullable APISuccessBlock)success
-                                   failure:(nullable APIFailureBlock)failure;
+/// @return 请求task；新鲜缓存命中、本地数据需要先从磁盘读取（请求在读取完成后发起）或路径无效时返回nil
+- (nullable NSURLSessionDataTask *)GETWithPathName:(NSString *)pathName
+                                            subPath:(nullable NSString *)subPath
+                                         parameters:(nullable id)parameters
+                                            headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                            success:(nullable APISuccessBlock)success
+                                            failure:(nullable APIFailureBlock)failure;
+
+/// 使用路径名称发起GET请求（带请求选项）
+/// 与不带选项的方法相同，options.responseModelClass 不为空时在后台队列完成模型映射，成功回调收到模型对象
+/// @param pathName 路径名称（如：@"user"）
+/// @param subPath 子路径（可选）
+/// @param parameters 请求参数
+/// @param headers 请求头
+/// @param options 请求选项
+/// @param success 成功回调（主线程）
+/// @param failure 失败回调（主线程）
+/// @return 请求task，返回nil的情况同上
+- (nullable NSURLSessionDataTask *)GETWithPathName:(NSString *)pathName
+                                            subPath:(nullable NSString *)subPath
+                                         parameters:(nullable id)parameters
+                                            headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                            options:(nullable APIRequestOptions *)options
+                                            success:(nullable APISuccessBlock)success
+                                            failure:(nullable APIFailureBlock)failure;
+
+/// 使用路径名称发起GET请求（先缓存后网络）
+/// 有本地数据（包括已过期的数据）时先在主线程回调cached，随后请求网络并回调refreshed；
+/// 服务器返回304或数据与本地一致时changed为NO，调用方可以跳过重复渲染
+/// 本地数据不在内存中时先在后台读取磁盘，此时返回nil（网络请求在读取完成后发起）
+/// @param pathName 路径名称（如：@"user"）
+/// @param subPath 子路径（可选）
+/// @param parameters 请求参数
+/// @param headers 请求头
+/// @param cached 本地数据回调（没有本地数据时不会调用）
+/// @param refreshed 网络数据回调
+/// @param failure 失败回调
+/// @return 请求task；本地数据需要先从磁盘读取或路径无效时返回nil
+- (nullable NSURLSessionDataTask *)GETWithPathName:(NSString *)pathName
+                                            subPath:(nullable NSString *)subPath
+                                         parameters:(nullable id)parameters
+                                            headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                             cached:(nullable APICachedResponseBlock)cached
+                                          refreshed:(nullable APIRefreshedResponseBlock)refreshed
+                                            failure:(nullable APIFailureBlock)failure;
+
+/// 使用路径名称发起GET请求（先缓存后网络，带请求选项）
+/// 与不带选项的方法相同，使用 options 中的优先级和取消作用域（作用域取消后cached、refreshed和failure不再回调）；
+/// options.responseModelClass 不为空时本地数据和网络数据都在后台队列按 modelKeyPath 映射为模型后再回调
+/// @param options 请求选项
+- (nullable NSURLSessionDataTask *)GETWithPathName:(NSString *)pathName
+                                            subPath:(nullable NSString *)subPath
+                                         parameters:(nullable id)parameters
+                                            headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                            options:(nullable APIRequestOptions *)options
+                                             cached:(nullable APICachedResponseBlock)cached
+                                          refreshed:(nullable APIRefreshedResponseBlock)refreshed
+                                            failure:(nullable APIFailureBlock)failure;
+
+/// 使用路径名称发起流式GET请求（用于大列表）
+/// 响应体边下载边解析，options.modelKeyPath 指定的数组中的元素按批次回调（指定 responseModelClass 时映射为模型），
+/// 第一批数据不用等整个响应下载完成；响应体不整体缓存，峰值内存与列表大小无关
+/// 流式请求不使用响应缓存和请求合并；与普通请求一样受截止时间和熔断器限制，401时刷新Token后重放，
+/// 还没有解析出任何元素时按重试策略自动重试（已回调的批次无法撤回，之后的失败直接回调）
+/// @param pathName 路径名称
+/// @param subPath 子路径（可选）
+/// @param parameters 请求参数
+/// @param headers 请求头
+/// @param options 请求选项（modelKeyPath为数组路径，nil表示响应本身是数组）
+/// @param batch 批次回调（主线程，按数组顺序）
+/// @param success 完成回调（主线程，返回元素总数）
+/// @param failure 失败回调（主线程，可能发生在部分批次回调之后）
+- (NSURLSessionDataTask *)streamGETWithPathName:(NSString *)pathName
+                                         subPath:(nullable NSString *)subPath
+                                      parameters:(nullable id)parameters
+                                         headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                         options:(nullable APIRequestOptions *)options
+                                           batch:(void(^)(NSArray *items))batch
+                                         success:(nullable void(^)(NSUInteger itemCount))success
+                                         failure:(nullable APIFailureBlock)failure;
 
 /// 使用路径名称发起POST请求（推荐使用）
 /// @param pathName 路径名称（如：@"user"）
@@ -139,7 +321,37 @@ typedef void(^APIProgressBlock)(NSProgress *progress);
                                     success:(nullable APISuccessBlock)success
                                     failure:(nullable APIFailureBlock)failure;
 
-/// 上传文件
+/// 使用路径名称发起POST请求（带请求选项，如路径参数 options.pathParameters）
+/// @param pathName 路径名称
+/// @param subPath 子路径（可选）
+/// @param parameters 请求参数
+/// @param headers 请求头
+/// @param options 请求选项
+/// @param success 成功回调
+/// @param failure 失败回调
+- (NSURLSessionDataTask *)POSTWithPathName:(NSString *)pathName
+                                    subPath:(nullable NSString *)subPath
+                                 parameters:(nullable id)parameters
+                                    headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                    options:(nullable APIRequestOptions *)options
+                                    success:(nullable APISuccessBlock)success
+                                    failure:(nullable APIFailureBlock)failure;
+
+/// 批量发起路径名称GET请求，全部完成后汇总回调一次（每个请求单独成功或失败）
+/// 默认并发发起独立的请求（与 GETWithPathName:subPath:parameters:headers:options:success:failure: 相同，受调度器并发数限制，使用响应缓存）；
+/// 当前环境部署了服务端批量接口（APIEnvironmentManager.currentEnvironmentSupportsBatchRequests）且 batchEndpointEnabled 时，
+/// 合并为一次POST调用 APIPathNameBatch，减少高延迟网络下的往返次数（不使用响应缓存）；
+/// 批量接口本身不可用（404、405、501）时自动改为独立请求，其他错误（网络错误、5xx等）时所有请求以该错误失败
+/// 批量接口协议：请求体 {"requests": [{"id", "method", "path", "params", "headers"}]}，响应体 {"responses": [{"id", "status", "body"}]}
+/// @param items 请求列表
+/// @param options 批量请求的选项（优先级、取消作用域和标签；item.options为nil时也用于模型映射）
+/// @param completion 汇总回调（主线程，结果顺序与items一致；取消作用域取消后不再回调）
+- (void)batchGETWithItems:(NSArray<APIBatchItem *> *)items
+                  options:(nullable APIRequestOptions *)options
+               completion:(void(^)(APIBatchResult *result))completion;
+
+/// 上传文件（multipart表单，文件数据整体在内存中）
+/// 大文件使用 APIChunkedUploader 从磁盘分片上传，支持断点续传
 /// @param URLString 请求路径
 /// @param parameters 请求参数
 /// @param fileData 文件数据
@@ -161,15 +373,17 @@ typedef void(^APIProgressBlock)(NSProgress *progress);
                               success:(nullable APISuccessBlock)success
                               failure:(nullable APIFailureBlock)failure;
 
-/// 下载文件
-/// @param URLString 下载路径
-/// @param parameters 请求参数
+/// 下载文件（由 APIDownloadManager 分段下载，支持断点续传；同一地址的并发下载合并）
+/// 需要校验文件时直接使用 APIDownloadManager 并传入expectedSHA256
+/// @param URLString 下载路径（相对路径时拼接当前环境的Base URL）
+/// @param parameters 请求参数（拼接到URL）
 /// @param headers 请求头
 /// @param destinationPath 保存路径
 /// @param progress 进度回调
 /// @param success 成功回调
 /// @param failure 失败回调
-- (NSURLSessionDownloadTask *)downloadFile:(NSString *)URLString
+/// @return 下载任务，地址无效时返回nil并回调failure
+- (nullable APIDownloadTask *)downloadFile:(NSString *)URLString
                                  parameters:(nullable id)parameters
                                     headers:(nullable NSDictionary<NSString *, NSString *> *)headers
                             destinationPath:(NSString *)destinationPath
@@ -177,9 +391,37 @@ typedef void(^APIProgressBlock)(NSProgress *progress);
                                     success:(nullable void(^)(NSURL *filePath))success
                                     failure:(nullable APIFailureBlock)failure;
 
-/// 取消所有请求
+/// 合并公共请求头和请求头，并依次执行请求拦截器（认证等）
+/// 供不经过 APIManager 发起请求的模块（如分片上传）复用同样的请求头和拦截器；拦截器需要同步完成，否则返回nil
+/// @param request 请求（调用方单独创建的请求，会被直接设置请求头）
+/// @param headers 请求头（覆盖公共请求头）
+/// @return 处理后的请求，被拦截器取消时返回nil
+- (nullable NSURLRequest *)interceptedRequestForRequest:(NSMutableURLRequest *)request
+                                                headers:(nullable NSDictionary<NSString *, NSString *> *)headers;
+
+/// 请求返回401时刷新Token（多个请求同时401时只刷新一次），供不经过 APIManager 发起请求的模块重放前调用
+/// 请求发出后Token已经刷新过时直接以成功回调，不再刷新
+/// @param request 返回401的请求（判断使用的是否为当前Token）
+/// @param completion 完成回调：成功后重新构建请求重放；失败时error为刷新请求的网络或服务端错误（会话不一定过期），服务器拒绝刷新或无法刷新时为nil
+- (void)refreshAuthorizationForRequest:(NSURLRequest *)request completion:(APITokenRefreshCompletionBlock)completion;
+
+/// 预连接（DNS解析、TCP和TLS握手），连接保留在会话中供后续请求复用
+/// 一般不直接调用，由 APIConnectionManager 在启动和切换环境时调用
+/// @param URLString 服务器地址
+- (void)preconnectToURLString:(NSString *)URLString;
+
+/// 取消所有请求（包括对冲请求、分片上传、文件下载和图片预加载；分片上传暂停，下载的断点数据保留）
 - (void)cancelAllRequests;
 
+/// 取消带指定标签的请求（标签来自 APIRequestOptions.tags，路径名称自动作为标签，如 APIPathNameUser）
+/// @param tag 标签
+/// @return 取消的请求数
+- (NSUInteger)cancelRequestsWithTag:(NSString *)tag;
+
+/// 取消绑定到所有者的请求（通过 APIRequestOptions.cancellationScope / optionsWithOwner:），回调不再执行
+/// @param owner 所有者（如视图控制器）
+- (void)cancelRequestsForOwner:(id)owner;
+
 /// 取消指定请求
 - (void)cancelTask:(NSURLSessionTask *)task;
 
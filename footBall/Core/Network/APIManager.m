@@ -8,14 +8,263 @@
 #import "APIManager.h"
 #import "APIEnvironmentManager.h"
 #import "APIRequestInterceptor.h"
+#import "APIInterceptorChain.h"
 #import "APIError.h"
+#import "APIResponseCache.h"
+#import "APIRetryPolicy.h"
+#import "APIRequestBudget.h"
+#import "APIPathConfig.h"
+#import "APILatencyTracker.h"
+#import "APIRequestOptions.h"
+#import "APIRequestScheduler.h"
+#import "APIConnectionManager.h"
+#import "APIStreamingSession.h"
+#import "APICodecSerializer.h"
+#import "APICompressionStatistics.h"
+#import "APICancellationScope.h"
+#import "APITaskRegistry.h"
+#import "APIMetricsStore.h"
+#import "APINetworkQualityEstimator.h"
+#import <MJExtension/MJExtension.h>
+
+/// 内部成功回调（附带HTTP响应，用于读取缓存相关响应头）
+typedef void(^APIResponseSuccessBlock)(id _Nullable responseObject, NSHTTPURLResponse * _Nullable response);
+
+/// 内部请求选项
+typedef NS_OPTIONS(NSUInteger, APIRequestInternalFlags) {
+    APIRequestInternalFlagNone = 0,
+    APIRequestInternalFlagNoCoalescing = 1 << 0, // 不合并到进行中的相同GET请求（重试时使用，避免合并到自身）
+    APIRequestInternalFlagNoAuthReplay = 1 << 1, // 401时不再刷新Token重放（重放过的请求再次401直接失败）
+};
+
+/// 进行中的GET请求 - 记录共享同一次网络调用的所有回调
+@interface APIInflightRequest : NSObject
+
+/// 当前承载请求的task（重试时会更新为新的task）
+@property (nonatomic, weak, nullable) NSURLSessionDataTask *task;
+@property (nonatomic, strong) NSMutableArray<APIResponseSuccessBlock> *successBlocks;
+@property (nonatomic, strong) NSMutableArray<APIFailureBlock> *failureBlocks;
+
+- (void)addSuccess:(nullable APIResponseSuccessBlock)success failure:(nullable APIFailureBlock)failure;
+
+@end
+
+@implementation APIInflightRequest
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _successBlocks = [NSMutableArray array];
+        _failureBlocks = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)addSuccess:(nullable APIResponseSuccessBlock)success failure:(nullable APIFailureBlock)failure {
+    if (success) {
+        [self.successBlocks addObject:[success copy]];
+    }
+    if (failure) {
+        [self.failureBlocks addObject:[failure copy]];
+    }
+}
+
+@end
+
+/// 批量请求的结果收集 - 所有请求都有结果后在主线程回调一次
+@interface APIBatchCollector : NSObject
+
+@property (nonatomic, assign) BOOL serverBatched;
+
+- (instancetype)initWithItems:(NSArray<APIBatchItem *> *)items completion:(void(^)(APIBatchResult *result))completion;
+
+/// 记录单个请求的结果（每个下标只记录一次）
+- (void)setResponseObject:(nullable id)responseObject error:(nullable NSError *)error atIndex:(NSUInteger)index;
+
+@end
+
+@implementation APIBatchCollector {
+    NSArray<APIBatchItem *> *_items;
+    NSMutableArray<APIBatchItemResult *> *_results;
+    NSUInteger _remainingCount;
+    void (^_completion)(APIBatchResult *result);
+}
+
+- (instancetype)initWithItems:(NSArray<APIBatchItem *> *)items completion:(void(^)(APIBatchResult *result))completion {
+    self = [super init];
+    if (self) {
+        _items = [items copy];
+        _results = [NSMutableArray arrayWithCapacity:items.count];
+        for (NSUInteger index = 0; index < items.count; index++) {
+            [_results addObject:(id)[NSNull null]];
+        }
+        _remainingCount = items.count;
+        _completion = [completion copy];
+    }
+    return self;
+}
+
+- (void)setResponseObject:(nullable id)responseObject error:(nullable NSError *)error atIndex:(NSUInteger)index {
+    APIError *apiError = nil;
+    if (error) {
+        apiError = [error isKindOfClass:[APIError class]] ? (APIError *)error : [APIError errorFromNSError:error];
+    }
+    APIBatchItemResult *result = [APIBatchItemResult resultWithItem:_items[index] responseObject:responseObject error:apiError];
+    
+    APIBatchResult *batchResult = nil;
+    void (^completion)(APIBatchResult *) = nil;
+    @synchronized (self) {
+        if (_results[index] != (id)[NSNull null]) {
+            return;
+        }
+        _results[index] = result;
+        _remainingCount--;
+        if (_remainingCount > 0) {
+            return;
+        }
+        batchResult = [[APIBatchResult alloc] initWithItemResults:_results serverBatched:self.serverBatched];
+        completion = _completion;
+        _completion = nil;
+    }
+    
+    if ([NSThread isMainThread]) {
+        completion(batchResult);
+    } else {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(batchResult);
+        });
+    }
+}
+
+@end
+
+/// 请求上下文 - 同一请求的所有尝试共享（请求选项、重试次数、上次等待时间、截止时间、拦截器数据）
+@interface APIRequestContext : NSObject
+
+@property (nonatomic, copy, nullable) APIRequestOptions *options;
+@property (nonatomic, assign) NSInteger retryCount;
+@property (nonatomic, assign) NSTimeInterval previousDelay;
+@property (nonatomic, assign) CFAbsoluteTime deadline;
+@property (nonatomic, strong, nullable) APICancellationToken *cancellationToken; // 绑定取消作用域时存在
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *interceptorUserInfo; // 拦截器上下文的userInfo
+@property (nonatomic, strong, nullable) APIInterceptorChain *interceptorChain; // 首次请求时创建（拦截器数组的快照）
+
+@end
+
+@implementation APIRequestContext
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _interceptorUserInfo = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+/// 本次尝试的拦截器上下文
+- (APIInterceptorContext *)interceptorContextWithHTTPMethod:(NSString *)methodString URLString:(NSString *)URLString {
+    return [[APIInterceptorContext alloc] initWithHTTPMethod:methodString
+                                                   URLString:URLString
+                                                     options:self.options
+                                                  retryCount:self.retryCount
+                                                    userInfo:self.interceptorUserInfo];
+}
+
+@end
+
+/// 绑定取消作用域的回调 - 取消时清空，立即释放回调捕获的对象（如视图控制器）
+@interface APIScopedBlockHolder : NSObject
+
+@property (atomic, copy, nullable) id block;
+
++ (instancetype)holderWithBlock:(id)block token:(APICancellationToken *)token;
+
+@end
+
+@implementation APIScopedBlockHolder
+
++ (instancetype)holderWithBlock:(id)block token:(APICancellationToken *)token {
+    APIScopedBlockHolder *holder = [[APIScopedBlockHolder alloc] init];
+    holder.block = block;
+    [token addCancellationHandler:^{
+        holder.block = nil;
+    }];
+    return holder;
+}
+
+@end
+
+/// 对冲请求状态 - 主请求和对冲请求中先成功的一个生效，其余取消
+@interface APIHedgeState : NSObject
+
+@property (nonatomic, strong) NSMutableArray<NSURLSessionTask *> *tasks;
+@property (nonatomic, assign, getter=isFinished) BOOL finished;
+
+/// 登记一次尝试（已结束时返回NO，调用方应取消该task）
+- (BOOL)addTask:(NSURLSessionTask *)task;
+
+/// 一次尝试完成
+/// @return 该结果是否应该交给调用方（成功、被取消或所有尝试都失败时为YES）
+- (BOOL)completeAttemptForTask:(NSURLSessionTask *)task error:(nullable NSError *)error;
+
+@end
+
+@implementation APIHedgeState
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _tasks = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (BOOL)addTask:(NSURLSessionTask *)task {
+    @synchronized (self) {
+        if (self.finished) {
+            return NO;
+        }
+        [self.tasks addObject:task];
+        return YES;
+    }
+}
+
+- (BOOL)completeAttemptForTask:(NSURLSessionTask *)task error:(nullable NSError *)error {
+    NSArray<NSURLSessionTask *> *losers = nil;
+    @synchronized (self) {
+        if (self.finished) {
+            return NO;
+        }
+        
+        [self.tasks removeObject:task];
+        // 失败且还有其他尝试在进行中：等待其他尝试的结果
+        if (error && error.code != NSURLErrorCancelled && self.tasks.count > 0) {
+            return NO;
+        }
+        
+        self.finished = YES;
+        losers = [self.tasks copy];
+        [self.tasks removeAllObjects];
+    }
+    
+    for (NSURLSessionTask *loser in losers) {
+        [loser cancel];
+    }
+    return YES;
+}
+
+@end
 
 @interface APIManager ()
 
 @property (nonatomic, strong) AFHTTPSessionManager *sessionManager;
-@property (nonatomic, strong) NSMutableArray<NSURLSessionTask *> *tasks;
+@property (nonatomic, strong) AFHTTPSessionManager *hedgeSessionManager; // 对冲请求使用独立的session（新的连接）
+@property (nonatomic, strong) APIStreamingSession *streamingSession; // 流式请求会话（不缓存响应体）
+@property (nonatomic, strong, readwrite) APITaskRegistry *taskRegistry;
 @property (nonatomic, strong) NSMutableArray<id<APIRequestInterceptor>> *mutableInterceptors;
-@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *retryCountMap; // 请求重试次数映射
+@property (nonatomic, strong) dispatch_queue_t retryQueue; // 重试定时器队列（不占用主线程）
+@property (nonatomic, strong) dispatch_queue_t decodeQueue; // 响应处理队列（缓存读写、拦截器、模型映射，完成后回到主线程回调）
+@property (nonatomic, strong) NSMutableDictionary<NSString *, APIInflightRequest *> *inflightRequests; // 进行中的GET请求（按请求标识合并）
 
 @end
 
@@ -35,297 +284,865 @@
     if (self) {
         _baseURL = @"";
         _timeoutInterval = 30.0;
+        _adaptsTimeoutToNetworkQuality = YES;
         _maxRetryCount = 3; // 默认最大重试3次
         _retryInterval = 2.0; // 默认重试间隔2秒
+        _retryPolicy = [[APIBackoffRetryPolicy alloc] init];
+        _retryBudget = [[APIRequestBudget alloc] init];
+        _requestDeadline = 45.0;
+        _circuitBreakerEnabled = YES;
+        _hedgingPercentile = 0.95;
+        _hedgeBudget = [[APIRequestBudget alloc] initWithRatio:0.05 minPerSecond:0.2 window:10.0];
+        _latencyTracker = [[APILatencyTracker alloc] init];
+        _retryQueue = dispatch_queue_create("com.football.api.retry", DISPATCH_QUEUE_SERIAL);
+        _decodeQueue = dispatch_queue_create("com.football.api.decode", DISPATCH_QUEUE_CONCURRENT);
         _commonHeaders = @{};
-        _tasks = [NSMutableArray array];
+        _taskRegistry = [[APITaskRegistry alloc] init];
         _mutableInterceptors = [NSMutableArray array];
-        _retryCountMap = [NSMutableDictionary dictionary];
+        _inflightRequests = [NSMutableDictionary dictionary];
+        _coalescesIdenticalGETRequests = YES;
+        _coalescingHeaderFields = @[@"Authorization", @"Cookie", @"Accept", @"Accept-Language"];
+        _responseCacheEnabled = YES;
         
-        // 初始化AFHTTPSessionManager
-        _sessionManager = [[AFHTTPSessionManager alloc] init];
-        _sessionManager.requestSerializer = [AFJSONRequestSerializer serializer];
-        _sessionManager.responseSerializer = [AFJSONResponseSerializer serializer];
+        // 初始化AFHTTPSessionManager（API请求和文件传输共用一个会话，同一主机的请求复用HTTP/2连接）
+        NSURLSessionConfiguration *configuration = [[APIConnectionManager sharedManager] sessionConfiguration];
+        // 响应缓存和条件请求由 APIResponseCache 处理：不再由系统缓存重复保存，系统也不会替换304或自行附加条件请求头
+        configuration.URLCache = nil;
+        configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+        _sessionManager = [[AFHTTPSessionManager alloc] initWithSessionConfiguration:configuration];
+        // 请求/响应体按payloadCodec编解码（默认JSON），响应按Content-Type选择解码器
+        _sessionManager.requestSerializer = [APICodecRequestSerializer serializer];
+        _sessionManager.responseSerializer = [APICodecResponseSerializer serializer];
         _sessionManager.requestSerializer.timeoutInterval = _timeoutInterval;
+        // JSON解析在AFNetworking的处理队列完成，回调在响应处理队列，不占用主线程
+        _sessionManager.completionQueue = _decodeQueue;
         
         // 设置可接受的响应类型
-        _sessionManager.responseSerializer.acceptableContentTypes = [NSSet setWithObjects:
-                                                                     @"application/json",
-                                                                     @"text/json",
-                                                                     @"text/javascript",
-                                                                     @"text/html",
-                                                                     @"text/plain",
-                                                                     nil];
+        NSSet *acceptableContentTypes = [NSSet setWithObjects:
+                                         @"application/json",
+                                         @"text/json",
+                                         @"text/javascript",
+                                         @"text/html",
+                                         @"text/plain",
+                                         nil];
+        _sessionManager.responseSerializer.acceptableContentTypes = [acceptableContentTypes setByAddingObjectsFromSet:[[APIPayloadCodecRegistry sharedRegistry] allAcceptableContentTypes]];
+        
+        // 接受304（条件请求的重新验证结果，响应体为空）
+        NSMutableIndexSet *acceptableStatusCodes = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(200, 100)];
+        [acceptableStatusCodes addIndex:304];
+        _sessionManager.responseSerializer.acceptableStatusCodes = acceptableStatusCodes;
+        
+        _hedgeSessionManager = [[AFHTTPSessionManager alloc] initWithSessionConfiguration:configuration];
+        _hedgeSessionManager.responseSerializer = _sessionManager.responseSerializer;
+        _hedgeSessionManager.completionQueue = _decodeQueue;
+        
+        // 按路径名称统计请求/响应体压缩前后的字节数和各阶段耗时，同时为网络质量估算采样
+        void (^metricsBlock)(NSURLSession *, NSURLSessionTask *, NSURLSessionTaskMetrics *) = ^(NSURLSession *session, NSURLSessionTask *task, NSURLSessionTaskMetrics *metrics) {
+            if (metrics) {
+                [[APICompressionStatistics sharedStatistics] recordMetrics:metrics forTask:task];
+                [[APIMetricsStore sharedStore] recordMetrics:metrics forTask:task];
+                [[APINetworkQualityEstimator sharedEstimator] recordMetrics:metrics forTask:task];
+            }
+        };
+        [_sessionManager setTaskDidFinishCollectingMetricsBlock:metricsBlock];
+        [_hedgeSessionManager setTaskDidFinishCollectingMetricsBlock:metricsBlock];
+        
+        _streamingSession = [[APIStreamingSession alloc] initWithConfiguration:configuration];
+        _streamingBatchSize = 20;
+        _requestBodyCompressionThreshold = 1024;
+        _uploadCompressionMaxLength = 1024 * 1024;
+        _batchEndpointEnabled = YES;
     }
     return self;
 }
 
+// 请求可以在任意线程构建，拦截器数组的读写需要加锁
 - (NSArray<id<APIRequestInterceptor>> *)interceptors {
-    return [self.mutableInterceptors copy];
+    @synchronized (self.mutableInterceptors) {
+        return [self.mutableInterceptors copy];
+    }
+}
+
+- (void)setInterceptors:(NSArray<id<APIRequestInterceptor>> *)interceptors {
+    @synchronized (self.mutableInterceptors) {
+        [self.mutableInterceptors setArray:interceptors ?: @[]];
+    }
 }
 
 - (void)addInterceptor:(id<APIRequestInterceptor>)interceptor {
-    if (interceptor && ![self.mutableInterceptors containsObject:interceptor]) {
-        [self.mutableInterceptors addObject:interceptor];
+    @synchronized (self.mutableInterceptors) {
+        if (interceptor && ![self.mutableInterceptors containsObject:interceptor]) {
+            [self.mutableInterceptors addObject:interceptor];
+        }
     }
 }
 
 - (void)removeInterceptor:(id<APIRequestInterceptor>)interceptor {
-    [self.mutableInterceptors removeObject:interceptor];
+    @synchronized (self.mutableInterceptors) {
+        [self.mutableInterceptors removeObject:interceptor];
+    }
+}
+
+- (NSTimeInterval)effectiveTimeoutInterval {
+    return [self adjustedIntervalForInterval:self.timeoutInterval];
+}
+
+/// 按网络质量放宽超时和截止时间
+- (NSTimeInterval)adjustedIntervalForInterval:(NSTimeInterval)interval {
+    if (!self.adaptsTimeoutToNetworkQuality) {
+        return interval;
+    }
+    return [[APINetworkQualityEstimator sharedEstimator] adjustedInterval:interval];
 }
 
 - (void)setRequestSerializer:(AFHTTPRequestSerializer *)serializer {
     self.sessionManager.requestSerializer = serializer;
 }
 
+- (void)setPayloadCodec:(id<APIPayloadCodec>)payloadCodec {
+    _payloadCodec = payloadCodec;
+    
+    APICodecRequestSerializer *serializer = [self codecRequestSerializerForProperty:@"payloadCodec"];
+    // JSON与默认行为一致，不改写Accept
+    serializer.codec = [payloadCodec isKindOfClass:[APIJSONCodec class]] ? nil : payloadCodec;
+}
+
+- (void)setRequestBodyEncoding:(APIContentEncoding)requestBodyEncoding {
+    _requestBodyEncoding = requestBodyEncoding;
+    [self codecRequestSerializerForProperty:@"requestBodyEncoding"].bodyEncoding = requestBodyEncoding;
+}
+
+- (void)setRequestBodyCompressionThreshold:(NSUInteger)requestBodyCompressionThreshold {
+    _requestBodyCompressionThreshold = requestBodyCompressionThreshold;
+    [self codecRequestSerializerForProperty:@"requestBodyCompressionThreshold"].bodyCompressionThreshold = requestBodyCompressionThreshold;
+}
+
+- (nullable APICodecRequestSerializer *)codecRequestSerializerForProperty:(NSString *)property {
+    APICodecRequestSerializer *serializer = (APICodecRequestSerializer *)self.sessionManager.requestSerializer;
+    if (![serializer isKindOfClass:[APICodecRequestSerializer class]]) {
+        NSLog(@"⚠️ 自定义请求序列化器不支持%@: %@", property, [serializer class]);
+        return nil;
+    }
+    return serializer;
+}
+
 - (void)setResponseSerializer:(AFJSONResponseSerializer *)serializer {
     self.sessionManager.responseSerializer = serializer;
+    self.hedgeSessionManager.responseSerializer = serializer;
+}
+
+- (NSURLSessionDataTask *)requestWithMethod:(HTTPMethod)method
+                                   URLString:(NSString *)URLString
+                                  parameters:(nullable id)parameters
+                                     headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                     success:(nullable APISuccessBlock)success
+                                     failure:(nullable APIFailureBlock)failure {
+    return [self requestWithMethod:method
+                          URLString:URLString
+                         parameters:parameters
+                            headers:headers
+                            options:nil
+                            success:success
+                            failure:failure];
 }
 
 - (NSURLSessionDataTask *)requestWithMethod:(HTTPMethod)method
                                    URLString:(NSString *)URLString
                                   parameters:(nullable id)parameters
                                      headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                     options:(nullable APIRequestOptions *)options
                                      success:(nullable APISuccessBlock)success
                                      failure:(nullable APIFailureBlock)failure {
+    APIRequestContext *context = [[APIRequestContext alloc] init];
+    context.options = options;
     
-    // 构建完整URL
-    NSString *fullURL = URLString;
-    // 优先使用APIEnvironmentManager，如果baseURL为空则使用环境管理器
-    if (self.baseURL.length > 0 && ![URLString hasPrefix:@"http"]) {
-        fullURL = [self.baseURL stringByAppendingPathComponent:URLString];
-    } else if (![URLString hasPrefix:@"http"]) {
-        // 使用环境管理器的Base URL
-        NSString *baseURL = [APIEnvironmentManager sharedManager].currentBaseURL;
-        if (baseURL.length > 0) {
-            // 确保baseURL不以/结尾，URLString以/开头
-            if ([baseURL hasSuffix:@"/"]) {
-                baseURL = [baseURL substringToIndex:baseURL.length - 1];
-            }
-            if (![URLString hasPrefix:@"/"]) {
-                URLString = [NSString stringWithFormat:@"/%@", URLString];
-            }
-            fullURL = [NSString stringWithFormat:@"%@%@", baseURL, URLString];
-        }
+    // 绑定取消作用域：取消后回调不再执行
+    APICancellationToken *token = [options.cancellationScope issueToken];
+    context.cancellationToken = token;
+    success = [self scopedSuccess:success token:token];
+    failure = [self scopedFailure:failure token:token];
+    
+    __weak typeof(self) weakSelf = self;
+    return [self requestWithMethod:method
+                          URLString:URLString
+                         parameters:parameters
+                            headers:headers
+                              flags:APIRequestInternalFlagNone
+                            context:context
+                    responseSuccess:^(id responseObject, NSHTTPURLResponse *response) {
+        [weakSelf deliverResponseObject:responseObject options:options URL:response.URL cancellationToken:token success:success failure:failure];
+    } failure:^(NSError *error) {
+        [weakSelf deliverError:error failure:failure];
+    }];
+}
+
+/// 通用请求方法（内部实现）
+/// @param flags 内部请求标记
+/// @param context 请求上下文（重试/重放时沿用同一个上下文）
+/// @param success 成功回调（附带HTTP响应）
+/// @note Token刷新期间（或Token已过期）发起的请求会被挂起，此时返回nil，刷新完成后自动重放或统一失败
+- (NSURLSessionDataTask *)requestWithMethod:(HTTPMethod)method
+                                   URLString:(NSString *)URLString
+                                  parameters:(nullable id)parameters
+                                     headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                       flags:(APIRequestInternalFlags)flags
+                                     context:(nullable APIRequestContext *)context
+                             responseSuccess:(nullable APIResponseSuccessBlock)success
+                                     failure:(nullable APIFailureBlock)failure {
+    
+    // 取消作用域已取消（等待中的重试或Token刷新后的重放到期时）：不再发起
+    if (context.cancellationToken.isCancelled) {
+        return nil;
     }
     
-    // 创建请求对象
-    NSMutableURLRequest *request = [self.sessionManager.requestSerializer requestWithMethod:[self HTTPMethodString:method]
-                                                                                   URLString:fullURL
-                                                                                  parameters:parameters
-                                                                                       error:nil];
+    // 构建完整URL（相对路径拼接当前环境路由表中的Base URL）
+    NSString *fullURL = [[APIEnvironmentManager sharedManager].routeTable absoluteURLStringForURLString:URLString];
     
-    // 合并请求头
-    NSMutableDictionary *allHeaders = [NSMutableDictionary dictionaryWithDictionary:self.commonHeaders];
-    if (headers) {
-        [allHeaders addEntriesFromDictionary:headers];
+    // Token因401正在刷新或已过期：挂起请求，等待刷新完成后使用新Token重放（提前刷新时Token仍有效，不挂起）
+    APIAuthenticationInterceptor *authInterceptor = [self authenticationInterceptor];
+    BOOL isTokenRefreshRequest = [authInterceptor isTokenRefreshURL:[NSURL URLWithString:fullURL]];
+    if (authInterceptor.canRefreshToken && !isTokenRefreshRequest &&
+        (authInterceptor.isRefreshingReactively || authInterceptor.isTokenExpired)) {
+        NSLog(@"⏸️ Token刷新中，挂起请求: %@", fullURL);
+        [self parkRequestWithMethod:method
+                          URLString:URLString
+                         parameters:parameters
+                            headers:headers
+                              flags:flags
+                            context:context
+                    responseSuccess:success
+                            failure:failure];
+        return nil;
     }
     
-    // 设置请求头
-    for (NSString *key in allHeaders.allKeys) {
-        [request setValue:allHeaders[key] forHTTPHeaderField:key];
+    // 首次请求：确定截止时间，截止时间覆盖所有重试
+    if (!context) {
+        context = [[APIRequestContext alloc] init];
+    }
+    if (context.deadline <= 0) {
+        context.deadline = CFAbsoluteTimeGetCurrent() + [self adjustedIntervalForInterval:self.requestDeadline];
+        [self.retryBudget recordRequest];
     }
     
-    // 执行请求拦截器
-    NSURLRequest *interceptedRequest = request;
-    for (id<APIRequestInterceptor> interceptor in self.interceptors) {
-        if ([interceptor respondsToSelector:@selector(interceptRequest:)]) {
-            interceptedRequest = [interceptor interceptRequest:interceptedRequest];
-            if (!interceptedRequest) {
-                // 请求被取消
-                if (failure) {
-                    APIError *error = [APIError errorWithCode:APIErrorCodeCancelled
-                                                       message:@"请求被拦截器取消"
-                                               underlyingError:nil];
-                    failure(error);
-                }
-                return nil;
-            }
+    // 已超过截止时间（如Token刷新等待过久），不再发起请求
+    NSTimeInterval remainingTime = context.deadline - CFAbsoluteTimeGetCurrent();
+    if (remainingTime <= 0) {
+        if (failure) {
+            APIError *error = [APIError errorWithCode:APIErrorCodeTimeout
+                                               message:@"请求超时"
+                                       underlyingError:nil];
+            error.requestPath = fullURL;
+            failure(error);
         }
+        return nil;
     }
     
-    // 设置请求头到sessionManager（用于AFNetworking）
-    for (NSString *key in interceptedRequest.allHTTPHeaderFields.allKeys) {
-        [self.sessionManager.requestSerializer setValue:interceptedRequest.allHTTPHeaderFields[key] 
-                                     forHTTPHeaderField:key];
+    // 拦截器链在首次请求时创建，同一请求的所有尝试共用
+    if (!context.interceptorChain) {
+        context.interceptorChain = [[APIInterceptorChain alloc] initWithInterceptors:self.interceptors];
     }
     
-    // 包装成功和失败回调，执行响应拦截器
+    // 构建请求并执行请求拦截器（单次请求超时不超过剩余时间，保证所有重试加起来不超过截止时间）
+    // 拦截器都同步完成时直接发起并返回task；有拦截器异步完成（如请求签名）时返回nil，完成后再发起
+    NSString *methodString = [self HTTPMethodString:method];
+    APIInterceptorContext *interceptorContext = [context interceptorContextWithHTTPMethod:methodString URLString:fullURL];
     __weak typeof(self) weakSelf = self;
-    APISuccessBlock wrappedSuccess = ^(id responseObject) {
-        // 执行响应拦截器
-        BOOL shouldContinue = YES;
-        for (id<APIRequestInterceptor> interceptor in weakSelf.interceptors) {
-            if ([interceptor respondsToSelector:@selector(interceptResponse:data:error:)]) {
-                shouldContinue = [interceptor interceptResponse:nil data:nil error:nil];
-                if (!shouldContinue) {
-                    break;
-                }
+    __block NSURLSessionDataTask *task = nil;
+    BOOL completed = [self buildRequestWithHTTPMethod:methodString
+                                            URLString:fullURL
+                                           parameters:parameters
+                                              headers:headers
+                                      timeoutInterval:MIN(self.effectiveTimeoutInterval, remainingTime)
+                                     interceptorChain:context.interceptorChain
+                                   interceptorContext:interceptorContext
+                                           completion:^(NSURLRequest *interceptedRequest, NSError *buildError) {
+        if (!interceptedRequest) {
+            // 序列化失败或请求被拦截器取消
+            if (failure) {
+                APIError *error = buildError ? [APIError errorFromNSError:buildError]
+                    : [APIError errorWithCode:APIErrorCodeCancelled message:@"请求被拦截器取消" underlyingError:nil];
+                error.requestPath = fullURL;
+                failure(error);
             }
+            return;
         }
         
-        if (shouldContinue && success) {
-            success(responseObject);
+        task = [weakSelf sendRequest:interceptedRequest
+                              method:method
+                           URLString:URLString
+                          parameters:parameters
+                             headers:headers
+                               flags:flags
+                             context:context
+                  interceptorContext:interceptorContext
+                     responseSuccess:success
+                             failure:failure];
+    }];
+    return completed ? task : nil;
+}
+
+/// 发起构建好的请求（合并相同GET、熔断、重试、对冲和调度）
+/// @param interceptedRequest 经过请求拦截器的请求
+/// @param interceptorContext 本次尝试的拦截器上下文（响应和错误拦截器沿用）
+- (nullable NSURLSessionDataTask *)sendRequest:(NSURLRequest *)interceptedRequest
+                                        method:(HTTPMethod)method
+                                     URLString:(NSString *)URLString
+                                    parameters:(nullable id)parameters
+                                       headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                         flags:(APIRequestInternalFlags)flags
+                                       context:(APIRequestContext *)context
+                            interceptorContext:(APIInterceptorContext *)interceptorContext
+                               responseSuccess:(nullable APIResponseSuccessBlock)success
+                                       failure:(nullable APIFailureBlock)failure {
+    // 异步拦截器完成时作用域可能已取消，剩余时间也可能已用完
+    if (context.cancellationToken.isCancelled) {
+        return nil;
+    }
+    NSString *fullURL = interceptorContext.URLString;
+    NSTimeInterval remainingTime = context.deadline - CFAbsoluteTimeGetCurrent();
+    if (remainingTime <= 0) {
+        if (failure) {
+            APIError *error = [APIError errorWithCode:APIErrorCodeTimeout
+                                               message:@"请求超时"
+                                       underlyingError:nil];
+            error.requestPath = fullURL;
+            failure(error);
         }
-    };
+        return nil;
+    }
+    APIAuthenticationInterceptor *authInterceptor = [self authenticationInterceptor];
+    BOOL isTokenRefreshRequest = [authInterceptor isTokenRefreshURL:interceptedRequest.URL];
     
-    // 生成请求唯一标识（用于跟踪重试次数）
-    NSString *requestKey = [NSString stringWithFormat:@"%@_%ld_%p", fullURL, (long)method, parameters];
+    // 生成请求唯一标识（用于跟踪重试次数和合并相同请求）
+    NSString *requestKey = [self requestKeyForMethod:method request:interceptedRequest parameters:parameters];
     
-    APIFailureBlock wrappedFailure = ^(NSError *error) {
-        // 转换为APIError
-        APIError *apiError = [APIError errorFromNSError:error];
-        apiError.requestPath = fullURL;
-        apiError.maxRetryCount = weakSelf.maxRetryCount;
-        apiError.retryInterval = weakSelf.retryInterval;
-        
-        // 获取当前重试次数
-        NSNumber *currentRetryCount = weakSelf.retryCountMap[requestKey];
-        apiError.retryCount = currentRetryCount ? [currentRetryCount integerValue] : 0;
-        
-        // 执行错误拦截器
-        NSError *finalError = apiError;
-        for (id<APIRequestInterceptor> interceptor in weakSelf.interceptors) {
-            if ([interceptor respondsToSelector:@selector(interceptError:)]) {
-                NSError *interceptedError = [interceptor interceptError:finalError];
-                if (!interceptedError) {
-                    // 错误已被处理，不继续传播
-                    [weakSelf.retryCountMap removeObjectForKey:requestKey]; // 清理重试计数
-                    return;
-                }
-                finalError = interceptedError;
+    // 合并相同的进行中GET请求：命中时只登记回调，由首个请求的响应统一分发
+    __weak typeof(self) weakSelf = self;
+    APIInflightRequest *inflightRequest = nil;
+    if (!(flags & APIRequestInternalFlagNoCoalescing) && method == HTTPMethodGET && self.coalescesIdenticalGETRequests) {
+        @synchronized (self.inflightRequests) {
+            APIInflightRequest *existingRequest = self.inflightRequests[requestKey];
+            if (existingRequest) {
+                [existingRequest addSuccess:success failure:failure];
+                NSLog(@"🔗 合并进行中的GET请求: %@", fullURL);
+                return existingRequest.task;
             }
-        }
-        
-        // 检查是否需要重试
-        APIError *finalAPIError = (APIError *)finalError;
-        if (finalAPIError.canRetry && 
-            weakSelf.maxRetryCount > 0 &&
-            finalAPIError.retryCount < weakSelf.maxRetryCount) {
-            // 增加重试次数
-            finalAPIError.retryCount = finalAPIError.retryCount + 1;
-            weakSelf.retryCountMap[requestKey] = @(finalAPIError.retryCount);
-            
-            NSLog(@"🔄 准备第 %ld 次重试（最大 %ld 次），间隔 %.1f 秒", 
-                  (long)finalAPIError.retryCount, 
-                  (long)weakSelf.maxRetryCount, 
-                  finalAPIError.retryInterval);
             
-            // 延迟重试
-            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(finalAPIError.retryInterval * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
-                // 重新发起请求
-                [weakSelf requestWithMethod:method
-                                  URLString:URLString
-                                 parameters:parameters
-                                    headers:headers
-                                    success:^(id responseObject) {
-                    // 重试成功，清理重试计数
-                    [weakSelf.retryCountMap removeObjectForKey:requestKey];
-                    if (success) {
-                        success(responseObject);
-                    }
-                } failure:wrappedFailure]; // 使用相同的wrappedFailure，继续重试逻辑
-            });
-            return; // 重试中，不调用失败回调
+            // 绑定取消作用域的请求不作为合并的首个请求：取消它的task会让合并进来的其他调用方一起失败
+            if (!context.cancellationToken) {
+                inflightRequest = [[APIInflightRequest alloc] init];
+                [inflightRequest addSuccess:success failure:failure];
+                self.inflightRequests[requestKey] = inflightRequest;
+            }
         }
         
-        // 清理重试计数
-        [weakSelf.retryCountMap removeObjectForKey:requestKey];
-        
-        // 统一错误处理回调
-        if (weakSelf.errorHandler) {
-            weakSelf.errorHandler(finalAPIError);
+        if (inflightRequest) {
+            success = ^(id responseObject, NSHTTPURLResponse *response) {
+                for (APIResponseSuccessBlock block in [weakSelf finishInflightRequestForKey:requestKey].successBlocks) {
+                    block(responseObject, response);
+                }
+            };
+            failure = ^(NSError *error) {
+                for (APIFailureBlock block in [weakSelf finishInflightRequestForKey:requestKey].failureBlocks) {
+                    block(error);
+                }
+            };
         }
-        
+    }
+    
+    // 熔断器打开：快速失败，不再等待已知异常的接口超时
+    APIPathConfig *pathConfig = [[APIPathConfigManager sharedManager] pathConfigForURL:interceptedRequest.URL];
+    APICircuitBreaker *circuitBreaker = self.circuitBreakerEnabled ? pathConfig.circuitBreaker : nil;
+    if (circuitBreaker && ![circuitBreaker allowRequest]) {
+        NSLog(@"⛔️ 接口[%@]熔断中，快速失败: %@", circuitBreaker.name, fullURL);
         if (failure) {
-            failure(finalError);
+            APIError *error = [APIError errorWithCode:APIErrorCodeCircuitOpen
+                                               message:@"服务暂时不可用，请稍后重试"
+                                       underlyingError:nil];
+            error.requestPath = fullURL;
+            failure(error);
         }
-    };
+        return nil;
+    }
+    CFAbsoluteTime attemptStartTime = CFAbsoluteTimeGetCurrent();
     
-    // 根据方法类型发起请求
-    NSURLSessionDataTask *task = nil;
+    // 包装成功和失败回调，执行响应拦截器
+    APIResponseSuccessBlock wrappedSuccess = ^(id responseObject, NSHTTPURLResponse *response) {
+        NSTimeInterval latency = CFAbsoluteTimeGetCurrent() - attemptStartTime;
+        [circuitBreaker recordSuccessWithLatency:latency];
+        if (method == HTTPMethodGET && pathConfig) {
+            [weakSelf.latencyTracker recordLatency:latency forKey:pathConfig.name];
+        }
+        
+        // 执行响应拦截器（可以异步完成）
+        [context.interceptorChain processResponse:response responseObject:responseObject context:interceptorContext completion:^(BOOL shouldContinue) {
+            [weakSelf recordInterceptorDurationOfContext:interceptorContext URL:interceptedRequest.URL];
+            if (shouldContinue && success) {
+                success(responseObject, response);
+            }
+        }];
+    };
     
-    switch (method) {
-        case HTTPMethodGET: {
-            task = [self.sessionManager GET:fullURL
-                                  parameters:parameters
-                                     headers:nil
-                                    progress:nil
-                                     success:^(NSURLSessionDataTask * _Nonnull task, id  _Nullable responseObject) {
-                [weakSelf.tasks removeObject:task];
-                wrappedSuccess(responseObject);
-            } failure:^(NSURLSessionDataTask * _Nullable task, NSError * _Nonnull error) {
-                [weakSelf.tasks removeObject:task];
-                wrappedFailure(error);
-            }];
-            break;
+    APIFailureBlock wrappedFailure = ^(NSError *error) {
+        // 取消作用域已取消：不再重试、刷新Token或回调
+        if (context.cancellationToken.isCancelled) {
+            [circuitBreaker recordIgnored];
+            return;
         }
-            
-        case HTTPMethodPOST: {
-            task = [self.sessionManager POST:fullURL
-                                   parameters:parameters
-                                      headers:nil
-                                     progress:nil
-                                      success:^(NSURLSessionDataTask * _Nonnull task, id  _Nullable responseObject) {
-                [weakSelf.tasks removeObject:task];
-                wrappedSuccess(responseObject);
-            } failure:^(NSURLSessionDataTask * _Nullable task, NSError * _Nonnull error) {
-                [weakSelf.tasks removeObject:task];
-                wrappedFailure(error);
-            }];
-            break;
+        
+        // 转换为APIError
+        APIError *apiError = [APIError errorFromNSError:error];
+        apiError.requestPath = fullURL;
+        
+        // 网络错误、超时和5xx计入熔断统计；取消不计入；其他（如4xx）说明服务正常响应
+        NSTimeInterval latency = CFAbsoluteTimeGetCurrent() - attemptStartTime;
+        if (apiError.code == APIErrorCodeCancelled) {
+            [circuitBreaker recordIgnored];
+        } else if (apiError.isNetworkError || apiError.isServerError) {
+            [circuitBreaker recordFailureWithLatency:latency];
+        } else {
+            [circuitBreaker recordSuccessWithLatency:latency];
         }
+        
+        // 401：刷新Token（多个请求同时401时只刷新一次）后重放一次，刷新失败则统一失败
+        if (apiError.code == APIErrorCodeUnauthorized &&
+            authInterceptor.canRefreshToken &&
+            !isTokenRefreshRequest &&
+            !(flags & APIRequestInternalFlagNoAuthReplay)) {
+            void (^replay)(void) = ^{
+                NSURLSessionDataTask *replayTask = [weakSelf requestWithMethod:method
+                                                                     URLString:URLString
+                                                                    parameters:parameters
+                                                                       headers:headers
+                                                                         flags:flags | APIRequestInternalFlagNoCoalescing | APIRequestInternalFlagNoAuthReplay
+                                                                       context:context
+                                                               responseSuccess:success
+                                                                       failure:failure];
+                inflightRequest.task = replayTask;
+            };
             
-        case HTTPMethodPUT: {
-            task = [self.sessionManager PUT:fullURL
-                                 parameters:parameters
-                                    headers:nil
-                                    success:^(NSURLSessionDataTask * _Nonnull task, id  _Nullable responseObject) {
-                [weakSelf.tasks removeObject:task];
-                wrappedSuccess(responseObject);
-            } failure:^(NSURLSessionDataTask * _Nullable task, NSError * _Nonnull error) {
-                [weakSelf.tasks removeObject:task];
-                wrappedFailure(error);
-            }];
-            break;
-        }
+            // 请求发出后Token已经刷新过（用旧Token发出的请求晚于刷新完成才返回401）：直接用新Token重放，不再刷新
+            if (!authInterceptor.isRefreshing && ![authInterceptor requestUsesCurrentToken:interceptedRequest]) {
+                NSLog(@"🔑 请求返回401，Token已在请求发出后刷新，直接重放: %@", fullURL);
+                replay();
+                return;
+            }
             
-        case HTTPMethodDELETE: {
-            task = [self.sessionManager DELETE:fullURL
-                                    parameters:parameters
-                                       headers:nil
-                                       success:^(NSURLSessionDataTask * _Nonnull task, id  _Nullable responseObject) {
-                [weakSelf.tasks removeObject:task];
-                wrappedSuccess(responseObject);
-            } failure:^(NSURLSessionDataTask * _Nullable task, NSError * _Nonnull error) {
-                [weakSelf.tasks removeObject:task];
-                wrappedFailure(error);
+            NSLog(@"🔑 请求返回401，等待Token刷新后重放: %@", fullURL);
+            [authInterceptor refreshTokenWithCompletion:^(BOOL refreshed, NSError * _Nullable refreshError) {
+                if (refreshed) {
+                    replay();
+                    return;
+                }
+                
+                // 刷新失败：会话过期由AuthManager统一通知一次，这里不再逐个触发errorHandler
+                // 刷新请求本身网络失败时返回该错误（Token可能仍然有效），否则返回原来的401
+                if (failure) {
+                    failure([weakSelf errorForFailedTokenRefresh:refreshError URLString:fullURL] ?: apiError);
+                }
             }];
-            break;
+            return;
         }
+        
+        // 重试等待时间由重试策略计算（错误拦截器可以修改）
+        id<APIRetryPolicy> retryPolicy = weakSelf.retryPolicy;
+        apiError.maxRetryCount = weakSelf.maxRetryCount;
+        apiError.retryCount = context.retryCount;
+        apiError.retryInterval = [retryPolicy delayForRetryCount:context.retryCount + 1
+                                                   previousDelay:context.previousDelay];
+        
+        // 执行错误拦截器（可以异步完成），之后决定是否重试
+        [context.interceptorChain processError:apiError context:interceptorContext completion:^(NSError *finalError) {
+            [weakSelf recordInterceptorDurationOfContext:interceptorContext URL:interceptedRequest.URL];
+            if (!finalError) {
+                // 错误已被处理，不继续传播
+                return;
+            }
             
-        case HTTPMethodPATCH: {
-            task = [self.sessionManager PATCH:fullURL
-                                   parameters:parameters
-                                      headers:nil
-                                      success:^(NSURLSessionDataTask * _Nonnull task, id  _Nullable responseObject) {
-                [weakSelf.tasks removeObject:task];
-                wrappedSuccess(responseObject);
-            } failure:^(NSURLSessionDataTask * _Nullable task, NSError * _Nonnull error) {
-                [weakSelf.tasks removeObject:task];
-                wrappedFailure(error);
-            }];
-            break;
-        }
-    }
-    
-    if (task) {
-        [self.tasks addObject:task];
+            // 检查是否需要重试
+            APIError *finalAPIError = (APIError *)finalError;
+            BOOL shouldRetry = [retryPolicy respondsToSelector:@selector(shouldRetryError:)]
+                ? [retryPolicy shouldRetryError:finalAPIError]
+                : finalAPIError.canRetry;
+            if (shouldRetry &&
+                weakSelf.maxRetryCount > 0 &&
+                context.retryCount < weakSelf.maxRetryCount) {
+                NSTimeInterval delay = finalAPIError.retryInterval;
+                NSTimeInterval timeLeft = context.deadline - CFAbsoluteTimeGetCurrent();
+                
+                if (delay >= timeLeft) {
+                    // 等待后已没有剩余时间，直接失败
+                    NSLog(@"⚠️ 剩余时间 %.1f 秒不足以重试，停止重试", timeLeft);
+                } else if (![weakSelf.retryBudget tryAcquire]) {
+                    // 重试预算耗尽（大量请求同时失败），直接失败，避免重试风暴
+                    NSLog(@"⚠️ 重试预算已耗尽，停止重试");
+                } else {
+                    // 增加重试次数
+                    context.retryCount = context.retryCount + 1;
+                    context.previousDelay = delay;
+                    finalAPIError.retryCount = context.retryCount;
+                    
+                    NSLog(@"🔄 准备第 %ld 次重试（最大 %ld 次），间隔 %.2f 秒",
+                          (long)context.retryCount,
+                          (long)weakSelf.maxRetryCount,
+                          delay);
+                    
+                    // 延迟重试（定时器在重试队列上，不占用主线程）
+                    APITaskRegistry *taskRegistry = weakSelf.taskRegistry;
+                    [taskRegistry beginWaitingRetry];
+                    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), weakSelf.retryQueue, ^{
+                        [taskRegistry endWaitingRetry];
+                        
+                        // 重新发起请求（不再参与合并，合并的调用方继续等待本次重试的结果）
+                        NSURLSessionDataTask *retryTask = [weakSelf requestWithMethod:method
+                                                                            URLString:URLString
+                                                                           parameters:parameters
+                                                                              headers:headers
+                                                                                flags:flags | APIRequestInternalFlagNoCoalescing
+                                                                              context:context
+                                                                      responseSuccess:success
+                                                                              failure:failure];
+                        inflightRequest.task = retryTask;
+                    });
+                    return; // 重试中，不调用失败回调
+                }
+            }
+            
+            // 统一错误处理回调（在主线程）
+            void (^errorHandler)(APIError *) = weakSelf.errorHandler;
+            if (errorHandler) {
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    errorHandler(finalAPIError);
+                });
+            }
+            
+            if (failure) {
+                failure(finalError);
+            }
+        }];
+    };
+    
+    // 对冲请求：路径开启对冲且有足够的延迟样本时，主请求开始执行后超过该路径最近延迟的分位数仍未返回，就在新连接上再发一次
+    APIHedgeState *hedgeState = nil;
+    NSTimeInterval hedgeDelay = 0;
+    if (method == HTTPMethodGET && pathConfig.hedgingEnabled) {
+        [self.hedgeBudget recordRequest];
+        hedgeDelay = [self.latencyTracker latencyAtPercentile:self.hedgingPercentile forKey:pathConfig.name];
+        if (hedgeDelay > 0 && hedgeDelay < remainingTime) {
+            hedgeState = [[APIHedgeState alloc] init];
+        }
+    }
+    
+    // 请求优先级：未指定时GET为可见内容，其他方法（提交、修改）为用户交互
+    APIRequestPriority priority = context.options.hasPriority ? context.options.priority
+        : (method == HTTPMethodGET ? APIRequestPriorityVisibleContent : APIRequestPriorityInteractive);
+    
+    // 使用构建好的请求创建task（暂不resume，由调度器按优先级和主机并发名额启动）
+    // 调度任务先赋值给job再排队：task很快结束（缓存响应、快速失败、取消）时完成回调中的finish也能释放主机名额
+    __block APIScheduledJob *job = nil;
+    __block NSURLSessionDataTask *task = nil;
+    task = [self.sessionManager dataTaskWithRequest:interceptedRequest
+                                     uploadProgress:nil
+                                   downloadProgress:nil
+                                  completionHandler:^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
+        [job finish];
+        [weakSelf untrackTask:task];
+        if (hedgeState && ![hedgeState completeAttemptForTask:task error:error]) {
+            return;
+        }
+        if (error) {
+            wrappedFailure(error);
+        } else {
+            wrappedSuccess(responseObject, (NSHTTPURLResponse *)response);
+        }
+    }];
+    
+    [self trackTask:task tags:[self tagsForOptions:context.options pathConfig:pathConfig]];
+    [context.cancellationToken addTask:task];
+    inflightRequest.task = task;
+    
+    // 对冲延迟从调度器真正开始主请求时计算：还在排队的请求不对冲，避免名额已满时再加倍负载
+    APIScheduledJobStartHandler startHandler = nil;
+    if (hedgeState && [hedgeState addTask:task]) {
+        NSSet<NSString *> *tags = [self tagsForOptions:context.options pathConfig:pathConfig];
+        startHandler = ^(APIScheduledJob *startedJob) {
+            NSTimeInterval timeLeft = context.deadline - CFAbsoluteTimeGetCurrent();
+            if (hedgeDelay >= timeLeft) {
+                return;
+            }
+            NSMutableURLRequest *hedgeRequest = [interceptedRequest mutableCopy];
+            hedgeRequest.timeoutInterval = MIN(weakSelf.effectiveTimeoutInterval, timeLeft - hedgeDelay);
+            [weakSelf scheduleHedgeRequest:hedgeRequest
+                                     delay:hedgeDelay
+                                  priority:priority
+                                primaryJob:startedJob
+                                hedgeState:hedgeState
+                                      tags:tags
+                         cancellationToken:context.cancellationToken
+                                   success:wrappedSuccess
+                                   failure:wrappedFailure];
+        };
     }
     
+    job = [[APIRequestScheduler sharedScheduler] jobWithTask:task priority:priority startHandler:startHandler];
+    [job start];
     return task;
 }
 
+/// 构建请求 - 请求头和超时只设置在这一个请求上，不修改共享的请求序列化器，可以在任意线程并发调用
+/// 公共请求头和自定义请求头先设置到请求上，序列化器再编码参数并补充未设置的默认请求头（编解码器的Content-Type/Accept、压缩的Content-Encoding按请求设置）
+/// @param completion 完成回调，传入经过请求拦截器的请求；序列化失败时请求为nil并传入error，被拦截器取消时都为nil
+/// @return 返回前completion是否已执行完成
+- (BOOL)buildRequestWithHTTPMethod:(NSString *)methodString
+                         URLString:(NSString *)URLString
+                        parameters:(nullable id)parameters
+                           headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                   timeoutInterval:(NSTimeInterval)timeoutInterval
+                  interceptorChain:(APIInterceptorChain *)interceptorChain
+                interceptorContext:(APIInterceptorContext *)interceptorContext
+                        completion:(void(^)(NSURLRequest * _Nullable request, NSError * _Nullable error))completion {
+    NSURL *URL = [NSURL URLWithString:URLString];
+    if (!URL) {
+        completion(nil, [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorBadURL userInfo:nil]);
+        return YES;
+    }
+    
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:URL];
+    request.HTTPMethod = methodString;
+    request.timeoutInterval = timeoutInterval;
+    [self setHeaders:headers toRequest:request];
+    
+    NSError *serializationError = nil;
+    NSURLRequest *serializedRequest = [self.sessionManager.requestSerializer requestBySerializingRequest:request
+                                                                                          withParameters:parameters
+                                                                                                   error:&serializationError];
+    if (!serializedRequest) {
+        completion(nil, serializationError);
+        return YES;
+    }
+    return [interceptorChain processRequest:serializedRequest context:interceptorContext completion:^(NSURLRequest *interceptedRequest) {
+        completion(interceptedRequest, nil);
+    }];
+}
+
+- (nullable NSURLRequest *)interceptedRequestForRequest:(NSMutableURLRequest *)request
+                                                headers:(nullable NSDictionary<NSString *, NSString *> *)headers {
+    [self setHeaders:headers toRequest:request];
+    APIInterceptorContext *context = [[APIInterceptorContext alloc] initWithHTTPMethod:request.HTTPMethod
+                                                                             URLString:request.URL.absoluteString ?: @""
+                                                                               options:nil
+                                                                            retryCount:0
+                                                                              userInfo:nil];
+    return [self interceptedRequest:request context:context];
+}
+
+- (void)refreshAuthorizationForRequest:(NSURLRequest *)request completion:(APITokenRefreshCompletionBlock)completion {
+    APIAuthenticationInterceptor *authInterceptor = [self authenticationInterceptor];
+    if (!authInterceptor.canRefreshToken) {
+        completion(NO, nil);
+        return;
+    }
+    
+    // 请求发出后Token已经刷新过：直接用新Token重放
+    if (!authInterceptor.isRefreshing && ![authInterceptor requestUsesCurrentToken:request]) {
+        completion(YES, nil);
+        return;
+    }
+    
+    NSString *URLString = request.URL.absoluteString ?: @"";
+    __weak typeof(self) weakSelf = self;
+    [authInterceptor refreshTokenWithCompletion:^(BOOL refreshed, NSError * _Nullable refreshError) {
+        completion(refreshed, refreshed ? nil : [weakSelf errorForFailedTokenRefresh:refreshError URLString:URLString]);
+    }];
+}
+
+/// 设置公共请求头和自定义请求头（自定义请求头优先）
+- (void)setHeaders:(nullable NSDictionary<NSString *, NSString *> *)headers toRequest:(NSMutableURLRequest *)request {
+    NSMutableDictionary<NSString *, NSString *> *allHeaders = [NSMutableDictionary dictionaryWithDictionary:self.commonHeaders];
+    if (headers) {
+        [allHeaders addEntriesFromDictionary:headers];
+    }
+    for (NSString *key in allHeaders.allKeys) {
+        [request setValue:allHeaders[key] forHTTPHeaderField:key];
+    }
+}
+
+/// 同步执行请求拦截器（文件上传、流式请求等不支持异步拦截器的请求使用），返回nil表示请求被取消
+- (nullable NSURLRequest *)interceptedRequest:(NSURLRequest *)request context:(APIInterceptorContext *)context {
+    __block NSURLRequest *interceptedRequest = nil;
+    APIInterceptorChain *chain = [[APIInterceptorChain alloc] initWithInterceptors:self.interceptors];
+    BOOL completed = [chain processRequest:request context:context completion:^(NSURLRequest *result) {
+        interceptedRequest = result;
+    }];
+    if (!completed) {
+        NSLog(@"⚠️ 拦截器未同步完成，该请求不支持异步拦截器，已取消: %@", request.URL.absoluteString);
+        return nil;
+    }
+    return interceptedRequest;
+}
+
+/// 生成请求唯一标识
+/// GET参数已由序列化器按key排序拼入URL，因此内容相同的参数字典会得到相同的标识
+- (NSString *)requestKeyForMethod:(HTTPMethod)method request:(NSURLRequest *)request parameters:(nullable id)parameters {
+    NSMutableString *requestKey = [NSMutableString stringWithFormat:@"%@ %@", [self HTTPMethodString:method], request.URL.absoluteString];
+    
+    // 非GET请求的参数在请求体中
+    if (method != HTTPMethodGET && parameters) {
+        if ([parameters isKindOfClass:[NSDictionary class]]) {
+            [requestKey appendFormat:@" %@", AFQueryStringFromParameters(parameters)];
+        } else {
+            [requestKey appendFormat:@" %@", [parameters description]];
+        }
+    }
+    
+    // 认证相关请求头不同（如不同用户的Token）视为不同请求；条件请求头不同时响应也不同
+    NSArray<NSString *> *headerFields = [self.coalescingHeaderFields arrayByAddingObjectsFromArray:@[@"If-None-Match", @"If-Modified-Since"]];
+    for (NSString *field in headerFields) {
+        NSString *value = [request valueForHTTPHeaderField:field];
+        if (value.length > 0) {
+            [requestKey appendFormat:@" %@=%@", field.lowercaseString, value];
+        }
+    }
+    
+    return requestKey;
+}
+
+/// 延迟发起对冲请求（主请求已返回、被抢占挂起或对冲预算耗尽时不发起）
+/// 对冲请求和主请求一样登记到请求登记表（另加 APITaskTagHedge 标签）并绑定取消作用域，按标签、作用域或全部取消时一并取消
+/// @param primaryJob 主请求的调度任务（在其开始执行时调用）
+- (void)scheduleHedgeRequest:(NSURLRequest *)request
+                       delay:(NSTimeInterval)delay
+                    priority:(APIRequestPriority)priority
+                  primaryJob:(APIScheduledJob *)primaryJob
+                  hedgeState:(APIHedgeState *)hedgeState
+                        tags:(nullable NSSet<NSString *> *)tags
+           cancellationToken:(nullable APICancellationToken *)cancellationToken
+                     success:(APIResponseSuccessBlock)success
+                     failure:(APIFailureBlock)failure {
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.retryQueue, ^{
+        if (hedgeState.isFinished) {
+            return;
+        }
+        
+        // 主请求被高优先级请求抢占挂起：主机名额已满，不再加倍负载
+        if (primaryJob.state != APIScheduledJobStateRunning) {
+            return;
+        }
+        
+        // 对冲预算：对冲请求不超过正常请求的一定比例，避免明显增加服务器负载
+        if (![weakSelf.hedgeBudget tryAcquire]) {
+            NSLog(@"⚠️ 对冲预算已耗尽，不发起对冲请求: %@", request.URL.absoluteString);
+            return;
+        }
+        
+        NSLog(@"🏁 请求超过 %.0fms 未返回，发起对冲请求: %@", delay * 1000, request.URL.absoluteString);
+        __block NSURLSessionDataTask *hedgeTask = nil;
+        __block APIScheduledJob *hedgeJob = nil;
+        hedgeTask = [weakSelf.hedgeSessionManager dataTaskWithRequest:request
+                                                       uploadProgress:nil
+                                                     downloadProgress:nil
+                                                    completionHandler:^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
+            [hedgeJob finish];
+            [weakSelf untrackTask:hedgeTask];
+            if (![hedgeState completeAttemptForTask:hedgeTask error:error]) {
+                return;
+            }
+            if (error) {
+                failure(error);
+            } else {
+                success(responseObject, (NSHTTPURLResponse *)response);
+            }
+        }];
+        
+        if ([hedgeState addTask:hedgeTask]) {
+            [weakSelf trackTask:hedgeTask tags:[(tags ?: [NSSet set]) setByAddingObject:APITaskTagHedge]];
+            [cancellationToken addTask:hedgeTask];
+            hedgeJob = [[APIRequestScheduler sharedScheduler] jobWithTask:hedgeTask priority:priority startHandler:nil];
+            [hedgeJob start];
+        } else {
+            [hedgeTask cancel];
+        }
+    });
+}
+
+/// 查找认证拦截器（用于Token刷新和请求挂起）
+- (nullable APIAuthenticationInterceptor *)authenticationInterceptor {
+    for (id<APIRequestInterceptor> interceptor in self.interceptors) {
+        if ([interceptor isKindOfClass:[APIAuthenticationInterceptor class]]) {
+            return (APIAuthenticationInterceptor *)interceptor;
+        }
+    }
+    return nil;
+}
+
+/// 挂起请求：等待Token刷新完成，成功后使用新Token重放
+/// 刷新请求网络失败时以该错误失败，服务器拒绝刷新时以401（登录已过期）失败
+- (void)parkRequestWithMethod:(HTTPMethod)method
+                    URLString:(NSString *)URLString
+                   parameters:(nullable id)parameters
+                      headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                        flags:(APIRequestInternalFlags)flags
+                      context:(nullable APIRequestContext *)context
+              responseSuccess:(nullable APIResponseSuccessBlock)success
+                      failure:(nullable APIFailureBlock)failure {
+    __weak typeof(self) weakSelf = self;
+    [[self authenticationInterceptor] refreshTokenWithCompletion:^(BOOL refreshed, NSError * _Nullable refreshError) {
+        if (refreshed) {
+            [weakSelf requestWithMethod:method
+                              URLString:URLString
+                             parameters:parameters
+                                headers:headers
+                                  flags:flags
+                                context:context
+                        responseSuccess:success
+                                failure:failure];
+            return;
+        }
+        
+        if (failure) {
+            APIError *error = [weakSelf errorForFailedTokenRefresh:refreshError URLString:URLString];
+            if (!error) {
+                error = [APIError errorWithCode:APIErrorCodeUnauthorized
+                                        message:@"登录已过期，请重新登录"
+                                underlyingError:refreshError];
+                error.requestPath = URLString;
+            }
+            failure(error);
+        }
+    }];
+}
+
+/// Token刷新失败时交给等待中请求的错误
+/// 刷新请求网络失败、超时、熔断或服务端5xx时返回对应错误（会话不一定过期，稍后可以重试）；服务器拒绝刷新时返回nil
+- (nullable APIError *)errorForFailedTokenRefresh:(nullable NSError *)refreshError URLString:(NSString *)URLString {
+    if (!refreshError) {
+        return nil;
+    }
+    
+    APIError *refreshAPIError = [refreshError isKindOfClass:[APIError class]] ? (APIError *)refreshError : [APIError errorFromNSError:refreshError];
+    if (!refreshAPIError.isNetworkError && !refreshAPIError.isServerError && refreshAPIError.code != APIErrorCodeCircuitOpen) {
+        return nil;
+    }
+    
+    // 每个请求一个新的错误对象，requestPath不互相覆盖
+    APIError *error = [APIError errorWithCode:refreshAPIError.code
+                                      message:refreshAPIError.localizedDescription
+                              underlyingError:refreshError];
+    error.businessCode = refreshAPIError.businessCode;
+    error.requestPath = URLString;
+    return error;
+}
+
+/// 结束进行中的GET请求，返回需要分发回调的请求记录
+- (nullable APIInflightRequest *)finishInflightRequestForKey:(NSString *)requestKey {
+    @synchronized (self.inflightRequests) {
+        APIInflightRequest *inflightRequest = self.inflightRequests[requestKey];
+        [self.inflightRequests removeObjectForKey:requestKey];
+        return inflightRequest;
+    }
+}
+
 - (NSURLSessionDataTask *)GET:(NSString *)URLString
                     parameters:(nullable id)parameters
                        headers:(nullable NSDictionary<NSString *, NSString *> *)headers
@@ -389,103 +1206,194 @@
                               success:(nullable APISuccessBlock)success
                               failure:(nullable APIFailureBlock)failure {
     
-    NSString *fullURL = URLString;
-    if (self.baseURL.length > 0 && ![URLString hasPrefix:@"http"]) {
-        fullURL = [self.baseURL stringByAppendingPathComponent:URLString];
-    }
-    
-    // 合并请求头
-    NSMutableDictionary *allHeaders = [NSMutableDictionary dictionaryWithDictionary:self.commonHeaders];
-    if (headers) {
-        [allHeaders addEntriesFromDictionary:headers];
-    }
+    // 相对路径拼接当前环境路由表中的Base URL
+    NSString *fullURL = [[APIEnvironmentManager sharedManager].routeTable absoluteURLStringForURLString:URLString];
     
-    for (NSString *key in allHeaders.allKeys) {
-        [self.sessionManager.requestSerializer setValue:allHeaders[key] forHTTPHeaderField:key];
-    }
-    
-    NSURLSessionDataTask *task = [self.sessionManager POST:fullURL
-                                                 parameters:parameters
-                                                    headers:nil
-                                  constructingBodyWithBlock:^(id<AFMultipartFormData>  _Nonnull formData) {
+    NSError *serializationError = nil;
+    NSMutableURLRequest *request = [self.sessionManager.requestSerializer multipartFormRequestWithMethod:@"POST"
+                                                                                               URLString:fullURL
+                                                                                              parameters:parameters
+                                                                               constructingBodyWithBlock:^(id<AFMultipartFormData>  _Nonnull formData) {
         [formData appendPartWithFileData:fileData
                                     name:name
                                 fileName:fileName
                                 mimeType:mimeType];
-    } progress:^(NSProgress * _Nonnull uploadProgress) {
-        if (progress) {
-            progress(uploadProgress);
-        }
-    } success:^(NSURLSessionDataTask * _Nonnull task, id  _Nullable responseObject) {
-        [self.tasks removeObject:task];
-        if (success) {
-            success(responseObject);
+    } error:&serializationError];
+    if (!request) {
+        if (failure) {
+            failure(serializationError);
         }
-    } failure:^(NSURLSessionDataTask * _Nullable task, NSError * _Nonnull error) {
-        [self.tasks removeObject:task];
+        return nil;
+    }
+    
+    // 请求头和超时只设置在这个请求上；Content-Type/Content-Length由表单决定（包含boundary），不使用公共请求头中的值
+    NSString *contentType = [request valueForHTTPHeaderField:@"Content-Type"];
+    NSString *contentLength = [request valueForHTTPHeaderField:@"Content-Length"];
+    [self setHeaders:headers toRequest:request];
+    [request setValue:contentType forHTTPHeaderField:@"Content-Type"];
+    [request setValue:contentLength forHTTPHeaderField:@"Content-Length"];
+    request.timeoutInterval = self.effectiveTimeoutInterval;
+    
+    // 文件数据已在内存中，可压缩的类型（如JSON、文本、日志）按阈值压缩整个表单；图片、音视频等已压缩的格式保持流式上传
+    // 压缩在调用线程同步进行，超过上限的文件同样保持流式上传
+    if (self.requestBodyEncoding != APIContentEncodingNone &&
+        fileData.length <= self.uploadCompressionMaxLength &&
+        [APIBodyCompressor isCompressibleMIMEType:mimeType]) {
+        [APIBodyCompressor compressStreamedBodyOfRequest:request
+                                                encoding:self.requestBodyEncoding
+                                               threshold:self.requestBodyCompressionThreshold];
+    }
+    
+    // 执行请求拦截器（如认证拦截器添加Authorization）
+    APIInterceptorContext *interceptorContext = [[APIInterceptorContext alloc] initWithHTTPMethod:@"POST"
+                                                                                        URLString:fullURL
+                                                                                          options:nil
+                                                                                       retryCount:0
+                                                                                         userInfo:nil];
+    request = [[self interceptedRequest:request context:interceptorContext] mutableCopy];
+    if (!request) {
         if (failure) {
+            APIError *error = [APIError errorWithCode:APIErrorCodeCancelled
+                                               message:@"请求被拦截器取消"
+                                       underlyingError:nil];
+            error.requestPath = fullURL;
             failure(error);
         }
-    }];
+        return nil;
+    }
     
-    if (task) {
-        [self.tasks addObject:task];
+    // 上传由调度器按可见内容优先级启动（不占用预加载/后台名额）
+    __block APIScheduledJob *job = nil;
+    __block NSURLSessionDataTask *task = nil;
+    void (^uploadProgressBlock)(NSProgress *) = ^(NSProgress * _Nonnull uploadProgress) {
+        if (progress) {
+            progress(uploadProgress);
+        }
+    };
+    void (^completionHandler)(NSURLResponse *, id, NSError *) = ^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
+        [job finish];
+        [self untrackTask:task];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (error) {
+                if (failure) {
+                    failure(error);
+                }
+            } else {
+                if (success) {
+                    success(responseObject);
+                }
+            }
+        });
+    };
+    
+    if (request.HTTPBodyStream) {
+        task = [self.sessionManager uploadTaskWithStreamedRequest:request
+                                                         progress:uploadProgressBlock
+                                                completionHandler:completionHandler];
+    } else {
+        NSData *bodyData = request.HTTPBody;
+        request.HTTPBody = nil;
+        task = [self.sessionManager uploadTaskWithRequest:request
+                                                 fromData:bodyData
+                                                 progress:uploadProgressBlock
+                                        completionHandler:completionHandler];
     }
     
+    [self trackTask:task tags:[NSSet setWithObject:APITaskTagUpload]];
+    job = [[APIRequestScheduler sharedScheduler] jobWithTask:task priority:APIRequestPriorityVisibleContent startHandler:nil];
+    [job start];
+    
     return task;
 }
 
-- (NSURLSessionDownloadTask *)downloadFile:(NSString *)URLString
+- (nullable APIDownloadTask *)downloadFile:(NSString *)URLString
                                  parameters:(nullable id)parameters
                                     headers:(nullable NSDictionary<NSString *, NSString *> *)headers
                             destinationPath:(NSString *)destinationPath
                                    progress:(nullable APIProgressBlock)progress
                                     success:(nullable void(^)(NSURL *filePath))success
                                     failure:(nullable APIFailureBlock)failure {
+    // 相对路径拼接当前环境的Base URL，参数由序列化器拼接到URL
+    NSString *fullURL = [[APIEnvironmentManager sharedManager].routeTable absoluteURLStringForURLString:URLString];
+    if (parameters) {
+        NSURLRequest *request = [self.sessionManager.requestSerializer requestWithMethod:@"GET"
+                                                                                 URLString:fullURL
+                                                                                parameters:parameters
+                                                                                     error:nil];
+        fullURL = request.URL.absoluteString ?: fullURL;
+    }
     
-    NSString *fullURL = URLString;
-    if (self.baseURL.length > 0 && ![URLString hasPrefix:@"http"]) {
-        fullURL = [self.baseURL stringByAppendingPathComponent:URLString];
+    return [[APIDownloadManager sharedManager] downloadURLString:fullURL
+                                                 destinationPath:destinationPath
+                                                  expectedSHA256:nil
+                                                         headers:headers
+                                                        progress:progress
+                                                         success:success
+                                                         failure:failure];
+}
+
+- (void)preconnectToURLString:(NSString *)URLString {
+    NSURL *url = [NSURL URLWithString:URLString];
+    if (url.host.length == 0) {
+        return;
     }
     
-    NSURLRequest *request = [self.sessionManager.requestSerializer requestWithMethod:@"GET"
-                                                                             URLString:fullURL
-                                                                            parameters:parameters
-                                                                                 error:nil];
+    // HEAD请求只用于建立连接（DNS解析、TCP和TLS握手），不关心响应内容
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
+    request.HTTPMethod = @"HEAD";
+    request.timeoutInterval = self.effectiveTimeoutInterval;
     
-    NSURLSessionDownloadTask *task = [self.sessionManager downloadTaskWithRequest:request
-                                                                          progress:^(NSProgress * _Nonnull downloadProgress) {
-        if (progress) {
-            progress(downloadProgress);
-        }
-    } destination:^NSURL * _Nonnull(NSURL * _Nonnull targetPath, NSURLResponse * _Nonnull response) {
-        return [NSURL fileURLWithPath:destinationPath];
-    } completionHandler:^(NSURLResponse * _Nonnull response, NSURL * _Nullable filePath, NSError * _Nullable error) {
-        if (error) {
-            if (failure) {
-                failure(error);
-            }
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    __block APIScheduledJob *job = nil;
+    NSURLSessionDataTask *task = [self.sessionManager dataTaskWithRequest:request
+                                                           uploadProgress:nil
+                                                         downloadProgress:nil
+                                                        completionHandler:^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
+        [job finish];
+        // 收到任何HTTP响应（包括4xx）都说明连接已建立
+        if (response) {
+            NSLog(@"🔌 预连接完成: %@（%.0fms）", url.host, (CFAbsoluteTimeGetCurrent() - startTime) * 1000);
         } else {
-            if (success) {
-                success(filePath);
-            }
+            NSLog(@"⚠️ 预连接失败: %@, %@", url.host, error.localizedDescription);
         }
     }];
-    
-    [task resume];
-    return task;
+    job = [[APIRequestScheduler sharedScheduler] jobWithTask:task priority:APIRequestPriorityPrefetch startHandler:nil];
+    [job start];
 }
 
 - (void)cancelAllRequests {
-    for (NSURLSessionTask *task in self.tasks) {
-        [task cancel];
-    }
-    [self.tasks removeAllObjects];
+    [self.taskRegistry cancelAllTasks];
+    [[APIDownloadManager sharedManager] cancelAllDownloads];
+}
+
+- (NSUInteger)cancelRequestsWithTag:(NSString *)tag {
+    return [self.taskRegistry cancelTasksWithTag:tag];
+}
+
+- (void)cancelRequestsForOwner:(id)owner {
+    [[APICancellationScope scopeForOwner:owner] cancel];
 }
 
 - (void)cancelTask:(NSURLSessionTask *)task {
     [task cancel];
-    [self.tasks removeObject:task];
+    [self untrackTask:task];
+}
+
+/// 登记进行中的task（回调在响应处理队列，由登记表保证线程安全）
+- (void)trackTask:(NSURLSessionTask *)task tags:(nullable NSSet<NSString *> *)tags {
+    [self.taskRegistry registerTask:task tags:tags];
+}
+
+- (void)untrackTask:(nullable NSURLSessionTask *)task {
+    [self.taskRegistry unregisterTask:task];
+}
+
+/// 请求的标签：请求选项中的标签加上路径名称（用于按模块取消和统计）
+- (nullable NSSet<NSString *> *)tagsForOptions:(nullable APIRequestOptions *)options pathConfig:(nullable APIPathConfig *)pathConfig {
+    if (!pathConfig.name) {
+        return options.tags;
+    }
+    return options.tags ? [options.tags setByAddingObject:pathConfig.name] : [NSSet setWithObject:pathConfig.name];
 }
 
 - (NSString *)HTTPMethodString:(HTTPMethod)method {
@@ -503,102 +1411,932 @@
     }
 }
 
-#pragma mark - Path Name Methods
+#pragma mark - Response Decoding
 
-- (NSURLSessionDataTask *)GETWithPathName:(NSString *)pathName
-                                   subPath:(nullable NSString *)subPath
-                                parameters:(nullable id)parameters
-                                   headers:(nullable NSDictionary<NSString *, NSString *> *)headers
-                                   success:(nullable APISuccessBlock)success
-                                   failure:(nullable APIFailureBlock)failure {
-    APIEnvironmentManager *envManager = [APIEnvironmentManager sharedManager];
-    NSString *basePath = [envManager pathForPathName:pathName];
+/// 在响应处理队列上完成模型映射，再回到主线程回调
+/// 没有指定模型类时直接回调响应对象；映射失败时回调 APIErrorCodeDecodingFailed；取消作用域已取消时跳过
+/// 模型映射和回调的耗时按URL的路径名称记录到 APIMetricsStore
+- (void)deliverResponseObject:(nullable id)responseObject
+                      options:(nullable APIRequestOptions *)options
+                          URL:(nullable NSURL *)URL
+            cancellationToken:(nullable APICancellationToken *)token
+                      success:(nullable APISuccessBlock)success
+                      failure:(nullable APIFailureBlock)failure {
+    if (token.isCancelled) {
+        return;
+    }
     
-    if (!basePath || basePath.length == 0) {
-        if (failure) {
-            NSError *error = [NSError errorWithDomain:@"APIManagerErrorDomain"
-                                                  code:-1
-                                              userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"未找到路径名称: %@", pathName]}];
-            failure(error);
+    // 从主线程调用（如缓存命中）时先切到响应处理队列，避免在主线程映射大列表
+    if ([NSThread isMainThread] && options.responseModelClass) {
+        dispatch_async(self.decodeQueue, ^{
+            [self deliverResponseObject:responseObject options:options URL:URL cancellationToken:token success:success failure:failure];
+        });
+        return;
+    }
+    
+    APIMetricsStore *metricsStore = [APIMetricsStore sharedStore];
+    id result = responseObject;
+    NSError *error = nil;
+    if (options.responseModelClass) {
+        CFAbsoluteTime mappingStartTime = CFAbsoluteTimeGetCurrent();
+        result = [self modelFromResponseObject:responseObject options:options error:&error];
+        [metricsStore recordDuration:CFAbsoluteTimeGetCurrent() - mappingStartTime phase:APIMetricsPhaseMapping forURL:URL];
+    }
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        CFAbsoluteTime callbackStartTime = CFAbsoluteTimeGetCurrent();
+        if (error) {
+            if (failure) {
+                failure(error);
+            }
+        } else if (success) {
+            success(result);
         }
-        return nil;
+        [metricsStore recordDuration:CFAbsoluteTimeGetCurrent() - callbackStartTime phase:APIMetricsPhaseCallback forURL:URL];
+    });
+}
+
+/// 记录一次尝试中所有拦截器阶段的耗时合计
+- (void)recordInterceptorDurationOfContext:(APIInterceptorContext *)interceptorContext URL:(NSURL *)URL {
+    NSTimeInterval duration = 0;
+    for (APIInterceptorTiming *timing in interceptorContext.timings) {
+        duration += timing.duration;
+    }
+    [[APIMetricsStore sharedStore] recordDuration:duration phase:APIMetricsPhaseInterceptor forURL:URL];
+}
+
+/// 把成功回调绑定到取消令牌：取消后不再执行，回调在取消时立即释放
+- (nullable APISuccessBlock)scopedSuccess:(nullable APISuccessBlock)success token:(nullable APICancellationToken *)token {
+    if (!token || !success) {
+        return success;
     }
     
-    // 拼接完整路径
-    NSString *fullPath = basePath;
-    if (subPath && subPath.length > 0) {
-        // 确保 subPath 以 / 开头
-        if (![subPath hasPrefix:@"/"]) {
-            subPath = [NSString stringWithFormat:@"/%@", subPath];
+    APIScopedBlockHolder *holder = [APIScopedBlockHolder holderWithBlock:success token:token];
+    return ^(id responseObject) {
+        APISuccessBlock block = holder.block;
+        if (block && !token.isCancelled) {
+            block(responseObject);
         }
-        fullPath = [basePath stringByAppendingString:subPath];
+    };
+}
+
+/// 把失败回调绑定到取消令牌：取消后不再执行，回调在取消时立即释放
+- (nullable APIFailureBlock)scopedFailure:(nullable APIFailureBlock)failure token:(nullable APICancellationToken *)token {
+    if (!token || !failure) {
+        return failure;
     }
     
-    // 构建完整URL：Base URL + Path
-    NSString *baseURL = envManager.currentBaseURL;
-    // 确保 baseURL 不以 / 结尾
-    if ([baseURL hasSuffix:@"/"]) {
-        baseURL = [baseURL substringToIndex:baseURL.length - 1];
+    APIScopedBlockHolder *holder = [APIScopedBlockHolder holderWithBlock:failure token:token];
+    return ^(NSError *error) {
+        APIFailureBlock block = holder.block;
+        if (block && !token.isCancelled) {
+            block(error);
+        }
+    };
+}
+
+/// 在主线程回调失败
+- (void)deliverError:(NSError *)error failure:(nullable APIFailureBlock)failure {
+    if (!failure) {
+        return;
+    }
+    if ([NSThread isMainThread]) {
+        failure(error);
+        return;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        failure(error);
+    });
+}
+
+/// 把响应对象映射为模型（字典映射为单个模型，数组映射为模型数组）
+- (nullable id)modelFromResponseObject:(nullable id)responseObject
+                               options:(APIRequestOptions *)options
+                                 error:(NSError **)error {
+    id object = responseObject;
+    if (options.modelKeyPath.length > 0 && [object isKindOfClass:[NSDictionary class]]) {
+        object = [object valueForKeyPath:options.modelKeyPath];
     }
-    // 确保 fullPath 以 / 开头
-    if (![fullPath hasPrefix:@"/"]) {
-        fullPath = [NSString stringWithFormat:@"/%@", fullPath];
+    
+    id model = nil;
+    if ([object isKindOfClass:[NSDictionary class]]) {
+        model = [options.responseModelClass mj_objectWithKeyValues:object];
+    } else if ([object isKindOfClass:[NSArray class]]) {
+        model = [options.responseModelClass mj_objectArrayWithKeyValuesArray:object];
     }
-    NSString *fullURL = [NSString stringWithFormat:@"%@%@", baseURL, fullPath];
     
-    return [self GET:fullURL
-          parameters:parameters
-             headers:headers
-             success:success
-             failure:failure];
+    if (!model && error) {
+        APIError *apiError = [APIError errorWithCode:APIErrorCodeDecodingFailed
+                                              message:@"响应数据解析失败"
+                                      underlyingError:nil];
+        *error = apiError;
+    }
+    return model;
 }
 
-- (NSURLSessionDataTask *)POSTWithPathName:(NSString *)pathName
-                                    subPath:(nullable NSString *)subPath
+#pragma mark - Response Cache
+
+/// 带响应缓存的GET请求
+- (nullable NSURLSessionDataTask *)cachedGET:(NSString *)URLString
+                                   parameters:(nullable id)parameters
+                                      headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                      options:(nullable APIRequestOptions *)options
+                                      success:(nullable APISuccessBlock)success
+                                      failure:(nullable APIFailureBlock)failure {
+    APIRequestContext *context = [[APIRequestContext alloc] init];
+    context.options = options;
+    APICancellationToken *token = [options.cancellationScope issueToken];
+    context.cancellationToken = token;
+    success = [self scopedSuccess:success token:token];
+    failure = [self scopedFailure:failure token:token];
+    
+    APIResponseCache *cache = [APIResponseCache sharedCache];
+    NSString *cacheKey = [cache cacheKeyForURLString:URLString parameters:parameters];
+    
+    // 缓存只在磁盘上时异步读取，读取完成后再决定是否请求网络（此时返回nil，取消请使用取消作用域）
+    __block NSURLSessionDataTask *task = nil;
+    [cache entryForKey:cacheKey completion:^(APICacheEntry * _Nullable entry) {
+        // 读取磁盘期间作用域已取消，不再请求
+        if (token.isCancelled) {
+            return;
+        }
+        
+        // 新鲜缓存：直接返回，不发起请求（解码和模型映射在响应处理队列）
+        if (entry.isFresh) {
+            [cache recordHitForEntry:entry];
+            dispatch_async(self.decodeQueue, ^{
+                [self deliverResponseObject:entry.responseObject options:options URL:[NSURL URLWithString:URLString] cancellationToken:token success:success failure:failure];
+            });
+            return;
+        }
+        
+        // stale-while-revalidate：先返回旧数据，后台重新验证更新缓存（重新验证只更新缓存，不随作用域取消）
+        if (entry.canServeStaleWhileRevalidating) {
+            [cache recordStaleHitForEntry:entry];
+            [cache recordRevalidation];
+            dispatch_async(self.decodeQueue, ^{
+                [self deliverResponseObject:entry.responseObject options:options URL:[NSURL URLWithString:URLString] cancellationToken:token success:success failure:failure];
+            });
+            task = [self fetchAndCacheGET:URLString
+                               parameters:parameters
+                                  headers:headers
+                                 cacheKey:cacheKey
+                                    entry:entry
+                persistsWithoutValidators:NO
+                                  context:nil
+                                  success:nil
+                                  failure:nil];
+            return;
+        }
+        
+        if (entry) {
+            [cache recordRevalidation];
+        } else {
+            [cache recordMiss];
+        }
+        
+        __weak typeof(self) weakSelf = self;
+        task = [self fetchAndCacheGET:URLString
+                           parameters:parameters
+                              headers:headers
+                             cacheKey:cacheKey
+                                entry:entry
+            persistsWithoutValidators:NO
+                              context:context
+                              success:^(id responseObject, BOOL changed) {
+            [weakSelf deliverResponseObject:responseObject options:options URL:[NSURL URLWithString:URLString] cancellationToken:token success:success failure:failure];
+        } failure:^(NSError *error) {
+            [weakSelf deliverError:error failure:failure];
+        }];
+    }];
+    return task;
+}
+
+/// 发起GET请求（有缓存条目时带条件请求头）并更新缓存
+/// @param persistsWithoutValidators 响应没有缓存头时是否仍然保存（用于先缓存后网络的首屏数据，已有条目时总是保存）
+/// @param context 请求上下文（请求选项和取消令牌），nil时使用默认配置
+/// @param success 成功回调（changed表示与缓存条目相比数据是否变化，无缓存时为YES；在响应处理队列调用）
+- (NSURLSessionDataTask *)fetchAndCacheGET:(NSString *)URLString
                                  parameters:(nullable id)parameters
                                     headers:(nullable NSDictionary<NSString *, NSString *> *)headers
-                                    success:(nullable APISuccessBlock)success
+                                   cacheKey:(NSString *)cacheKey
+                                      entry:(nullable APICacheEntry *)entry
+                  persistsWithoutValidators:(BOOL)persistsWithoutValidators
+                                    context:(nullable APIRequestContext *)context
+                                    success:(nullable APIRefreshedResponseBlock)success
                                     failure:(nullable APIFailureBlock)failure {
-    APIEnvironmentManager *envManager = [APIEnvironmentManager sharedManager];
-    NSString *basePath = [envManager pathForPathName:pathName];
+    NSMutableDictionary *requestHeaders = [NSMutableDictionary dictionaryWithDictionary:headers ?: @{}];
+    if (entry) {
+        [requestHeaders addEntriesFromDictionary:entry.conditionalHeaders];
+    }
     
-    if (!basePath || basePath.length == 0) {
+    APIResponseCache *cache = [APIResponseCache sharedCache];
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
+    return [self requestWithMethod:HTTPMethodGET
+                          URLString:URLString
+                         parameters:parameters
+                            headers:requestHeaders
+                              flags:APIRequestInternalFlagNone
+                            context:context
+                    responseSuccess:^(id responseObject, NSHTTPURLResponse *response) {
+        // 304：内容未变化，刷新缓存有效期并返回缓存数据
+        // 内存中的条目可能正在被其他线程读取或归档，在新条目上更新元信息后替换
+        if (response.statusCode == 304 && entry) {
+            APICacheEntry *refreshedEntry = [entry entryByRefreshingWithNotModifiedResponse:response];
+            [cache storeEntry:refreshedEntry forKey:cacheKey];
+            [cache recordNotModifiedForEntry:refreshedEntry];
+            if (success) {
+                success(refreshedEntry.responseObject, NO);
+            }
+            return;
+        }
+        
+        // 已有本地数据时同样持久化（不带新鲜期），避免覆盖先缓存后网络保存的首屏数据
+        APICacheEntry *newEntry = (persistsWithoutValidators || entry)
+            ? [APICacheEntry persistentEntryWithResponse:response responseObject:responseObject]
+            : [APICacheEntry entryWithResponse:response responseObject:responseObject];
+        if (newEntry) {
+            newEntry.fetchDuration = CFAbsoluteTimeGetCurrent() - startTime;
+            [cache storeEntry:newEntry forKey:cacheKey];
+        } else if (entry) {
+            [cache removeEntryForKey:cacheKey];
+        }
+        
+        if (success) {
+            BOOL changed = !entry || ![responseObject isEqual:entry.responseObject];
+            success(responseObject, changed);
+        }
+    } failure:failure];
+}
+
+#pragma mark - Path Name Methods
+
+/// 根据路径名称构建完整URL：Base URL + Path（替换路径参数） + SubPath，使用当前环境预先编译的路由表
+/// @return 未找到路径名称或路径参数不匹配时返回nil，并通过failure回调错误
+- (nullable NSString *)fullURLForPathName:(NSString *)pathName
+                                  subPath:(nullable NSString *)subPath
+                           pathParameters:(nullable NSDictionary<NSString *, id> *)pathParameters
+                                  failure:(nullable APIFailureBlock)failure {
+    NSError *error = nil;
+    NSString *fullURL = [[APIEnvironmentManager sharedManager].routeTable URLStringForPathName:pathName
+                                                                                       subPath:subPath
+                                                                                pathParameters:pathParameters
+                                                                                         error:&error];
+    if (!fullURL) {
+        NSLog(@"⚠️ %@", error.localizedDescription);
         if (failure) {
-            NSError *error = [NSError errorWithDomain:@"APIManagerErrorDomain"
-                                                  code:-1
-                                              userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"未找到路径名称: %@", pathName]}];
             failure(error);
         }
+    }
+    return fullURL;
+}
+
+- (nullable NSURLSessionDataTask *)GETWithPathName:(NSString *)pathName
+                                            subPath:(nullable NSString *)subPath
+                                         parameters:(nullable id)parameters
+                                            headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                            success:(nullable APISuccessBlock)success
+                                            failure:(nullable APIFailureBlock)failure {
+    return [self GETWithPathName:pathName
+                         subPath:subPath
+                      parameters:parameters
+                         headers:headers
+                         options:nil
+                         success:success
+                         failure:failure];
+}
+
+- (nullable NSURLSessionDataTask *)GETWithPathName:(NSString *)pathName
+                                            subPath:(nullable NSString *)subPath
+                                         parameters:(nullable id)parameters
+                                            headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                            options:(nullable APIRequestOptions *)options
+                                            success:(nullable APISuccessBlock)success
+                                            failure:(nullable APIFailureBlock)failure {
+    NSString *fullURL = [self fullURLForPathName:pathName subPath:subPath pathParameters:options.pathParameters failure:failure];
+    if (!fullURL) {
+        return nil;
+    }
+    
+    if (self.responseCacheEnabled) {
+        return [self cachedGET:fullURL
+                    parameters:parameters
+                       headers:headers
+                       options:options
+                       success:success
+                       failure:failure];
+    }
+    
+    return [self requestWithMethod:HTTPMethodGET
+                         URLString:fullURL
+                        parameters:parameters
+                           headers:headers
+                           options:options
+                           success:success
+                           failure:failure];
+}
+
+- (nullable NSURLSessionDataTask *)GETWithPathName:(NSString *)pathName
+                                            subPath:(nullable NSString *)subPath
+                                         parameters:(nullable id)parameters
+                                            headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                             cached:(nullable APICachedResponseBlock)cached
+                                          refreshed:(nullable APIRefreshedResponseBlock)refreshed
+                                            failure:(nullable APIFailureBlock)failure {
+    return [self GETWithPathName:pathName
+                         subPath:subPath
+                      parameters:parameters
+                         headers:headers
+                         options:nil
+                          cached:cached
+                       refreshed:refreshed
+                         failure:failure];
+}
+
+- (nullable NSURLSessionDataTask *)GETWithPathName:(NSString *)pathName
+                                            subPath:(nullable NSString *)subPath
+                                         parameters:(nullable id)parameters
+                                            headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                            options:(nullable APIRequestOptions *)options
+                                             cached:(nullable APICachedResponseBlock)cached
+                                          refreshed:(nullable APIRefreshedResponseBlock)refreshed
+                                            failure:(nullable APIFailureBlock)failure {
+    NSString *fullURL = [self fullURLForPathName:pathName subPath:subPath pathParameters:options.pathParameters failure:failure];
+    if (!fullURL) {
+        return nil;
+    }
+    
+    // 绑定取消作用域：取消后网络数据和失败不再回调
+    APIRequestContext *context = [[APIRequestContext alloc] init];
+    context.options = options;
+    APICancellationToken *token = [options.cancellationScope issueToken];
+    context.cancellationToken = token;
+    failure = [self scopedFailure:failure token:token];
+    if (token && refreshed) {
+        APIScopedBlockHolder *holder = [APIScopedBlockHolder holderWithBlock:refreshed token:token];
+        refreshed = ^(id responseObject, BOOL changed) {
+            APIRefreshedResponseBlock block = holder.block;
+            if (block && !token.isCancelled) {
+                block(responseObject, changed);
+            }
+        };
+    }
+    
+    APIResponseCache *cache = [APIResponseCache sharedCache];
+    NSString *cacheKey = [cache cacheKeyForURLString:fullURL parameters:parameters];
+    
+    // 缓存只在磁盘上时异步读取，读取完成后再请求网络（此时返回nil，取消请使用取消作用域）
+    __block NSURLSessionDataTask *task = nil;
+    [cache entryForKey:cacheKey completion:^(APICacheEntry * _Nullable entry) {
+        if (token.isCancelled) {
+            return;
+        }
+        
+        // 先返回本地数据（无论是否过期），用于首屏渲染；仍在新鲜期内时紧接着回调refreshed，无需请求网络
+        // 解码和模型映射在响应处理队列，回调在主线程
+        BOOL fresh = entry.isFresh;
+        if (entry) {
+            dispatch_async(self.decodeQueue, ^{
+                id cachedObject = entry.responseObject;
+                if (cachedObject && options.responseModelClass) {
+                    cachedObject = [self modelFromResponseObject:cachedObject options:options error:nil];
+                }
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    if (cached && cachedObject && !token.isCancelled) {
+                        cached(cachedObject);
+                    }
+                    if (fresh && refreshed) {
+                        refreshed(cachedObject, NO);
+                    }
+                });
+            });
+        }
+        
+        if (fresh) {
+            [cache recordHitForEntry:entry];
+            return;
+        }
+        
+        if (entry) {
+            [cache recordRevalidation];
+        } else {
+            [cache recordMiss];
+        }
+        
+        __weak typeof(self) weakSelf = self;
+        task = [self fetchAndCacheGET:fullURL
+                           parameters:parameters
+                              headers:headers
+                             cacheKey:cacheKey
+                                entry:entry
+            persistsWithoutValidators:YES
+                              context:context
+                              success:^(id responseObject, BOOL changed) {
+            // 模型映射在响应处理队列，映射失败按解析失败回调
+            id object = responseObject;
+            if (object && options.responseModelClass) {
+                NSError *mappingError = nil;
+                object = [weakSelf modelFromResponseObject:object options:options error:&mappingError];
+                if (mappingError) {
+                    [weakSelf deliverError:mappingError failure:failure];
+                    return;
+                }
+            }
+            dispatch_async(dispatch_get_main_queue(), ^{
+                if (refreshed) {
+                    refreshed(object, changed);
+                }
+            });
+        } failure:^(NSError *error) {
+            [weakSelf deliverError:error failure:failure];
+        }];
+    }];
+    return task;
+}
+
+- (NSURLSessionDataTask *)streamGETWithPathName:(NSString *)pathName
+                                         subPath:(nullable NSString *)subPath
+                                      parameters:(nullable id)parameters
+                                         headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                         options:(nullable APIRequestOptions *)options
+                                           batch:(void(^)(NSArray *items))batch
+                                         success:(nullable void(^)(NSUInteger itemCount))success
+                                         failure:(nullable APIFailureBlock)failure {
+    NSString *fullURL = [self fullURLForPathName:pathName subPath:subPath pathParameters:options.pathParameters failure:failure];
+    if (!fullURL) {
+        return nil;
+    }
+    
+    // 截止时间覆盖所有重试和Token刷新后的重放；拦截器链所有尝试共用
+    APIRequestContext *context = [[APIRequestContext alloc] init];
+    context.options = options;
+    context.cancellationToken = [options.cancellationScope issueToken];
+    context.deadline = CFAbsoluteTimeGetCurrent() + [self adjustedIntervalForInterval:self.requestDeadline];
+    context.interceptorChain = [[APIInterceptorChain alloc] initWithInterceptors:self.interceptors];
+    [self.retryBudget recordRequest];
+    
+    return [self streamGET:fullURL
+                parameters:parameters
+                   headers:headers
+                     flags:APIRequestInternalFlagNone
+                   context:context
+                     batch:batch
+                   success:success
+                   failure:[self scopedFailure:failure token:context.cancellationToken]];
+}
+
+/// 发起一次流式GET尝试
+/// Token刷新中或已过期时挂起等待刷新；401时刷新Token后重放一次；还没有解析出任何元素时按重试策略重试（已回调的批次无法撤回，不再重试）
+/// 挂起、重放和重试时返回nil或之前的task，取消请使用取消作用域
+- (nullable NSURLSessionDataTask *)streamGET:(NSString *)fullURL
+                                  parameters:(nullable id)parameters
+                                     headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                       flags:(APIRequestInternalFlags)flags
+                                     context:(APIRequestContext *)context
+                                       batch:(void(^)(NSArray *items))batch
+                                     success:(nullable void(^)(NSUInteger itemCount))success
+                                     failure:(nullable APIFailureBlock)failure {
+    APICancellationToken *token = context.cancellationToken;
+    if (token.isCancelled) {
+        return nil;
+    }
+    
+    __weak typeof(self) weakSelf = self;
+    void (^replay)(APIRequestInternalFlags) = ^(APIRequestInternalFlags replayFlags) {
+        [weakSelf streamGET:fullURL
+                 parameters:parameters
+                    headers:headers
+                      flags:replayFlags
+                    context:context
+                      batch:batch
+                    success:success
+                    failure:failure];
+    };
+    
+    // Token因401正在刷新或已过期：挂起请求，等待刷新完成后使用新Token发起
+    APIAuthenticationInterceptor *authInterceptor = [self authenticationInterceptor];
+    if (authInterceptor.canRefreshToken && (authInterceptor.isRefreshingReactively || authInterceptor.isTokenExpired)) {
+        NSLog(@"⏸️ Token刷新中，挂起流式请求: %@", fullURL);
+        [authInterceptor refreshTokenWithCompletion:^(BOOL refreshed, NSError * _Nullable refreshError) {
+            if (refreshed) {
+                replay(flags);
+                return;
+            }
+            
+            APIError *error = [weakSelf errorForFailedTokenRefresh:refreshError URLString:fullURL];
+            if (!error) {
+                error = [APIError errorWithCode:APIErrorCodeUnauthorized
+                                        message:@"登录已过期，请重新登录"
+                                underlyingError:refreshError];
+                error.requestPath = fullURL;
+            }
+            [weakSelf deliverError:error failure:failure];
+        }];
+        return nil;
+    }
+    
+    // 已超过截止时间（如重试或等待Token刷新过久），不再发起请求
+    NSTimeInterval remainingTime = context.deadline - CFAbsoluteTimeGetCurrent();
+    if (remainingTime <= 0) {
+        APIError *error = [APIError errorWithCode:APIErrorCodeTimeout
+                                          message:@"请求超时"
+                                  underlyingError:nil];
+        error.requestPath = fullURL;
+        [self deliverError:error failure:failure];
         return nil;
     }
     
-    // 拼接完整路径
-    NSString *fullPath = basePath;
-    if (subPath && subPath.length > 0) {
-        // 确保 subPath 以 / 开头
-        if (![subPath hasPrefix:@"/"]) {
-            subPath = [NSString stringWithFormat:@"/%@", subPath];
+    // 熔断器打开：快速失败
+    APIPathConfig *pathConfig = [[APIPathConfigManager sharedManager] pathConfigForURL:[NSURL URLWithString:fullURL]];
+    APICircuitBreaker *circuitBreaker = self.circuitBreakerEnabled ? pathConfig.circuitBreaker : nil;
+    if (circuitBreaker && ![circuitBreaker allowRequest]) {
+        NSLog(@"⛔️ 接口[%@]熔断中，快速失败: %@", circuitBreaker.name, fullURL);
+        APIError *error = [APIError errorWithCode:APIErrorCodeCircuitOpen
+                                          message:@"服务暂时不可用，请稍后重试"
+                                  underlyingError:nil];
+        error.requestPath = fullURL;
+        [self deliverError:error failure:failure];
+        return nil;
+    }
+    
+    __block NSError *buildError = nil;
+    APIInterceptorContext *interceptorContext = [context interceptorContextWithHTTPMethod:@"GET" URLString:fullURL];
+    __block NSMutableURLRequest *interceptedRequest = nil;
+    BOOL completed = [self buildRequestWithHTTPMethod:@"GET"
+                                            URLString:fullURL
+                                           parameters:parameters
+                                              headers:headers
+                                      timeoutInterval:MIN(self.effectiveTimeoutInterval, remainingTime)
+                                     interceptorChain:context.interceptorChain
+                                   interceptorContext:interceptorContext
+                                           completion:^(NSURLRequest *request, NSError *error) {
+        interceptedRequest = [request mutableCopy];
+        buildError = error;
+    }];
+    if (!completed) {
+        NSLog(@"⚠️ 拦截器未同步完成，流式请求不支持异步拦截器，已取消: %@", fullURL);
+        interceptedRequest = nil;
+        buildError = nil;
+    }
+    if (!interceptedRequest) {
+        APIError *error = buildError ? [APIError errorFromNSError:buildError]
+            : [APIError errorWithCode:APIErrorCodeCancelled message:@"请求被拦截器取消" underlyingError:nil];
+        error.requestPath = fullURL;
+        [self deliverError:error failure:failure];
+        return nil;
+    }
+    // 流式解析器只支持JSON，不使用payloadCodec协商的格式
+    [interceptedRequest setValue:[APIJSONCodec sharedCodec].contentType forHTTPHeaderField:@"Accept"];
+    
+    // 数组元素按批次在流式会话的代理队列解析和映射，主线程只接收完成的批次；取消后跳过未映射的批次
+    APIRequestOptions *options = context.options;
+    APIJSONStreamParser *parser = [[APIJSONStreamParser alloc] initWithKeyPath:options.modelKeyPath];
+    parser.batchSize = self.streamingBatchSize;
+    parser.batchHandler = ^(NSArray *items) {
+        if (token.isCancelled) {
+            return;
+        }
+        
+        NSArray *batchItems = items;
+        if (options.responseModelClass) {
+            batchItems = [options.responseModelClass mj_objectArrayWithKeyValuesArray:items] ?: @[];
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (!token.isCancelled) {
+                batch(batchItems);
+            }
+        });
+    };
+    
+    CFAbsoluteTime attemptStartTime = CFAbsoluteTimeGetCurrent();
+    __block APIScheduledJob *job = nil;
+    __block NSURLSessionDataTask *task = nil;
+    task = [self.streamingSession dataTaskWithRequest:interceptedRequest
+                                               parser:parser
+                                           completion:^(NSHTTPURLResponse *response, NSError *error) {
+        [job finish];
+        [weakSelf untrackTask:task];
+        NSTimeInterval latency = CFAbsoluteTimeGetCurrent() - attemptStartTime;
+        
+        if (!error) {
+            [circuitBreaker recordSuccessWithLatency:latency];
+            NSUInteger itemCount = parser.itemCount;
+            dispatch_async(dispatch_get_main_queue(), ^{
+                if (success && !token.isCancelled) {
+                    success(itemCount);
+                }
+            });
+            return;
+        }
+        
+        if (token.isCancelled) {
+            [circuitBreaker recordIgnored];
+            return;
+        }
+        
+        APIError *apiError = [APIError errorFromNSError:error];
+        apiError.requestPath = fullURL;
+        
+        // 熔断统计与普通请求相同：网络错误、超时和5xx计入失败
+        if (apiError.code == APIErrorCodeCancelled) {
+            [circuitBreaker recordIgnored];
+        } else if (apiError.isNetworkError || apiError.isServerError) {
+            [circuitBreaker recordFailureWithLatency:latency];
+        } else {
+            [circuitBreaker recordSuccessWithLatency:latency];
+        }
+        
+        // 401：与普通请求相同，刷新Token后重放一次（请求发出后Token已刷新时直接重放）
+        if (apiError.code == APIErrorCodeUnauthorized &&
+            authInterceptor.canRefreshToken &&
+            !(flags & APIRequestInternalFlagNoAuthReplay)) {
+            APIRequestInternalFlags replayFlags = flags | APIRequestInternalFlagNoAuthReplay;
+            if (!authInterceptor.isRefreshing && ![authInterceptor requestUsesCurrentToken:interceptedRequest]) {
+                NSLog(@"🔑 流式请求返回401，Token已在请求发出后刷新，直接重放: %@", fullURL);
+                replay(replayFlags);
+                return;
+            }
+            
+            NSLog(@"🔑 流式请求返回401，等待Token刷新后重放: %@", fullURL);
+            [authInterceptor refreshTokenWithCompletion:^(BOOL refreshed, NSError * _Nullable refreshError) {
+                if (refreshed) {
+                    replay(replayFlags);
+                    return;
+                }
+                [weakSelf deliverError:[weakSelf errorForFailedTokenRefresh:refreshError URLString:fullURL] ?: apiError failure:failure];
+            }];
+            return;
+        }
+        
+        // 还没有解析出任何元素时按重试策略重试，等待时间不超过截止时间，并受重试预算限制
+        id<APIRetryPolicy> retryPolicy = weakSelf.retryPolicy;
+        BOOL shouldRetry = [retryPolicy respondsToSelector:@selector(shouldRetryError:)]
+            ? [retryPolicy shouldRetryError:apiError]
+            : apiError.canRetry;
+        if (shouldRetry && parser.itemCount == 0 && context.retryCount < weakSelf.maxRetryCount) {
+            NSTimeInterval delay = [retryPolicy delayForRetryCount:context.retryCount + 1 previousDelay:context.previousDelay];
+            if (delay < context.deadline - CFAbsoluteTimeGetCurrent() && [weakSelf.retryBudget tryAcquire]) {
+                context.retryCount = context.retryCount + 1;
+                context.previousDelay = delay;
+                NSLog(@"🔄 流式请求准备第 %ld 次重试（最大 %ld 次），间隔 %.2f 秒",
+                      (long)context.retryCount,
+                      (long)weakSelf.maxRetryCount,
+                      delay);
+                
+                APITaskRegistry *taskRegistry = weakSelf.taskRegistry;
+                [taskRegistry beginWaitingRetry];
+                dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), weakSelf.retryQueue, ^{
+                    [taskRegistry endWaitingRetry];
+                    replay(flags);
+                });
+                return;
+            }
+        }
+        
+        [weakSelf deliverError:apiError failure:failure];
+    }];
+    
+    [self trackTask:task tags:[self tagsForOptions:options pathConfig:pathConfig]];
+    [token addTask:task];
+    APIRequestPriority priority = options.hasPriority ? options.priority : APIRequestPriorityVisibleContent;
+    job = [[APIRequestScheduler sharedScheduler] jobWithTask:task priority:priority startHandler:nil];
+    [job start];
+    return task;
+}
+
+- (void)batchGETWithItems:(NSArray<APIBatchItem *> *)items
+                  options:(nullable APIRequestOptions *)options
+               completion:(void(^)(APIBatchResult *result))completion {
+    if (items.count == 0) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion([[APIBatchResult alloc] initWithItemResults:@[] serverBatched:NO]);
+        });
+        return;
+    }
+    
+    APIBatchCollector *collector = [[APIBatchCollector alloc] initWithItems:items completion:completion];
+    if (items.count > 1 && self.batchEndpointEnabled && [APIEnvironmentManager sharedManager].currentEnvironmentSupportsBatchRequests) {
+        [self sendBatchEndpointRequestWithItems:items options:options collector:collector];
+        return;
+    }
+    [self fanOutBatchItems:items
+                   indexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, items.count)]
+                   options:options
+                 collector:collector];
+}
+
+/// 并发发起独立的请求（每个请求的回调被取消作用域丢弃时，收集器随之释放）
+/// @param indexes 要发起的请求在items中的下标
+- (void)fanOutBatchItems:(NSArray<APIBatchItem *> *)items
+                 indexes:(NSIndexSet *)indexes
+                 options:(nullable APIRequestOptions *)options
+               collector:(APIBatchCollector *)collector {
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        APIBatchItem *item = items[idx];
+        [self GETWithPathName:item.pathName
+                      subPath:item.subPath
+                   parameters:item.parameters
+                      headers:item.headers
+                      options:item.options ?: options
+                      success:^(id responseObject) {
+            [collector setResponseObject:responseObject error:nil atIndex:idx];
+        } failure:^(NSError *error) {
+            [collector setResponseObject:nil error:error atIndex:idx];
+        }];
+    }];
+}
+
+/// 合并为一次服务端批量接口调用，响应按id拆分后在响应处理队列完成各自的模型映射
+- (void)sendBatchEndpointRequestWithItems:(NSArray<APIBatchItem *> *)items
+                                  options:(nullable APIRequestOptions *)options
+                                collector:(APIBatchCollector *)collector {
+    NSMutableArray<NSDictionary *> *requests = [NSMutableArray arrayWithCapacity:items.count];
+    NSMutableIndexSet *batchedIndexes = [NSMutableIndexSet indexSet];
+    [items enumerateObjectsUsingBlock:^(APIBatchItem *item, NSUInteger idx, BOOL *stop) {
+        // 路径名称不存在的请求直接失败，其余照常合并
+        APIRequestOptions *itemOptions = item.options ?: options;
+        NSString *fullURL = [self fullURLForPathName:item.pathName subPath:item.subPath pathParameters:itemOptions.pathParameters failure:^(NSError *error) {
+            [collector setResponseObject:nil error:error atIndex:idx];
+        }];
+        if (!fullURL) {
+            return;
         }
-        fullPath = [basePath stringByAppendingString:subPath];
+        
+        NSMutableDictionary *request = [NSMutableDictionary dictionary];
+        request[@"id"] = [@(idx) stringValue];
+        request[@"method"] = @"GET";
+        request[@"path"] = [NSURL URLWithString:fullURL].path ?: @"/";
+        if (item.parameters) {
+            request[@"params"] = item.parameters;
+        }
+        if (item.headers.count > 0) {
+            request[@"headers"] = item.headers;
+        }
+        [requests addObject:request];
+        [batchedIndexes addIndex:idx];
+    }];
+    if (batchedIndexes.count == 0) {
+        return;
     }
     
-    // 构建完整URL：Base URL + Path
-    NSString *baseURL = envManager.currentBaseURL;
-    // 确保 baseURL 不以 / 结尾
-    if ([baseURL hasSuffix:@"/"]) {
-        baseURL = [baseURL substringToIndex:baseURL.length - 1];
+    NSString *batchURL = [self fullURLForPathName:APIPathNameBatch subPath:nil pathParameters:nil failure:nil];
+    if (!batchURL) {
+        [self fanOutBatchItems:items indexes:batchedIndexes options:options collector:collector];
+        return;
+    }
+    collector.serverBatched = YES;
+    
+    // 批量接口的响应不做整体模型映射
+    APIRequestOptions *batchOptions = [options copy] ?: [[APIRequestOptions alloc] init];
+    batchOptions.responseModelClass = nil;
+    batchOptions.modelKeyPath = nil;
+    
+    __weak typeof(self) weakSelf = self;
+    dispatch_queue_t decodeQueue = self.decodeQueue;
+    [self requestWithMethod:HTTPMethodPOST
+                  URLString:batchURL
+                 parameters:@{@"requests": requests}
+                    headers:nil
+                    options:batchOptions
+                    success:^(id responseObject) {
+        dispatch_async(decodeQueue, ^{
+            [weakSelf deliverBatchResponse:responseObject items:items indexes:batchedIndexes options:options collector:collector];
+        });
+    } failure:^(NSError *error) {
+        APIError *apiError = [error isKindOfClass:[APIError class]] ? (APIError *)error : [APIError errorFromNSError:error];
+        
+        // 批量接口不可用（未部署或不支持该方法）：改为独立请求
+        NSInteger statusCode = [weakSelf HTTPStatusCodeOfError:apiError];
+        if (statusCode == 404 || statusCode == 405 || statusCode == 501) {
+            NSLog(@"⚠️ 批量接口不可用（HTTP %ld），改为独立请求", (long)statusCode);
+            collector.serverBatched = NO;
+            [weakSelf fanOutBatchItems:items indexes:batchedIndexes options:options collector:collector];
+            return;
+        }
+        
+        // 其他错误（网络错误、5xx、业务错误等）：独立请求大概率同样失败，所有请求以该错误失败
+        [batchedIndexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+            [collector setResponseObject:nil error:apiError atIndex:idx];
+        }];
+    }];
+}
+
+/// 拆分批量接口的响应（在响应处理队列调用）
+- (void)deliverBatchResponse:(nullable id)responseObject
+                       items:(NSArray<APIBatchItem *> *)items
+                     indexes:(NSIndexSet *)indexes
+                     options:(nullable APIRequestOptions *)options
+                   collector:(APIBatchCollector *)collector {
+    NSMutableDictionary<NSString *, NSDictionary *> *responses = [NSMutableDictionary dictionary];
+    id responseList = [responseObject isKindOfClass:[NSDictionary class]] ? responseObject[@"responses"] : nil;
+    if ([responseList isKindOfClass:[NSArray class]]) {
+        for (id response in responseList) {
+            if ([response isKindOfClass:[NSDictionary class]] && response[@"id"]) {
+                responses[[NSString stringWithFormat:@"%@", response[@"id"]]] = response;
+            }
+        }
+    }
+    
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        APIBatchItem *item = items[idx];
+        NSDictionary *response = responses[[@(idx) stringValue]];
+        if (!response) {
+            APIError *error = [APIError errorWithCode:APIErrorCodeDecodingFailed message:@"批量接口缺少该请求的响应" underlyingError:nil];
+            error.requestPath = item.pathName;
+            [collector setResponseObject:nil error:error atIndex:idx];
+            return;
+        }
+        
+        // 状态码缺失或不是数字时无法判断成功与否，按解析失败处理
+        NSInteger status = 0;
+        if (![self parseBatchStatus:response[@"status"] status:&status]) {
+            APIError *error = [APIError errorWithCode:APIErrorCodeDecodingFailed message:@"批量接口响应的状态码无效" underlyingError:nil];
+            error.requestPath = item.pathName;
+            [collector setResponseObject:nil error:error atIndex:idx];
+            return;
+        }
+        
+        id body = response[@"body"];
+        if (body == [NSNull null]) {
+            body = nil;
+        }
+        if (status >= 400) {
+            // 与独立请求一致：状态码映射为错误码，原始状态码保留在businessCode
+            NSString *message = [body isKindOfClass:[NSDictionary class]] ? body[@"message"] : nil;
+            APIError *error = [APIError errorWithBusinessCode:status
+                                              businessMessage:[message isKindOfClass:[NSString class]] ? message : nil
+                                              underlyingError:nil];
+            error.requestPath = item.pathName;
+            [collector setResponseObject:nil error:error atIndex:idx];
+            return;
+        }
+        
+        APIRequestOptions *itemOptions = item.options ?: options;
+        NSError *error = nil;
+        id result = body;
+        if (itemOptions.responseModelClass) {
+            result = [self modelFromResponseObject:body options:itemOptions error:&error];
+        }
+        [collector setResponseObject:(error ? nil : result) error:error atIndex:idx];
+    }];
+}
+
+/// 批量接口响应中的状态码（数字或数字字符串）
+/// @return 缺失或不是整数时返回NO
+- (BOOL)parseBatchStatus:(nullable id)value status:(NSInteger *)status {
+    if ([value isKindOfClass:[NSNumber class]]) {
+        *status = [value integerValue];
+        return YES;
     }
-    // 确保 fullPath 以 / 开头
-    if (![fullPath hasPrefix:@"/"]) {
-        fullPath = [NSString stringWithFormat:@"/%@", fullPath];
+    if ([value isKindOfClass:[NSString class]]) {
+        NSScanner *scanner = [NSScanner scannerWithString:value];
+        return [scanner scanInteger:status] && scanner.isAtEnd;
+    }
+    return NO;
+}
+
+/// 错误对应的HTTP状态码（没有HTTP响应时为0）
+- (NSInteger)HTTPStatusCodeOfError:(NSError *)error {
+    NSError *underlyingError = [error isKindOfClass:[APIError class]] ? ((APIError *)error).underlyingError : nil;
+    NSHTTPURLResponse *response = error.userInfo[AFNetworkingOperationFailingURLResponseErrorKey] ?: underlyingError.userInfo[AFNetworkingOperationFailingURLResponseErrorKey];
+    return [response isKindOfClass:[NSHTTPURLResponse class]] ? response.statusCode : 0;
+}
+
+- (NSURLSessionDataTask *)POSTWithPathName:(NSString *)pathName
+                                    subPath:(nullable NSString *)subPath
+                                 parameters:(nullable id)parameters
+                                    headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                    success:(nullable APISuccessBlock)success
+                                    failure:(nullable APIFailureBlock)failure {
+    return [self POSTWithPathName:pathName
+                          subPath:subPath
+                       parameters:parameters
+                          headers:headers
+                          options:nil
+                          success:success
+                          failure:failure];
+}
+
+- (NSURLSessionDataTask *)POSTWithPathName:(NSString *)pathName
+                                    subPath:(nullable NSString *)subPath
+                                 parameters:(nullable id)parameters
+                                    headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                    options:(nullable APIRequestOptions *)options
+                                    success:(nullable APISuccessBlock)success
+                                    failure:(nullable APIFailureBlock)failure {
+    NSString *fullURL = [self fullURLForPathName:pathName subPath:subPath pathParameters:options.pathParameters failure:failure];
+    if (!fullURL) {
+        return nil;
     }
-    NSString *fullURL = [NSString stringWithFormat:@"%@%@", baseURL, fullPath];
     
-    return [self POST:fullURL
-           parameters:parameters
-              headers:headers
-              success:success
-              failure:failure];
+    return [self requestWithMethod:HTTPMethodPOST
+                         URLString:fullURL
+                        parameters:parameters
+                           headers:headers
+                           options:options
+                           success:success
+                           failure:failure];
 }
 
 @end
@@ -0,0 +1,56 @@
+//
+//  APIRequestOptions.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import "APIRequestScheduler.h"
+#import "APICancellationScope.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 单个请求的选项（可选，未设置的项使用 APIManager 的默认配置）
+@interface APIRequestOptions : NSObject <NSCopying>
+
+/// 请求优先级（默认：GET为可见内容，其他方法为交互）
+@property (nonatomic, assign) APIRequestPriority priority;
+
+/// 是否显式设置了优先级
+@property (nonatomic, assign, readonly) BOOL hasPriority;
+
+/// 响应模型类（可选，使用MJExtension映射）
+/// 设置后在后台队列完成模型映射，成功回调收到的是模型对象（字典映射为单个模型，数组映射为模型数组）
+@property (nonatomic, strong, nullable) Class responseModelClass;
+
+/// 模型数据在响应中的路径（可选，如：@"data.list"），nil时映射整个响应
+@property (nonatomic, copy, nullable) NSString *modelKeyPath;
+
+/// 路径参数（可选，如 @{@"id": @42}），按路径名称请求时替换路径模板中的参数（如 /api/v1/user/{id:int}/matches）
+@property (nonatomic, copy, nullable) NSDictionary<NSString *, id> *pathParameters;
+
+/// 请求标签（可选，如 @"imagePrefetch"），可以通过 APIManager cancelRequestsWithTag: 批量取消，并按标签统计
+/// 路径名称会自动作为标签
+@property (nonatomic, copy, nullable) NSSet<NSString *> *tags;
+
+/// 取消作用域（弱引用，可选）
+/// 作用域取消或释放时，请求连同等待中的重试和响应处理一起取消，回调不再执行
+@property (nonatomic, weak, nullable) APICancellationScope *cancellationScope;
+
+/// 便捷构造
+/// @param priority 请求优先级
++ (instancetype)optionsWithPriority:(APIRequestPriority)priority;
+
+/// 便捷构造
+/// @param modelClass 响应模型类
+/// @param keyPath 模型数据在响应中的路径
++ (instancetype)optionsWithResponseModelClass:(Class)modelClass keyPath:(nullable NSString *)keyPath;
+
+/// 便捷构造：请求绑定到所有者的取消作用域（如视图控制器，离开或释放时取消）
+/// @param owner 所有者
++ (instancetype)optionsWithOwner:(id)owner;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,54 @@
+//
+//  APIRequestOptions.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIRequestOptions.h"
+
+@interface APIRequestOptions ()
+
+@property (nonatomic, assign) BOOL hasPriority;
+
+@end
+
+@implementation APIRequestOptions
+
++ (instancetype)optionsWithPriority:(APIRequestPriority)priority {
+    APIRequestOptions *options = [[APIRequestOptions alloc] init];
+    options.priority = priority;
+    return options;
+}
+
++ (instancetype)optionsWithResponseModelClass:(Class)modelClass keyPath:(nullable NSString *)keyPath {
+    APIRequestOptions *options = [[APIRequestOptions alloc] init];
+    options.responseModelClass = modelClass;
+    options.modelKeyPath = keyPath;
+    return options;
+}
+
++ (instancetype)optionsWithOwner:(id)owner {
+    APIRequestOptions *options = [[APIRequestOptions alloc] init];
+    options.cancellationScope = [APICancellationScope scopeForOwner:owner];
+    return options;
+}
+
+- (void)setPriority:(APIRequestPriority)priority {
+    _priority = priority;
+    _hasPriority = YES;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    APIRequestOptions *options = [[APIRequestOptions allocWithZone:zone] init];
+    options->_priority = _priority;
+    options->_hasPriority = _hasPriority;
+    options->_responseModelClass = _responseModelClass;
+    options->_modelKeyPath = [_modelKeyPath copy];
+    options->_tags = [_tags copy];
+    options->_pathParameters = [_pathParameters copy];
+    options.cancellationScope = self.cancellationScope;
+    return options;
+}
+
+@end
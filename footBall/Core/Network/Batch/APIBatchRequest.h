@@ -0,0 +1,106 @@
+//
+//  APIBatchRequest.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import "APIRequestOptions.h"
+#import "APIError.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 批量请求中的一个GET请求（按路径名称）
+@interface APIBatchItem : NSObject
+
+/// 路径名称（如：@"user_profile"）
+@property (nonatomic, copy, readonly) NSString *pathName;
+
+/// 子路径（可选）
+@property (nonatomic, copy, readonly, nullable) NSString *subPath;
+
+/// 请求参数（可选）
+@property (nonatomic, strong, readonly, nullable) id parameters;
+
+/// 请求头（可选）
+@property (nonatomic, copy, nullable) NSDictionary<NSString *, NSString *> *headers;
+
+/// 请求选项（可选，如模型类；nil时使用批量请求的选项）
+@property (nonatomic, copy, nullable) APIRequestOptions *options;
+
+/// 便捷构造
+/// @param pathName 路径名称
+/// @param subPath 子路径
+/// @param parameters 请求参数
++ (instancetype)itemWithPathName:(NSString *)pathName
+                         subPath:(nullable NSString *)subPath
+                      parameters:(nullable id)parameters;
+
+/// 便捷构造（带请求选项）
+/// @param pathName 路径名称
+/// @param subPath 子路径
+/// @param parameters 请求参数
+/// @param options 请求选项
++ (instancetype)itemWithPathName:(NSString *)pathName
+                         subPath:(nullable NSString *)subPath
+                      parameters:(nullable id)parameters
+                         options:(nullable APIRequestOptions *)options;
+
+@end
+
+/// 批量请求中单个请求的结果
+@interface APIBatchItemResult : NSObject
+
+/// 对应的请求
+@property (nonatomic, strong, readonly) APIBatchItem *item;
+
+/// 响应对象（指定模型类时为模型对象；失败时为nil）
+@property (nonatomic, strong, readonly, nullable) id responseObject;
+
+/// 错误（成功时为nil）
+@property (nonatomic, strong, readonly, nullable) APIError *error;
+
+/// 是否成功
+@property (nonatomic, assign, readonly, getter=isSucceeded) BOOL succeeded;
+
+/// 初始化方法
+/// @param item 对应的请求
+/// @param responseObject 响应对象
+/// @param error 错误
++ (instancetype)resultWithItem:(APIBatchItem *)item
+                responseObject:(nullable id)responseObject
+                         error:(nullable APIError *)error;
+
+@end
+
+/// 批量请求的汇总结果（每个请求单独成功或失败，顺序与请求一致）
+@interface APIBatchResult : NSObject
+
+/// 各请求的结果（与请求顺序一致）
+@property (nonatomic, copy, readonly) NSArray<APIBatchItemResult *> *itemResults;
+
+/// 成功的请求数
+@property (nonatomic, assign, readonly) NSUInteger succeededCount;
+
+/// 是否全部成功
+@property (nonatomic, assign, readonly) BOOL allSucceeded;
+
+/// 是否通过服务端批量接口完成（否则为并发的独立请求）
+@property (nonatomic, assign, readonly, getter=isServerBatched) BOOL serverBatched;
+
+/// 指定路径名称的第一个结果（同一路径名称出现多次时按下标取 itemResults）
+/// @param pathName 路径名称
+- (nullable APIBatchItemResult *)resultForPathName:(NSString *)pathName;
+
+/// 初始化方法
+/// @param itemResults 各请求的结果
+/// @param serverBatched 是否通过服务端批量接口完成
+- (instancetype)initWithItemResults:(NSArray<APIBatchItemResult *> *)itemResults
+                      serverBatched:(BOOL)serverBatched NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,106 @@
+//
+//  APIBatchRequest.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIBatchRequest.h"
+
+#pragma mark - APIBatchItem
+
+@interface APIBatchItem ()
+
+@property (nonatomic, copy, readwrite) NSString *pathName;
+@property (nonatomic, copy, readwrite, nullable) NSString *subPath;
+@property (nonatomic, strong, readwrite, nullable) id parameters;
+
+@end
+
+@implementation APIBatchItem
+
++ (instancetype)itemWithPathName:(NSString *)pathName
+                         subPath:(nullable NSString *)subPath
+                      parameters:(nullable id)parameters {
+    return [self itemWithPathName:pathName subPath:subPath parameters:parameters options:nil];
+}
+
++ (instancetype)itemWithPathName:(NSString *)pathName
+                         subPath:(nullable NSString *)subPath
+                      parameters:(nullable id)parameters
+                         options:(nullable APIRequestOptions *)options {
+    APIBatchItem *item = [[APIBatchItem alloc] init];
+    item.pathName = pathName;
+    item.subPath = subPath;
+    item.parameters = parameters;
+    item.options = options;
+    return item;
+}
+
+@end
+
+#pragma mark - APIBatchItemResult
+
+@interface APIBatchItemResult ()
+
+@property (nonatomic, strong, readwrite) APIBatchItem *item;
+@property (nonatomic, strong, readwrite, nullable) id responseObject;
+@property (nonatomic, strong, readwrite, nullable) APIError *error;
+
+@end
+
+@implementation APIBatchItemResult
+
++ (instancetype)resultWithItem:(APIBatchItem *)item
+                responseObject:(nullable id)responseObject
+                         error:(nullable APIError *)error {
+    APIBatchItemResult *result = [[APIBatchItemResult alloc] init];
+    result.item = item;
+    result.responseObject = responseObject;
+    result.error = error;
+    return result;
+}
+
+- (BOOL)isSucceeded {
+    return self.error == nil;
+}
+
+@end
+
+#pragma mark - APIBatchResult
+
+@implementation APIBatchResult
+
+- (instancetype)initWithItemResults:(NSArray<APIBatchItemResult *> *)itemResults serverBatched:(BOOL)serverBatched {
+    self = [super init];
+    if (self) {
+        _itemResults = [itemResults copy];
+        _serverBatched = serverBatched;
+    }
+    return self;
+}
+
+- (NSUInteger)succeededCount {
+    NSUInteger count = 0;
+    for (APIBatchItemResult *result in self.itemResults) {
+        if (result.isSucceeded) {
+            count++;
+        }
+    }
+    return count;
+}
+
+- (BOOL)allSucceeded {
+    return self.succeededCount == self.itemResults.count;
+}
+
+- (nullable APIBatchItemResult *)resultForPathName:(NSString *)pathName {
+    for (APIBatchItemResult *result in self.itemResults) {
+        if ([result.item.pathName isEqualToString:pathName]) {
+            return result;
+        }
+    }
+    return nil;
+}
+
+@end
@@ -0,0 +1,161 @@
+//
+//  APIResponseCache.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class APICacheEntry;
+
+/// 缓存条目读取回调
+typedef void(^APICacheEntryBlock)(APICacheEntry * _Nullable entry);
+
+/// 响应缓存条目 - 保存响应数据及其HTTP缓存元信息
+/// 存入缓存后可能同时被多个线程读取和归档，不再修改，更新元信息时生成新的条目
+@interface APICacheEntry : NSObject <NSSecureCoding, NSCopying>
+
+/// 响应数据（JSON）
+@property (nonatomic, strong, readonly) NSData *data;
+
+/// ETag（用于If-None-Match）
+@property (nonatomic, copy, readonly, nullable) NSString *ETag;
+
+/// Last-Modified（用于If-Modified-Since）
+@property (nonatomic, copy, readonly, nullable) NSString *lastModified;
+
+/// 最近一次从服务器确认的时间
+@property (nonatomic, strong, readonly) NSDate *validatedDate;
+
+/// 新鲜期（秒，来自Cache-Control: max-age或Expires）
+@property (nonatomic, assign, readonly) NSTimeInterval maxAge;
+
+/// 过期后允许先返回旧数据再后台重新验证的时长（秒，来自Cache-Control: stale-while-revalidate）
+@property (nonatomic, assign, readonly) NSTimeInterval staleWhileRevalidate;
+
+/// 上次从网络完整获取的耗时（秒，用于统计节省的时间）
+@property (nonatomic, assign) NSTimeInterval fetchDuration;
+
+/// 是否在新鲜期内
+@property (nonatomic, assign, readonly, getter=isFresh) BOOL fresh;
+
+/// 是否可以先返回旧数据并在后台重新验证
+@property (nonatomic, assign, readonly) BOOL canServeStaleWhileRevalidating;
+
+/// 条件请求头（If-None-Match / If-Modified-Since）
+@property (nonatomic, strong, readonly) NSDictionary<NSString *, NSString *> *conditionalHeaders;
+
+/// 根据响应创建缓存条目
+/// @param response HTTP响应
+/// @param responseObject 响应对象
+/// @return 响应不可缓存（no-store、非200、无任何验证信息）时返回nil
++ (nullable instancetype)entryWithResponse:(NSHTTPURLResponse *)response responseObject:(nullable id)responseObject;
+
+/// 根据响应创建持久化条目（没有缓存头时也保存，新鲜期为0，下次使用前总是重新请求）
+/// 用于先缓存后网络的首屏数据；no-store和非200响应仍然返回nil
+/// @param response HTTP响应
+/// @param responseObject 响应对象
++ (nullable instancetype)persistentEntryWithResponse:(NSHTTPURLResponse *)response responseObject:(nullable id)responseObject;
+
+/// 收到304后生成更新了缓存元信息的新条目（不修改当前条目）
+/// @param response 304响应
+- (APICacheEntry *)entryByRefreshingWithNotModifiedResponse:(NSHTTPURLResponse *)response;
+
+/// 解码后的响应对象
+- (nullable id)responseObject;
+
+@end
+
+/// HTTP响应缓存 - 内存 + 磁盘两级缓存
+/// 按 APIEnvironment 和当前用户（AuthManager.userIdentifier）分区，不同环境/用户之间的缓存互不可见
+/// 磁盘读写都在IO队列进行；磁盘缓存按最近使用时间淘汰，启动和进入后台时按 diskAgeLimit、diskSizeLimit 清理
+@interface APIResponseCache : NSObject
+
+/// 单例
++ (instancetype)sharedCache;
+
+/// 内存缓存条目上限（默认：100）
+@property (nonatomic, assign) NSUInteger memoryCountLimit;
+
+/// 磁盘缓存大小上限（字节，默认：20MB，0表示不限制），超出时先移除最久未使用的条目
+@property (nonatomic, assign) unsigned long long diskSizeLimit;
+
+/// 磁盘缓存条目最长保留时间（秒，默认：7天，0表示不限制），按最近一次使用计算
+@property (nonatomic, assign) NSTimeInterval diskAgeLimit;
+
+/// 生成缓存Key（包含当前环境和用户分区）
+/// @param URLString 完整URL
+/// @param parameters 请求参数
+- (NSString *)cacheKeyForURLString:(NSString *)URLString parameters:(nullable id)parameters;
+
+/// 读取缓存条目（先内存后磁盘）
+/// 内存命中时在调用线程同步回调；否则在IO队列读取磁盘并解码，完成后在后台队列回调
+/// @param cacheKey 缓存Key
+/// @param completion 读取完成回调（没有缓存时entry为nil）
+- (void)entryForKey:(NSString *)cacheKey completion:(APICacheEntryBlock)completion;
+
+/// 保存缓存条目（磁盘异步写入）
+/// @param entry 缓存条目
+/// @param cacheKey 缓存Key
+- (void)storeEntry:(APICacheEntry *)entry forKey:(NSString *)cacheKey;
+
+/// 移除缓存条目
+/// @param cacheKey 缓存Key
+- (void)removeEntryForKey:(NSString *)cacheKey;
+
+/// 清空所有缓存
+- (void)removeAllEntries;
+
+/// 按 diskAgeLimit 和 diskSizeLimit 清理磁盘缓存（异步）
+- (void)trimDiskCache;
+
+#pragma mark - 统计
+
+/// 新鲜命中次数（未发起网络请求）
+@property (nonatomic, assign, readonly) NSUInteger hitCount;
+
+/// 过期命中次数（先返回旧数据，后台重新验证）
+@property (nonatomic, assign, readonly) NSUInteger staleHitCount;
+
+/// 未命中次数
+@property (nonatomic, assign, readonly) NSUInteger missCount;
+
+/// 条件请求（重新验证）次数
+@property (nonatomic, assign, readonly) NSUInteger revalidationCount;
+
+/// 服务器返回304次数
+@property (nonatomic, assign, readonly) NSUInteger notModifiedCount;
+
+/// 节省的下载字节数（命中和304时未重新下载的响应体大小）
+@property (nonatomic, assign, readonly) unsigned long long savedBytes;
+
+/// 节省的网络等待时间（秒，按条目上次完整获取的耗时估算）
+@property (nonatomic, assign, readonly) NSTimeInterval savedTime;
+
+/// 记录新鲜命中
+- (void)recordHitForEntry:(APICacheEntry *)entry;
+
+/// 记录过期命中
+- (void)recordStaleHitForEntry:(APICacheEntry *)entry;
+
+/// 记录未命中
+- (void)recordMiss;
+
+/// 记录条件请求
+- (void)recordRevalidation;
+
+/// 记录304
+- (void)recordNotModifiedForEntry:(APICacheEntry *)entry;
+
+/// 统计信息（用于日志和调试工具展示）
+- (NSDictionary<NSString *, NSNumber *> *)statistics;
+
+/// 重置统计
+- (void)resetStatistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
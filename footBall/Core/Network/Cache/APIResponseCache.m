@@ -0,0 +1,604 @@
+//
+//  APIResponseCache.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIResponseCache.h"
+#import "APIEnvironmentManager.h"
+#import "AuthManager.h"
+#import <AFNetworking/AFNetworking.h>
+#import <CommonCrypto/CommonDigest.h>
+#import <UIKit/UIKit.h>
+
+#pragma mark - Helpers
+
+/// SHA256十六进制摘要（用于文件名和用户分区，避免明文落盘）
+static NSString *APIResponseCacheSHA256(NSString *string) {
+    NSData *data = [string dataUsingEncoding:NSUTF8StringEncoding];
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+    
+    NSMutableString *hex = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [hex appendFormat:@"%02x", digest[i]];
+    }
+    return hex;
+}
+
+/// 解析HTTP日期（RFC 1123）
+static NSDate *APIResponseCacheDateFromHTTPString(NSString *string) {
+    if (string.length == 0) {
+        return nil;
+    }
+    
+    static NSDateFormatter *formatter = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        formatter = [[NSDateFormatter alloc] init];
+        formatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+        formatter.timeZone = [NSTimeZone timeZoneWithAbbreviation:@"GMT"];
+        formatter.dateFormat = @"EEE, dd MMM yyyy HH:mm:ss zzz";
+    });
+    
+    @synchronized (formatter) {
+        return [formatter dateFromString:string];
+    }
+}
+
+#pragma mark - APICacheEntry
+
+@interface APICacheEntry ()
+
+@property (nonatomic, strong) NSData *data;
+@property (nonatomic, copy, nullable) NSString *ETag;
+@property (nonatomic, copy, nullable) NSString *lastModified;
+@property (nonatomic, strong) NSDate *validatedDate;
+@property (nonatomic, assign) NSTimeInterval maxAge;
+@property (nonatomic, assign) NSTimeInterval staleWhileRevalidate;
+
+@end
+
+@implementation APICacheEntry
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
++ (nullable instancetype)entryWithResponse:(NSHTTPURLResponse *)response responseObject:(nullable id)responseObject {
+    return [self entryWithResponse:response responseObject:responseObject requiresValidators:YES];
+}
+
++ (nullable instancetype)persistentEntryWithResponse:(NSHTTPURLResponse *)response responseObject:(nullable id)responseObject {
+    return [self entryWithResponse:response responseObject:responseObject requiresValidators:NO];
+}
+
++ (nullable instancetype)entryWithResponse:(NSHTTPURLResponse *)response
+                            responseObject:(nullable id)responseObject
+                        requiresValidators:(BOOL)requiresValidators {
+    if (response.statusCode != 200 || !responseObject) {
+        return nil;
+    }
+    
+    NSDictionary *headers = response.allHeaderFields;
+    NSString *cacheControl = [self headerValue:@"Cache-Control" inHeaders:headers];
+    NSDictionary<NSString *, NSString *> *directives = [self directivesFromCacheControl:cacheControl];
+    
+    // no-store：禁止缓存
+    if (directives[@"no-store"]) {
+        return nil;
+    }
+    
+    APICacheEntry *entry = [[APICacheEntry alloc] init];
+    entry.ETag = [self headerValue:@"ETag" inHeaders:headers];
+    entry.lastModified = [self headerValue:@"Last-Modified" inHeaders:headers];
+    [entry applyFreshnessFromHeaders:headers directives:directives];
+    
+    // 既没有新鲜期也没有验证信息，缓存没有意义
+    if (requiresValidators && entry.maxAge <= 0 && entry.ETag.length == 0 && entry.lastModified.length == 0) {
+        return nil;
+    }
+    
+    // MessagePack响应可能包含二进制数据（NSData），无法按JSON缓存（直接序列化会抛出异常）
+    if (([responseObject isKindOfClass:[NSDictionary class]] || [responseObject isKindOfClass:[NSArray class]]) &&
+        ![NSJSONSerialization isValidJSONObject:responseObject]) {
+        NSLog(@"⚠️ 响应数据无法缓存: 包含非JSON类型");
+        return nil;
+    }
+    
+    NSError *error = nil;
+    NSData *data = [NSJSONSerialization dataWithJSONObject:responseObject
+                                                   options:NSJSONWritingFragmentsAllowed
+                                                     error:&error];
+    if (!data) {
+        NSLog(@"⚠️ 响应数据无法缓存: %@", error.localizedDescription);
+        return nil;
+    }
+    entry.data = data;
+    
+    return entry;
+}
+
+- (APICacheEntry *)entryByRefreshingWithNotModifiedResponse:(NSHTTPURLResponse *)response {
+    APICacheEntry *entry = [self copy];
+    [entry refreshWithNotModifiedResponse:response];
+    return entry;
+}
+
+/// 更新缓存元信息（只在还未存入缓存的新条目上调用）
+- (void)refreshWithNotModifiedResponse:(NSHTTPURLResponse *)response {
+    NSDictionary *headers = response.allHeaderFields;
+    NSString *cacheControl = [APICacheEntry headerValue:@"Cache-Control" inHeaders:headers];
+    
+    // 304可能携带新的缓存策略和验证信息
+    NSString *ETag = [APICacheEntry headerValue:@"ETag" inHeaders:headers];
+    if (ETag.length > 0) {
+        self.ETag = ETag;
+    }
+    NSString *lastModified = [APICacheEntry headerValue:@"Last-Modified" inHeaders:headers];
+    if (lastModified.length > 0) {
+        self.lastModified = lastModified;
+    }
+    if (cacheControl.length > 0 || [APICacheEntry headerValue:@"Expires" inHeaders:headers]) {
+        [self applyFreshnessFromHeaders:headers directives:[APICacheEntry directivesFromCacheControl:cacheControl]];
+    } else {
+        self.validatedDate = [NSDate date];
+    }
+}
+
+- (void)applyFreshnessFromHeaders:(NSDictionary *)headers directives:(NSDictionary<NSString *, NSString *> *)directives {
+    self.validatedDate = [NSDate date];
+    self.maxAge = 0;
+    self.staleWhileRevalidate = 0;
+    
+    if (directives[@"no-cache"]) {
+        // no-cache：可以缓存，但每次使用前必须重新验证
+        return;
+    }
+    
+    if (directives[@"max-age"]) {
+        self.maxAge = MAX(0, [directives[@"max-age"] doubleValue]);
+    } else {
+        NSDate *expires = APIResponseCacheDateFromHTTPString([APICacheEntry headerValue:@"Expires" inHeaders:headers]);
+        NSDate *date = APIResponseCacheDateFromHTTPString([APICacheEntry headerValue:@"Date" inHeaders:headers]) ?: [NSDate date];
+        if (expires) {
+            self.maxAge = MAX(0, [expires timeIntervalSinceDate:date]);
+        }
+    }
+    
+    if (directives[@"stale-while-revalidate"]) {
+        self.staleWhileRevalidate = MAX(0, [directives[@"stale-while-revalidate"] doubleValue]);
+    }
+}
+
+- (BOOL)isFresh {
+    return [[NSDate date] timeIntervalSinceDate:self.validatedDate] < self.maxAge;
+}
+
+- (BOOL)canServeStaleWhileRevalidating {
+    NSTimeInterval age = [[NSDate date] timeIntervalSinceDate:self.validatedDate];
+    return age >= self.maxAge && age < self.maxAge + self.staleWhileRevalidate;
+}
+
+- (NSDictionary<NSString *, NSString *> *)conditionalHeaders {
+    NSMutableDictionary *headers = [NSMutableDictionary dictionary];
+    if (self.ETag.length > 0) {
+        headers[@"If-None-Match"] = self.ETag;
+    }
+    if (self.lastModified.length > 0) {
+        headers[@"If-Modified-Since"] = self.lastModified;
+    }
+    return headers;
+}
+
+- (nullable id)responseObject {
+    if (!self.data) {
+        return nil;
+    }
+    return [NSJSONSerialization JSONObjectWithData:self.data options:NSJSONReadingFragmentsAllowed error:nil];
+}
+
+#pragma mark - Header Parsing
+
++ (nullable NSString *)headerValue:(NSString *)name inHeaders:(NSDictionary *)headers {
+    // 响应头名称不区分大小写
+    for (NSString *key in headers) {
+        if ([key caseInsensitiveCompare:name] == NSOrderedSame) {
+            return headers[key];
+        }
+    }
+    return nil;
+}
+
++ (NSDictionary<NSString *, NSString *> *)directivesFromCacheControl:(nullable NSString *)cacheControl {
+    NSMutableDictionary *directives = [NSMutableDictionary dictionary];
+    for (NSString *component in [cacheControl componentsSeparatedByString:@","]) {
+        NSString *directive = [component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+        if (directive.length == 0) {
+            continue;
+        }
+        
+        NSRange equalRange = [directive rangeOfString:@"="];
+        if (equalRange.location == NSNotFound) {
+            directives[directive.lowercaseString] = @"";
+        } else {
+            NSString *name = [[directive substringToIndex:equalRange.location] lowercaseString];
+            NSString *value = [directive substringFromIndex:NSMaxRange(equalRange)];
+            directives[name] = [value stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"\" "]];
+        }
+    }
+    return directives;
+}
+
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(nullable NSZone *)zone {
+    APICacheEntry *entry = [[APICacheEntry allocWithZone:zone] init];
+    entry.data = self.data;
+    entry.ETag = self.ETag;
+    entry.lastModified = self.lastModified;
+    entry.validatedDate = self.validatedDate;
+    entry.maxAge = self.maxAge;
+    entry.staleWhileRevalidate = self.staleWhileRevalidate;
+    entry.fetchDuration = self.fetchDuration;
+    return entry;
+}
+
+#pragma mark - NSSecureCoding
+
+- (void)encodeWithCoder:(NSCoder *)coder {
+    [coder encodeObject:self.data forKey:@"data"];
+    [coder encodeObject:self.ETag forKey:@"ETag"];
+    [coder encodeObject:self.lastModified forKey:@"lastModified"];
+    [coder encodeObject:self.validatedDate forKey:@"validatedDate"];
+    [coder encodeDouble:self.maxAge forKey:@"maxAge"];
+    [coder encodeDouble:self.staleWhileRevalidate forKey:@"staleWhileRevalidate"];
+    [coder encodeDouble:self.fetchDuration forKey:@"fetchDuration"];
+}
+
+- (nullable instancetype)initWithCoder:(NSCoder *)coder {
+    self = [super init];
+    if (self) {
+        _data = [coder decodeObjectOfClass:[NSData class] forKey:@"data"];
+        _ETag = [coder decodeObjectOfClass:[NSString class] forKey:@"ETag"];
+        _lastModified = [coder decodeObjectOfClass:[NSString class] forKey:@"lastModified"];
+        _validatedDate = [coder decodeObjectOfClass:[NSDate class] forKey:@"validatedDate"];
+        _maxAge = [coder decodeDoubleForKey:@"maxAge"];
+        _staleWhileRevalidate = [coder decodeDoubleForKey:@"staleWhileRevalidate"];
+        _fetchDuration = [coder decodeDoubleForKey:@"fetchDuration"];
+        
+        if (!_data || !_validatedDate) {
+            return nil;
+        }
+    }
+    return self;
+}
+
+@end
+
+#pragma mark - APIResponseCache
+
+@interface APIResponseCache ()
+
+@property (nonatomic, strong) NSCache<NSString *, APICacheEntry *> *memoryCache; // 文件名（Key的摘要） -> 条目，磁盘清理时可以按文件名移除
+@property (nonatomic, strong) dispatch_queue_t ioQueue;
+@property (nonatomic, copy) NSString *diskPath;
+
+@property (nonatomic, assign) NSUInteger hitCount;
+@property (nonatomic, assign) NSUInteger staleHitCount;
+@property (nonatomic, assign) NSUInteger missCount;
+@property (nonatomic, assign) NSUInteger revalidationCount;
+@property (nonatomic, assign) NSUInteger notModifiedCount;
+@property (nonatomic, assign) unsigned long long savedBytes;
+@property (nonatomic, assign) NSTimeInterval savedTime;
+
+@end
+
+@implementation APIResponseCache
+
++ (instancetype)sharedCache {
+    static APIResponseCache *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[APIResponseCache alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _memoryCache = [[NSCache alloc] init];
+        _memoryCache.name = @"com.football.api.responseCache";
+        self.memoryCountLimit = 100;
+        
+        _ioQueue = dispatch_queue_create("com.football.api.responseCache.io", DISPATCH_QUEUE_SERIAL);
+        
+        NSString *cachesPath = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+        _diskPath = [cachesPath stringByAppendingPathComponent:@"APIResponseCache"];
+        [[NSFileManager defaultManager] createDirectoryAtPath:_diskPath
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:nil];
+        
+        _diskSizeLimit = 20 * 1024 * 1024;
+        _diskAgeLimit = 7 * 24 * 60 * 60;
+        [self trimDiskCache];
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationDidEnterBackground:)
+                                                     name:UIApplicationDidEnterBackgroundNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void)setMemoryCountLimit:(NSUInteger)memoryCountLimit {
+    _memoryCountLimit = memoryCountLimit;
+    self.memoryCache.countLimit = memoryCountLimit;
+}
+
+- (NSString *)cacheKeyForURLString:(NSString *)URLString parameters:(nullable id)parameters {
+    // 环境分区
+    APIEnvironment environment = [APIEnvironmentManager sharedManager].currentEnvironment;
+    
+    // 用户分区（用户标识摘要，未登录为anonymous；刷新Token后不变，缓存继续有效）
+    NSString *userIdentifier = [AuthManager sharedManager].userIdentifier;
+    NSString *userPartition = userIdentifier.length > 0 ? [APIResponseCacheSHA256(userIdentifier) substringToIndex:16] : @"anonymous";
+    
+    // 参数按key排序，内容相同的参数得到相同的Key
+    NSString *query = @"";
+    if ([parameters isKindOfClass:[NSDictionary class]]) {
+        query = AFQueryStringFromParameters(parameters);
+    } else if (parameters) {
+        query = [parameters description];
+    }
+    
+    return [NSString stringWithFormat:@"%ld|%@|%@?%@", (long)environment, userPartition, URLString, query];
+}
+
+- (void)entryForKey:(NSString *)cacheKey completion:(APICacheEntryBlock)completion {
+    NSString *fileName = [self fileNameForKey:cacheKey];
+    NSString *filePath = [self.diskPath stringByAppendingPathComponent:fileName];
+    APICacheEntry *entry = [self.memoryCache objectForKey:fileName];
+    if (entry) {
+        // 内存命中同样更新磁盘文件的最近使用时间，否则最常用的条目在磁盘清理时反而最先被移除
+        dispatch_async(self.ioQueue, ^{
+            [self touchFileAtPath:filePath];
+        });
+        completion(entry);
+        return;
+    }
+    
+    dispatch_async(self.ioQueue, ^{
+        APICacheEntry *diskEntry = [self diskEntryAtPath:filePath];
+        if (diskEntry) {
+            [self.memoryCache setObject:diskEntry forKey:fileName];
+        }
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            completion(diskEntry);
+        });
+    });
+}
+
+- (void)storeEntry:(APICacheEntry *)entry forKey:(NSString *)cacheKey {
+    NSString *fileName = [self fileNameForKey:cacheKey];
+    [self.memoryCache setObject:entry forKey:fileName];
+    
+    NSString *filePath = [self.diskPath stringByAppendingPathComponent:fileName];
+    dispatch_async(self.ioQueue, ^{
+        NSError *error = nil;
+        NSData *fileData = [NSKeyedArchiver archivedDataWithRootObject:entry requiringSecureCoding:YES error:&error];
+        if (!fileData || ![fileData writeToFile:filePath options:NSDataWritingAtomic error:&error]) {
+            NSLog(@"⚠️ 缓存条目写入失败: %@", error.localizedDescription);
+        }
+    });
+}
+
+- (void)removeEntryForKey:(NSString *)cacheKey {
+    NSString *fileName = [self fileNameForKey:cacheKey];
+    [self.memoryCache removeObjectForKey:fileName];
+    
+    NSString *filePath = [self.diskPath stringByAppendingPathComponent:fileName];
+    dispatch_async(self.ioQueue, ^{
+        [[NSFileManager defaultManager] removeItemAtPath:filePath error:nil];
+    });
+}
+
+- (void)removeAllEntries {
+    [self.memoryCache removeAllObjects];
+    
+    NSString *diskPath = self.diskPath;
+    dispatch_async(self.ioQueue, ^{
+        [[NSFileManager defaultManager] removeItemAtPath:diskPath error:nil];
+        [[NSFileManager defaultManager] createDirectoryAtPath:diskPath
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:nil];
+    });
+    NSLog(@"🗑️ API响应缓存已清空");
+}
+
+- (void)trimDiskCache {
+    dispatch_async(self.ioQueue, ^{
+        [self trimDiskCacheInIOQueue];
+    });
+}
+
+#pragma mark - Private Methods
+
+/// 磁盘文件名（同时作为内存缓存的Key）
+- (NSString *)fileNameForKey:(NSString *)cacheKey {
+    return APIResponseCacheSHA256(cacheKey);
+}
+
+/// 修改时间作为最近使用时间，清理时先移除最久未使用的条目（在IO队列调用）
+- (void)touchFileAtPath:(NSString *)filePath {
+    [[NSFileManager defaultManager] setAttributes:@{NSFileModificationDate: [NSDate date]} ofItemAtPath:filePath error:nil];
+}
+
+/// 读取磁盘条目（在IO队列调用），解码失败的文件直接删除
+- (nullable APICacheEntry *)diskEntryAtPath:(NSString *)filePath {
+    NSData *fileData = [NSData dataWithContentsOfFile:filePath];
+    if (!fileData) {
+        return nil;
+    }
+    
+    NSError *error = nil;
+    APICacheEntry *entry = [NSKeyedUnarchiver unarchivedObjectOfClass:[APICacheEntry class] fromData:fileData error:&error];
+    if (!entry) {
+        NSLog(@"⚠️ 缓存条目读取失败，已移除: %@", error.localizedDescription);
+        [[NSFileManager defaultManager] removeItemAtPath:filePath error:nil];
+        return nil;
+    }
+    
+    [self touchFileAtPath:filePath];
+    return entry;
+}
+
+/// 清理磁盘缓存（在IO队列调用）：先移除超过保留时间的条目，仍超出大小上限时按最近使用时间从旧到新移除到上限的一半
+- (void)trimDiskCacheInIOQueue {
+    NSURL *diskURL = [NSURL fileURLWithPath:self.diskPath isDirectory:YES];
+    NSArray<NSURLResourceKey> *resourceKeys = @[NSURLIsDirectoryKey, NSURLContentModificationDateKey, NSURLTotalFileAllocatedSizeKey];
+    NSDirectoryEnumerator<NSURL *> *enumerator = [[NSFileManager defaultManager] enumeratorAtURL:diskURL
+                                                                      includingPropertiesForKeys:resourceKeys
+                                                                                         options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                                    errorHandler:nil];
+    
+    NSDate *expirationDate = self.diskAgeLimit > 0 ? [NSDate dateWithTimeIntervalSinceNow:-self.diskAgeLimit] : nil;
+    NSMutableDictionary<NSURL *, NSDictionary<NSURLResourceKey, id> *> *files = [NSMutableDictionary dictionary];
+    unsigned long long totalSize = 0;
+    NSUInteger expiredCount = 0;
+    
+    for (NSURL *fileURL in enumerator) {
+        NSDictionary<NSURLResourceKey, id> *values = [fileURL resourceValuesForKeys:resourceKeys error:nil];
+        if ([values[NSURLIsDirectoryKey] boolValue]) {
+            continue;
+        }
+        
+        NSDate *modificationDate = values[NSURLContentModificationDateKey];
+        if (expirationDate && [modificationDate compare:expirationDate] == NSOrderedAscending) {
+            [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+            [self.memoryCache removeObjectForKey:fileURL.lastPathComponent];
+            expiredCount++;
+            continue;
+        }
+        
+        totalSize += [values[NSURLTotalFileAllocatedSizeKey] unsignedLongLongValue];
+        files[fileURL] = values;
+    }
+    
+    NSUInteger evictedCount = 0;
+    if (self.diskSizeLimit > 0 && totalSize > self.diskSizeLimit) {
+        // 清理到上限的一半，留出余量，避免很快再次超出
+        unsigned long long targetSize = self.diskSizeLimit / 2;
+        NSArray<NSURL *> *sortedFiles = [files keysSortedByValueWithOptions:NSSortConcurrent
+                                                            usingComparator:^NSComparisonResult(NSDictionary *obj1, NSDictionary *obj2) {
+            return [obj1[NSURLContentModificationDateKey] compare:obj2[NSURLContentModificationDateKey]];
+        }];
+        
+        for (NSURL *fileURL in sortedFiles) {
+            if (totalSize <= targetSize) {
+                break;
+            }
+            if ([[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil]) {
+                [self.memoryCache removeObjectForKey:fileURL.lastPathComponent];
+                totalSize -= [files[fileURL][NSURLTotalFileAllocatedSizeKey] unsignedLongLongValue];
+                evictedCount++;
+            }
+        }
+    }
+    
+    // 被移除的条目已同时移出内存，其他条目保留在内存中
+    if (expiredCount > 0 || evictedCount > 0) {
+        NSLog(@"🧹 API响应缓存清理: 过期%lu条, 超出大小上限移除%lu条, 剩余%.1fMB",
+              (unsigned long)expiredCount, (unsigned long)evictedCount, totalSize / 1024.0 / 1024.0);
+    }
+}
+
+- (void)applicationDidEnterBackground:(NSNotification *)notification {
+    UIApplication *application = [UIApplication sharedApplication];
+    __block UIBackgroundTaskIdentifier taskIdentifier = [application beginBackgroundTaskWithExpirationHandler:^{
+        [application endBackgroundTask:taskIdentifier];
+        taskIdentifier = UIBackgroundTaskInvalid;
+    }];
+    
+    dispatch_async(self.ioQueue, ^{
+        [self trimDiskCacheInIOQueue];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (taskIdentifier != UIBackgroundTaskInvalid) {
+                [application endBackgroundTask:taskIdentifier];
+                taskIdentifier = UIBackgroundTaskInvalid;
+            }
+        });
+    });
+}
+
+#pragma mark - Statistics
+
+- (void)recordHitForEntry:(APICacheEntry *)entry {
+    @synchronized (self) {
+        self.hitCount++;
+        self.savedBytes += entry.data.length;
+        self.savedTime += entry.fetchDuration;
+    }
+}
+
+- (void)recordStaleHitForEntry:(APICacheEntry *)entry {
+    @synchronized (self) {
+        self.staleHitCount++;
+        self.savedTime += entry.fetchDuration;
+    }
+}
+
+- (void)recordMiss {
+    @synchronized (self) {
+        self.missCount++;
+    }
+}
+
+- (void)recordRevalidation {
+    @synchronized (self) {
+        self.revalidationCount++;
+    }
+}
+
+- (void)recordNotModifiedForEntry:(APICacheEntry *)entry {
+    @synchronized (self) {
+        self.notModifiedCount++;
+        self.savedBytes += entry.data.length;
+    }
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)statistics {
+    @synchronized (self) {
+        return @{
+            @"hit": @(self.hitCount),
+            @"staleHit": @(self.staleHitCount),
+            @"miss": @(self.missCount),
+            @"revalidate": @(self.revalidationCount),
+            @"notModified": @(self.notModifiedCount),
+            @"savedBytes": @(self.savedBytes),
+            @"savedTime": @(self.savedTime)
+        };
+    }
+}
+
+- (void)resetStatistics {
+    @synchronized (self) {
+        self.hitCount = 0;
+        self.staleHitCount = 0;
+        self.missCount = 0;
+        self.revalidationCount = 0;
+        self.notModifiedCount = 0;
+        self.savedBytes = 0;
+        self.savedTime = 0;
+    }
+}
+
+@end
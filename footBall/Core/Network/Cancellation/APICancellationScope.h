@@ -0,0 +1,55 @@
+//
+//  APICancellationScope.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 取消令牌 - 一次请求（包括它的重试、重放和响应处理）在取消作用域中的登记
+@interface APICancellationToken : NSObject
+
+/// 是否已取消
+@property (atomic, assign, readonly, getter=isCancelled) BOOL cancelled;
+
+/// 登记请求当前的task（重试时登记新的task），取消时一并取消
+/// @param task 请求task（已取消时立即取消）
+- (void)addTask:(NSURLSessionTask *)task;
+
+/// 登记取消时执行的操作（如释放回调），已取消时立即执行
+/// @param handler 取消操作（在调用 cancel 的线程执行）
+- (void)addCancellationHandler:(dispatch_block_t)handler;
+
+/// 取消（只影响这一次请求）
+- (void)cancel;
+
+@end
+
+/// 取消作用域 - 把请求绑定到一个所有者（如视图控制器），所有者离开或释放时自动取消
+/// 取消后：进行中的task被取消，等待中的重试和Token刷新后的重放不再发起，未完成的响应处理（模型映射）跳过，回调不再执行并立即释放
+/// 作用域只取消取消之前发起的请求，之后发起的请求不受影响（页面再次出现时可以继续使用）
+@interface APICancellationScope : NSObject
+
+/// 所有者的作用域（首次访问时创建，所有者释放时取消其中所有请求）
+/// @param owner 所有者
++ (instancetype)scopeForOwner:(id)owner;
+
+/// 发放一个取消令牌（作用域弱引用令牌，请求结束后自动移除）
+- (APICancellationToken *)issueToken;
+
+/// 创建子作用域（父作用域弱引用子作用域，由调用方持有）
+/// 父作用域取消时子作用域中的请求一并取消，子作用域单独取消不影响父作用域（如分页数据源每页一个子作用域）
+- (APICancellationScope *)childScope;
+
+/// 进行中的请求数（包括子作用域中的请求）
+@property (nonatomic, assign, readonly) NSUInteger activeRequestCount;
+
+/// 取消作用域（包括子作用域）中所有进行中的请求
+- (void)cancel;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,164 @@
+//
+//  APICancellationScope.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APICancellationScope.h"
+#import <objc/runtime.h>
+
+#pragma mark - APICancellationToken
+
+@interface APICancellationToken ()
+
+@property (atomic, assign, readwrite, getter=isCancelled) BOOL cancelled;
+@property (nonatomic, strong) NSHashTable<NSURLSessionTask *> *tasks; // 弱引用，task结束后自动移除
+@property (nonatomic, strong) NSMutableArray<dispatch_block_t> *cancellationHandlers;
+
+@end
+
+@implementation APICancellationToken
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _tasks = [NSHashTable weakObjectsHashTable];
+        _cancellationHandlers = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)addTask:(NSURLSessionTask *)task {
+    @synchronized (self) {
+        if (!self.cancelled) {
+            [self.tasks addObject:task];
+            return;
+        }
+    }
+    [task cancel];
+}
+
+- (void)addCancellationHandler:(dispatch_block_t)handler {
+    @synchronized (self) {
+        if (!self.cancelled) {
+            [self.cancellationHandlers addObject:[handler copy]];
+            return;
+        }
+    }
+    handler();
+}
+
+- (void)cancel {
+    NSArray<NSURLSessionTask *> *tasks = nil;
+    NSArray<dispatch_block_t> *handlers = nil;
+    @synchronized (self) {
+        if (self.cancelled) {
+            return;
+        }
+        self.cancelled = YES;
+        tasks = self.tasks.allObjects;
+        handlers = [self.cancellationHandlers copy];
+        [self.tasks removeAllObjects];
+        [self.cancellationHandlers removeAllObjects];
+    }
+    
+    for (NSURLSessionTask *task in tasks) {
+        [task cancel];
+    }
+    for (dispatch_block_t handler in handlers) {
+        handler();
+    }
+}
+
+@end
+
+#pragma mark - APICancellationScope
+
+static const void *kAPICancellationScopeKey = &kAPICancellationScopeKey;
+
+@interface APICancellationScope ()
+
+@property (nonatomic, strong) NSHashTable<APICancellationToken *> *tokens; // 弱引用，请求结束（令牌释放）后自动移除
+@property (nonatomic, strong) NSHashTable<APICancellationScope *> *childScopes; // 弱引用，子作用域释放后自动移除
+
+@end
+
+@implementation APICancellationScope
+
++ (instancetype)scopeForOwner:(id)owner {
+    @synchronized (owner) {
+        APICancellationScope *scope = objc_getAssociatedObject(owner, kAPICancellationScopeKey);
+        if (!scope) {
+            scope = [[APICancellationScope alloc] init];
+            objc_setAssociatedObject(owner, kAPICancellationScopeKey, scope, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
+        return scope;
+    }
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _tokens = [NSHashTable weakObjectsHashTable];
+        _childScopes = [NSHashTable weakObjectsHashTable];
+    }
+    return self;
+}
+
+/// 所有者释放时关联的作用域随之释放，取消其中的请求
+- (void)dealloc {
+    [self cancel];
+}
+
+- (APICancellationToken *)issueToken {
+    APICancellationToken *token = [[APICancellationToken alloc] init];
+    @synchronized (self) {
+        [self.tokens addObject:token];
+    }
+    return token;
+}
+
+- (APICancellationScope *)childScope {
+    APICancellationScope *scope = [[APICancellationScope alloc] init];
+    @synchronized (self) {
+        [self.childScopes addObject:scope];
+    }
+    return scope;
+}
+
+- (NSUInteger)activeRequestCount {
+    NSUInteger count = 0;
+    NSArray<APICancellationScope *> *childScopes = nil;
+    @synchronized (self) {
+        count = self.tokens.allObjects.count;
+        childScopes = self.childScopes.allObjects;
+    }
+    for (APICancellationScope *childScope in childScopes) {
+        count += childScope.activeRequestCount;
+    }
+    return count;
+}
+
+- (void)cancel {
+    NSArray<APICancellationToken *> *tokens = nil;
+    NSArray<APICancellationScope *> *childScopes = nil;
+    @synchronized (self) {
+        tokens = self.tokens.allObjects;
+        [self.tokens removeAllObjects];
+        // 子作用域保留（之后在子作用域中发起的请求仍然随父作用域取消）
+        childScopes = self.childScopes.allObjects;
+    }
+    
+    if (tokens.count > 0) {
+        NSLog(@"🚫 取消作用域中的%lu个请求", (unsigned long)tokens.count);
+    }
+    for (APICancellationToken *token in tokens) {
+        [token cancel];
+    }
+    for (APICancellationScope *childScope in childScopes) {
+        [childScope cancel];
+    }
+}
+
+@end
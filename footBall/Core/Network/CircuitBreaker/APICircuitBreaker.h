@@ -0,0 +1,90 @@
+//
+//  APICircuitBreaker.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 熔断器状态
+typedef NS_ENUM(NSInteger, APICircuitBreakerState) {
+    APICircuitBreakerStateClosed = 0,   // 关闭（正常放行）
+    APICircuitBreakerStateOpen,         // 打开（快速失败）
+    APICircuitBreakerStateHalfOpen      // 半开（放行少量探测请求）
+};
+
+/// 熔断器状态变化通知（object为APICircuitBreaker）
+FOUNDATION_EXPORT NSString *const APICircuitBreakerStateDidChangeNotification;
+
+/// 熔断器 - 接口持续失败或变慢时快速失败，避免页面一直等待超时
+/// 统计窗口内失败（含慢调用）比例超过阈值时打开；打开一段时间后进入半开，探测请求成功则关闭，失败则重新打开
+@interface APICircuitBreaker : NSObject
+
+/// 名称（路径名称）
+@property (nonatomic, copy, readonly) NSString *name;
+
+/// 当前状态
+@property (nonatomic, assign, readonly) APICircuitBreakerState state;
+
+/// 失败比例阈值（默认：0.5）
+@property (nonatomic, assign) double failureRateThreshold;
+
+/// 慢调用阈值（秒，默认：5），耗时超过该值的成功请求也计为失败
+@property (nonatomic, assign) NSTimeInterval slowCallThreshold;
+
+/// 统计窗口内最少请求数，少于该值时不打开（默认：10）
+@property (nonatomic, assign) NSUInteger minimumRequestCount;
+
+/// 统计窗口（秒，默认：30）
+@property (nonatomic, assign) NSTimeInterval window;
+
+/// 打开持续时间（秒，默认：15），之后进入半开状态
+@property (nonatomic, assign) NSTimeInterval openDuration;
+
+/// 半开状态下允许同时进行的探测请求数（默认：1）
+@property (nonatomic, assign) NSUInteger halfOpenProbeCount;
+
+/// 统计窗口内的失败比例
+@property (nonatomic, assign, readonly) double failureRate;
+
+/// 统计窗口内的请求数
+@property (nonatomic, assign, readonly) NSUInteger sampleCount;
+
+/// 累计快速失败次数
+@property (nonatomic, assign, readonly) NSUInteger rejectedCount;
+
+/// 累计打开次数
+@property (nonatomic, assign, readonly) NSUInteger openedCount;
+
+/// 初始化方法
+/// @param name 名称（路径名称）
+- (instancetype)initWithName:(NSString *)name;
+
+/// 是否放行请求（打开状态返回NO；半开状态只放行探测请求）
+/// @note 返回YES后必须调用一次 record 方法，否则半开状态的探测名额不会释放
+- (BOOL)allowRequest;
+
+/// 记录成功
+/// @param latency 请求耗时（秒）
+- (void)recordSuccessWithLatency:(NSTimeInterval)latency;
+
+/// 记录失败（网络错误、超时、5xx）
+/// @param latency 请求耗时（秒）
+- (void)recordFailureWithLatency:(NSTimeInterval)latency;
+
+/// 记录不计入统计的结果（如请求取消），只释放半开状态的探测名额
+- (void)recordIgnored;
+
+/// 重置为关闭状态并清空统计
+- (void)reset;
+
+/// 状态显示名称
+/// @param state 状态
++ (NSString *)displayNameForState:(APICircuitBreakerState)state;
+
+@end
+
+NS_ASSUME_NONNULL_END
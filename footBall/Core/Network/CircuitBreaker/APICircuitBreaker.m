@@ -0,0 +1,233 @@
+//
+//  APICircuitBreaker.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APICircuitBreaker.h"
+
+NSString *const APICircuitBreakerStateDidChangeNotification = @"APICircuitBreakerStateDidChangeNotification";
+
+/// 统计样本
+@interface APICircuitBreakerSample : NSObject
+
+@property (nonatomic, assign) CFAbsoluteTime timestamp;
+@property (nonatomic, assign) BOOL failed;
+
+@end
+
+@implementation APICircuitBreakerSample
+@end
+
+@interface APICircuitBreaker ()
+
+@property (nonatomic, assign) APICircuitBreakerState state;
+@property (nonatomic, assign) NSUInteger rejectedCount;
+@property (nonatomic, assign) NSUInteger openedCount;
+@property (nonatomic, strong) NSMutableArray<APICircuitBreakerSample *> *samples; // 统计窗口内的样本（按时间递增）
+@property (nonatomic, assign) CFAbsoluteTime openedTime; // 最近一次打开的时间
+@property (nonatomic, assign) NSUInteger probesInFlight; // 半开状态下进行中的探测请求数
+
+@end
+
+@implementation APICircuitBreaker
+
+- (instancetype)init {
+    return [self initWithName:@""];
+}
+
+- (instancetype)initWithName:(NSString *)name {
+    self = [super init];
+    if (self) {
+        _name = [name copy];
+        _state = APICircuitBreakerStateClosed;
+        _failureRateThreshold = 0.5;
+        _slowCallThreshold = 5.0;
+        _minimumRequestCount = 10;
+        _window = 30.0;
+        _openDuration = 15.0;
+        _halfOpenProbeCount = 1;
+        _samples = [NSMutableArray array];
+    }
+    return self;
+}
+
+#pragma mark - Public Methods
+
+- (BOOL)allowRequest {
+    APICircuitBreakerState previousState;
+    BOOL allowed = YES;
+    
+    @synchronized (self) {
+        previousState = self.state;
+        
+        // 打开时间已到，进入半开状态
+        if (self.state == APICircuitBreakerStateOpen &&
+            CFAbsoluteTimeGetCurrent() - self.openedTime >= self.openDuration) {
+            self.state = APICircuitBreakerStateHalfOpen;
+            self.probesInFlight = 0;
+        }
+        
+        switch (self.state) {
+            case APICircuitBreakerStateClosed:
+                allowed = YES;
+                break;
+            case APICircuitBreakerStateOpen:
+                allowed = NO;
+                break;
+            case APICircuitBreakerStateHalfOpen:
+                allowed = self.probesInFlight < self.halfOpenProbeCount;
+                if (allowed) {
+                    self.probesInFlight++;
+                }
+                break;
+        }
+        
+        if (!allowed) {
+            self.rejectedCount++;
+        }
+    }
+    
+    [self notifyIfStateChangedFrom:previousState];
+    return allowed;
+}
+
+- (void)recordSuccessWithLatency:(NSTimeInterval)latency {
+    // 慢调用视为失败：后端变慢时同样需要快速失败
+    [self recordResultWithFailed:(latency >= self.slowCallThreshold)];
+}
+
+- (void)recordFailureWithLatency:(NSTimeInterval)latency {
+    [self recordResultWithFailed:YES];
+}
+
+- (void)recordIgnored {
+    @synchronized (self) {
+        if (self.state == APICircuitBreakerStateHalfOpen && self.probesInFlight > 0) {
+            self.probesInFlight--;
+        }
+    }
+}
+
+- (void)reset {
+    APICircuitBreakerState previousState;
+    @synchronized (self) {
+        previousState = self.state;
+        self.state = APICircuitBreakerStateClosed;
+        self.probesInFlight = 0;
+        [self.samples removeAllObjects];
+    }
+    [self notifyIfStateChangedFrom:previousState];
+}
+
+- (double)failureRate {
+    @synchronized (self) {
+        [self pruneSamples];
+        if (self.samples.count == 0) {
+            return 0;
+        }
+        
+        NSUInteger failedCount = 0;
+        for (APICircuitBreakerSample *sample in self.samples) {
+            if (sample.failed) {
+                failedCount++;
+            }
+        }
+        return (double)failedCount / self.samples.count;
+    }
+}
+
+- (NSUInteger)sampleCount {
+    @synchronized (self) {
+        [self pruneSamples];
+        return self.samples.count;
+    }
+}
+
++ (NSString *)displayNameForState:(APICircuitBreakerState)state {
+    switch (state) {
+        case APICircuitBreakerStateClosed:
+            return @"关闭";
+        case APICircuitBreakerStateOpen:
+            return @"打开";
+        case APICircuitBreakerStateHalfOpen:
+            return @"半开";
+    }
+}
+
+#pragma mark - Private Methods
+
+- (void)recordResultWithFailed:(BOOL)failed {
+    APICircuitBreakerState previousState;
+    @synchronized (self) {
+        previousState = self.state;
+        
+        if (self.state == APICircuitBreakerStateHalfOpen) {
+            if (self.probesInFlight > 0) {
+                self.probesInFlight--;
+            }
+            
+            if (failed) {
+                // 探测失败，重新打开
+                [self open];
+            } else if (self.probesInFlight == 0) {
+                // 探测成功，恢复正常
+                self.state = APICircuitBreakerStateClosed;
+                [self.samples removeAllObjects];
+            }
+        } else if (self.state == APICircuitBreakerStateClosed) {
+            APICircuitBreakerSample *sample = [[APICircuitBreakerSample alloc] init];
+            sample.timestamp = CFAbsoluteTimeGetCurrent();
+            sample.failed = failed;
+            [self.samples addObject:sample];
+            
+            if (failed && self.sampleCount >= self.minimumRequestCount &&
+                self.failureRate >= self.failureRateThreshold) {
+                [self open];
+            }
+        }
+    }
+    
+    [self notifyIfStateChangedFrom:previousState];
+}
+
+/// 打开熔断器（调用方已加锁）
+- (void)open {
+    self.state = APICircuitBreakerStateOpen;
+    self.openedTime = CFAbsoluteTimeGetCurrent();
+    self.probesInFlight = 0;
+    self.openedCount++;
+    [self.samples removeAllObjects];
+}
+
+/// 移除窗口外的样本（调用方已加锁）
+- (void)pruneSamples {
+    CFAbsoluteTime threshold = CFAbsoluteTimeGetCurrent() - self.window;
+    NSUInteger expiredCount = 0;
+    while (expiredCount < self.samples.count && self.samples[expiredCount].timestamp < threshold) {
+        expiredCount++;
+    }
+    if (expiredCount > 0) {
+        [self.samples removeObjectsInRange:NSMakeRange(0, expiredCount)];
+    }
+}
+
+- (void)notifyIfStateChangedFrom:(APICircuitBreakerState)previousState {
+    APICircuitBreakerState currentState = self.state;
+    if (currentState == previousState) {
+        return;
+    }
+    
+    NSLog(@"%@ 熔断器[%@]: %@ -> %@",
+          currentState == APICircuitBreakerStateOpen ? @"⚠️" : @"✅",
+          self.name,
+          [APICircuitBreaker displayNameForState:previousState],
+          [APICircuitBreaker displayNameForState:currentState]);
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [[NSNotificationCenter defaultCenter] postNotificationName:APICircuitBreakerStateDidChangeNotification object:self];
+    });
+}
+
+@end
@@ -0,0 +1,39 @@
+//
+//  APICodecSerializer.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import <AFNetworking/AFNetworking.h>
+#import "APIPayloadCodec.h"
+#import "APIBodyCompressor.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 按编解码器序列化请求体的请求序列化器
+/// codec为nil时与AFJSONRequestSerializer行为一致；
+/// 设置codec后，请求体使用codec编码并设置对应的Content-Type，同时通过Accept告知服务端优先返回该格式（JSON作为回退）；
+/// 设置bodyEncoding后，不小于阈值的请求体按该方式压缩并设置Content-Encoding
+@interface APICodecRequestSerializer : AFJSONRequestSerializer
+
+/// 请求体编解码器（默认：nil，即JSON）
+@property (nonatomic, strong, nullable) id<APIPayloadCodec> codec;
+
+/// 请求体压缩方式（默认：APIContentEncodingNone，不压缩）
+@property (nonatomic, assign) APIContentEncoding bodyEncoding;
+
+/// 请求体压缩阈值（字节，默认：1024，小于该值的请求体不压缩）
+@property (nonatomic, assign) NSUInteger bodyCompressionThreshold;
+
+@end
+
+/// 按响应Content-Type选择编解码器的响应序列化器
+/// JSON响应仍由AFJSONResponseSerializer解析；其他已注册格式（如MessagePack）使用对应的编解码器解码，
+/// 调用方拿到的都是相同的Foundation对象
+@interface APICodecResponseSerializer : AFJSONResponseSerializer
+
+@end
+
+NS_ASSUME_NONNULL_END
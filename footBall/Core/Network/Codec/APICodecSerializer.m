@@ -0,0 +1,140 @@
+//
+//  APICodecSerializer.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APICodecSerializer.h"
+#import "APIMetricsStore.h"
+
+@implementation APICodecRequestSerializer
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _bodyCompressionThreshold = 1024;
+    }
+    return self;
+}
+
+- (nullable NSURLRequest *)requestBySerializingRequest:(NSURLRequest *)request
+                                        withParameters:(nullable id)parameters
+                                                 error:(NSError *__autoreleasing *)error {
+    NSURLRequest *serializedRequest = nil;
+    if (self.codec) {
+        serializedRequest = [self requestBySerializingRequest:request withParameters:parameters codec:self.codec error:error];
+    } else {
+        serializedRequest = [super requestBySerializingRequest:request withParameters:parameters error:error];
+    }
+    if (!serializedRequest || self.bodyEncoding == APIContentEncodingNone) {
+        return serializedRequest;
+    }
+    
+    NSMutableURLRequest *mutableRequest = [serializedRequest mutableCopy];
+    [APIBodyCompressor compressBodyOfRequest:mutableRequest encoding:self.bodyEncoding threshold:self.bodyCompressionThreshold];
+    return mutableRequest;
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    APICodecRequestSerializer *serializer = [super copyWithZone:zone];
+    serializer.codec = self.codec;
+    serializer.bodyEncoding = self.bodyEncoding;
+    serializer.bodyCompressionThreshold = self.bodyCompressionThreshold;
+    return serializer;
+}
+
+#pragma mark - Private Methods
+
+- (nullable NSURLRequest *)requestBySerializingRequest:(NSURLRequest *)request
+                                        withParameters:(nullable id)parameters
+                                                 codec:(id<APIPayloadCodec>)codec
+                                                 error:(NSError *__autoreleasing *)error {
+    // GET/HEAD/DELETE参数仍拼接在URL中，只有请求体使用codec编码
+    BOOL encodesParametersInURI = [self.HTTPMethodsEncodingParametersInURI containsObject:request.HTTPMethod.uppercaseString];
+    NSMutableURLRequest *mutableRequest = [[super requestBySerializingRequest:request
+                                                               withParameters:(encodesParametersInURI ? parameters : nil)
+                                                                        error:error] mutableCopy];
+    if (!mutableRequest) {
+        return nil;
+    }
+    
+    if (!encodesParametersInURI && parameters) {
+        NSData *body = [codec encodeObject:parameters error:error];
+        if (!body) {
+            return nil;
+        }
+        [mutableRequest setValue:codec.contentType forHTTPHeaderField:@"Content-Type"];
+        mutableRequest.HTTPBody = body;
+    }
+    
+    // 公共请求头中的Accept: application/json会被覆盖，服务端不支持该格式时仍可以返回JSON
+    [mutableRequest setValue:[self acceptHeaderForCodec:codec] forHTTPHeaderField:@"Accept"];
+    return mutableRequest;
+}
+
+- (NSString *)acceptHeaderForCodec:(id<APIPayloadCodec>)codec {
+    NSString *JSONContentType = [APIJSONCodec sharedCodec].contentType;
+    if ([codec.contentType isEqualToString:JSONContentType]) {
+        return JSONContentType;
+    }
+    return [NSString stringWithFormat:@"%@, %@;q=0.9", codec.contentType, JSONContentType];
+}
+
+@end
+
+@implementation APICodecResponseSerializer
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        self.acceptableContentTypes = [self.acceptableContentTypes setByAddingObjectsFromSet:[[APIPayloadCodecRegistry sharedRegistry] allAcceptableContentTypes]];
+    }
+    return self;
+}
+
+- (nullable id)responseObjectForResponse:(nullable NSURLResponse *)response
+                                    data:(nullable NSData *)data
+                                   error:(NSError *__autoreleasing *)error {
+    // 记录响应体解析耗时（在AFNetworking的响应处理队列上执行）
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    id responseObject = [self decodedObjectForResponse:response data:data error:error];
+    if (data.length > 0) {
+        [[APIMetricsStore sharedStore] recordDuration:CFAbsoluteTimeGetCurrent() - startTime phase:APIMetricsPhaseDecode forURL:response.URL];
+    }
+    return responseObject;
+}
+
+#pragma mark - Private Methods
+
+/// 按Content-Type选择编解码器解析响应体
+- (nullable id)decodedObjectForResponse:(nullable NSURLResponse *)response
+                                   data:(nullable NSData *)data
+                                  error:(NSError *__autoreleasing *)error {
+    id<APIPayloadCodec> codec = [[APIPayloadCodecRegistry sharedRegistry] codecForContentType:response.MIMEType];
+    if (!codec || [codec isKindOfClass:[APIJSONCodec class]]) {
+        return [super responseObjectForResponse:response data:data error:error];
+    }
+    
+    // 与JSON解析保持一致：状态码校验失败时仍解析响应体（业务错误信息在响应体中）
+    NSError *validationError = nil;
+    BOOL valid = [self validateResponse:(NSHTTPURLResponse *)response data:data error:&validationError];
+    if (error) {
+        *error = validationError;
+    }
+    if ((!valid && !error) || data.length == 0) {
+        return nil;
+    }
+    
+    NSError *decodeError = nil;
+    id responseObject = [codec decodeData:data error:&decodeError];
+    if (!responseObject) {
+        if (error && !*error) {
+            *error = decodeError;
+        }
+        return nil;
+    }
+    return responseObject;
+}
+
+@end
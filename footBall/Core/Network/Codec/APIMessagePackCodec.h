@@ -0,0 +1,27 @@
+//
+//  APIMessagePackCodec.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import "APIPayloadCodec.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// MessagePack编解码器（application/msgpack，WebSocket子协议：msgpack）
+/// 支持 NSDictionary、NSArray、NSString、NSNumber（布尔/整数/浮点）、NSNull、NSData（bin类型）
+/// 解码结果与JSON解析得到的Foundation对象类型一致，可直接交给MJExtension映射模型
+/// @note 不支持扩展类型（ext），遇到时解码失败
+@interface APIMessagePackCodec : NSObject <APIPayloadCodec>
+
+/// 单例
++ (instancetype)sharedCodec;
+
+/// 最大嵌套深度（默认：128，超过时编解码失败，防止恶意数据导致栈溢出）
+@property (nonatomic, assign) NSUInteger maxDepth;
+
+@end
+
+NS_ASSUME_NONNULL_END
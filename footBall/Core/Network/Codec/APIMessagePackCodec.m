@@ -0,0 +1,492 @@
+//
+//  APIMessagePackCodec.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIMessagePackCodec.h"
+
+/// 解码游标
+typedef struct {
+    const uint8_t *bytes;
+    NSUInteger length;
+    NSUInteger offset;
+} APIMessagePackReader;
+
+static NSError *APIMessagePackError(NSString *message) {
+    return [NSError errorWithDomain:APIPayloadCodecErrorDomain
+                               code:-2
+                           userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"MessagePack: %@", message]}];
+}
+
+#pragma mark - Encoding
+
+static inline void APIMessagePackWriteByte(NSMutableData *data, uint8_t byte) {
+    [data appendBytes:&byte length:1];
+}
+
+static inline void APIMessagePackWriteUInt16(NSMutableData *data, uint8_t marker, uint16_t value) {
+    uint8_t buffer[3] = {marker, (uint8_t)(value >> 8), (uint8_t)value};
+    [data appendBytes:buffer length:sizeof(buffer)];
+}
+
+static inline void APIMessagePackWriteUInt32(NSMutableData *data, uint8_t marker, uint32_t value) {
+    uint8_t buffer[5] = {marker, (uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value};
+    [data appendBytes:buffer length:sizeof(buffer)];
+}
+
+static inline void APIMessagePackWriteUInt64(NSMutableData *data, uint8_t marker, uint64_t value) {
+    uint8_t buffer[9] = {marker,
+        (uint8_t)(value >> 56), (uint8_t)(value >> 48), (uint8_t)(value >> 40), (uint8_t)(value >> 32),
+        (uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value};
+    [data appendBytes:buffer length:sizeof(buffer)];
+}
+
+static void APIMessagePackWriteUnsigned(NSMutableData *data, uint64_t value) {
+    if (value <= 0x7f) {
+        APIMessagePackWriteByte(data, (uint8_t)value);
+    } else if (value <= UINT8_MAX) {
+        uint8_t buffer[2] = {0xcc, (uint8_t)value};
+        [data appendBytes:buffer length:sizeof(buffer)];
+    } else if (value <= UINT16_MAX) {
+        APIMessagePackWriteUInt16(data, 0xcd, (uint16_t)value);
+    } else if (value <= UINT32_MAX) {
+        APIMessagePackWriteUInt32(data, 0xce, (uint32_t)value);
+    } else {
+        APIMessagePackWriteUInt64(data, 0xcf, value);
+    }
+}
+
+static void APIMessagePackWriteSigned(NSMutableData *data, int64_t value) {
+    if (value >= 0) {
+        APIMessagePackWriteUnsigned(data, (uint64_t)value);
+    } else if (value >= -32) {
+        APIMessagePackWriteByte(data, (uint8_t)(int8_t)value);
+    } else if (value >= INT8_MIN) {
+        uint8_t buffer[2] = {0xd0, (uint8_t)(int8_t)value};
+        [data appendBytes:buffer length:sizeof(buffer)];
+    } else if (value >= INT16_MIN) {
+        APIMessagePackWriteUInt16(data, 0xd1, (uint16_t)(int16_t)value);
+    } else if (value >= INT32_MIN) {
+        APIMessagePackWriteUInt32(data, 0xd2, (uint32_t)(int32_t)value);
+    } else {
+        APIMessagePackWriteUInt64(data, 0xd3, (uint64_t)value);
+    }
+}
+
+static void APIMessagePackWriteNumber(NSMutableData *data, NSNumber *number) {
+    // JSON解析得到的布尔值是CFBoolean
+    if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+        APIMessagePackWriteByte(data, number.boolValue ? 0xc3 : 0xc2);
+        return;
+    }
+    
+    switch (number.objCType[0]) {
+        case 'f': {
+            float value = number.floatValue;
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            APIMessagePackWriteUInt32(data, 0xca, bits);
+            break;
+        }
+        case 'd': {
+            double value = number.doubleValue;
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            APIMessagePackWriteUInt64(data, 0xcb, bits);
+            break;
+        }
+        case 'C':
+        case 'S':
+        case 'I':
+        case 'L':
+        case 'Q':
+            APIMessagePackWriteUnsigned(data, number.unsignedLongLongValue);
+            break;
+        default:
+            APIMessagePackWriteSigned(data, number.longLongValue);
+            break;
+    }
+}
+
+/// 写入类型标记和长度（fix类型标记为0时表示该类型没有fix形式）
+static BOOL APIMessagePackWriteHeader(NSMutableData *data, NSUInteger length, uint8_t fixMarker, NSUInteger fixLimit, uint8_t marker8, uint8_t marker16, uint8_t marker32) {
+    if (fixMarker && length < fixLimit) {
+        APIMessagePackWriteByte(data, fixMarker | (uint8_t)length);
+    } else if (marker8 && length <= UINT8_MAX) {
+        uint8_t buffer[2] = {marker8, (uint8_t)length};
+        [data appendBytes:buffer length:sizeof(buffer)];
+    } else if (length <= UINT16_MAX) {
+        APIMessagePackWriteUInt16(data, marker16, (uint16_t)length);
+    } else if (length <= UINT32_MAX) {
+        APIMessagePackWriteUInt32(data, marker32, (uint32_t)length);
+    } else {
+        return NO;
+    }
+    return YES;
+}
+
+static BOOL APIMessagePackWriteObject(NSMutableData *data, id object, NSUInteger depth, NSUInteger maxDepth, NSError **error) {
+    if (depth > maxDepth) {
+        if (error) {
+            *error = APIMessagePackError(@"嵌套层级过深");
+        }
+        return NO;
+    }
+    
+    if (!object || object == [NSNull null]) {
+        APIMessagePackWriteByte(data, 0xc0);
+        return YES;
+    }
+    
+    if ([object isKindOfClass:[NSString class]]) {
+        // 先完成编码再写入头部：无法编码为UTF-8的字符串（如不成对的代理项）编码失败，不写入半个字符串
+        NSData *UTF8Data = [(NSString *)object dataUsingEncoding:NSUTF8StringEncoding];
+        if (!UTF8Data) {
+            if (error) {
+                *error = APIMessagePackError(@"字符串无法编码为UTF-8");
+            }
+            return NO;
+        }
+        if (!APIMessagePackWriteHeader(data, UTF8Data.length, 0xa0, 32, 0xd9, 0xda, 0xdb)) {
+            if (error) {
+                *error = APIMessagePackError(@"字符串过长");
+            }
+            return NO;
+        }
+        [data appendData:UTF8Data];
+        return YES;
+    }
+    
+    if ([object isKindOfClass:[NSNumber class]]) {
+        APIMessagePackWriteNumber(data, object);
+        return YES;
+    }
+    
+    if ([object isKindOfClass:[NSDictionary class]]) {
+        NSDictionary *dictionary = object;
+        if (!APIMessagePackWriteHeader(data, dictionary.count, 0x80, 16, 0, 0xde, 0xdf)) {
+            if (error) {
+                *error = APIMessagePackError(@"字典元素过多");
+            }
+            return NO;
+        }
+        for (id key in dictionary) {
+            if (!APIMessagePackWriteObject(data, key, depth + 1, maxDepth, error) ||
+                !APIMessagePackWriteObject(data, dictionary[key], depth + 1, maxDepth, error)) {
+                return NO;
+            }
+        }
+        return YES;
+    }
+    
+    if ([object isKindOfClass:[NSArray class]]) {
+        NSArray *array = object;
+        if (!APIMessagePackWriteHeader(data, array.count, 0x90, 16, 0, 0xdc, 0xdd)) {
+            if (error) {
+                *error = APIMessagePackError(@"数组元素过多");
+            }
+            return NO;
+        }
+        for (id element in array) {
+            if (!APIMessagePackWriteObject(data, element, depth + 1, maxDepth, error)) {
+                return NO;
+            }
+        }
+        return YES;
+    }
+    
+    if ([object isKindOfClass:[NSData class]]) {
+        NSData *binary = object;
+        if (!APIMessagePackWriteHeader(data, binary.length, 0, 0, 0xc4, 0xc5, 0xc6)) {
+            if (error) {
+                *error = APIMessagePackError(@"二进制数据过长");
+            }
+            return NO;
+        }
+        [data appendData:binary];
+        return YES;
+    }
+    
+    if (error) {
+        *error = APIMessagePackError([NSString stringWithFormat:@"不支持的类型 %@", [object class]]);
+    }
+    return NO;
+}
+
+#pragma mark - Decoding
+
+static inline BOOL APIMessagePackRead(APIMessagePackReader *reader, NSUInteger length, const uint8_t **bytes) {
+    if (reader->length - reader->offset < length) {
+        return NO;
+    }
+    *bytes = reader->bytes + reader->offset;
+    reader->offset += length;
+    return YES;
+}
+
+static inline BOOL APIMessagePackReadUInt(APIMessagePackReader *reader, NSUInteger size, uint64_t *value) {
+    const uint8_t *bytes = NULL;
+    if (!APIMessagePackRead(reader, size, &bytes)) {
+        return NO;
+    }
+    uint64_t result = 0;
+    for (NSUInteger i = 0; i < size; i++) {
+        result = (result << 8) | bytes[i];
+    }
+    *value = result;
+    return YES;
+}
+
+static id APIMessagePackReadObject(APIMessagePackReader *reader, NSUInteger depth, NSUInteger maxDepth, NSError **error);
+
+static id APIMessagePackReadString(APIMessagePackReader *reader, NSUInteger length, NSError **error) {
+    const uint8_t *bytes = NULL;
+    if (!APIMessagePackRead(reader, length, &bytes)) {
+        if (error) {
+            *error = APIMessagePackError(@"数据不完整");
+        }
+        return nil;
+    }
+    NSString *string = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+    if (!string && error) {
+        *error = APIMessagePackError(@"字符串不是有效的UTF-8");
+    }
+    return string;
+}
+
+static id APIMessagePackReadBinary(APIMessagePackReader *reader, NSUInteger length, NSError **error) {
+    const uint8_t *bytes = NULL;
+    if (!APIMessagePackRead(reader, length, &bytes)) {
+        if (error) {
+            *error = APIMessagePackError(@"数据不完整");
+        }
+        return nil;
+    }
+    return [NSData dataWithBytes:bytes length:length];
+}
+
+static id APIMessagePackReadArray(APIMessagePackReader *reader, NSUInteger count, NSUInteger depth, NSUInteger maxDepth, NSError **error) {
+    // 每个元素至少占1字节，按剩余长度限制预分配容量，避免伪造的长度导致大量内存分配
+    NSMutableArray *array = [NSMutableArray arrayWithCapacity:MIN(count, reader->length - reader->offset)];
+    for (NSUInteger i = 0; i < count; i++) {
+        id element = APIMessagePackReadObject(reader, depth + 1, maxDepth, error);
+        if (!element) {
+            return nil;
+        }
+        [array addObject:element];
+    }
+    return array;
+}
+
+static id APIMessagePackReadMap(APIMessagePackReader *reader, NSUInteger count, NSUInteger depth, NSUInteger maxDepth, NSError **error) {
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:MIN(count, (reader->length - reader->offset) / 2)];
+    for (NSUInteger i = 0; i < count; i++) {
+        id key = APIMessagePackReadObject(reader, depth + 1, maxDepth, error);
+        if (!key) {
+            return nil;
+        }
+        if (![key conformsToProtocol:@protocol(NSCopying)]) {
+            if (error) {
+                *error = APIMessagePackError(@"字典键类型无效");
+            }
+            return nil;
+        }
+        id value = APIMessagePackReadObject(reader, depth + 1, maxDepth, error);
+        if (!value) {
+            return nil;
+        }
+        dictionary[key] = value;
+    }
+    return dictionary;
+}
+
+static id APIMessagePackReadObject(APIMessagePackReader *reader, NSUInteger depth, NSUInteger maxDepth, NSError **error) {
+    if (depth > maxDepth) {
+        if (error) {
+            *error = APIMessagePackError(@"嵌套层级过深");
+        }
+        return nil;
+    }
+    
+    const uint8_t *markerByte = NULL;
+    if (!APIMessagePackRead(reader, 1, &markerByte)) {
+        if (error) {
+            *error = APIMessagePackError(@"数据不完整");
+        }
+        return nil;
+    }
+    uint8_t marker = *markerByte;
+    
+    // fix类型
+    if (marker <= 0x7f) {
+        return @((long long)marker);
+    }
+    if (marker >= 0xe0) {
+        return @((long long)(int8_t)marker);
+    }
+    if ((marker & 0xf0) == 0x80) {
+        return APIMessagePackReadMap(reader, marker & 0x0f, depth, maxDepth, error);
+    }
+    if ((marker & 0xf0) == 0x90) {
+        return APIMessagePackReadArray(reader, marker & 0x0f, depth, maxDepth, error);
+    }
+    if ((marker & 0xe0) == 0xa0) {
+        return APIMessagePackReadString(reader, marker & 0x1f, error);
+    }
+    
+    uint64_t value = 0;
+    switch (marker) {
+        case 0xc0:
+            return [NSNull null];
+        case 0xc2:
+            return @NO;
+        case 0xc3:
+            return @YES;
+        case 0xc4:
+        case 0xc5:
+        case 0xc6:
+            if (!APIMessagePackReadUInt(reader, 1 << (marker - 0xc4), &value)) {
+                break;
+            }
+            return APIMessagePackReadBinary(reader, (NSUInteger)value, error);
+        case 0xca: {
+            if (!APIMessagePackReadUInt(reader, 4, &value)) {
+                break;
+            }
+            uint32_t bits = (uint32_t)value;
+            float result;
+            memcpy(&result, &bits, sizeof(result));
+            return @(result);
+        }
+        case 0xcb: {
+            if (!APIMessagePackReadUInt(reader, 8, &value)) {
+                break;
+            }
+            double result;
+            memcpy(&result, &value, sizeof(result));
+            return @(result);
+        }
+        case 0xcc:
+        case 0xcd:
+        case 0xce:
+        case 0xcf:
+            if (!APIMessagePackReadUInt(reader, 1 << (marker - 0xcc), &value)) {
+                break;
+            }
+            // 与JSON解析结果保持一致，能用有符号整数表示的都返回long long
+            return value <= LLONG_MAX ? @((long long)value) : @(value);
+        case 0xd0:
+            if (!APIMessagePackReadUInt(reader, 1, &value)) {
+                break;
+            }
+            return @((long long)(int8_t)value);
+        case 0xd1:
+            if (!APIMessagePackReadUInt(reader, 2, &value)) {
+                break;
+            }
+            return @((long long)(int16_t)value);
+        case 0xd2:
+            if (!APIMessagePackReadUInt(reader, 4, &value)) {
+                break;
+            }
+            return @((long long)(int32_t)value);
+        case 0xd3:
+            if (!APIMessagePackReadUInt(reader, 8, &value)) {
+                break;
+            }
+            return @((long long)value);
+        case 0xd9:
+        case 0xda:
+        case 0xdb:
+            if (!APIMessagePackReadUInt(reader, 1 << (marker - 0xd9), &value)) {
+                break;
+            }
+            return APIMessagePackReadString(reader, (NSUInteger)value, error);
+        case 0xdc:
+        case 0xdd:
+            if (!APIMessagePackReadUInt(reader, marker == 0xdc ? 2 : 4, &value)) {
+                break;
+            }
+            return APIMessagePackReadArray(reader, (NSUInteger)value, depth, maxDepth, error);
+        case 0xde:
+        case 0xdf:
+            if (!APIMessagePackReadUInt(reader, marker == 0xde ? 2 : 4, &value)) {
+                break;
+            }
+            return APIMessagePackReadMap(reader, (NSUInteger)value, depth, maxDepth, error);
+        default:
+            // 0xc1（保留）、0xc7-0xc9/0xd4-0xd8（扩展类型）
+            if (error) {
+                *error = APIMessagePackError([NSString stringWithFormat:@"不支持的类型标记 0x%02x", marker]);
+            }
+            return nil;
+    }
+    
+    if (error) {
+        *error = APIMessagePackError(@"数据不完整");
+    }
+    return nil;
+}
+
+@implementation APIMessagePackCodec
+
++ (instancetype)sharedCodec {
+    static APIMessagePackCodec *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[APIMessagePackCodec alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _maxDepth = 128;
+    }
+    return self;
+}
+
+- (NSString *)name {
+    return @"MessagePack";
+}
+
+- (NSString *)contentType {
+    return @"application/msgpack";
+}
+
+- (NSSet<NSString *> *)acceptableContentTypes {
+    return [NSSet setWithObjects:@"application/msgpack", @"application/x-msgpack", @"application/vnd.msgpack", nil];
+}
+
+- (NSString *)webSocketSubprotocol {
+    return @"msgpack";
+}
+
+- (nullable NSData *)encodeObject:(id)object error:(NSError **)error {
+    NSMutableData *data = [NSMutableData dataWithCapacity:256];
+    if (!APIMessagePackWriteObject(data, object, 0, self.maxDepth, error)) {
+        return nil;
+    }
+    return data;
+}
+
+- (nullable id)decodeData:(NSData *)data error:(NSError **)error {
+    APIMessagePackReader reader = {data.bytes, data.length, 0};
+    id object = APIMessagePackReadObject(&reader, 0, self.maxDepth, error);
+    if (!object) {
+        return nil;
+    }
+    
+    if (reader.offset != reader.length) {
+        if (error) {
+            *error = APIMessagePackError(@"数据末尾有多余字节");
+        }
+        return nil;
+    }
+    return object;
+}
+
+@end
@@ -0,0 +1,80 @@
+//
+//  APIPayloadCodec.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 编解码错误域
+FOUNDATION_EXPORT NSString *const APIPayloadCodecErrorDomain;
+
+/// 请求/响应体编解码器协议
+/// 在Foundation对象（NSDictionary、NSArray、NSString、NSNumber、NSNull、NSData）与线上字节之间转换
+@protocol APIPayloadCodec <NSObject>
+
+/// 名称（用于日志和性能对比，如：JSON、MessagePack）
+@property (nonatomic, copy, readonly) NSString *name;
+
+/// HTTP Content-Type（如：application/json、application/msgpack）
+@property (nonatomic, copy, readonly) NSString *contentType;
+
+/// 可识别的响应Content-Type（含contentType和别名）
+@property (nonatomic, copy, readonly) NSSet<NSString *> *acceptableContentTypes;
+
+/// WebSocket子协议名称（如：json、msgpack）
+@property (nonatomic, copy, readonly) NSString *webSocketSubprotocol;
+
+/// 编码
+/// @param object Foundation对象
+/// @param error 错误信息
+/// @return 编码后的数据，失败返回nil
+- (nullable NSData *)encodeObject:(id)object error:(NSError **)error;
+
+/// 解码
+/// @param data 数据
+/// @param error 错误信息
+/// @return Foundation对象，失败返回nil
+- (nullable id)decodeData:(NSData *)data error:(NSError **)error;
+
+@end
+
+/// JSON编解码器（NSJSONSerialization，与原有请求/响应格式一致）
+@interface APIJSONCodec : NSObject <APIPayloadCodec>
+
+/// 单例
++ (instancetype)sharedCodec;
+
+@end
+
+/// 编解码器注册表 - 根据Content-Type和WebSocket子协议查找编解码器
+/// 默认注册JSON和MessagePack
+@interface APIPayloadCodecRegistry : NSObject
+
+/// 单例
++ (instancetype)sharedRegistry;
+
+/// 已注册的编解码器（按注册顺序）
+@property (nonatomic, copy, readonly) NSArray<id<APIPayloadCodec>> *codecs;
+
+/// 注册编解码器（同名的会被替换）
+/// @param codec 编解码器
+- (void)registerCodec:(id<APIPayloadCodec>)codec;
+
+/// 根据Content-Type查找编解码器（忽略参数和大小写，如：application/msgpack; charset=binary）
+/// @param contentType Content-Type
+- (nullable id<APIPayloadCodec>)codecForContentType:(nullable NSString *)contentType;
+
+/// 根据WebSocket子协议查找编解码器
+/// @param subprotocol 子协议
+- (nullable id<APIPayloadCodec>)codecForWebSocketSubprotocol:(nullable NSString *)subprotocol;
+
+/// 所有已注册编解码器可识别的Content-Type
+- (NSSet<NSString *> *)allAcceptableContentTypes;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,141 @@
+//
+//  APIPayloadCodec.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIPayloadCodec.h"
+#import "APIMessagePackCodec.h"
+
+NSString *const APIPayloadCodecErrorDomain = @"APIPayloadCodecErrorDomain";
+
+@implementation APIJSONCodec
+
++ (instancetype)sharedCodec {
+    static APIJSONCodec *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[APIJSONCodec alloc] init];
+    });
+    return instance;
+}
+
+- (NSString *)name {
+    return @"JSON";
+}
+
+- (NSString *)contentType {
+    return @"application/json";
+}
+
+- (NSSet<NSString *> *)acceptableContentTypes {
+    return [NSSet setWithObjects:@"application/json", @"text/json", @"text/javascript", nil];
+}
+
+- (NSString *)webSocketSubprotocol {
+    return @"json";
+}
+
+- (nullable NSData *)encodeObject:(id)object error:(NSError **)error {
+    if (![NSJSONSerialization isValidJSONObject:object]) {
+        if (error) {
+            *error = [NSError errorWithDomain:APIPayloadCodecErrorDomain
+                                         code:-1
+                                     userInfo:@{NSLocalizedDescriptionKey: @"对象无法转换为JSON"}];
+        }
+        return nil;
+    }
+    return [NSJSONSerialization dataWithJSONObject:object options:0 error:error];
+}
+
+- (nullable id)decodeData:(NSData *)data error:(NSError **)error {
+    return [NSJSONSerialization JSONObjectWithData:data options:NSJSONReadingFragmentsAllowed error:error];
+}
+
+@end
+
+@interface APIPayloadCodecRegistry ()
+
+@property (nonatomic, strong) NSMutableArray<id<APIPayloadCodec>> *mutableCodecs;
+
+@end
+
+@implementation APIPayloadCodecRegistry
+
++ (instancetype)sharedRegistry {
+    static APIPayloadCodecRegistry *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[APIPayloadCodecRegistry alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _mutableCodecs = [NSMutableArray array];
+        [_mutableCodecs addObject:[APIJSONCodec sharedCodec]];
+        [_mutableCodecs addObject:[APIMessagePackCodec sharedCodec]];
+    }
+    return self;
+}
+
+#pragma mark - Public Methods
+
+- (NSArray<id<APIPayloadCodec>> *)codecs {
+    @synchronized (self) {
+        return [self.mutableCodecs copy];
+    }
+}
+
+- (void)registerCodec:(id<APIPayloadCodec>)codec {
+    @synchronized (self) {
+        NSUInteger index = [self.mutableCodecs indexOfObjectPassingTest:^BOOL(id<APIPayloadCodec> obj, NSUInteger idx, BOOL *stop) {
+            return [obj.name isEqualToString:codec.name];
+        }];
+        if (index != NSNotFound) {
+            self.mutableCodecs[index] = codec;
+        } else {
+            [self.mutableCodecs addObject:codec];
+        }
+    }
+}
+
+- (nullable id<APIPayloadCodec>)codecForContentType:(nullable NSString *)contentType {
+    NSString *mediaType = [[contentType componentsSeparatedByString:@";"].firstObject stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]].lowercaseString;
+    if (mediaType.length == 0) {
+        return nil;
+    }
+    
+    for (id<APIPayloadCodec> codec in self.codecs) {
+        if ([codec.acceptableContentTypes containsObject:mediaType]) {
+            return codec;
+        }
+    }
+    return nil;
+}
+
+- (nullable id<APIPayloadCodec>)codecForWebSocketSubprotocol:(nullable NSString *)subprotocol {
+    if (subprotocol.length == 0) {
+        return nil;
+    }
+    
+    for (id<APIPayloadCodec> codec in self.codecs) {
+        if ([codec.webSocketSubprotocol caseInsensitiveCompare:subprotocol] == NSOrderedSame) {
+            return codec;
+        }
+    }
+    return nil;
+}
+
+- (NSSet<NSString *> *)allAcceptableContentTypes {
+    NSMutableSet<NSString *> *contentTypes = [NSMutableSet set];
+    for (id<APIPayloadCodec> codec in self.codecs) {
+        [contentTypes unionSet:codec.acceptableContentTypes];
+    }
+    return [contentTypes copy];
+}
+
+@end
@@ -0,0 +1,62 @@
+//
+//  APIBodyCompressor.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 请求体压缩方式（Content-Encoding）
+typedef NS_ENUM(NSInteger, APIContentEncoding) {
+    APIContentEncodingNone = 0,  // 不压缩
+    APIContentEncodingGzip,      // gzip
+    APIContentEncodingDeflate    // deflate（zlib格式）
+};
+
+/// NSURLProtocol属性Key：压缩前的请求体字节数（用于压缩统计）
+FOUNDATION_EXPORT NSString *const APIUncompressedBodyLengthPropertyKey;
+
+/// 请求体压缩器（zlib）
+@interface APIBodyCompressor : NSObject
+
+/// 压缩数据
+/// @param data 原始数据
+/// @param encoding 压缩方式
+/// @return 压缩后的数据，失败或encoding为None时返回nil
++ (nullable NSData *)compressData:(NSData *)data encoding:(APIContentEncoding)encoding;
+
+/// Content-Encoding请求头的值（None返回nil）
+/// @param encoding 压缩方式
++ (nullable NSString *)headerValueForEncoding:(APIContentEncoding)encoding;
+
+/// 该类型的内容是否值得压缩（图片、音视频、压缩包等已经压缩过的格式返回NO）
+/// @param MIMEType MIME类型
++ (BOOL)isCompressibleMIMEType:(nullable NSString *)MIMEType;
+
+/// 按阈值压缩请求体：请求体不小于阈值、没有Content-Encoding且压缩后更小时替换请求体，
+/// 设置Content-Encoding/Content-Length，并记录压缩前字节数（APIUncompressedBodyLengthPropertyKey）
+/// @param request 请求（使用HTTPBody，流式请求体不处理）
+/// @param encoding 压缩方式
+/// @param threshold 压缩阈值（字节）
+/// @return 是否压缩
++ (BOOL)compressBodyOfRequest:(NSMutableURLRequest *)request
+                     encoding:(APIContentEncoding)encoding
+                    threshold:(NSUInteger)threshold;
+
+/// 压缩流式请求体（如内存中的multipart表单）
+/// 请求体（Content-Length）不小于阈值时读出HTTPBodyStream，之后无论是否压缩请求体都改为HTTPBody，规则同上
+/// @param request 请求
+/// @param encoding 压缩方式
+/// @param threshold 压缩阈值（字节）
+/// @return 是否压缩
+/// @note 会把整个请求体读入内存，只用于数据本身已在内存中的请求
++ (BOOL)compressStreamedBodyOfRequest:(NSMutableURLRequest *)request
+                             encoding:(APIContentEncoding)encoding
+                            threshold:(NSUInteger)threshold;
+
+@end
+
+NS_ASSUME_NONNULL_END
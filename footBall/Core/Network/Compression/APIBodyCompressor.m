@@ -0,0 +1,147 @@
+//
+//  APIBodyCompressor.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIBodyCompressor.h"
+#import <zlib.h>
+
+NSString *const APIUncompressedBodyLengthPropertyKey = @"APIUncompressedBodyLength";
+
+/// 每次deflate输出的块大小
+static const NSUInteger kAPIBodyCompressorChunkSize = 16 * 1024;
+
+@implementation APIBodyCompressor
+
+#pragma mark - Public Methods
+
++ (nullable NSData *)compressData:(NSData *)data encoding:(APIContentEncoding)encoding {
+    if (encoding == APIContentEncodingNone || data.length == 0 || data.length > UINT_MAX) {
+        return nil;
+    }
+    
+    // windowBits：15为zlib格式（HTTP的deflate），加16为gzip格式
+    int windowBits = (encoding == APIContentEncodingGzip) ? 15 + 16 : 15;
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return nil;
+    }
+    
+    stream.next_in = (Bytef *)data.bytes;
+    stream.avail_in = (uInt)data.length;
+    
+    NSMutableData *compressedData = [NSMutableData dataWithLength:MIN(deflateBound(&stream, (uLong)data.length), data.length + kAPIBodyCompressorChunkSize)];
+    int status = Z_OK;
+    while (status == Z_OK) {
+        if (stream.total_out >= compressedData.length) {
+            [compressedData increaseLengthBy:kAPIBodyCompressorChunkSize];
+        }
+        stream.next_out = (Bytef *)compressedData.mutableBytes + stream.total_out;
+        stream.avail_out = (uInt)(compressedData.length - stream.total_out);
+        status = deflate(&stream, Z_FINISH);
+    }
+    deflateEnd(&stream);
+    
+    if (status != Z_STREAM_END) {
+        return nil;
+    }
+    compressedData.length = stream.total_out;
+    return compressedData;
+}
+
++ (nullable NSString *)headerValueForEncoding:(APIContentEncoding)encoding {
+    switch (encoding) {
+        case APIContentEncodingNone:
+            return nil;
+        case APIContentEncodingGzip:
+            return @"gzip";
+        case APIContentEncodingDeflate:
+            return @"deflate";
+    }
+}
+
++ (BOOL)isCompressibleMIMEType:(nullable NSString *)MIMEType {
+    NSString *type = MIMEType.lowercaseString;
+    if (type.length == 0) {
+        return YES;
+    }
+    
+    // SVG是文本格式，可以压缩
+    if ([type hasPrefix:@"image/svg"]) {
+        return YES;
+    }
+    
+    for (NSString *prefix in @[@"image/", @"video/", @"audio/"]) {
+        if ([type hasPrefix:prefix]) {
+            return NO;
+        }
+    }
+    
+    NSSet<NSString *> *compressedTypes = [NSSet setWithObjects:
+                                          @"application/zip",
+                                          @"application/gzip",
+                                          @"application/x-gzip",
+                                          @"application/x-7z-compressed",
+                                          @"application/x-rar-compressed",
+                                          @"application/pdf",
+                                          nil];
+    return ![compressedTypes containsObject:type];
+}
+
++ (BOOL)compressBodyOfRequest:(NSMutableURLRequest *)request
+                     encoding:(APIContentEncoding)encoding
+                    threshold:(NSUInteger)threshold {
+    NSData *body = request.HTTPBody;
+    if (encoding == APIContentEncodingNone || body.length == 0 || body.length < threshold) {
+        return NO;
+    }
+    
+    // 调用方已经编码过的请求体不再压缩
+    if ([request valueForHTTPHeaderField:@"Content-Encoding"].length > 0) {
+        return NO;
+    }
+    
+    NSData *compressedBody = [self compressData:body encoding:encoding];
+    if (!compressedBody || compressedBody.length >= body.length) {
+        return NO;
+    }
+    
+    request.HTTPBody = compressedBody;
+    [request setValue:[self headerValueForEncoding:encoding] forHTTPHeaderField:@"Content-Encoding"];
+    [request setValue:[NSString stringWithFormat:@"%lu", (unsigned long)compressedBody.length] forHTTPHeaderField:@"Content-Length"];
+    [NSURLProtocol setProperty:@(body.length) forKey:APIUncompressedBodyLengthPropertyKey inRequest:request];
+    return YES;
+}
+
++ (BOOL)compressStreamedBodyOfRequest:(NSMutableURLRequest *)request
+                             encoding:(APIContentEncoding)encoding
+                            threshold:(NSUInteger)threshold {
+    NSInputStream *bodyStream = request.HTTPBodyStream;
+    long long contentLength = [request valueForHTTPHeaderField:@"Content-Length"].longLongValue;
+    if (encoding == APIContentEncodingNone || !bodyStream || contentLength <= 0 || contentLength < (long long)threshold) {
+        return NO;
+    }
+    
+    NSMutableData *body = [NSMutableData dataWithCapacity:(NSUInteger)contentLength];
+    uint8_t buffer[16 * 1024];
+    NSInteger length = 0;
+    [bodyStream open];
+    while ((length = [bodyStream read:buffer maxLength:sizeof(buffer)]) > 0) {
+        [body appendBytes:buffer length:(NSUInteger)length];
+    }
+    [bodyStream close];
+    if (length < 0) {
+        NSLog(@"⚠️ 读取请求体失败，不压缩: %@", bodyStream.streamError.localizedDescription);
+        return NO;
+    }
+    
+    // 流已经读完，不能再交给NSURLSession
+    request.HTTPBodyStream = nil;
+    request.HTTPBody = body;
+    return [self compressBodyOfRequest:request encoding:encoding threshold:threshold];
+}
+
+@end
@@ -0,0 +1,64 @@
+//
+//  APICompressionStatistics.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 单个路径名称的压缩统计
+@interface APICompressionStatisticsEntry : NSObject <NSCopying>
+
+/// 路径名称（未注册的路径为URL路径）
+@property (nonatomic, copy, readonly) NSString *pathName;
+
+/// 请求次数
+@property (nonatomic, assign, readonly) NSUInteger requestCount;
+
+/// 请求体压缩前字节数
+@property (nonatomic, assign, readonly) int64_t requestRawBytes;
+
+/// 请求体实际发送字节数
+@property (nonatomic, assign, readonly) int64_t requestEncodedBytes;
+
+/// 响应体解压后字节数
+@property (nonatomic, assign, readonly) int64_t responseRawBytes;
+
+/// 响应体实际接收字节数
+@property (nonatomic, assign, readonly) int64_t responseEncodedBytes;
+
+/// 蜂窝网络下节省的字节数（请求+响应）
+@property (nonatomic, assign, readonly) int64_t cellularSavedBytes;
+
+/// 响应Content-Encoding次数（如：br、gzip、identity）
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, NSNumber *> *responseEncodingCounts;
+
+/// 节省的字节数（请求+响应）
+- (int64_t)savedBytes;
+
+@end
+
+/// 压缩统计 - 按路径名称记录请求/响应体的原始字节数和实际传输字节数
+/// 数据来自NSURLSessionTaskMetrics，响应压缩由NSURLSession自动协商（Accept-Encoding: br, gzip, deflate）并解压
+@interface APICompressionStatistics : NSObject
+
+/// 单例
++ (instancetype)sharedStatistics;
+
+/// 记录一次请求的传输指标
+/// @param metrics 任务指标
+/// @param task 任务
+- (void)recordMetrics:(NSURLSessionTaskMetrics *)metrics forTask:(NSURLSessionTask *)task;
+
+/// 所有路径的统计（按节省字节数降序）
+- (NSArray<APICompressionStatisticsEntry *> *)allEntries;
+
+/// 清空统计
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
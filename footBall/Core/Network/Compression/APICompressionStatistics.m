@@ -0,0 +1,169 @@
+//
+//  APICompressionStatistics.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APICompressionStatistics.h"
+#import "APIBodyCompressor.h"
+#import "APIPathConfig.h"
+
+@interface APICompressionStatisticsEntry ()
+
+@property (nonatomic, copy) NSString *pathName;
+@property (nonatomic, assign) NSUInteger requestCount;
+@property (nonatomic, assign) int64_t requestRawBytes;
+@property (nonatomic, assign) int64_t requestEncodedBytes;
+@property (nonatomic, assign) int64_t responseRawBytes;
+@property (nonatomic, assign) int64_t responseEncodedBytes;
+@property (nonatomic, assign) int64_t cellularSavedBytes;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *mutableResponseEncodingCounts;
+
+@end
+
+@implementation APICompressionStatisticsEntry
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _mutableResponseEncodingCounts = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)responseEncodingCounts {
+    return [self.mutableResponseEncodingCounts copy];
+}
+
+- (int64_t)savedBytes {
+    return (self.requestRawBytes - self.requestEncodedBytes) + (self.responseRawBytes - self.responseEncodedBytes);
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    APICompressionStatisticsEntry *entry = [[APICompressionStatisticsEntry allocWithZone:zone] init];
+    entry.pathName = self.pathName;
+    entry.requestCount = self.requestCount;
+    entry.requestRawBytes = self.requestRawBytes;
+    entry.requestEncodedBytes = self.requestEncodedBytes;
+    entry.responseRawBytes = self.responseRawBytes;
+    entry.responseEncodedBytes = self.responseEncodedBytes;
+    entry.cellularSavedBytes = self.cellularSavedBytes;
+    entry.mutableResponseEncodingCounts = [self.mutableResponseEncodingCounts mutableCopy];
+    return entry;
+}
+
+@end
+
+@interface APICompressionStatistics ()
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, APICompressionStatisticsEntry *> *entries; // 路径名称 -> 统计
+
+@end
+
+@implementation APICompressionStatistics
+
++ (instancetype)sharedStatistics {
+    static APICompressionStatistics *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[APICompressionStatistics alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _entries = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark - Public Methods
+
+- (void)recordMetrics:(NSURLSessionTaskMetrics *)metrics forTask:(NSURLSessionTask *)task {
+    int64_t requestEncodedBytes = 0;
+    int64_t responseRawBytes = 0;
+    int64_t responseEncodedBytes = 0;
+    BOOL cellular = NO;
+    BOOL loadedFromNetwork = NO;
+    NSString *responseEncoding = nil;
+    
+    // 只统计实际走网络的传输（本地缓存命中的不产生流量）
+    for (NSURLSessionTaskTransactionMetrics *transaction in metrics.transactionMetrics) {
+        if (transaction.resourceFetchType != NSURLSessionTaskMetricsResourceFetchTypeNetworkLoad) {
+            continue;
+        }
+        loadedFromNetwork = YES;
+        requestEncodedBytes += transaction.countOfRequestBodyBytesSent;
+        responseEncodedBytes += transaction.countOfResponseBodyBytesReceived;
+        responseRawBytes += transaction.countOfResponseBodyBytesAfterDecoding;
+        cellular = cellular || transaction.isCellular;
+        
+        if ([transaction.response isKindOfClass:[NSHTTPURLResponse class]]) {
+            responseEncoding = [(NSHTTPURLResponse *)transaction.response valueForHTTPHeaderField:@"Content-Encoding"];
+        }
+    }
+    if (!loadedFromNetwork) {
+        return;
+    }
+    
+    // 请求体由APIBodyCompressor压缩时记录了压缩前的字节数，否则原始字节数即发送字节数
+    NSURLRequest *request = task.originalRequest;
+    NSNumber *uncompressedLength = [NSURLProtocol propertyForKey:APIUncompressedBodyLengthPropertyKey inRequest:request];
+    int64_t requestRawBytes = requestEncodedBytes;
+    if (uncompressedLength && requestEncodedBytes > 0) {
+        requestRawBytes = uncompressedLength.longLongValue;
+    }
+    
+    NSString *pathName = [[APIPathConfigManager sharedManager] pathConfigForURL:request.URL].name;
+    if (pathName.length == 0) {
+        pathName = request.URL.path.length > 0 ? request.URL.path : @"/";
+    }
+    NSString *encodingKey = responseEncoding.length > 0 ? responseEncoding.lowercaseString : @"identity";
+    
+    @synchronized (self) {
+        APICompressionStatisticsEntry *entry = self.entries[pathName];
+        if (!entry) {
+            entry = [[APICompressionStatisticsEntry alloc] init];
+            entry.pathName = pathName;
+            self.entries[pathName] = entry;
+        }
+        
+        entry.requestCount++;
+        entry.requestRawBytes += requestRawBytes;
+        entry.requestEncodedBytes += requestEncodedBytes;
+        entry.responseRawBytes += responseRawBytes;
+        entry.responseEncodedBytes += responseEncodedBytes;
+        if (cellular) {
+            entry.cellularSavedBytes += (requestRawBytes - requestEncodedBytes) + (responseRawBytes - responseEncodedBytes);
+        }
+        entry.mutableResponseEncodingCounts[encodingKey] = @(entry.mutableResponseEncodingCounts[encodingKey].unsignedIntegerValue + 1);
+    }
+}
+
+- (NSArray<APICompressionStatisticsEntry *> *)allEntries {
+    NSMutableArray<APICompressionStatisticsEntry *> *entries = [NSMutableArray array];
+    @synchronized (self) {
+        for (APICompressionStatisticsEntry *entry in self.entries.allValues) {
+            [entries addObject:[entry copy]];
+        }
+    }
+    
+    [entries sortUsingComparator:^NSComparisonResult(APICompressionStatisticsEntry *obj1, APICompressionStatisticsEntry *obj2) {
+        if (obj1.savedBytes == obj2.savedBytes) {
+            return [obj1.pathName compare:obj2.pathName];
+        }
+        return obj1.savedBytes > obj2.savedBytes ? NSOrderedAscending : NSOrderedDescending;
+    }];
+    return entries;
+}
+
+- (void)reset {
+    @synchronized (self) {
+        [self.entries removeAllObjects];
+    }
+}
+
+@end
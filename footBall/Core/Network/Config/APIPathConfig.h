@@ -6,9 +6,13 @@
 //
 
 #import <Foundation/Foundation.h>
+#import "APICircuitBreaker.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
+/// 路径配置变化通知（注册、移除或清空后发送，object为APIPathConfigManager）
+FOUNDATION_EXPORT NSString *const APIPathConfigDidChangeNotification;
+
 /// API路径配置模型
 @interface APIPathConfig : NSObject
 
@@ -16,11 +20,18 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong) NSString *name;
 
 /// 路径值（如：@"/api/v1/user"、@"/api/v1/auth"）
+/// 支持路径参数模板（如：@"/api/v1/user/{id:int}/matches"，类型可选 int/string，默认string），参数通过 APIRequestOptions.pathParameters 传入
 @property (nonatomic, strong) NSString *path;
 
 /// 路径描述（可选）
 @property (nonatomic, strong, nullable) NSString *pathDescription;
 
+/// 是否对该路径的GET请求启用对冲（默认：NO，只用于幂等的GET接口），详见 APIManager.hedgingPercentile
+@property (nonatomic, assign) BOOL hedgingEnabled;
+
+/// 该路径的熔断器（按路径名称独立统计）
+@property (nonatomic, strong, readonly) APICircuitBreaker *circuitBreaker;
+
 /// 初始化方法
 /// @param name 路径名称
 /// @param path 路径值
@@ -35,6 +46,7 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 /// API路径配置管理器 - 统一管理所有API路径
+/// 可以在任意线程读取；注册、移除整体替换内部的不可变快照，进行中的读取继续使用旧快照
 @interface APIPathConfigManager : NSObject
 
 /// 单例
@@ -47,6 +59,14 @@ NS_ASSUME_NONNULL_BEGIN
 /// 获取所有路径配置
 - (NSDictionary<NSString *, APIPathConfig *> *)allPathConfigs;
 
+/// 根据请求URL匹配路径配置（取路径值最长的匹配项，如 /api/v1/user/list 匹配 user_list 而不是 user；模板中的参数匹配任意一个路径段）
+/// @param URL 请求URL
+- (nullable APIPathConfig *)pathConfigForURL:(NSURL *)URL;
+
+/// 获取指定路径名称的熔断器
+/// @param pathName 路径名称
+- (nullable APICircuitBreaker *)circuitBreakerForPathName:(NSString *)pathName;
+
 /// 注册路径配置
 /// @param pathConfig 路径配置
 - (void)registerPathConfig:(APIPathConfig *)pathConfig;
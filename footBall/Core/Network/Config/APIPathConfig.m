@@ -8,9 +8,14 @@
 #import "APIPathConfig.h"
 #import "APIPathNames.h"
 #import "APIPathValues.h"
+#import "APIEnvironmentManager.h"
+
+NSString *const APIPathConfigDidChangeNotification = @"APIPathConfigDidChangeNotification";
 
 @implementation APIPathConfig
 
+@synthesize circuitBreaker = _circuitBreaker;
+
 + (instancetype)configWithName:(NSString *)name path:(NSString *)path {
     return [self configWithName:name path:path description:nil];
 }
@@ -23,11 +28,21 @@
     return config;
 }
 
+- (APICircuitBreaker *)circuitBreaker {
+    @synchronized (self) {
+        if (!_circuitBreaker) {
+            _circuitBreaker = [[APICircuitBreaker alloc] initWithName:self.name ?: @""];
+        }
+        return _circuitBreaker;
+    }
+}
+
 @end
 
 @interface APIPathConfigManager ()
 
-@property (nonatomic, strong) NSMutableDictionary<NSString *, APIPathConfig *> *pathConfigs;
+/// 路径配置（不可变快照：修改时在锁内整体替换，读取时在锁内取出后无锁使用，后台队列上的匹配不受注册/移除影响）
+@property (nonatomic, copy) NSDictionary<NSString *, APIPathConfig *> *pathConfigs;
 
 @end
 
@@ -45,7 +60,7 @@
 - (instancetype)init {
     self = [super init];
     if (self) {
-        _pathConfigs = [NSMutableDictionary dictionary];
+        _pathConfigs = @{};
         
         // 加载默认路径配置
         [self loadDefaultPathConfigs];
@@ -60,7 +75,9 @@
     // 用户模块
     [self registerPathWithName:APIPathNameUser path:APIPathValueUser description:@"用户相关接口"];
     [self registerPathWithName:APIPathNameUserProfile path:APIPathValueUserProfile description:@"用户资料"];
-    [self registerPathWithName:APIPathNameUserList path:APIPathValueUserList description:@"用户列表"];
+    APIPathConfig *userListConfig = [APIPathConfig configWithName:APIPathNameUserList path:APIPathValueUserList description:@"用户列表"];
+    userListConfig.hedgingEnabled = YES; // 列表GET接口幂等，开启对冲降低长尾延迟
+    [self registerPathConfig:userListConfig];
     
     // 认证模块
     [self registerPathWithName:APIPathNameAuth path:APIPathValueAuth description:@"认证相关接口"];
@@ -70,8 +87,12 @@
     
     // 文件模块
     [self registerPathWithName:APIPathNameUpload path:APIPathValueUpload description:@"文件上传"];
+    [self registerPathWithName:APIPathNameUploadChunked path:APIPathValueUploadChunked description:@"分片上传"];
     [self registerPathWithName:APIPathNameDownload path:APIPathValueDownload description:@"文件下载"];
     
+    // 批量请求
+    [self registerPathWithName:APIPathNameBatch path:APIPathValueBatch description:@"服务端批量接口"];
+    
     // 其他模块可以根据需要添加
     // 在 APIPathNames.h/m 中添加路径名称常量
     // 在 APIPathValues.h/m 中添加路径值常量
@@ -84,7 +105,7 @@
         return @"";
     }
     
-    APIPathConfig *config = self.pathConfigs[pathName];
+    APIPathConfig *config = [self pathConfigsSnapshot][pathName];
     if (!config) {
         NSLog(@"⚠️ 未找到路径名称: %@", pathName);
         return @"";
@@ -94,7 +115,20 @@
 }
 
 - (NSDictionary<NSString *, APIPathConfig *> *)allPathConfigs {
-    return [self.pathConfigs copy];
+    return [self pathConfigsSnapshot];
+}
+
+- (nullable APIPathConfig *)pathConfigForURL:(NSURL *)URL {
+    // 路由表按路径建有索引（环境或路径配置变化时重新编译）
+    NSString *pathName = [[APIEnvironmentManager sharedManager].routeTable pathNameForURL:URL];
+    return pathName ? [self pathConfigsSnapshot][pathName] : nil;
+}
+
+- (nullable APICircuitBreaker *)circuitBreakerForPathName:(NSString *)pathName {
+    if (!pathName || pathName.length == 0) {
+        return nil;
+    }
+    return [self pathConfigsSnapshot][pathName].circuitBreaker;
 }
 
 - (void)registerPathConfig:(APIPathConfig *)pathConfig {
@@ -103,8 +137,13 @@
         return;
     }
     
-    self.pathConfigs[pathConfig.name] = pathConfig;
+    @synchronized (self) {
+        NSMutableDictionary *pathConfigs = [self.pathConfigs mutableCopy];
+        pathConfigs[pathConfig.name] = pathConfig;
+        self.pathConfigs = pathConfigs;
+    }
     NSLog(@"✅ 已注册路径: %@ -> %@", pathConfig.name, pathConfig.path);
+    [[NSNotificationCenter defaultCenter] postNotificationName:APIPathConfigDidChangeNotification object:self];
 }
 
 - (void)registerPathWithName:(NSString *)name path:(NSString *)path {
@@ -122,13 +161,30 @@
         return;
     }
     
-    [self.pathConfigs removeObjectForKey:pathName];
+    @synchronized (self) {
+        NSMutableDictionary *pathConfigs = [self.pathConfigs mutableCopy];
+        [pathConfigs removeObjectForKey:pathName];
+        self.pathConfigs = pathConfigs;
+    }
     NSLog(@"✅ 已移除路径: %@", pathName);
+    [[NSNotificationCenter defaultCenter] postNotificationName:APIPathConfigDidChangeNotification object:self];
 }
 
 - (void)clearAllPathConfigs {
-    [self.pathConfigs removeAllObjects];
+    @synchronized (self) {
+        self.pathConfigs = @{};
+    }
     NSLog(@"✅ 已清空所有路径配置");
+    [[NSNotificationCenter defaultCenter] postNotificationName:APIPathConfigDidChangeNotification object:self];
+}
+
+#pragma mark - Private Methods
+
+/// 当前路径配置的不可变快照
+- (NSDictionary<NSString *, APIPathConfig *> *)pathConfigsSnapshot {
+    @synchronized (self) {
+        return self.pathConfigs;
+    }
 }
 
 @end
@@ -33,9 +33,15 @@ FOUNDATION_EXPORT NSString * const APIPathNameAuthRefresh;
 #pragma mark - 文件模块
 /// 文件上传
 FOUNDATION_EXPORT NSString * const APIPathNameUpload;
+/// 分片上传（详见 APIChunkedUploader）
+FOUNDATION_EXPORT NSString * const APIPathNameUploadChunked;
 /// 文件下载
 FOUNDATION_EXPORT NSString * const APIPathNameDownload;
 
+#pragma mark - 批量请求
+/// 服务端批量接口（详见 APIManager batchGETWithItems:）
+FOUNDATION_EXPORT NSString * const APIPathNameBatch;
+
 @end
 
 NS_ASSUME_NONNULL_END
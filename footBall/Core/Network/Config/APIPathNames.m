@@ -20,4 +20,8 @@ NSString * const APIPathNameAuthRefresh = @"auth_refresh";
 
 #pragma mark - 文件模块
 NSString * const APIPathNameUpload = @"upload";
+NSString * const APIPathNameUploadChunked = @"upload_chunked";
 NSString * const APIPathNameDownload = @"download";
+
+#pragma mark - 批量请求
+NSString * const APIPathNameBatch = @"batch";
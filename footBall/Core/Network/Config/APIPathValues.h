@@ -33,9 +33,15 @@ FOUNDATION_EXPORT NSString * const APIPathValueAuthRefresh;
 #pragma mark - 文件模块
 /// 文件上传路径
 FOUNDATION_EXPORT NSString * const APIPathValueUpload;
+/// 分片上传路径
+FOUNDATION_EXPORT NSString * const APIPathValueUploadChunked;
 /// 文件下载路径
 FOUNDATION_EXPORT NSString * const APIPathValueDownload;
 
+#pragma mark - 批量请求
+/// 服务端批量接口路径
+FOUNDATION_EXPORT NSString * const APIPathValueBatch;
+
 @end
 
 NS_ASSUME_NONNULL_END
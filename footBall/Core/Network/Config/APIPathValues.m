@@ -20,4 +20,8 @@ NSString * const APIPathValueAuthRefresh = @"/api/v1/auth/refresh";
 
 #pragma mark - 文件模块
 NSString * const APIPathValueUpload = @"/api/v1/upload";
+NSString * const APIPathValueUploadChunked = @"/api/v1/upload/chunked";
 NSString * const APIPathValueDownload = @"/api/v1/download";
+
+#pragma mark - 批量请求
+NSString * const APIPathValueBatch = @"/api/v1/batch";
@@ -0,0 +1,95 @@
+//
+//  APIRouteTable.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import "APIPathConfig.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 路由错误域
+FOUNDATION_EXPORT NSErrorDomain const APIRouteErrorDomain;
+
+/// 路由错误码
+typedef NS_ENUM(NSInteger, APIRouteErrorCode) {
+    APIRouteErrorCodeUnknownPathName = 1,  // 未注册的路径名称
+    APIRouteErrorCodeMissingParameter,     // 缺少路径参数
+    APIRouteErrorCodeInvalidParameter      // 路径参数类型不匹配
+};
+
+/// 路径参数类型
+typedef NS_ENUM(NSInteger, APIRouteParameterType) {
+    APIRouteParameterTypeString = 0, // {name} 或 {name:string}，按路径段转义
+    APIRouteParameterTypeInteger     // {name:int}，NSNumber或纯数字字符串
+};
+
+/// 编译后的路由 - 路径模板（如 /api/v1/user/{id:int}/matches）拆分为字面量和参数，
+/// 第一个参数之前的部分已经和Base URL拼好（没有参数时就是完整的绝对地址）
+@interface APIRoute : NSObject
+
+/// 路径名称
+@property (nonatomic, copy, readonly) NSString *pathName;
+
+/// 路径模板（路径配置中的路径值）
+@property (nonatomic, copy, readonly) NSString *pathTemplate;
+
+/// 拼好Base URL的地址前缀（到第一个参数为止）
+@property (nonatomic, copy, readonly) NSString *absoluteURLPrefix;
+
+/// 参数名称（按出现顺序）
+@property (nonatomic, copy, readonly) NSArray<NSString *> *parameterNames;
+
+/// 构建完整地址
+/// 没有参数和子路径时直接返回缓存的地址，不产生新的字符串
+/// @param pathParameters 路径参数（参数名 -> 值）
+/// @param subPath 子路径（可选，自动补全开头的/）
+/// @param error 参数缺失或类型不匹配时的错误
+- (nullable NSString *)URLStringWithPathParameters:(nullable NSDictionary<NSString *, id> *)pathParameters
+                                           subPath:(nullable NSString *)subPath
+                                             error:(NSError **)error;
+
+@end
+
+/// 路由表 - 一个环境下所有路径名称编译后的路由（不可变，环境或路径配置变化时整体替换）
+@interface APIRouteTable : NSObject
+
+/// 编译时的Base URL（已去掉结尾的/）
+@property (nonatomic, copy, readonly) NSString *baseURL;
+
+/// 编译路由表
+/// @param baseURL Base URL
+/// @param pathConfigs 路径配置（路径名称 -> 配置）
+- (instancetype)initWithBaseURL:(NSString *)baseURL
+                    pathConfigs:(NSDictionary<NSString *, APIPathConfig *> *)pathConfigs NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// 路径名称对应的路由
+/// @param pathName 路径名称
+- (nullable APIRoute *)routeForPathName:(NSString *)pathName;
+
+/// 构建路径名称的完整地址
+/// @param pathName 路径名称
+/// @param subPath 子路径（可选）
+/// @param pathParameters 路径参数（可选）
+/// @param error 路径名称未注册、参数缺失或类型不匹配时的错误
+- (nullable NSString *)URLStringForPathName:(NSString *)pathName
+                                    subPath:(nullable NSString *)subPath
+                             pathParameters:(nullable NSDictionary<NSString *, id> *)pathParameters
+                                      error:(NSError **)error;
+
+/// 根据请求URL查找路径名称（取路径值最长的匹配项，模板中的参数匹配任意一个路径段）
+/// 不带参数的路径按路径索引查找（从完整路径开始逐段去掉结尾，O(路径段数)），只有带参数的路由需要逐个匹配
+/// @param URL 请求URL（Base URL带有路径前缀时先去掉前缀）
+- (nullable NSString *)pathNameForURL:(NSURL *)URL;
+
+/// 相对路径拼接Base URL（已经是http/https开头的地址原样返回）
+/// @param URLString 相对路径（如 @"/api/v1/user" 或 @"api/v1/user"）
+- (NSString *)absoluteURLStringForURLString:(NSString *)URLString;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,293 @@
+//
+//  APIRouteTable.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIRouteTable.h"
+
+NSErrorDomain const APIRouteErrorDomain = @"APIRouteErrorDomain";
+
+static NSError *APIRouteError(APIRouteErrorCode code, NSString *message) {
+    return [NSError errorWithDomain:APIRouteErrorDomain code:code userInfo:@{NSLocalizedDescriptionKey: message}];
+}
+
+/// 路径参数允许的字符（路径段中不能出现 / ? #）
+static NSCharacterSet *APIRouteParameterAllowedCharacters(void) {
+    static NSCharacterSet *characters = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSMutableCharacterSet *set = [[NSCharacterSet URLPathAllowedCharacterSet] mutableCopy];
+        [set removeCharactersInString:@"/?#"];
+        characters = [set copy];
+    });
+    return characters;
+}
+
+#pragma mark - APIRoute
+
+@interface APIRoute ()
+
+@property (nonatomic, copy, readwrite) NSString *pathName;
+@property (nonatomic, copy, readwrite) NSString *pathTemplate;
+@property (nonatomic, copy, readwrite) NSString *absoluteURLPrefix;
+@property (nonatomic, copy, readwrite) NSArray<NSString *> *parameterNames;
+@property (nonatomic, copy) NSArray<NSNumber *> *parameterTypes; // APIRouteParameterType
+@property (nonatomic, copy) NSArray<NSString *> *trailingLiterals; // 每个参数之后的字面量
+@property (nonatomic, copy) NSString *normalizedPath; // 以/开头、不以/结尾的路径模板（路径索引的键）
+@property (nonatomic, strong, nullable) NSRegularExpression *pathExpression; // 带参数时匹配请求路径的正则（参数匹配一个路径段）
+
+@end
+
+@implementation APIRoute
+
+/// 编译路径模板
+/// @param baseURL 已去掉结尾/的Base URL
+- (instancetype)initWithPathName:(NSString *)pathName pathTemplate:(NSString *)pathTemplate baseURL:(NSString *)baseURL {
+    self = [super init];
+    if (self) {
+        _pathName = [pathName copy];
+        _pathTemplate = [pathTemplate copy];
+        
+        NSString *path = [pathTemplate hasPrefix:@"/"] ? pathTemplate : [@"/" stringByAppendingString:pathTemplate];
+        NSMutableArray<NSString *> *literals = [NSMutableArray array];
+        NSMutableArray<NSString *> *names = [NSMutableArray array];
+        NSMutableArray<NSNumber *> *types = [NSMutableArray array];
+        NSUInteger location = 0;
+        while (location < path.length) {
+            NSRange openRange = [path rangeOfString:@"{" options:0 range:NSMakeRange(location, path.length - location)];
+            if (openRange.location == NSNotFound) {
+                break;
+            }
+            NSRange closeRange = [path rangeOfString:@"}" options:0 range:NSMakeRange(openRange.location, path.length - openRange.location)];
+            if (closeRange.location == NSNotFound) {
+                NSLog(@"⚠️ 路径模板缺少}，按字面量处理: %@", pathTemplate);
+                break;
+            }
+            
+            // {name} 或 {name:type}
+            NSString *placeholder = [path substringWithRange:NSMakeRange(NSMaxRange(openRange), closeRange.location - NSMaxRange(openRange))];
+            NSRange separatorRange = [placeholder rangeOfString:@":"];
+            NSString *name = separatorRange.location == NSNotFound ? placeholder : [placeholder substringToIndex:separatorRange.location];
+            NSString *type = separatorRange.location == NSNotFound ? nil : [placeholder substringFromIndex:NSMaxRange(separatorRange)];
+            
+            [literals addObject:[path substringWithRange:NSMakeRange(location, openRange.location - location)]];
+            [names addObject:name];
+            [types addObject:@([type isEqualToString:@"int"] ? APIRouteParameterTypeInteger : APIRouteParameterTypeString)];
+            location = NSMaxRange(closeRange);
+        }
+        [literals addObject:[path substringFromIndex:location]];
+        
+        _absoluteURLPrefix = [baseURL stringByAppendingString:literals.firstObject];
+        _trailingLiterals = [literals subarrayWithRange:NSMakeRange(1, literals.count - 1)];
+        _parameterNames = [names copy];
+        _parameterTypes = [types copy];
+        _normalizedPath = path.length > 1 && [path hasSuffix:@"/"] ? [path substringToIndex:path.length - 1] : path;
+        
+        // 字面量原样匹配，参数匹配一个路径段，结尾需要是路径段边界
+        if (names.count > 0) {
+            NSMutableString *pattern = [NSMutableString stringWithString:@"^"];
+            [literals enumerateObjectsUsingBlock:^(NSString *literal, NSUInteger idx, BOOL *stop) {
+                if (idx > 0) {
+                    [pattern appendString:@"[^/]+"];
+                }
+                [pattern appendString:[NSRegularExpression escapedPatternForString:literal]];
+            }];
+            if ([pattern hasSuffix:@"/"]) {
+                [pattern deleteCharactersInRange:NSMakeRange(pattern.length - 1, 1)];
+            }
+            [pattern appendString:@"(?=/|$)"];
+            _pathExpression = [NSRegularExpression regularExpressionWithPattern:pattern options:0 error:nil];
+        }
+    }
+    return self;
+}
+
+- (nullable NSString *)URLStringWithPathParameters:(nullable NSDictionary<NSString *, id> *)pathParameters
+                                           subPath:(nullable NSString *)subPath
+                                             error:(NSError **)error {
+    if (self.parameterNames.count == 0 && subPath.length == 0) {
+        return self.absoluteURLPrefix;
+    }
+    
+    NSMutableString *URLString = [NSMutableString stringWithCapacity:self.absoluteURLPrefix.length + self.pathTemplate.length + subPath.length + 1];
+    [URLString appendString:self.absoluteURLPrefix];
+    for (NSUInteger index = 0; index < self.parameterNames.count; index++) {
+        NSString *name = self.parameterNames[index];
+        NSString *value = [self stringForParameter:pathParameters[name]
+                                              name:name
+                                              type:self.parameterTypes[index].integerValue
+                                             error:error];
+        if (!value) {
+            return nil;
+        }
+        [URLString appendString:value];
+        [URLString appendString:self.trailingLiterals[index]];
+    }
+    
+    if (subPath.length > 0) {
+        if (![subPath hasPrefix:@"/"]) {
+            [URLString appendString:@"/"];
+        }
+        [URLString appendString:subPath];
+    }
+    return URLString;
+}
+
+#pragma mark - Private Methods
+
+/// 参数值转为路径段（按类型校验并转义）
+- (nullable NSString *)stringForParameter:(nullable id)value
+                                     name:(NSString *)name
+                                     type:(APIRouteParameterType)type
+                                    error:(NSError **)error {
+    if (!value || value == [NSNull null]) {
+        if (error) {
+            *error = APIRouteError(APIRouteErrorCodeMissingParameter, [NSString stringWithFormat:@"路径[%@]缺少参数: %@", self.pathName, name]);
+        }
+        return nil;
+    }
+    
+    NSString *string = nil;
+    if (type == APIRouteParameterTypeInteger) {
+        if ([value isKindOfClass:[NSNumber class]] && !CFNumberIsFloatType((__bridge CFNumberRef)value)) {
+            string = [value stringValue];
+        } else if ([value isKindOfClass:[NSString class]] && [value length] > 0 &&
+                   [[value stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"0123456789"]] length] == 0) {
+            string = value;
+        }
+    } else if ([value isKindOfClass:[NSString class]]) {
+        string = [value stringByAddingPercentEncodingWithAllowedCharacters:APIRouteParameterAllowedCharacters()];
+    } else if ([value isKindOfClass:[NSNumber class]]) {
+        string = [value stringValue];
+    }
+    
+    if (string.length == 0) {
+        if (error) {
+            *error = APIRouteError(APIRouteErrorCodeInvalidParameter, [NSString stringWithFormat:@"路径[%@]的参数%@类型不匹配: %@", self.pathName, name, value]);
+        }
+        return nil;
+    }
+    return string;
+}
+
+@end
+
+#pragma mark - APIRouteTable
+
+@interface APIRouteTable ()
+
+@property (nonatomic, copy, readwrite) NSString *baseURL;
+@property (nonatomic, copy) NSDictionary<NSString *, APIRoute *> *routes; // 路径名称 -> 路由
+@property (nonatomic, copy) NSString *basePath; // Base URL的路径前缀（如 /gateway），没有时为空字符串
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *pathNamesByPath; // 不带参数的路径 -> 路径名称
+@property (nonatomic, copy) NSArray<APIRoute *> *templateRoutes; // 带参数的路由（路径模板从长到短）
+
+@end
+
+@implementation APIRouteTable
+
+- (instancetype)initWithBaseURL:(NSString *)baseURL pathConfigs:(NSDictionary<NSString *, APIPathConfig *> *)pathConfigs {
+    self = [super init];
+    if (self) {
+        _baseURL = [baseURL hasSuffix:@"/"] ? [baseURL substringToIndex:baseURL.length - 1] : [baseURL copy];
+        
+        NSString *basePath = [NSURL URLWithString:_baseURL].path ?: @"";
+        _basePath = [basePath isEqualToString:@"/"] ? @"" : basePath;
+        
+        NSMutableDictionary<NSString *, APIRoute *> *routes = [NSMutableDictionary dictionaryWithCapacity:pathConfigs.count];
+        NSMutableDictionary<NSString *, NSString *> *pathNamesByPath = [NSMutableDictionary dictionaryWithCapacity:pathConfigs.count];
+        NSMutableArray<APIRoute *> *templateRoutes = [NSMutableArray array];
+        [pathConfigs enumerateKeysAndObjectsUsingBlock:^(NSString *pathName, APIPathConfig *config, BOOL *stop) {
+            if (config.path.length == 0) {
+                return;
+            }
+            APIRoute *route = [[APIRoute alloc] initWithPathName:pathName pathTemplate:config.path baseURL:self->_baseURL];
+            routes[pathName] = route;
+            if (route.pathExpression) {
+                [templateRoutes addObject:route];
+            } else if (!pathNamesByPath[route.normalizedPath]) {
+                pathNamesByPath[route.normalizedPath] = pathName;
+            }
+        }];
+        [templateRoutes sortUsingComparator:^NSComparisonResult(APIRoute *route1, APIRoute *route2) {
+            return route1.normalizedPath.length > route2.normalizedPath.length ? NSOrderedAscending
+                : (route1.normalizedPath.length < route2.normalizedPath.length ? NSOrderedDescending : NSOrderedSame);
+        }];
+        _routes = [routes copy];
+        _pathNamesByPath = [pathNamesByPath copy];
+        _templateRoutes = [templateRoutes copy];
+    }
+    return self;
+}
+
+- (nullable APIRoute *)routeForPathName:(NSString *)pathName {
+    return self.routes[pathName];
+}
+
+- (nullable NSString *)URLStringForPathName:(NSString *)pathName
+                                    subPath:(nullable NSString *)subPath
+                             pathParameters:(nullable NSDictionary<NSString *, id> *)pathParameters
+                                      error:(NSError **)error {
+    APIRoute *route = pathName.length > 0 ? self.routes[pathName] : nil;
+    if (!route) {
+        if (error) {
+            *error = APIRouteError(APIRouteErrorCodeUnknownPathName, [NSString stringWithFormat:@"未找到路径名称: %@", pathName]);
+        }
+        return nil;
+    }
+    return [route URLStringWithPathParameters:pathParameters subPath:subPath error:error];
+}
+
+- (nullable NSString *)pathNameForURL:(NSURL *)URL {
+    NSString *requestPath = URL.path;
+    if (requestPath.length == 0) {
+        return nil;
+    }
+    if (self.basePath.length > 0 && [requestPath hasPrefix:self.basePath] &&
+        (requestPath.length == self.basePath.length || [requestPath characterAtIndex:self.basePath.length] == '/')) {
+        requestPath = [requestPath substringFromIndex:self.basePath.length];
+    }
+    
+    // 不带参数的路径：从完整路径开始逐段去掉结尾，第一个命中的就是最长的匹配
+    NSString *matchedPathName = nil;
+    NSUInteger matchedLength = 0;
+    NSString *candidate = requestPath;
+    while (candidate.length > 0) {
+        NSString *pathName = self.pathNamesByPath[candidate];
+        if (pathName) {
+            matchedPathName = pathName;
+            matchedLength = candidate.length;
+            break;
+        }
+        NSRange separatorRange = [candidate rangeOfString:@"/" options:NSBackwardsSearch];
+        if (separatorRange.location == NSNotFound || separatorRange.location == 0) {
+            break;
+        }
+        candidate = [candidate substringToIndex:separatorRange.location];
+    }
+    
+    // 带参数的路由：只有路径模板比已命中的路径更长时才可能是更长的匹配
+    for (APIRoute *route in self.templateRoutes) {
+        if (route.normalizedPath.length <= matchedLength) {
+            break;
+        }
+        if ([route.pathExpression firstMatchInString:requestPath options:0 range:NSMakeRange(0, requestPath.length)]) {
+            return route.pathName;
+        }
+    }
+    return matchedPathName;
+}
+
+- (NSString *)absoluteURLStringForURLString:(NSString *)URLString {
+    if ([URLString hasPrefix:@"http"] || self.baseURL.length == 0) {
+        return URLString;
+    }
+    if ([URLString hasPrefix:@"/"]) {
+        return [self.baseURL stringByAppendingString:URLString];
+    }
+    return [NSString stringWithFormat:@"%@/%@", self.baseURL, URLString];
+}
+
+@end
@@ -9,6 +9,9 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/// 服务器地址变化通知（object为APIServerConfigManager）
+FOUNDATION_EXPORT NSString *const APIServerConfigDidChangeNotification;
+
 /// API环境类型
 typedef NS_ENUM(NSInteger, APIEnvironment) {
     APIEnvironmentTest = 0,      // 测试环境
@@ -56,6 +59,24 @@ typedef NS_ENUM(NSInteger, APIEnvironment) {
 /// @param environment 环境类型
 - (void)setServerURL:(NSString *)serverURL forEnvironment:(APIEnvironment)environment;
 
+/// 获取指定环境的图片CDN地址（用于启动时预连接）
+/// @param environment 环境类型
+- (nullable NSString *)imageCDNURLForEnvironment:(APIEnvironment)environment;
+
+/// 设置图片CDN地址
+/// @param imageCDNURL 图片CDN地址
+/// @param environment 环境类型
+- (void)setImageCDNURL:(nullable NSString *)imageCDNURL forEnvironment:(APIEnvironment)environment;
+
+/// 指定环境的服务端是否部署了批量接口（APIPathNameBatch，默认：都不支持）
+/// @param environment 环境类型
+- (BOOL)supportsBatchRequestsForEnvironment:(APIEnvironment)environment;
+
+/// 设置指定环境的服务端是否部署了批量接口
+/// @param supportsBatchRequests 是否支持
+/// @param environment 环境类型
+- (void)setSupportsBatchRequests:(BOOL)supportsBatchRequests forEnvironment:(APIEnvironment)environment;
+
 #ifdef DEBUG
 /// 从 BVAPPEnvironmentHostManager 同步服务器地址（仅Debug模式）
 - (void)syncServerURLsFromEnvironmentHostManager;
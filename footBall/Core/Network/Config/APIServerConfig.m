@@ -7,6 +7,8 @@
 
 #import "APIServerConfig.h"
 
+NSString *const APIServerConfigDidChangeNotification = @"APIServerConfigDidChangeNotification";
+
 @implementation APIServerConfig
 
 + (instancetype)configWithEnvironment:(APIEnvironment)environment
@@ -24,6 +26,8 @@
 @interface APIServerConfigManager ()
 
 @property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSString *> *serverURLs;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSString *> *imageCDNURLs;
+@property (nonatomic, strong) NSMutableSet<NSNumber *> *batchEnvironments; // 部署了批量接口的环境
 
 /// 从 BVAPPEnvironmentHostManager 同步服务器地址（Debug模式下）
 - (void)syncServerURLsFromEnvironmentHostManager;
@@ -48,6 +52,8 @@
     self = [super init];
     if (self) {
         _serverURLs = [NSMutableDictionary dictionary];
+        _imageCDNURLs = [NSMutableDictionary dictionary];
+        _batchEnvironments = [NSMutableSet set];
         
         // 初始化默认服务器地址配置
         // 可以从 BVAPPEnvironmentHostManager 中提取 domainUrl
@@ -63,6 +69,11 @@
     _serverURLs[@(APIEnvironmentUAT)] = @"https://uat-api.example.com";
     _serverURLs[@(APIEnvironmentAppStore)] = @"https://api.example.com";
     
+    // 默认图片CDN地址配置
+    _imageCDNURLs[@(APIEnvironmentTest)] = @"https://test-img.example.com";
+    _imageCDNURLs[@(APIEnvironmentUAT)] = @"https://uat-img.example.com";
+    _imageCDNURLs[@(APIEnvironmentAppStore)] = @"https://img.example.com";
+    
     // 尝试从 BVAPPEnvironmentHostManager 同步服务器地址
     #ifdef DEBUG
         [self syncServerURLsFromEnvironmentHostManager];
@@ -203,6 +214,39 @@
     
     self.serverURLs[@(environment)] = cleanURL;
     NSLog(@"✅ 已更新环境 %ld 的服务器地址: %@", (long)environment, cleanURL);
+    [[NSNotificationCenter defaultCenter] postNotificationName:APIServerConfigDidChangeNotification object:self];
+}
+
+- (nullable NSString *)imageCDNURLForEnvironment:(APIEnvironment)environment {
+    return self.imageCDNURLs[@(environment)];
+}
+
+- (void)setImageCDNURL:(nullable NSString *)imageCDNURL forEnvironment:(APIEnvironment)environment {
+    if (imageCDNURL.length == 0) {
+        [self.imageCDNURLs removeObjectForKey:@(environment)];
+        return;
+    }
+    
+    NSString *cleanURL = imageCDNURL;
+    if ([cleanURL hasSuffix:@"/"]) {
+        cleanURL = [cleanURL substringToIndex:cleanURL.length - 1];
+    }
+    
+    self.imageCDNURLs[@(environment)] = cleanURL;
+    NSLog(@"✅ 已更新环境 %ld 的图片CDN地址: %@", (long)environment, cleanURL);
+}
+
+- (BOOL)supportsBatchRequestsForEnvironment:(APIEnvironment)environment {
+    return [self.batchEnvironments containsObject:@(environment)];
+}
+
+- (void)setSupportsBatchRequests:(BOOL)supportsBatchRequests forEnvironment:(APIEnvironment)environment {
+    if (supportsBatchRequests) {
+        [self.batchEnvironments addObject:@(environment)];
+    } else {
+        [self.batchEnvironments removeObject:@(environment)];
+    }
+    NSLog(@"✅ 已%@环境 %ld 的批量接口", supportsBatchRequests ? @"开启" : @"关闭", (long)environment);
 }
 
 - (NSString *)displayNameForEnvironment:(APIEnvironment)environment {
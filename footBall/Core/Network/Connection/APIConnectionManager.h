@@ -0,0 +1,35 @@
+//
+//  APIConnectionManager.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 连接管理器 - 统一的URLSession配置与预连接
+/// API、文件传输和图片下载使用同一份会话配置；HTTPS连接通过ALPN协商HTTP/2，同一会话内对同一主机的请求复用一条连接多路传输
+/// 启动时和环境切换后预连接API服务器和图片CDN（DNS解析、TCP和TLS握手），首个用户可见的请求不再等待握手
+@interface APIConnectionManager : NSObject
+
+/// 单例
++ (instancetype)sharedManager;
+
+/// 每个主机的最大连接数（默认：与 APIRequestScheduler 每个主机的最大并发数一致）
+@property (nonatomic, assign) NSInteger HTTPMaximumConnectionsPerHost;
+
+/// 同一主机两次预连接的最小间隔（秒，默认：30），避免启动流程中重复预连接
+@property (nonatomic, assign) NSTimeInterval preconnectInterval;
+
+/// 创建会话配置（每次返回新的副本，创建URLSession前可以再按需修改）
+- (NSURLSessionConfiguration *)sessionConfiguration;
+
+/// 预连接当前环境的API服务器和图片CDN
+/// 单例创建后即监听 APIEnvironmentDidChangeNotification，切换环境后自动预连接新环境
+- (void)preconnectCurrentEnvironment;
+
+@end
+
+NS_ASSUME_NONNULL_END
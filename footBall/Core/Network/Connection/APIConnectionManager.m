@@ -0,0 +1,99 @@
+//
+//  APIConnectionManager.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIConnectionManager.h"
+#import "APIEnvironmentManager.h"
+#import "APIManager.h"
+#import "APIRequestScheduler.h"
+#import "SDImageManager.h"
+
+@interface APIConnectionManager ()
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSDate *> *preconnectDates; // 主机 -> 最近一次预连接时间
+
+@end
+
+@implementation APIConnectionManager
+
++ (instancetype)sharedManager {
+    static APIConnectionManager *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[APIConnectionManager alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _HTTPMaximumConnectionsPerHost = [APIRequestScheduler sharedScheduler].maxConcurrentRequestsPerHost;
+        _preconnectInterval = 30.0;
+        _preconnectDates = [NSMutableDictionary dictionary];
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(environmentDidChange:)
+                                                     name:APIEnvironmentDidChangeNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+#pragma mark - Public Methods
+
+- (NSURLSessionConfiguration *)sessionConfiguration {
+    NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+    configuration.HTTPMaximumConnectionsPerHost = self.HTTPMaximumConnectionsPerHost;
+    // HTTP/2在一条连接上多路复用，不使用HTTP/1.1管线化
+    configuration.HTTPShouldUsePipelining = NO;
+    // HTTP/2要求TLS 1.2及以上
+    configuration.TLSMinimumSupportedProtocolVersion = tls_protocol_version_TLSv12;
+    return configuration;
+}
+
+- (void)preconnectCurrentEnvironment {
+    APIEnvironmentManager *envManager = [APIEnvironmentManager sharedManager];
+    
+    NSString *baseURL = envManager.currentBaseURL;
+    if ([self shouldPreconnectToURLString:baseURL]) {
+        [[APIManager sharedManager] preconnectToURLString:baseURL];
+    }
+    
+    NSString *imageCDNURL = envManager.currentImageCDNURL;
+    if (imageCDNURL && [self shouldPreconnectToURLString:imageCDNURL]) {
+        [[SDImageManager sharedManager] preconnectToURLString:imageCDNURL];
+    }
+}
+
+#pragma mark - Private Methods
+
+- (void)environmentDidChange:(NSNotification *)notification {
+    [self preconnectCurrentEnvironment];
+}
+
+/// 同一主机在预连接间隔内只预连接一次
+- (BOOL)shouldPreconnectToURLString:(NSString *)URLString {
+    NSString *host = [NSURL URLWithString:URLString].host.lowercaseString;
+    if (host.length == 0) {
+        return NO;
+    }
+    
+    @synchronized (self.preconnectDates) {
+        NSDate *lastDate = self.preconnectDates[host];
+        if (lastDate && -[lastDate timeIntervalSinceNow] < self.preconnectInterval) {
+            return NO;
+        }
+        self.preconnectDates[host] = [NSDate date];
+        return YES;
+    }
+}
+
+@end
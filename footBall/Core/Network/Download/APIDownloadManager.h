@@ -0,0 +1,119 @@
+//
+//  APIDownloadManager.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import "APIRequestScheduler.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 下载状态
+typedef NS_ENUM(NSInteger, APIDownloadState) {
+    APIDownloadStateQueued = 0,   // 等待开始
+    APIDownloadStateDownloading,  // 下载中
+    APIDownloadStateVerifying,    // 校验中
+    APIDownloadStatePaused,       // 已暂停（已下载的数据保留）
+    APIDownloadStateCompleted,    // 已完成
+    APIDownloadStateFailed,       // 失败（已下载的数据保留，再次下载同一地址和SHA256时继续）
+    APIDownloadStateCancelled     // 已取消
+};
+
+/// 下载完成回调
+typedef void(^APIDownloadSuccessBlock)(NSURL *filePath);
+
+/// 下载任务（同一地址和期望的SHA256同时只有一个任务，重复下载共享该任务）
+@interface APIDownloadTask : NSObject
+
+/// 下载地址
+@property (nonatomic, strong, readonly) NSURL *URL;
+
+/// 期望的SHA256（十六进制，nil时不校验）
+@property (nonatomic, copy, readonly, nullable) NSString *expectedSHA256;
+
+/// 当前状态
+@property (assign, readonly) APIDownloadState state;
+
+/// 下载进度（字节，文件大小未知时totalUnitCount为-1）
+@property (nonatomic, strong, readonly) NSProgress *progress;
+
+/// 分段数（服务端不支持Range时为1）
+@property (assign, readonly) NSUInteger segmentCount;
+
+/// 当前下载速度（字节/秒）
+@property (assign, readonly) double bytesPerSecond;
+
+/// 失败原因
+@property (nonatomic, strong, readonly, nullable) NSError *error;
+
+@end
+
+/// 下载管理器 - 大文件按HTTP Range分段并行下载，边下载边写入磁盘
+/// 已下载的分段进度持久化（Caches目录），暂停、失败或重新启动后从断点继续（If-Range校验文件未变化，变化时重新下载）；
+/// 完成后校验SHA256再移动到目标路径；同一地址（期望的SHA256也相同）的并发下载合并为一个任务；请求经过 APIManager 的公共请求头和拦截器，由请求调度器排队
+@interface APIDownloadManager : NSObject
+
+/// 单例（使用 APIConnectionManager 的会话配置）
++ (instancetype)sharedManager;
+
+/// 初始化方法
+/// @param configuration 会话配置
+/// @param storageName 断点数据目录名（Caches下）
+- (instancetype)initWithSessionConfiguration:(NSURLSessionConfiguration *)configuration storageName:(NSString *)storageName;
+
+/// 单个文件的最大分段数（默认：4）
+@property (nonatomic, assign) NSUInteger maxSegmentCount;
+
+/// 分段的最小字节数（默认：2MB），小于两个分段的文件不分段
+@property (nonatomic, assign) int64_t minimumSegmentSize;
+
+/// 分段失败的最大重试次数（默认：3），超过后任务失败
+@property (nonatomic, assign) NSUInteger maxRetryCount;
+
+/// 下载请求的调度优先级（默认：APIRequestPriorityBackground）
+@property (nonatomic, assign) APIRequestPriority priority;
+
+/// 所有下载的总速度（字节/秒）
+@property (nonatomic, assign, readonly) double bytesPerSecond;
+
+/// 进行中的任务
+@property (nonatomic, copy, readonly) NSArray<APIDownloadTask *> *activeTasks;
+
+/// 下载文件
+/// 同一地址、同一期望SHA256已在下载时合并到该任务（各自的目标路径都会得到文件），SHA256不同时各自下载和校验；有断点数据时从断点继续
+/// @param URLString 下载地址（相对路径时拼接当前环境的Base URL）
+/// @param destinationPath 保存路径（已存在时覆盖）
+/// @param expectedSHA256 期望的SHA256（nil时不校验），不一致时删除已下载的数据并回调失败
+/// @param headers 请求头
+/// @param progress 进度回调（主线程）
+/// @param success 成功回调（主线程）
+/// @param failure 失败回调（主线程）
+/// @return 下载任务，地址无效时返回nil并回调failure
+- (nullable APIDownloadTask *)downloadURLString:(NSString *)URLString
+                                destinationPath:(NSString *)destinationPath
+                                 expectedSHA256:(nullable NSString *)expectedSHA256
+                                        headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                       progress:(nullable void(^)(NSProgress *progress))progress
+                                        success:(nullable APIDownloadSuccessBlock)success
+                                        failure:(nullable void(^)(NSError *error))failure;
+
+/// 暂停下载（已下载的数据保留）
+/// @param task 任务
+- (void)pauseTask:(APIDownloadTask *)task;
+
+/// 继续下载（暂停的任务；失败的任务再次调用 downloadURLString: 从断点继续）
+/// @param task 任务
+- (void)resumeTask:(APIDownloadTask *)task;
+
+/// 取消下载并删除已下载的数据（所有合并到该任务的调用方都会收到取消）
+/// @param task 任务
+- (void)cancelTask:(APIDownloadTask *)task;
+
+/// 取消所有下载（保留已下载的数据，再次下载时继续）
+- (void)cancelAllDownloads;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,961 @@
+//
+//  APIDownloadManager.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIDownloadManager.h"
+#import "APIManager.h"
+#import "APIEnvironmentManager.h"
+#import "APIConnectionManager.h"
+#import "APICompressionStatistics.h"
+#import <AFNetworking/AFNetworking.h>
+#import <CommonCrypto/CommonDigest.h>
+
+/// 默认分段最小字节数
+static const int64_t kAPIDownloadDefaultMinimumSegmentSize = 2 * 1024 * 1024;
+/// 每写入多少字节保存一次断点
+static const int64_t kAPIDownloadMetadataSaveInterval = 1024 * 1024;
+/// 进度回调的最小间隔
+static const NSTimeInterval kAPIDownloadProgressInterval = 0.1;
+/// 下载速度的统计窗口
+static const NSTimeInterval kAPIDownloadThroughputWindow = 1.0;
+
+#pragma mark - Helpers
+
+/// SHA256十六进制摘要（断点文件名，避免地址中的特殊字符）
+static NSString *APIDownloadSHA256(NSString *string) {
+    NSData *data = [string dataUsingEncoding:NSUTF8StringEncoding];
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+    
+    NSMutableString *hex = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [hex appendFormat:@"%02x", digest[i]];
+    }
+    return hex;
+}
+
+/// 文件的SHA256（按1MB读取，不一次性读入内存）
+static NSString *APIDownloadFileSHA256(NSURL *fileURL) {
+    NSFileHandle *fileHandle = [NSFileHandle fileHandleForReadingFromURL:fileURL error:nil];
+    if (!fileHandle) {
+        return nil;
+    }
+    
+    CC_SHA256_CTX context;
+    CC_SHA256_Init(&context);
+    while (YES) {
+        @autoreleasepool {
+            NSData *data = [fileHandle readDataUpToLength:1024 * 1024 error:nil];
+            if (data.length == 0) {
+                break;
+            }
+            CC_SHA256_Update(&context, data.bytes, (CC_LONG)data.length);
+        }
+    }
+    [fileHandle closeAndReturnError:nil];
+    
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(digest, &context);
+    NSMutableString *hex = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [hex appendFormat:@"%02x", digest[i]];
+    }
+    return hex;
+}
+
+/// Content-Range的起始位置（bytes start-end/total），无法解析时返回-1
+static int64_t APIDownloadContentRangeStart(NSString *contentRange) {
+    NSScanner *scanner = [NSScanner scannerWithString:contentRange ?: @""];
+    long long start = -1;
+    if ([scanner scanString:@"bytes" intoString:nil] && [scanner scanLongLong:&start]) {
+        return start;
+    }
+    return -1;
+}
+
+#pragma mark - APIDownloadSegment
+
+/// 下载分段（一个Range请求）
+@interface APIDownloadSegment : NSObject
+
+@property (nonatomic, weak) APIDownloadTask *downloadTask;
+@property (nonatomic, assign) int64_t start;
+@property (nonatomic, assign) int64_t length; // -1表示未知（服务端未返回文件大小）
+@property (nonatomic, assign) int64_t received;
+@property (nonatomic, assign) NSUInteger retryCount;
+@property (nonatomic, strong, nullable) NSURLSessionDataTask *dataTask;
+@property (nonatomic, strong, nullable) APIScheduledJob *job;
+@property (nonatomic, strong, nullable) NSFileHandle *fileHandle;
+@property (nonatomic, strong, nullable) NSError *error;
+
+@end
+
+@implementation APIDownloadSegment
+
+- (BOOL)isComplete {
+    return self.length >= 0 && self.received >= self.length;
+}
+
+- (NSDictionary *)dictionaryRepresentation {
+    return @{@"start": @(self.start), @"length": @(self.length), @"received": @(self.received)};
+}
+
+@end
+
+#pragma mark - APIDownloadObserver
+
+/// 下载的调用方（同一地址的多次下载合并后各自的目标路径和回调）
+@interface APIDownloadObserver : NSObject
+
+@property (nonatomic, copy) NSString *destinationPath;
+@property (nonatomic, copy, nullable) void(^progressBlock)(NSProgress *progress);
+@property (nonatomic, copy, nullable) APIDownloadSuccessBlock successBlock;
+@property (nonatomic, copy, nullable) void(^failureBlock)(NSError *error);
+
+@end
+
+@implementation APIDownloadObserver
+
+@end
+
+#pragma mark - APIDownloadTask
+
+@interface APIDownloadTask ()
+
+@property (nonatomic, strong, readwrite) NSURL *URL;
+@property (nonatomic, copy, readwrite, nullable) NSString *expectedSHA256;
+@property (assign, readwrite) APIDownloadState state;
+@property (nonatomic, strong, readwrite) NSProgress *progress;
+@property (assign, readwrite) NSUInteger segmentCount;
+@property (assign, readwrite) double bytesPerSecond;
+@property (nonatomic, strong, readwrite, nullable) NSError *error;
+
+// 以下只在下载队列中访问
+@property (nonatomic, copy) NSString *key; // 合并键：下载地址，有期望的SHA256时加上SHA256（同一地址不同文件不合并）
+@property (nonatomic, copy) NSString *storageKey;
+@property (nonatomic, copy, nullable) NSDictionary<NSString *, NSString *> *headers;
+@property (nonatomic, strong) NSMutableArray<APIDownloadObserver *> *observers;
+@property (nonatomic, copy) NSArray<APIDownloadSegment *> *segments;
+@property (nonatomic, assign) int64_t totalBytes; // -1表示未知
+@property (nonatomic, assign) BOOL acceptsRanges;
+@property (nonatomic, copy, nullable) NSString *validator; // If-Range校验值（强ETag或Last-Modified）
+@property (nonatomic, strong, nullable) NSURLSessionDataTask *probeTask; // HEAD请求（获取文件大小和是否支持Range）
+@property (nonatomic, strong, nullable) APIScheduledJob *probeJob;
+@property (nonatomic, assign) NSUInteger probeRetryCount;
+@property (nonatomic, assign) NSUInteger generation; // 每次开始/暂停/结束时递增，旧的延迟重试直接忽略
+@property (nonatomic, assign) int64_t unsavedBytes;
+@property (nonatomic, assign) CFAbsoluteTime throughputWindowStart;
+@property (nonatomic, assign) int64_t throughputWindowBytes;
+@property (nonatomic, assign) CFAbsoluteTime lastProgressTime;
+
+@end
+
+@implementation APIDownloadTask
+
+- (instancetype)initWithURL:(NSURL *)URL expectedSHA256:(nullable NSString *)expectedSHA256 {
+    self = [super init];
+    if (self) {
+        _URL = URL;
+        _expectedSHA256 = [expectedSHA256 copy];
+        _key = expectedSHA256.length > 0
+            ? [NSString stringWithFormat:@"%@#sha256=%@", URL.absoluteString, expectedSHA256.lowercaseString]
+            : URL.absoluteString;
+        _storageKey = APIDownloadSHA256(_key);
+        _observers = [NSMutableArray array];
+        _segments = @[];
+        _totalBytes = -1;
+        _progress = [NSProgress progressWithTotalUnitCount:-1];
+        _state = APIDownloadStateQueued;
+    }
+    return self;
+}
+
+- (int64_t)receivedBytes {
+    int64_t receivedBytes = 0;
+    for (APIDownloadSegment *segment in self.segments) {
+        receivedBytes += segment.received;
+    }
+    return receivedBytes;
+}
+
+@end
+
+#pragma mark - APIDownloadManager
+
+@interface APIDownloadManager () <NSURLSessionDataDelegate>
+
+@property (nonatomic, strong) NSURLSession *session;
+@property (nonatomic, strong) dispatch_queue_t queue; // 任务状态和会话代理回调都在该串行队列中处理
+@property (nonatomic, copy) NSString *storagePath;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, APIDownloadTask *> *tasks; // 合并键（下载地址和期望的SHA256） -> 进行中的任务
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, id> *sessionTaskObjects; // taskIdentifier -> 分段或任务（HEAD请求）
+
+@end
+
+@implementation APIDownloadManager
+
++ (instancetype)sharedManager {
+    static APIDownloadManager *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[APIDownloadManager alloc] initWithSessionConfiguration:[[APIConnectionManager sharedManager] sessionConfiguration]
+                                                                storageName:@"APIDownloads"];
+    });
+    return instance;
+}
+
+- (instancetype)initWithSessionConfiguration:(NSURLSessionConfiguration *)configuration storageName:(NSString *)storageName {
+    self = [super init];
+    if (self) {
+        _maxSegmentCount = 4;
+        _minimumSegmentSize = kAPIDownloadDefaultMinimumSegmentSize;
+        _maxRetryCount = 3;
+        _priority = APIRequestPriorityBackground;
+        _tasks = [NSMutableDictionary dictionary];
+        _sessionTaskObjects = [NSMutableDictionary dictionary];
+        
+        NSString *cachesPath = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+        _storagePath = [cachesPath stringByAppendingPathComponent:storageName];
+        [[NSFileManager defaultManager] createDirectoryAtPath:_storagePath
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:nil];
+        
+        // 数据直接写入文件，不经过URL缓存；代理回调在下载队列中串行执行
+        configuration.URLCache = nil;
+        configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+        _queue = dispatch_queue_create("com.football.api.download", DISPATCH_QUEUE_SERIAL);
+        NSOperationQueue *delegateQueue = [[NSOperationQueue alloc] init];
+        delegateQueue.name = @"com.football.api.download";
+        delegateQueue.maxConcurrentOperationCount = 1;
+        delegateQueue.underlyingQueue = _queue;
+        _session = [NSURLSession sessionWithConfiguration:configuration delegate:self delegateQueue:delegateQueue];
+    }
+    return self;
+}
+
+- (void)setMaxSegmentCount:(NSUInteger)maxSegmentCount {
+    _maxSegmentCount = MAX(maxSegmentCount, (NSUInteger)1);
+}
+
+- (double)bytesPerSecond {
+    __block double bytesPerSecond = 0;
+    dispatch_sync(self.queue, ^{
+        for (APIDownloadTask *task in self.tasks.allValues) {
+            bytesPerSecond += [self bytesPerSecondOfTask:task];
+        }
+    });
+    return bytesPerSecond;
+}
+
+- (NSArray<APIDownloadTask *> *)activeTasks {
+    __block NSArray<APIDownloadTask *> *tasks = nil;
+    dispatch_sync(self.queue, ^{
+        tasks = self.tasks.allValues;
+    });
+    return tasks;
+}
+
+#pragma mark - Public Methods
+
+- (nullable APIDownloadTask *)downloadURLString:(NSString *)URLString
+                                destinationPath:(NSString *)destinationPath
+                                 expectedSHA256:(nullable NSString *)expectedSHA256
+                                        headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                       progress:(nullable void(^)(NSProgress *progress))progress
+                                        success:(nullable APIDownloadSuccessBlock)success
+                                        failure:(nullable void(^)(NSError *error))failure {
+    NSURL *URL = [self URLForURLString:URLString];
+    if (!URL || destinationPath.length == 0) {
+        APIError *error = [APIError errorWithCode:APIErrorCodeBadRequest message:@"下载地址或保存路径无效" underlyingError:nil];
+        error.requestPath = URLString;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (failure) {
+                failure(error);
+            }
+        });
+        return nil;
+    }
+    
+    APIDownloadObserver *observer = [[APIDownloadObserver alloc] init];
+    observer.destinationPath = destinationPath;
+    observer.progressBlock = progress;
+    observer.successBlock = success;
+    observer.failureBlock = failure;
+    
+    __block APIDownloadTask *task = [[APIDownloadTask alloc] initWithURL:URL expectedSHA256:expectedSHA256];
+    dispatch_sync(self.queue, ^{
+        APIDownloadTask *existingTask = self.tasks[task.key];
+        if (existingTask) {
+            task = existingTask;
+            NSLog(@"🔗 合并下载: %@", URL.lastPathComponent);
+            [task.observers addObject:observer];
+            if (task.state == APIDownloadStatePaused) {
+                [self startTask:task];
+            }
+            return;
+        }
+        
+        task.headers = headers;
+        [task.observers addObject:observer];
+        self.tasks[task.key] = task;
+        [self startTask:task];
+    });
+    return task;
+}
+
+- (void)pauseTask:(APIDownloadTask *)task {
+    dispatch_async(self.queue, ^{
+        if (task.state != APIDownloadStateDownloading && task.state != APIDownloadStateQueued) {
+            return;
+        }
+        
+        [self stopRequestsOfTask:task];
+        task.state = APIDownloadStatePaused;
+        [self saveMetadataOfTask:task];
+        NSLog(@"⏸️ 下载暂停: %@（%lld字节）", task.URL.lastPathComponent, [task receivedBytes]);
+    });
+}
+
+- (void)resumeTask:(APIDownloadTask *)task {
+    dispatch_async(self.queue, ^{
+        if (task.state == APIDownloadStatePaused && self.tasks[task.key] == task) {
+            [self startTask:task];
+        }
+    });
+}
+
+- (void)cancelTask:(APIDownloadTask *)task {
+    dispatch_async(self.queue, ^{
+        if (self.tasks[task.key] != task) {
+            return;
+        }
+        
+        [self stopRequestsOfTask:task];
+        [self removeStoredDataOfTask:task];
+        [self finishTask:task state:APIDownloadStateCancelled error:[APIError errorWithCode:APIErrorCodeCancelled message:@"下载已取消" underlyingError:nil]];
+    });
+}
+
+- (void)cancelAllDownloads {
+    dispatch_async(self.queue, ^{
+        for (APIDownloadTask *task in self.tasks.allValues) {
+            [self cancelTaskKeepingData:task];
+        }
+    });
+}
+
+#pragma mark - Private Methods
+
+/// 相对路径拼接当前环境的Base URL
+- (nullable NSURL *)URLForURLString:(NSString *)URLString {
+    return [NSURL URLWithString:[[APIEnvironmentManager sharedManager].routeTable absoluteURLStringForURLString:URLString]];
+}
+
+/// 开始（或继续）下载：有断点时继续未完成的分段，否则先用HEAD请求获取文件大小再分段
+- (void)startTask:(APIDownloadTask *)task {
+    [self stopRequestsOfTask:task];
+    task.state = APIDownloadStateDownloading;
+    task.error = nil;
+    task.probeRetryCount = 0;
+    task.throughputWindowStart = CFAbsoluteTimeGetCurrent();
+    task.throughputWindowBytes = 0;
+    
+    if (task.segments.count == 0) {
+        [self restoreMetadataOfTask:task];
+    }
+    if (task.segments.count == 0) {
+        [self probeTask:task];
+        return;
+    }
+    
+    NSLog(@"⬇️ 下载继续: %@（%lld/%lld字节，%lu段）", task.URL.lastPathComponent, [task receivedBytes], task.totalBytes, (unsigned long)task.segments.count);
+    for (APIDownloadSegment *segment in task.segments) {
+        segment.retryCount = 0;
+    }
+    [self startSegmentsOfTask:task];
+}
+
+- (void)probeTask:(APIDownloadTask *)task {
+    NSError *error = nil;
+    NSMutableURLRequest *request = [self requestForTask:task method:@"HEAD" error:&error];
+    if (!request) {
+        [self failTask:task error:error];
+        return;
+    }
+    
+    task.probeTask = [self.session dataTaskWithRequest:request];
+    self.sessionTaskObjects[@(task.probeTask.taskIdentifier)] = task;
+    [[APIManager sharedManager].taskRegistry registerTask:task.probeTask tags:[NSSet setWithObject:APITaskTagDownload]];
+    task.probeJob = [[APIRequestScheduler sharedScheduler] jobWithTask:task.probeTask priority:self.priority startHandler:nil];
+    [task.probeJob start];
+}
+
+/// 按HEAD响应分段：支持Range且文件足够大时分成多段并行下载，否则整个文件一段
+- (void)planSegmentsOfTask:(APIDownloadTask *)task response:(nullable NSHTTPURLResponse *)response {
+    BOOL succeeded = response.statusCode >= 200 && response.statusCode < 300;
+    int64_t totalBytes = succeeded && response.expectedContentLength > 0 ? response.expectedContentLength : -1;
+    NSString *acceptRanges = [response valueForHTTPHeaderField:@"Accept-Ranges"].lowercaseString;
+    task.acceptsRanges = totalBytes > 0 && [acceptRanges containsString:@"bytes"];
+    
+    // 弱ETag不能用于If-Range
+    NSString *ETag = [response valueForHTTPHeaderField:@"ETag"];
+    task.validator = (ETag.length > 0 && ![ETag hasPrefix:@"W/"]) ? ETag : [response valueForHTTPHeaderField:@"Last-Modified"];
+    
+    NSUInteger segmentCount = 1;
+    if (task.acceptsRanges && totalBytes >= self.minimumSegmentSize * 2) {
+        segmentCount = (NSUInteger)MIN((int64_t)self.maxSegmentCount, totalBytes / self.minimumSegmentSize);
+    }
+    [self resetTask:task totalBytes:totalBytes segmentCount:segmentCount];
+    NSLog(@"⬇️ 下载开始: %@（%lld字节，%lu段）", task.URL.lastPathComponent, totalBytes, (unsigned long)segmentCount);
+    [self saveMetadataOfTask:task];
+    [self startSegmentsOfTask:task];
+}
+
+/// 重新分段并清空已下载的数据
+- (void)resetTask:(APIDownloadTask *)task totalBytes:(int64_t)totalBytes segmentCount:(NSUInteger)segmentCount {
+    NSMutableArray<APIDownloadSegment *> *segments = [NSMutableArray array];
+    if (totalBytes < 0) {
+        APIDownloadSegment *segment = [[APIDownloadSegment alloc] init];
+        segment.downloadTask = task;
+        segment.length = -1;
+        [segments addObject:segment];
+    } else {
+        int64_t segmentLength = (totalBytes + segmentCount - 1) / segmentCount;
+        for (int64_t start = 0; start < totalBytes; start += segmentLength) {
+            APIDownloadSegment *segment = [[APIDownloadSegment alloc] init];
+            segment.downloadTask = task;
+            segment.start = start;
+            segment.length = MIN(segmentLength, totalBytes - start);
+            [segments addObject:segment];
+        }
+    }
+    
+    task.segments = segments;
+    task.segmentCount = segments.count;
+    task.totalBytes = totalBytes;
+    task.progress.totalUnitCount = totalBytes;
+    task.progress.completedUnitCount = 0;
+    [[NSFileManager defaultManager] createFileAtPath:[self dataURLForTask:task].path contents:nil attributes:nil];
+}
+
+/// 服务端忽略了Range或文件已变化：丢弃已下载的数据，整个文件重新下载
+- (void)restartTaskWithoutRanges:(APIDownloadTask *)task {
+    NSLog(@"⚠️ 文件已变化或服务端不支持断点续传，重新下载: %@", task.URL.lastPathComponent);
+    [self stopRequestsOfTask:task];
+    task.acceptsRanges = NO;
+    task.validator = nil;
+    [self resetTask:task totalBytes:-1 segmentCount:1];
+    [self saveMetadataOfTask:task];
+    [self startSegmentsOfTask:task];
+}
+
+- (void)startSegmentsOfTask:(APIDownloadTask *)task {
+    for (APIDownloadSegment *segment in task.segments) {
+        if (task.state != APIDownloadStateDownloading) {
+            return;
+        }
+        if (!segment.isComplete && !segment.dataTask) {
+            [self startSegment:segment];
+        }
+    }
+    if ([self allSegmentsCompleteOfTask:task]) {
+        [self verifyTask:task];
+    }
+}
+
+- (void)startSegment:(APIDownloadSegment *)segment {
+    APIDownloadTask *task = segment.downloadTask;
+    NSError *error = nil;
+    NSMutableURLRequest *request = [self requestForTask:task method:@"GET" error:&error];
+    if (!request) {
+        [self failTask:task error:error];
+        return;
+    }
+    
+    if (task.acceptsRanges) {
+        int64_t offset = segment.start + segment.received;
+        NSString *range = segment.length >= 0 ?
+            [NSString stringWithFormat:@"bytes=%lld-%lld", offset, segment.start + segment.length - 1] :
+            [NSString stringWithFormat:@"bytes=%lld-", offset];
+        [request setValue:range forHTTPHeaderField:@"Range"];
+        if (task.validator.length > 0) {
+            [request setValue:task.validator forHTTPHeaderField:@"If-Range"];
+        }
+    } else {
+        segment.received = 0;
+    }
+    
+    segment.dataTask = [self.session dataTaskWithRequest:request];
+    self.sessionTaskObjects[@(segment.dataTask.taskIdentifier)] = segment;
+    [[APIManager sharedManager].taskRegistry registerTask:segment.dataTask tags:[NSSet setWithObject:APITaskTagDownload]];
+    segment.job = [[APIRequestScheduler sharedScheduler] jobWithTask:segment.dataTask priority:self.priority startHandler:nil];
+    [segment.job start];
+}
+
+/// 构建请求，经过 APIManager 的公共请求头和拦截器
+- (nullable NSMutableURLRequest *)requestForTask:(APIDownloadTask *)task method:(NSString *)method error:(NSError **)error {
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:task.URL];
+    request.HTTPMethod = method;
+    request.timeoutInterval = [APIManager sharedManager].effectiveTimeoutInterval;
+    
+    NSURLRequest *interceptedRequest = [[APIManager sharedManager] interceptedRequestForRequest:request headers:task.headers];
+    if (!interceptedRequest) {
+        APIError *cancelledError = [APIError errorWithCode:APIErrorCodeCancelled message:@"请求被拦截器取消" underlyingError:nil];
+        cancelledError.requestPath = task.URL.absoluteString;
+        *error = cancelledError;
+        return nil;
+    }
+    
+    // Range按原始字节计算，不接受内容编码（否则分段和文件大小对应的是压缩后的数据）
+    NSMutableURLRequest *mutableRequest = [interceptedRequest mutableCopy];
+    [mutableRequest setValue:@"identity" forHTTPHeaderField:@"Accept-Encoding"];
+    return mutableRequest;
+}
+
+/// 取消任务，断点数据保留（再次下载同一地址时继续）
+- (void)cancelTaskKeepingData:(APIDownloadTask *)task {
+    [self stopRequestsOfTask:task];
+    [self saveMetadataOfTask:task];
+    [self finishTask:task state:APIDownloadStateCancelled error:[APIError errorWithCode:APIErrorCodeCancelled message:@"下载已取消" underlyingError:nil]];
+}
+
+/// 取消进行中的请求（回调映射一并移除，之后到达的回调直接忽略）
+- (void)stopRequestsOfTask:(APIDownloadTask *)task {
+    task.generation++;
+    task.bytesPerSecond = 0;
+    if (task.probeTask) {
+        [self.sessionTaskObjects removeObjectForKey:@(task.probeTask.taskIdentifier)];
+        [task.probeTask cancel];
+        [task.probeJob finish];
+        task.probeTask = nil;
+        task.probeJob = nil;
+    }
+    
+    for (APIDownloadSegment *segment in task.segments) {
+        if (segment.dataTask) {
+            [self.sessionTaskObjects removeObjectForKey:@(segment.dataTask.taskIdentifier)];
+            [segment.dataTask cancel];
+            [segment.job finish];
+            segment.dataTask = nil;
+            segment.job = nil;
+        }
+        [segment.fileHandle closeAndReturnError:nil];
+        segment.fileHandle = nil;
+        segment.error = nil;
+    }
+}
+
+- (BOOL)allSegmentsCompleteOfTask:(APIDownloadTask *)task {
+    if (task.segments.count == 0) {
+        return NO;
+    }
+    for (APIDownloadSegment *segment in task.segments) {
+        if (!segment.isComplete) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+/// 分段失败：客户端错误直接失败，其他错误按次数重试，超过次数后任务失败（已下载的数据保留）
+- (void)handleError:(NSError *)error segment:(APIDownloadSegment *)segment {
+    APIDownloadTask *task = segment.downloadTask;
+    NSHTTPURLResponse *response = error.userInfo[AFNetworkingOperationFailingURLResponseErrorKey];
+    NSInteger statusCode = response.statusCode;
+    BOOL retryable = !(statusCode >= 400 && statusCode < 500 && statusCode != 408 && statusCode != 429);
+    
+    segment.retryCount++;
+    if (!retryable || segment.retryCount > self.maxRetryCount) {
+        [self failTask:task error:error];
+        return;
+    }
+    
+    NSTimeInterval delay = segment.retryCount * 1.0;
+    NSLog(@"🔄 下载分段重试（第%lu次，%.0f秒后）: %@ - %@", (unsigned long)segment.retryCount, delay, task.URL.lastPathComponent, error.localizedDescription);
+    NSUInteger generation = task.generation;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+        if (task.generation == generation && task.state == APIDownloadStateDownloading &&
+            !segment.dataTask && [task.segments containsObject:segment]) {
+            [self startSegment:segment];
+        }
+    });
+}
+
+/// 所有分段完成：校验SHA256后移动到各调用方的目标路径
+- (void)verifyTask:(APIDownloadTask *)task {
+    [self stopRequestsOfTask:task];
+    task.state = APIDownloadStateVerifying;
+    task.progress.totalUnitCount = task.totalBytes;
+    task.progress.completedUnitCount = task.totalBytes;
+    [self notifyProgressOfTask:task force:YES];
+    
+    NSUInteger generation = task.generation;
+    NSURL *dataURL = [self dataURLForTask:task];
+    NSString *expectedSHA256 = task.expectedSHA256;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        NSString *SHA256 = expectedSHA256.length > 0 ? APIDownloadFileSHA256(dataURL) : nil;
+        dispatch_async(self.queue, ^{
+            if (task.generation != generation || task.state != APIDownloadStateVerifying) {
+                return;
+            }
+            
+            if (expectedSHA256.length > 0 && [SHA256 caseInsensitiveCompare:expectedSHA256] != NSOrderedSame) {
+                [self removeStoredDataOfTask:task];
+                APIError *error = [APIError errorWithCode:APIErrorCodeDecodingFailed
+                                                  message:[NSString stringWithFormat:@"文件校验失败: %@", task.URL.lastPathComponent]
+                                          underlyingError:nil];
+                error.requestPath = task.URL.absoluteString;
+                [self failTask:task error:error];
+                return;
+            }
+            [self deliverFileOfTask:task];
+        });
+    });
+}
+
+/// 把下载的文件交给各调用方：前面的调用方复制，最后一个移动
+- (void)deliverFileOfTask:(APIDownloadTask *)task {
+    NSURL *dataURL = [self dataURLForTask:task];
+    NSArray<APIDownloadObserver *> *observers = [task.observers copy];
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSMutableArray *results = [NSMutableArray array];
+    for (NSUInteger i = 0; i < observers.count; i++) {
+        NSURL *destinationURL = [NSURL fileURLWithPath:observers[i].destinationPath];
+        NSError *error = nil;
+        [fileManager createDirectoryAtURL:destinationURL.URLByDeletingLastPathComponent withIntermediateDirectories:YES attributes:nil error:nil];
+        [fileManager removeItemAtURL:destinationURL error:nil];
+        BOOL succeeded = (i == observers.count - 1) ?
+            [fileManager moveItemAtURL:dataURL toURL:destinationURL error:&error] :
+            [fileManager copyItemAtURL:dataURL toURL:destinationURL error:&error];
+        [results addObject:succeeded ? destinationURL : error];
+    }
+    
+    [self removeStoredDataOfTask:task];
+    task.state = APIDownloadStateCompleted;
+    [task.observers removeAllObjects];
+    [self.tasks removeObjectForKey:task.key];
+    NSLog(@"✅ 下载完成: %@（%lld字节）", task.URL.lastPathComponent, task.totalBytes);
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        for (NSUInteger i = 0; i < observers.count; i++) {
+            id result = results[i];
+            if ([result isKindOfClass:[NSURL class]]) {
+                if (observers[i].successBlock) {
+                    observers[i].successBlock(result);
+                }
+            } else if (observers[i].failureBlock) {
+                observers[i].failureBlock(result);
+            }
+        }
+    });
+}
+
+/// 失败：断点保留，再次下载同一地址时继续
+- (void)failTask:(APIDownloadTask *)task error:(NSError *)error {
+    [self stopRequestsOfTask:task];
+    [self saveMetadataOfTask:task];
+    
+    APIError *apiError = [error isKindOfClass:[APIError class]] ? (APIError *)error : [APIError errorFromNSError:error];
+    if (!apiError.requestPath) {
+        apiError.requestPath = task.URL.absoluteString;
+    }
+    NSLog(@"❌ 下载失败: %@ - %@", task.URL.lastPathComponent, apiError.localizedDescription);
+    [self finishTask:task state:APIDownloadStateFailed error:apiError];
+}
+
+/// 结束任务并通知所有调用方
+- (void)finishTask:(APIDownloadTask *)task state:(APIDownloadState)state error:(NSError *)error {
+    task.state = state;
+    task.error = error;
+    NSArray<APIDownloadObserver *> *observers = [task.observers copy];
+    [task.observers removeAllObjects];
+    [self.tasks removeObjectForKey:task.key];
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        for (APIDownloadObserver *observer in observers) {
+            if (observer.failureBlock) {
+                observer.failureBlock(error);
+            }
+        }
+    });
+}
+
+- (void)recordReceivedBytes:(int64_t)length task:(APIDownloadTask *)task {
+    task.unsavedBytes += length;
+    task.throughputWindowBytes += length;
+    
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    NSTimeInterval elapsed = now - task.throughputWindowStart;
+    if (elapsed >= kAPIDownloadThroughputWindow) {
+        task.bytesPerSecond = task.throughputWindowBytes / elapsed;
+        task.throughputWindowStart = now;
+        task.throughputWindowBytes = 0;
+    }
+    
+    if (task.unsavedBytes >= kAPIDownloadMetadataSaveInterval) {
+        [self saveMetadataOfTask:task];
+    }
+    [self notifyProgressOfTask:task force:NO];
+}
+
+/// 下载速度（超过两个统计窗口没有数据时视为0）
+- (double)bytesPerSecondOfTask:(APIDownloadTask *)task {
+    if (task.state != APIDownloadStateDownloading ||
+        CFAbsoluteTimeGetCurrent() - task.throughputWindowStart > kAPIDownloadThroughputWindow * 2) {
+        return 0;
+    }
+    return task.bytesPerSecond;
+}
+
+- (void)notifyProgressOfTask:(APIDownloadTask *)task force:(BOOL)force {
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    if (!force && now - task.lastProgressTime < kAPIDownloadProgressInterval) {
+        return;
+    }
+    task.lastProgressTime = now;
+    task.progress.completedUnitCount = [task receivedBytes];
+    
+    NSProgress *progress = task.progress;
+    NSArray<APIDownloadObserver *> *observers = [task.observers copy];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        for (APIDownloadObserver *observer in observers) {
+            if (observer.progressBlock) {
+                observer.progressBlock(progress);
+            }
+        }
+    });
+}
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+didReceiveResponse:(NSURLResponse *)response
+ completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler {
+    APIDownloadSegment *segment = self.sessionTaskObjects[@(dataTask.taskIdentifier)];
+    if (![segment isKindOfClass:[APIDownloadSegment class]]) {
+        completionHandler(segment ? NSURLSessionResponseAllow : NSURLSessionResponseCancel);
+        return;
+    }
+    
+    APIDownloadTask *task = segment.downloadTask;
+    NSHTTPURLResponse *HTTPResponse = (NSHTTPURLResponse *)response;
+    NSInteger statusCode = [HTTPResponse isKindOfClass:[NSHTTPURLResponse class]] ? HTTPResponse.statusCode : 0;
+    int64_t offset = segment.start + segment.received;
+    
+    // 206：确认返回的是请求的位置；200：服务端忽略了Range（或If-Range不匹配，文件已变化），只有从头下载整个文件时可以接受
+    BOOL restart = NO;
+    if (statusCode == 206) {
+        restart = APIDownloadContentRangeStart([HTTPResponse valueForHTTPHeaderField:@"Content-Range"]) != offset;
+    } else if (statusCode >= 200 && statusCode < 300) {
+        restart = offset != 0 || task.segments.count > 1;
+        if (!restart && segment.length < 0 && response.expectedContentLength > 0) {
+            segment.length = response.expectedContentLength;
+            task.totalBytes = response.expectedContentLength;
+            task.progress.totalUnitCount = task.totalBytes;
+        }
+    } else if (statusCode == 416) {
+        restart = YES;
+    } else {
+        NSString *message = [NSString stringWithFormat:@"下载失败: %ld", (long)statusCode];
+        segment.error = [NSError errorWithDomain:@"APIManagerErrorDomain"
+                                            code:statusCode
+                                        userInfo:@{NSLocalizedDescriptionKey: message,
+                                                   AFNetworkingOperationFailingURLResponseErrorKey: response}];
+        completionHandler(NSURLSessionResponseCancel);
+        return;
+    }
+    
+    if (restart) {
+        completionHandler(NSURLSessionResponseCancel);
+        [self restartTaskWithoutRanges:task];
+        return;
+    }
+    
+    NSError *error = nil;
+    segment.fileHandle = [NSFileHandle fileHandleForWritingToURL:[self dataURLForTask:task] error:&error];
+    if (!segment.fileHandle || ![segment.fileHandle seekToOffset:(unsigned long long)offset error:&error]) {
+        segment.error = error;
+        completionHandler(NSURLSessionResponseCancel);
+        return;
+    }
+    completionHandler(NSURLSessionResponseAllow);
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data {
+    APIDownloadSegment *segment = self.sessionTaskObjects[@(dataTask.taskIdentifier)];
+    if (![segment isKindOfClass:[APIDownloadSegment class]] || !segment.fileHandle || segment.error) {
+        return;
+    }
+    
+    NSError *error = nil;
+    if (![segment.fileHandle writeData:data error:&error]) {
+        segment.error = error;
+        [dataTask cancel];
+        return;
+    }
+    segment.received += data.length;
+    [self recordReceivedBytes:data.length task:segment.downloadTask];
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)sessionTask didCompleteWithError:(NSError *)error {
+    id object = self.sessionTaskObjects[@(sessionTask.taskIdentifier)];
+    [self.sessionTaskObjects removeObjectForKey:@(sessionTask.taskIdentifier)];
+    [[APIManager sharedManager].taskRegistry unregisterTask:sessionTask];
+    
+    // 下载器自己取消的请求已移除回调映射，到这里的取消来自外部（如 cancelRequestsWithTag:）：取消任务，断点数据保留
+    BOOL cancelledExternally = object && [error.domain isEqualToString:NSURLErrorDomain] && error.code == NSURLErrorCancelled &&
+        !([object isKindOfClass:[APIDownloadSegment class]] && ((APIDownloadSegment *)object).error);
+    if (cancelledExternally) {
+        APIDownloadTask *task = [object isKindOfClass:[APIDownloadSegment class]] ? ((APIDownloadSegment *)object).downloadTask : object;
+        if (task && self.tasks[task.key] == task) {
+            NSLog(@"⏹️ 下载请求被取消: %@", task.URL.lastPathComponent);
+            [self cancelTaskKeepingData:task];
+        }
+        return;
+    }
+    
+    // HEAD请求：网络错误重试，HTTP错误（如不支持HEAD）按未知大小整个文件下载，真实错误由GET请求返回
+    if ([object isKindOfClass:[APIDownloadTask class]]) {
+        APIDownloadTask *task = object;
+        [task.probeJob finish];
+        task.probeJob = nil;
+        task.probeTask = nil;
+        if (error) {
+            task.probeRetryCount++;
+            if (task.probeRetryCount > self.maxRetryCount) {
+                [self failTask:task error:error];
+                return;
+            }
+            NSUInteger generation = task.generation;
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(task.probeRetryCount * NSEC_PER_SEC)), self.queue, ^{
+                if (task.generation == generation && task.state == APIDownloadStateDownloading && !task.probeTask) {
+                    [self probeTask:task];
+                }
+            });
+            return;
+        }
+        [self planSegmentsOfTask:task response:(NSHTTPURLResponse *)sessionTask.response];
+        return;
+    }
+    
+    APIDownloadSegment *segment = object;
+    if (![segment isKindOfClass:[APIDownloadSegment class]]) {
+        return;
+    }
+    [segment.job finish];
+    [segment.fileHandle closeAndReturnError:nil];
+    segment.job = nil;
+    segment.dataTask = nil;
+    segment.fileHandle = nil;
+    
+    APIDownloadTask *task = segment.downloadTask;
+    NSError *finalError = segment.error ?: error;
+    segment.error = nil;
+    if (!finalError) {
+        if (segment.length < 0) {
+            // 未知大小的文件，连接正常结束即下载完成
+            segment.length = segment.received;
+            task.totalBytes = segment.received;
+        } else if (!segment.isComplete) {
+            finalError = [NSError errorWithDomain:NSURLErrorDomain
+                                             code:NSURLErrorNetworkConnectionLost
+                                         userInfo:@{NSLocalizedDescriptionKey: @"连接提前关闭"}];
+        }
+    }
+    if (finalError) {
+        [self handleError:finalError segment:segment];
+        return;
+    }
+    
+    segment.retryCount = 0;
+    [self saveMetadataOfTask:task];
+    if ([self allSegmentsCompleteOfTask:task]) {
+        [self verifyTask:task];
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics {
+    [[APICompressionStatistics sharedStatistics] recordMetrics:metrics forTask:task];
+}
+
+#pragma mark - Persistence
+
+- (NSURL *)dataURLForTask:(APIDownloadTask *)task {
+    return [NSURL fileURLWithPath:[self.storagePath stringByAppendingPathComponent:[task.storageKey stringByAppendingPathExtension:@"download"]]];
+}
+
+- (NSURL *)metadataURLForTask:(APIDownloadTask *)task {
+    return [NSURL fileURLWithPath:[self.storagePath stringByAppendingPathComponent:[task.storageKey stringByAppendingPathExtension:@"plist"]]];
+}
+
+/// 保存断点（只有支持Range的下载可以继续）
+- (void)saveMetadataOfTask:(APIDownloadTask *)task {
+    task.unsavedBytes = 0;
+    if (!task.acceptsRanges || task.segments.count == 0) {
+        [[NSFileManager defaultManager] removeItemAtURL:[self metadataURLForTask:task] error:nil];
+        return;
+    }
+    
+    NSMutableArray<NSDictionary *> *segments = [NSMutableArray array];
+    for (APIDownloadSegment *segment in task.segments) {
+        [segments addObject:[segment dictionaryRepresentation]];
+    }
+    NSMutableDictionary *metadata = [NSMutableDictionary dictionary];
+    metadata[@"URL"] = task.URL.absoluteString;
+    metadata[@"totalBytes"] = @(task.totalBytes);
+    metadata[@"validator"] = task.validator;
+    metadata[@"segments"] = segments;
+    
+    NSError *error = nil;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:metadata format:NSPropertyListBinaryFormat_v1_0 options:0 error:&error];
+    if (!data || ![data writeToURL:[self metadataURLForTask:task] options:NSDataWritingAtomic error:&error]) {
+        NSLog(@"⚠️ 下载断点保存失败: %@", error.localizedDescription);
+    }
+}
+
+/// 读取断点，数据文件不完整或地址不一致时丢弃
+- (void)restoreMetadataOfTask:(APIDownloadTask *)task {
+    NSData *data = [NSData dataWithContentsOfURL:[self metadataURLForTask:task]];
+    NSDictionary *metadata = data ? [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:nil error:nil] : nil;
+    if (![metadata isKindOfClass:[NSDictionary class]] || ![metadata[@"URL"] isEqual:task.URL.absoluteString]) {
+        [self removeStoredDataOfTask:task];
+        return;
+    }
+    
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:[self dataURLForTask:task].path error:nil];
+    unsigned long long dataLength = attributes ? [attributes fileSize] : 0;
+    NSMutableArray<APIDownloadSegment *> *segments = [NSMutableArray array];
+    for (NSDictionary *dictionary in metadata[@"segments"]) {
+        APIDownloadSegment *segment = [[APIDownloadSegment alloc] init];
+        segment.downloadTask = task;
+        segment.start = [dictionary[@"start"] longLongValue];
+        segment.length = [dictionary[@"length"] longLongValue];
+        segment.received = [dictionary[@"received"] longLongValue];
+        if (!attributes || segment.received < 0 || (unsigned long long)(segment.start + segment.received) > dataLength) {
+            [self removeStoredDataOfTask:task];
+            return;
+        }
+        [segments addObject:segment];
+    }
+    
+    task.segments = segments;
+    task.segmentCount = segments.count;
+    task.acceptsRanges = YES;
+    task.validator = metadata[@"validator"];
+    task.totalBytes = [metadata[@"totalBytes"] longLongValue];
+    task.progress.totalUnitCount = task.totalBytes;
+    task.progress.completedUnitCount = [task receivedBytes];
+}
+
+- (void)removeStoredDataOfTask:(APIDownloadTask *)task {
+    [[NSFileManager defaultManager] removeItemAtURL:[self dataURLForTask:task] error:nil];
+    [[NSFileManager defaultManager] removeItemAtURL:[self metadataURLForTask:task] error:nil];
+    task.segments = @[];
+}
+
+@end
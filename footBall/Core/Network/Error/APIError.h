@@ -15,6 +15,8 @@ typedef NS_ENUM(NSInteger, APIErrorCode) {
     APIErrorCodeNetworkUnavailable = -1000, // 网络不可用
     APIErrorCodeTimeout = -1001,           // 请求超时
     APIErrorCodeCancelled = -1002,         // 请求取消
+    APIErrorCodeCircuitOpen = -1003,       // 接口熔断中（快速失败，未发起请求）
+    APIErrorCodeDecodingFailed = -1004,    // 响应数据解析失败（模型映射失败）
     APIErrorCodeServerError = 500,         // 服务器错误
     APIErrorCodeUnauthorized = 401,        // 未授权
     APIErrorCodeForbidden = 403,           // 禁止访问
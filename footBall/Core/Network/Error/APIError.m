@@ -6,6 +6,7 @@
 //
 
 #import "APIError.h"
+#import <AFNetworking/AFNetworking.h>
 #import <objc/runtime.h>
 
 @implementation APIError
@@ -67,6 +68,13 @@ static char kRetryCountKey;
     }
     
     APIErrorCode code = [APIError mapNSErrorCodeToErrorCode:error.code];
+    
+    // HTTP状态码错误（如401）由响应序列化器校验失败产生，按状态码映射
+    NSHTTPURLResponse *response = error.userInfo[AFNetworkingOperationFailingURLResponseErrorKey];
+    if ([response isKindOfClass:[NSHTTPURLResponse class]] && code == APIErrorCodeUnknown) {
+        code = [APIError mapBusinessCodeToErrorCode:response.statusCode];
+    }
+    
     NSString *message = error.localizedDescription ?: @"网络请求失败";
     
     return [self errorWithCode:code message:message underlyingError:error];
@@ -0,0 +1,37 @@
+//
+//  APILatencyTracker.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 延迟统计 - 按Key（路径名称）保存最近的请求耗时，计算分位数
+@interface APILatencyTracker : NSObject
+
+/// 每个Key保留的最近样本数（默认：100）
+@property (nonatomic, assign) NSUInteger capacity;
+
+/// 计算分位数所需的最少样本数（默认：20），样本不足时分位数为0
+@property (nonatomic, assign) NSUInteger minimumSampleCount;
+
+/// 记录一次请求耗时
+/// @param latency 耗时（秒）
+/// @param key Key（路径名称）
+- (void)recordLatency:(NSTimeInterval)latency forKey:(NSString *)key;
+
+/// 最近耗时的分位数
+/// @param percentile 分位（0~1，如0.95）
+/// @param key Key（路径名称）
+/// @return 样本不足时返回0
+- (NSTimeInterval)latencyAtPercentile:(double)percentile forKey:(NSString *)key;
+
+/// 清空统计
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
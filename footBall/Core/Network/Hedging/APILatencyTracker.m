@@ -0,0 +1,70 @@
+//
+//  APILatencyTracker.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APILatencyTracker.h"
+
+@interface APILatencyTracker ()
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<NSNumber *> *> *samples; // Key -> 最近的耗时（按时间递增）
+
+@end
+
+@implementation APILatencyTracker
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _capacity = 100;
+        _minimumSampleCount = 20;
+        _samples = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)recordLatency:(NSTimeInterval)latency forKey:(NSString *)key {
+    if (key.length == 0 || latency < 0) {
+        return;
+    }
+    
+    @synchronized (self) {
+        NSMutableArray<NSNumber *> *latencies = self.samples[key];
+        if (!latencies) {
+            latencies = [NSMutableArray array];
+            self.samples[key] = latencies;
+        }
+        
+        [latencies addObject:@(latency)];
+        if (latencies.count > self.capacity) {
+            [latencies removeObjectsInRange:NSMakeRange(0, latencies.count - self.capacity)];
+        }
+    }
+}
+
+- (NSTimeInterval)latencyAtPercentile:(double)percentile forKey:(NSString *)key {
+    NSArray<NSNumber *> *latencies = nil;
+    @synchronized (self) {
+        latencies = [self.samples[key] copy];
+    }
+    
+    if (latencies.count == 0 || latencies.count < self.minimumSampleCount) {
+        return 0;
+    }
+    
+    NSArray<NSNumber *> *sortedLatencies = [latencies sortedArrayUsingSelector:@selector(compare:)];
+    double clampedPercentile = MIN(MAX(percentile, 0), 1);
+    NSUInteger index = (NSUInteger)ceil(clampedPercentile * sortedLatencies.count);
+    index = MIN(MAX(index, 1), sortedLatencies.count) - 1;
+    return [sortedLatencies[index] doubleValue];
+}
+
+- (void)reset {
+    @synchronized (self) {
+        [self.samples removeAllObjects];
+    }
+}
+
+@end
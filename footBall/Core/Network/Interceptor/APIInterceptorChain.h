@@ -0,0 +1,101 @@
+//
+//  APIInterceptorChain.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import "APIRequestInterceptor.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 单个拦截器阶段的耗时统计
+@interface APIInterceptorStatisticsEntry : NSObject <NSCopying>
+
+/// 拦截器名称（类名）
+@property (nonatomic, copy, readonly) NSString *interceptorName;
+
+/// 阶段
+@property (nonatomic, assign, readonly) APIInterceptorPhase phase;
+
+/// 执行次数
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/// 总耗时（秒）
+@property (nonatomic, assign, readonly) NSTimeInterval totalDuration;
+
+/// 最大耗时（秒）
+@property (nonatomic, assign, readonly) NSTimeInterval maxDuration;
+
+/// 平均耗时（秒）
+- (NSTimeInterval)averageDuration;
+
+@end
+
+/// 拦截器耗时统计 - 按拦截器和阶段累计，用于找出增加请求延迟的拦截器
+@interface APIInterceptorStatistics : NSObject
+
+/// 单例
++ (instancetype)sharedStatistics;
+
+/// 记录一次拦截器阶段的耗时
+/// @param duration 耗时（秒）
+/// @param interceptorName 拦截器名称
+/// @param phase 阶段
+- (void)recordDuration:(NSTimeInterval)duration forInterceptorName:(NSString *)interceptorName phase:(APIInterceptorPhase)phase;
+
+/// 所有统计（按总耗时降序）
+- (NSArray<APIInterceptorStatisticsEntry *> *)allEntries;
+
+/// 清空统计
+- (void)reset;
+
+/// 阶段名称
++ (NSString *)displayNameForPhase:(APIInterceptorPhase)phase;
+
+@end
+
+/// 拦截器链 - 依次执行拦截器的请求、响应和错误阶段，每个阶段可以异步完成
+/// 创建时保存拦截器数组的快照，同一请求的所有尝试使用同一个拦截器链；每个阶段的耗时记录到上下文和 APIInterceptorStatistics
+@interface APIInterceptorChain : NSObject
+
+/// 拦截器（按顺序执行）
+@property (nonatomic, copy, readonly) NSArray<id<APIRequestInterceptor>> *interceptors;
+
+/// 初始化方法
+/// @param interceptors 拦截器
+- (instancetype)initWithInterceptors:(NSArray<id<APIRequestInterceptor>> *)interceptors NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// 执行请求阶段
+/// @param request 请求
+/// @param context 请求上下文
+/// @param completion 完成回调，传入处理后的请求，nil表示请求被取消
+/// @return 返回前completion是否已执行完成（所有拦截器都同步完成时为YES）
+- (BOOL)processRequest:(NSURLRequest *)request
+               context:(APIInterceptorContext *)context
+            completion:(void(^)(NSURLRequest * _Nullable request))completion;
+
+/// 执行响应阶段
+/// @param response HTTP响应
+/// @param responseObject 解码后的响应数据
+/// @param context 请求上下文
+/// @param completion 完成回调，传入是否继续处理响应
+- (void)processResponse:(nullable NSHTTPURLResponse *)response
+         responseObject:(nullable id)responseObject
+                context:(APIInterceptorContext *)context
+             completion:(void(^)(BOOL shouldContinue))completion;
+
+/// 执行错误阶段
+/// @param error 错误信息
+/// @param context 请求上下文
+/// @param completion 完成回调，传入处理后的错误，nil表示错误已处理
+- (void)processError:(NSError *)error
+             context:(APIInterceptorContext *)context
+          completion:(void(^)(NSError * _Nullable error))completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
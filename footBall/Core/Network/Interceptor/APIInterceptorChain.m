@@ -0,0 +1,258 @@
+//
+//  APIInterceptorChain.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIInterceptorChain.h"
+
+@interface APIInterceptorStatisticsEntry ()
+
+@property (nonatomic, copy) NSString *interceptorName;
+@property (nonatomic, assign) APIInterceptorPhase phase;
+@property (nonatomic, assign) NSUInteger count;
+@property (nonatomic, assign) NSTimeInterval totalDuration;
+@property (nonatomic, assign) NSTimeInterval maxDuration;
+
+@end
+
+@implementation APIInterceptorStatisticsEntry
+
+- (NSTimeInterval)averageDuration {
+    return self.count > 0 ? self.totalDuration / self.count : 0;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    APIInterceptorStatisticsEntry *entry = [[APIInterceptorStatisticsEntry allocWithZone:zone] init];
+    entry.interceptorName = self.interceptorName;
+    entry.phase = self.phase;
+    entry.count = self.count;
+    entry.totalDuration = self.totalDuration;
+    entry.maxDuration = self.maxDuration;
+    return entry;
+}
+
+@end
+
+@interface APIInterceptorStatistics ()
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, APIInterceptorStatisticsEntry *> *entries; // 拦截器名称|阶段 -> 统计
+
+@end
+
+@implementation APIInterceptorStatistics
+
++ (instancetype)sharedStatistics {
+    static APIInterceptorStatistics *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[APIInterceptorStatistics alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _entries = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)recordDuration:(NSTimeInterval)duration forInterceptorName:(NSString *)interceptorName phase:(APIInterceptorPhase)phase {
+    NSString *key = [NSString stringWithFormat:@"%@|%ld", interceptorName, (long)phase];
+    @synchronized (self.entries) {
+        APIInterceptorStatisticsEntry *entry = self.entries[key];
+        if (!entry) {
+            entry = [[APIInterceptorStatisticsEntry alloc] init];
+            entry.interceptorName = interceptorName;
+            entry.phase = phase;
+            self.entries[key] = entry;
+        }
+        entry.count++;
+        entry.totalDuration += duration;
+        entry.maxDuration = MAX(entry.maxDuration, duration);
+    }
+}
+
+- (NSArray<APIInterceptorStatisticsEntry *> *)allEntries {
+    NSMutableArray<APIInterceptorStatisticsEntry *> *entries = [NSMutableArray array];
+    @synchronized (self.entries) {
+        for (APIInterceptorStatisticsEntry *entry in self.entries.allValues) {
+            [entries addObject:[entry copy]];
+        }
+    }
+    return [entries sortedArrayUsingComparator:^NSComparisonResult(APIInterceptorStatisticsEntry *obj1, APIInterceptorStatisticsEntry *obj2) {
+        return [@(obj2.totalDuration) compare:@(obj1.totalDuration)];
+    }];
+}
+
+- (void)reset {
+    @synchronized (self.entries) {
+        [self.entries removeAllObjects];
+    }
+}
+
++ (NSString *)displayNameForPhase:(APIInterceptorPhase)phase {
+    switch (phase) {
+        case APIInterceptorPhaseRequest:
+            return @"请求";
+        case APIInterceptorPhaseResponse:
+            return @"响应";
+        case APIInterceptorPhaseError:
+            return @"错误";
+    }
+    return @"未知";
+}
+
+@end
+
+@implementation APIInterceptorChain
+
+- (instancetype)initWithInterceptors:(NSArray<id<APIRequestInterceptor>> *)interceptors {
+    self = [super init];
+    if (self) {
+        _interceptors = [interceptors copy];
+    }
+    return self;
+}
+
+#pragma mark - Public Methods
+
+- (BOOL)processRequest:(NSURLRequest *)request
+               context:(APIInterceptorContext *)context
+            completion:(void(^)(NSURLRequest * _Nullable request))completion {
+    // completion执行完后才标记完成：返回YES时调用方可以安全读取completion中写入的结果
+    NSObject *lock = [[NSObject alloc] init];
+    __block BOOL finished = NO;
+    [self runRequestStageAtIndex:0 request:request context:context completion:^(NSURLRequest *interceptedRequest) {
+        completion(interceptedRequest);
+        @synchronized (lock) {
+            finished = YES;
+        }
+    }];
+    @synchronized (lock) {
+        return finished;
+    }
+}
+
+- (void)processResponse:(nullable NSHTTPURLResponse *)response
+         responseObject:(nullable id)responseObject
+                context:(APIInterceptorContext *)context
+             completion:(void(^)(BOOL shouldContinue))completion {
+    [self runResponseStageAtIndex:0 response:response responseObject:responseObject context:context completion:completion];
+}
+
+- (void)processError:(NSError *)error
+             context:(APIInterceptorContext *)context
+          completion:(void(^)(NSError * _Nullable error))completion {
+    [self runErrorStageAtIndex:0 error:error context:context completion:completion];
+}
+
+#pragma mark - Private Methods
+
+- (void)runRequestStageAtIndex:(NSUInteger)index
+                       request:(NSURLRequest *)request
+                       context:(APIInterceptorContext *)context
+                    completion:(void(^)(NSURLRequest * _Nullable request))completion {
+    if (index >= self.interceptors.count) {
+        completion(request);
+        return;
+    }
+    
+    id<APIRequestInterceptor> interceptor = self.interceptors[index];
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    void (^next)(NSURLRequest *) = ^(NSURLRequest *interceptedRequest) {
+        [self recordDurationSince:startTime interceptor:interceptor phase:APIInterceptorPhaseRequest context:context];
+        if (!interceptedRequest) {
+            completion(nil);
+            return;
+        }
+        [self runRequestStageAtIndex:index + 1 request:interceptedRequest context:context completion:completion];
+    };
+    
+    if ([interceptor respondsToSelector:@selector(interceptRequest:context:completion:)]) {
+        [interceptor interceptRequest:request context:context completion:next];
+    } else if ([interceptor respondsToSelector:@selector(interceptRequest:context:)]) {
+        next([interceptor interceptRequest:request context:context]);
+    } else if ([interceptor respondsToSelector:@selector(interceptRequest:)]) {
+        next([interceptor interceptRequest:request]);
+    } else {
+        [self runRequestStageAtIndex:index + 1 request:request context:context completion:completion];
+    }
+}
+
+- (void)runResponseStageAtIndex:(NSUInteger)index
+                       response:(nullable NSHTTPURLResponse *)response
+                 responseObject:(nullable id)responseObject
+                        context:(APIInterceptorContext *)context
+                     completion:(void(^)(BOOL shouldContinue))completion {
+    if (index >= self.interceptors.count) {
+        completion(YES);
+        return;
+    }
+    
+    id<APIRequestInterceptor> interceptor = self.interceptors[index];
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    void (^next)(BOOL) = ^(BOOL shouldContinue) {
+        [self recordDurationSince:startTime interceptor:interceptor phase:APIInterceptorPhaseResponse context:context];
+        if (!shouldContinue) {
+            completion(NO);
+            return;
+        }
+        [self runResponseStageAtIndex:index + 1 response:response responseObject:responseObject context:context completion:completion];
+    };
+    
+    if ([interceptor respondsToSelector:@selector(interceptResponse:responseObject:context:completion:)]) {
+        [interceptor interceptResponse:response responseObject:responseObject context:context completion:next];
+    } else if ([interceptor respondsToSelector:@selector(interceptResponse:data:error:)]) {
+        next([interceptor interceptResponse:response data:nil error:nil]);
+    } else {
+        [self runResponseStageAtIndex:index + 1 response:response responseObject:responseObject context:context completion:completion];
+    }
+}
+
+- (void)runErrorStageAtIndex:(NSUInteger)index
+                       error:(NSError *)error
+                     context:(APIInterceptorContext *)context
+                  completion:(void(^)(NSError * _Nullable error))completion {
+    if (index >= self.interceptors.count) {
+        completion(error);
+        return;
+    }
+    
+    id<APIRequestInterceptor> interceptor = self.interceptors[index];
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    void (^next)(NSError *) = ^(NSError *interceptedError) {
+        [self recordDurationSince:startTime interceptor:interceptor phase:APIInterceptorPhaseError context:context];
+        if (!interceptedError) {
+            completion(nil);
+            return;
+        }
+        [self runErrorStageAtIndex:index + 1 error:interceptedError context:context completion:completion];
+    };
+    
+    if ([interceptor respondsToSelector:@selector(interceptError:context:completion:)]) {
+        [interceptor interceptError:error context:context completion:next];
+    } else if ([interceptor respondsToSelector:@selector(interceptError:context:)]) {
+        next([interceptor interceptError:error context:context]);
+    } else if ([interceptor respondsToSelector:@selector(interceptError:)]) {
+        next([interceptor interceptError:error]);
+    } else {
+        [self runErrorStageAtIndex:index + 1 error:error context:context completion:completion];
+    }
+}
+
+/// 记录拦截器阶段耗时（只记录实现了该阶段的拦截器）
+- (void)recordDurationSince:(CFAbsoluteTime)startTime
+                interceptor:(id<APIRequestInterceptor>)interceptor
+                      phase:(APIInterceptorPhase)phase
+                    context:(APIInterceptorContext *)context {
+    NSTimeInterval duration = CFAbsoluteTimeGetCurrent() - startTime;
+    NSString *interceptorName = NSStringFromClass([interceptor class]);
+    [context recordDuration:duration forInterceptorName:interceptorName phase:phase];
+    [[APIInterceptorStatistics sharedStatistics] recordDuration:duration forInterceptorName:interceptorName phase:phase];
+}
+
+@end
@@ -0,0 +1,79 @@
+//
+//  APIInterceptorContext.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class APIRequestOptions;
+
+/// 拦截器阶段
+typedef NS_ENUM(NSInteger, APIInterceptorPhase) {
+    APIInterceptorPhaseRequest = 0, // 请求发送前
+    APIInterceptorPhaseResponse,    // 收到响应后
+    APIInterceptorPhaseError        // 请求失败后
+};
+
+/// 拦截器单个阶段的耗时
+@interface APIInterceptorTiming : NSObject
+
+/// 拦截器名称（类名）
+@property (nonatomic, copy, readonly) NSString *interceptorName;
+
+/// 阶段
+@property (nonatomic, assign, readonly) APIInterceptorPhase phase;
+
+/// 耗时（秒，从调用拦截器到它完成，包括异步等待的时间）
+@property (nonatomic, assign, readonly) NSTimeInterval duration;
+
+@end
+
+/// 拦截器上下文 - 一次请求尝试的只读信息，拦截器需要保存的状态放在userInfo中（不再挂在NSURLRequest的关联对象上）
+/// 每次尝试（首次请求、重试、Token刷新后的重放）创建新的上下文，同一次尝试的请求、响应和错误阶段共享；userInfo在同一请求的所有尝试间共享
+@interface APIInterceptorContext : NSObject
+
+/// 请求方法（如 @"GET"）
+@property (nonatomic, copy, readonly) NSString *HTTPMethod;
+
+/// 完整请求地址
+@property (nonatomic, copy, readonly) NSString *URLString;
+
+/// 请求选项（可选）
+@property (nonatomic, copy, readonly, nullable) APIRequestOptions *options;
+
+/// 已重试次数（首次请求为0）
+@property (nonatomic, assign, readonly) NSInteger retryCount;
+
+/// 拦截器自定义数据（同一请求的拦截器按顺序执行，不需要加锁；key建议带拦截器前缀）
+@property (nonatomic, strong, readonly) NSMutableDictionary<NSString *, id> *userInfo;
+
+/// 本次尝试中各拦截器阶段的耗时（按执行顺序）
+@property (nonatomic, copy, readonly) NSArray<APIInterceptorTiming *> *timings;
+
+/// 记录拦截器阶段的耗时（由 APIInterceptorChain 调用）
+/// @param duration 耗时（秒）
+/// @param interceptorName 拦截器名称
+/// @param phase 阶段
+- (void)recordDuration:(NSTimeInterval)duration forInterceptorName:(NSString *)interceptorName phase:(APIInterceptorPhase)phase;
+
+/// 初始化方法
+/// @param methodString 请求方法
+/// @param URLString 完整请求地址
+/// @param options 请求选项
+/// @param retryCount 已重试次数
+/// @param userInfo 同一请求共享的自定义数据（nil时新建）
+- (instancetype)initWithHTTPMethod:(NSString *)methodString
+                         URLString:(NSString *)URLString
+                           options:(nullable APIRequestOptions *)options
+                        retryCount:(NSInteger)retryCount
+                          userInfo:(nullable NSMutableDictionary<NSString *, id> *)userInfo NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
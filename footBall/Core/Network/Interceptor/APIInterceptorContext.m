@@ -0,0 +1,64 @@
+//
+//  APIInterceptorContext.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIInterceptorContext.h"
+#import "APIRequestOptions.h"
+
+@interface APIInterceptorTiming ()
+
+@property (nonatomic, copy, readwrite) NSString *interceptorName;
+@property (nonatomic, assign, readwrite) APIInterceptorPhase phase;
+@property (nonatomic, assign, readwrite) NSTimeInterval duration;
+
+@end
+
+@implementation APIInterceptorTiming
+
+@end
+
+@interface APIInterceptorContext ()
+
+@property (nonatomic, strong) NSMutableArray<APIInterceptorTiming *> *mutableTimings;
+
+@end
+
+@implementation APIInterceptorContext
+
+- (instancetype)initWithHTTPMethod:(NSString *)methodString
+                         URLString:(NSString *)URLString
+                           options:(nullable APIRequestOptions *)options
+                        retryCount:(NSInteger)retryCount
+                          userInfo:(nullable NSMutableDictionary<NSString *, id> *)userInfo {
+    self = [super init];
+    if (self) {
+        _HTTPMethod = [methodString copy];
+        _URLString = [URLString copy];
+        _options = [options copy];
+        _retryCount = retryCount;
+        _userInfo = userInfo ?: [NSMutableDictionary dictionary];
+        _mutableTimings = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (NSArray<APIInterceptorTiming *> *)timings {
+    @synchronized (self.mutableTimings) {
+        return [self.mutableTimings copy];
+    }
+}
+
+- (void)recordDuration:(NSTimeInterval)duration forInterceptorName:(NSString *)interceptorName phase:(APIInterceptorPhase)phase {
+    APIInterceptorTiming *timing = [[APIInterceptorTiming alloc] init];
+    timing.interceptorName = interceptorName;
+    timing.phase = phase;
+    timing.duration = duration;
+    @synchronized (self.mutableTimings) {
+        [self.mutableTimings addObject:timing];
+    }
+}
+
+@end
@@ -6,13 +6,18 @@
 //
 
 #import <Foundation/Foundation.h>
+#import "APIInterceptorContext.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
 @class NSURLRequest;
 @class NSURLResponse;
+@class NSHTTPURLResponse;
 
 /// 请求拦截器协议 - 用于统一处理请求和响应
+/// 每个请求单独构建NSURLRequest，拦截器可能在任意线程被并发调用，不要修改共享状态；同一请求的状态放在上下文的userInfo中
+/// 每个阶段可以实现异步方法（带completion，如需要等待的请求签名），异步方法优先于同步方法；completion必须且只能调用一次，可以在任意线程调用
+/// @note 异步方法只在通用请求方法（GET/POST/PUT/DELETE/PATCH）中可以异步完成；文件上传、流式请求、分片上传和下载要求拦截器同步完成，否则请求被取消
 @protocol APIRequestInterceptor <NSObject>
 
 @optional
@@ -22,6 +27,20 @@ NS_ASSUME_NONNULL_BEGIN
 /// @return 修改后的请求，返回nil表示取消请求
 - (nullable NSURLRequest *)interceptRequest:(NSURLRequest *)request;
 
+/// 拦截请求（带上下文，实现后不再调用 interceptRequest:）
+/// @param request 原始请求
+/// @param context 请求上下文
+/// @return 修改后的请求，返回nil表示取消请求
+- (nullable NSURLRequest *)interceptRequest:(NSURLRequest *)request context:(APIInterceptorContext *)context;
+
+/// 拦截请求（异步）
+/// @param request 原始请求
+/// @param context 请求上下文
+/// @param completion 完成回调，传入修改后的请求，传入nil表示取消请求
+- (void)interceptRequest:(NSURLRequest *)request
+                 context:(APIInterceptorContext *)context
+              completion:(void(^)(NSURLRequest * _Nullable request))completion;
+
 /// 拦截响应（在收到响应后调用）
 /// @param response 响应对象
 /// @param data 响应数据
@@ -31,26 +50,90 @@ NS_ASSUME_NONNULL_BEGIN
                      data:(nullable NSData *)data
                     error:(nullable NSError *)error;
 
+/// 拦截响应（异步，实现后不再调用 interceptResponse:data:error:）
+/// @param response HTTP响应
+/// @param responseObject 解码后的响应数据（AFNetworking在会话队列中解码，不保留原始字节）
+/// @param context 请求上下文
+/// @param completion 完成回调，传入是否继续处理响应，NO表示拦截器已处理完成
+- (void)interceptResponse:(nullable NSHTTPURLResponse *)response
+           responseObject:(nullable id)responseObject
+                  context:(APIInterceptorContext *)context
+               completion:(void(^)(BOOL shouldContinue))completion;
+
 /// 拦截错误（在请求失败时调用）
 /// @param error 错误信息
 /// @return 处理后的错误，返回nil表示错误已处理
 - (nullable NSError *)interceptError:(NSError *)error;
 
+/// 拦截错误（带上下文，实现后不再调用 interceptError:）
+/// @param error 错误信息
+/// @param context 请求上下文
+/// @return 处理后的错误，返回nil表示错误已处理
+- (nullable NSError *)interceptError:(NSError *)error context:(APIInterceptorContext *)context;
+
+/// 拦截错误（异步）
+/// @param error 错误信息
+/// @param context 请求上下文
+/// @param completion 完成回调，传入处理后的错误，传入nil表示错误已处理
+- (void)interceptError:(NSError *)error
+               context:(APIInterceptorContext *)context
+            completion:(void(^)(NSError * _Nullable error))completion;
+
 @end
 
 /// 认证拦截器 - 自动添加Token等认证信息
+/// Token刷新完成回调（失败时error为刷新请求的错误，可以区分网络错误和服务器拒绝刷新）
+typedef void(^APITokenRefreshCompletionBlock)(BOOL success, NSError * _Nullable error);
+
 @interface APIAuthenticationInterceptor : NSObject <APIRequestInterceptor>
 
 /// Token获取回调
 @property (nonatomic, copy, nullable) NSString *(^tokenProvider)(void);
 
-/// Token刷新回调
-@property (nonatomic, copy, nullable) void(^tokenRefreshHandler)(void(^completion)(BOOL success));
+/// Token刷新回调（由调用方执行实际的刷新请求，完成后回调结果）
+@property (nonatomic, copy, nullable) void(^tokenRefreshHandler)(APITokenRefreshCompletionBlock completion);
+
+/// Token过期时间获取回调（如解析JWT的exp，返回nil表示未知）
+@property (nonatomic, copy, nullable) NSDate * _Nullable (^tokenExpirationProvider)(void);
+
+/// 刷新Token接口的完整地址获取回调（如从当前环境的路由表取 APIPathNameAuthRefresh 的地址），该接口的请求不会被挂起
+/// 每次判断时调用，切换环境或更新路径配置后自动使用新地址
+@property (nonatomic, copy, nullable) NSString * _Nullable (^refreshURLProvider)(void);
+
+/// 提前刷新时间（秒，默认：60）：Token在该时间内即将过期时，后台主动刷新，避免在请求路径上遇到401
+@property (nonatomic, assign) NSTimeInterval proactiveRefreshInterval;
+
+/// 是否正在刷新Token
+@property (nonatomic, assign, readonly, getter=isRefreshing) BOOL refreshing;
+
+/// 是否正在因401或Token过期刷新（此时新请求挂起等待刷新结果）
+/// 提前刷新时为NO：当前Token仍然有效，新请求照常发出
+@property (nonatomic, assign, readonly, getter=isRefreshingReactively) BOOL refreshingReactively;
+
+/// 是否可以刷新Token（已设置tokenRefreshHandler）
+@property (nonatomic, assign, readonly) BOOL canRefreshToken;
+
+/// Token是否已过期（过期时间未知时为NO）
+@property (nonatomic, assign, readonly, getter=isTokenExpired) BOOL tokenExpired;
 
 /// 初始化方法
 /// @param tokenProvider Token提供者
 - (instancetype)initWithTokenProvider:(nullable NSString *(^)(void))tokenProvider;
 
+/// 刷新Token（单飞：刷新进行中时只登记回调，同一时间只会发起一次刷新）
+/// 用于401或Token过期，刷新期间 isRefreshingReactively 为YES；进行中的提前刷新同样转为这种刷新
+/// @param completion 刷新完成回调（主线程）
+- (void)refreshTokenWithCompletion:(nullable APITokenRefreshCompletionBlock)completion;
+
+/// 是否为刷新Token接口的请求（主机和完整路径都相同，只是结尾相同的其他接口不算）
+/// @param URL 请求URL
+- (BOOL)isTokenRefreshURL:(nullable NSURL *)URL;
+
+/// 请求的Authorization头是否为当前Token
+/// 返回NO说明请求发出后Token已经刷新（如同时401的请求中较早的一个已完成刷新），收到401时直接用新Token重放即可
+/// @param request 实际发出的请求
+- (BOOL)requestUsesCurrentToken:(NSURLRequest *)request;
+
 @end
 
 /// 日志拦截器 - 记录请求和响应日志
@@ -8,6 +8,14 @@
 #import "APIRequestInterceptor.h"
 #import "APIError.h"
 
+@interface APIAuthenticationInterceptor ()
+
+@property (nonatomic, assign, getter=isRefreshing) BOOL refreshing;
+@property (nonatomic, assign, getter=isRefreshingReactively) BOOL refreshingReactively;
+@property (nonatomic, strong) NSMutableArray<APITokenRefreshCompletionBlock> *pendingRefreshCompletions; // 等待刷新结果的回调
+
+@end
+
 @implementation APIAuthenticationInterceptor
 
 - (instancetype)init {
@@ -18,15 +26,109 @@
     self = [super init];
     if (self) {
         _tokenProvider = tokenProvider;
+        _proactiveRefreshInterval = 60.0;
+        _pendingRefreshCompletions = [NSMutableArray array];
     }
     return self;
 }
 
+- (BOOL)canRefreshToken {
+    return self.tokenRefreshHandler != nil;
+}
+
+- (BOOL)isTokenExpired {
+    NSDate *expirationDate = self.tokenExpirationProvider ? self.tokenExpirationProvider() : nil;
+    return expirationDate && [expirationDate timeIntervalSinceNow] <= 0;
+}
+
+- (BOOL)isTokenRefreshURL:(nullable NSURL *)URL {
+    NSString *refreshURLString = self.refreshURLProvider ? self.refreshURLProvider() : nil;
+    NSURL *refreshURL = refreshURLString.length > 0 ? [NSURL URLWithString:refreshURLString] : nil;
+    if (!refreshURL || !URL) {
+        return NO;
+    }
+    
+    if (refreshURL.host.length > 0 && [refreshURL.host caseInsensitiveCompare:URL.host ?: @""] != NSOrderedSame) {
+        return NO;
+    }
+    return [URL.path isEqualToString:refreshURL.path];
+}
+
+- (void)refreshTokenWithCompletion:(nullable APITokenRefreshCompletionBlock)completion {
+    [self refreshTokenReactively:YES completion:completion];
+}
+
+/// 发起或加入刷新
+/// @param reactive 是否因401或Token过期刷新（提前刷新时新请求不挂起）
+- (void)refreshTokenReactively:(BOOL)reactive completion:(nullable APITokenRefreshCompletionBlock)completion {
+    @synchronized (self) {
+        if (completion) {
+            [self.pendingRefreshCompletions addObject:[completion copy]];
+        }
+        if (reactive) {
+            self.refreshingReactively = YES;
+        }
+        if (self.isRefreshing) {
+            return;
+        }
+        self.refreshing = YES;
+    }
+    
+    // 异步发起刷新，避免在拦截器执行过程中重入APIManager
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (!self.tokenRefreshHandler) {
+            [self finishRefreshingWithSuccess:NO error:nil];
+            return;
+        }
+        
+        NSLog(@"🔑 开始%@刷新Token", self.isRefreshingReactively ? @"" : @"提前");
+        self.tokenRefreshHandler(^(BOOL success, NSError * _Nullable error) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [self finishRefreshingWithSuccess:success error:error];
+            });
+        });
+    });
+}
+
+- (void)finishRefreshingWithSuccess:(BOOL)success error:(nullable NSError *)error {
+    NSArray<APITokenRefreshCompletionBlock> *completions = nil;
+    @synchronized (self) {
+        completions = [self.pendingRefreshCompletions copy];
+        [self.pendingRefreshCompletions removeAllObjects];
+        self.refreshing = NO;
+        self.refreshingReactively = NO;
+    }
+    
+    NSLog(@"%@ Token刷新%@，恢复 %ld 个等待中的请求", success ? @"✅" : @"❌", success ? @"成功" : @"失败", (long)completions.count);
+    for (APITokenRefreshCompletionBlock completion in completions) {
+        completion(success, success ? nil : error);
+    }
+}
+
+- (BOOL)requestUsesCurrentToken:(NSURLRequest *)request {
+    NSString *token = self.tokenProvider ? self.tokenProvider() : nil;
+    if (token.length == 0) {
+        // 没有可用的Token，只能刷新
+        return YES;
+    }
+    
+    NSString *currentAuthorization = [NSString stringWithFormat:@"Bearer %@", token];
+    return [[request valueForHTTPHeaderField:@"Authorization"] isEqualToString:currentAuthorization];
+}
+
 - (nullable NSURLRequest *)interceptRequest:(NSURLRequest *)request {
     if (!self.tokenProvider) {
         return request;
     }
     
+    // Token即将过期：后台主动刷新，当前请求和刷新期间的新请求仍使用未过期的Token
+    if (self.canRefreshToken && !self.isRefreshing && ![self isTokenRefreshURL:request.URL]) {
+        NSDate *expirationDate = self.tokenExpirationProvider ? self.tokenExpirationProvider() : nil;
+        if (expirationDate && [expirationDate timeIntervalSinceNow] < self.proactiveRefreshInterval) {
+            [self refreshTokenReactively:NO completion:nil];
+        }
+    }
+    
     NSString *token = self.tokenProvider();
     if (!token || token.length == 0) {
         return request;
@@ -56,12 +158,16 @@
     return self;
 }
 
-- (nullable NSURLRequest *)interceptRequest:(NSURLRequest *)request {
+- (nullable NSURLRequest *)interceptRequest:(NSURLRequest *)request context:(APIInterceptorContext *)context {
     if (!self.enabled || self.logLevel < 1) {
         return request;
     }
     
-    NSLog(@"🌐 [API Request] %@ %@", request.HTTPMethod, request.URL.absoluteString);
+    if (context.retryCount > 0) {
+        NSLog(@"🌐 [API Request] %@ %@（第 %ld 次重试）", request.HTTPMethod, request.URL.absoluteString, (long)context.retryCount);
+    } else {
+        NSLog(@"🌐 [API Request] %@ %@", request.HTTPMethod, request.URL.absoluteString);
+    }
     
     if (self.logLevel >= 2 && request.HTTPBody) {
         NSString *bodyString = [[NSString alloc] initWithData:request.HTTPBody encoding:NSUTF8StringEncoding];
@@ -75,25 +181,32 @@
     return request;
 }
 
-- (BOOL)interceptResponse:(NSURLResponse *)response
-                     data:(nullable NSData *)data
-                    error:(nullable NSError *)error {
-    if (!self.enabled || self.logLevel < 1) {
-        return YES;
-    }
-    
-    if (error) {
-        NSLog(@"❌ [API Error] %@", error.localizedDescription);
-    } else {
-        NSLog(@"✅ [API Response] %@", ((NSHTTPURLResponse *)response).statusCode);
+- (void)interceptResponse:(nullable NSHTTPURLResponse *)response
+           responseObject:(nullable id)responseObject
+                  context:(APIInterceptorContext *)context
+               completion:(void (^)(BOOL))completion {
+    if (self.enabled && self.logLevel >= 1) {
+        NSLog(@"✅ [API Response] %ld %@", (long)response.statusCode, context.URLString);
         
-        if (self.logLevel >= 2 && data) {
-            NSString *responseString = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
-            NSLog(@"📥 [Response Body] %@", responseString);
+        if (self.logLevel >= 2 && responseObject) {
+            NSLog(@"📥 [Response Body] %@", responseObject);
+        }
+        if (self.logLevel >= 2 && context.timings.count > 0) {
+            NSMutableArray<NSString *> *timings = [NSMutableArray array];
+            for (APIInterceptorTiming *timing in context.timings) {
+                [timings addObject:[NSString stringWithFormat:@"%@ %.2fms", timing.interceptorName, timing.duration * 1000]];
+            }
+            NSLog(@"⏱️ [Interceptors] %@", [timings componentsJoinedByString:@", "]);
         }
     }
-    
-    return YES;
+    completion(YES);
+}
+
+- (nullable NSError *)interceptError:(NSError *)error context:(APIInterceptorContext *)context {
+    if (self.enabled && self.logLevel >= 1) {
+        NSLog(@"❌ [API Error] %@ %@", context.URLString, error.localizedDescription);
+    }
+    return error;
 }
 
 @end
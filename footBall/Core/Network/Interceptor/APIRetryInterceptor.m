@@ -7,19 +7,6 @@
 
 #import "APIRetryInterceptor.h"
 #import "APIError.h"
-#import <objc/runtime.h>
-
-// 使用关联对象存储请求信息，用于重试
-static char kRequestInfoKey;
-
-@interface APIRetryRequestInfo : NSObject
-@property (nonatomic, strong) NSURLRequest *request;
-@property (nonatomic, copy) void(^retryBlock)(void);
-@property (nonatomic, assign) NSInteger retryCount;
-@end
-
-@implementation APIRetryRequestInfo
-@end
 
 @implementation APIRetryInterceptor
 
@@ -38,21 +25,7 @@ static char kRequestInfoKey;
     return self;
 }
 
-- (nullable NSURLRequest *)interceptRequest:(NSURLRequest *)request {
-    if (!self.enabled) {
-        return request;
-    }
-    
-    // 存储请求信息，用于重试
-    APIRetryRequestInfo *requestInfo = [[APIRetryRequestInfo alloc] init];
-    requestInfo.request = request;
-    requestInfo.retryCount = 0;
-    objc_setAssociatedObject(request, &kRequestInfoKey, requestInfo, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
-    
-    return request;
-}
-
-- (nullable NSError *)interceptError:(NSError *)error {
+- (nullable NSError *)interceptError:(NSError *)error context:(APIInterceptorContext *)context {
     if (!self.enabled) {
         return error;
     }
@@ -71,14 +44,14 @@ static char kRequestInfoKey;
         return apiError;
     }
     
-    // 检查是否超过配置的最大重试次数
-    if (apiError.retryCount >= self.maxRetryCount) {
+    // 检查是否超过配置的最大重试次数（重试次数由请求上下文记录）
+    if (context.retryCount >= self.maxRetryCount) {
         NSLog(@"⚠️ 已达到配置的最大重试次数 %ld，停止重试", (long)self.maxRetryCount);
         return apiError;
     }
     
     // 增加重试次数
-    apiError.retryCount = apiError.retryCount + 1;
+    apiError.retryCount = context.retryCount + 1;
     apiError.maxRetryCount = self.maxRetryCount;
     apiError.retryInterval = self.retryInterval;
     
@@ -0,0 +1,116 @@
+//
+//  APIMetricsStore.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 请求耗时阶段
+typedef NS_ENUM(NSInteger, APIMetricsPhase) {
+    APIMetricsPhaseTotal = 0,    // task总耗时（NSURLSessionTaskMetrics.taskInterval）
+    APIMetricsPhaseDNS,          // DNS解析
+    APIMetricsPhaseConnect,      // TCP连接（不含TLS）
+    APIMetricsPhaseTLS,          // TLS握手
+    APIMetricsPhaseTTFB,         // 请求开始发送到收到响应首字节
+    APIMetricsPhaseTransfer,     // 响应体传输
+    APIMetricsPhaseDecode,       // 响应体解析（JSON/MessagePack）
+    APIMetricsPhaseMapping,      // 模型映射
+    APIMetricsPhaseInterceptor,  // 拦截器（请求、响应和错误阶段合计）
+    APIMetricsPhaseCallback,     // 主线程业务回调
+    APIMetricsPhaseCount
+};
+
+/// 延迟直方图 - 对数线性分桶（每个2的幂区间再均分16个桶，相对误差不超过1/16），
+/// 记录1微秒到约268秒的耗时（超出的按上限计），内存固定，不保存原始样本；非线程安全，APIMetricsStore 对外返回的是副本
+@interface APIMetricsHistogram : NSObject <NSCopying>
+
+/// 样本数
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/// 最小值（秒）
+@property (nonatomic, assign, readonly) NSTimeInterval minValue;
+
+/// 最大值（秒）
+@property (nonatomic, assign, readonly) NSTimeInterval maxValue;
+
+/// 平均值（秒）
+@property (nonatomic, assign, readonly) NSTimeInterval mean;
+
+/// 记录一个耗时
+/// @param value 耗时（秒，负数忽略）
+- (void)recordValue:(NSTimeInterval)value;
+
+/// 分位数（返回所在桶的上界）
+/// @param percentile 分位（0~1，如0.99）
+/// @return 没有样本时返回0
+- (NSTimeInterval)valueAtPercentile:(double)percentile;
+
+@end
+
+/// 单个路径名称的请求耗时统计快照
+@interface APIPathMetricsEntry : NSObject <NSCopying>
+
+/// 路径名称（未配置的请求为URL路径）
+@property (nonatomic, copy, readonly) NSString *pathName;
+
+/// 走网络的请求数
+@property (nonatomic, assign, readonly) NSUInteger requestCount;
+
+/// 失败的请求数（网络错误或HTTP状态码不小于400）
+@property (nonatomic, assign, readonly) NSUInteger errorCount;
+
+/// 复用已有连接的请求数
+@property (nonatomic, assign, readonly) NSUInteger reusedConnectionCount;
+
+/// 最近一次记录的时间
+@property (nonatomic, strong, readonly) NSDate *lastUpdateDate;
+
+/// 阶段的直方图
+/// @param phase 阶段
+/// @return 该阶段没有记录时返回nil
+- (nullable APIMetricsHistogram *)histogramForPhase:(APIMetricsPhase)phase;
+
+@end
+
+/// 请求耗时统计 - 按路径名称汇总NSURLSessionTaskMetrics（DNS、连接、TLS、首字节、传输）
+/// 和客户端自身的耗时（解析、模型映射、拦截器、回调），每个阶段一个直方图，可以计算p50/p90/p99
+/// 保存在内存中，路径数超过上限时淘汰最久没有更新的路径；可以导出JSON供调试插件和性能测试使用
+@interface APIMetricsStore : NSObject
+
+/// 单例
++ (instancetype)sharedStore;
+
+/// 最多保存的路径数（默认：64）
+@property (nonatomic, assign) NSUInteger maxPathCount;
+
+/// 记录task的网络耗时（在会话的metrics回调中调用；本地缓存命中的task不记录）
+/// @param metrics task的耗时数据
+/// @param task 请求task
+- (void)recordMetrics:(NSURLSessionTaskMetrics *)metrics forTask:(NSURLSessionTask *)task;
+
+/// 记录客户端阶段的耗时
+/// @param duration 耗时（秒）
+/// @param phase 阶段
+/// @param URL 请求地址（按路径配置解析路径名称）
+- (void)recordDuration:(NSTimeInterval)duration phase:(APIMetricsPhase)phase forURL:(nullable NSURL *)URL;
+
+/// 所有路径的统计快照（按请求数从多到少排序）
+- (NSArray<APIPathMetricsEntry *> *)allEntries;
+
+/// 导出JSON（耗时单位为毫秒，每个阶段包含count/min/mean/p50/p90/p99/max）
+- (NSData *)JSONData;
+
+/// 清空统计
+- (void)reset;
+
+/// 阶段的显示名称
+/// @param phase 阶段
++ (NSString *)displayNameForPhase:(APIMetricsPhase)phase;
+
+@end
+
+NS_ASSUME_NONNULL_END
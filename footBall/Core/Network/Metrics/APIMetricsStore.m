@@ -0,0 +1,422 @@
+//
+//  APIMetricsStore.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIMetricsStore.h"
+#import "APIPathConfig.h"
+
+static const NSUInteger kAPIMetricsSubBucketBits = 4;
+static const NSUInteger kAPIMetricsSubBucketCount = 1 << kAPIMetricsSubBucketBits;
+static const NSUInteger kAPIMetricsMaxExponent = 27; // 最大记录 2^28-1 微秒
+static const NSUInteger kAPIMetricsBucketCount = kAPIMetricsSubBucketCount * (kAPIMetricsMaxExponent - kAPIMetricsSubBucketBits + 2);
+static const uint64_t kAPIMetricsMaxValue = (1ULL << (kAPIMetricsMaxExponent + 1)) - 1;
+
+/// 微秒值所在的桶：小于16的值每个值一个桶，之后每个2的幂区间均分16个桶
+static NSUInteger APIMetricsBucketIndex(uint64_t value) {
+    if (value < kAPIMetricsSubBucketCount) {
+        return (NSUInteger)value;
+    }
+    NSUInteger exponent = 63 - __builtin_clzll(value);
+    NSUInteger shift = exponent - kAPIMetricsSubBucketBits;
+    NSUInteger subBucket = (NSUInteger)(value >> shift) & (kAPIMetricsSubBucketCount - 1);
+    return kAPIMetricsSubBucketCount + shift * kAPIMetricsSubBucketCount + subBucket;
+}
+
+/// 桶的上界（微秒）
+static uint64_t APIMetricsBucketUpperBound(NSUInteger index) {
+    if (index < kAPIMetricsSubBucketCount) {
+        return index;
+    }
+    NSUInteger shift = index / kAPIMetricsSubBucketCount - 1;
+    NSUInteger subBucket = index % kAPIMetricsSubBucketCount;
+    return ((uint64_t)(kAPIMetricsSubBucketCount + subBucket) << shift) + (1ULL << shift) - 1;
+}
+
+/// 累加一段区间的耗时（开始或结束时间缺失时不记录，如复用连接没有DNS和连接阶段）
+static void APIMetricsAddInterval(NSTimeInterval *durations, BOOL *recorded, APIMetricsPhase phase, NSDate *startDate, NSDate *endDate) {
+    if (!startDate || !endDate) {
+        return;
+    }
+    durations[phase] += MAX([endDate timeIntervalSinceDate:startDate], 0);
+    recorded[phase] = YES;
+}
+
+/// 阶段在导出JSON中的key
+static NSString *APIMetricsPhaseKey(APIMetricsPhase phase) {
+    switch (phase) {
+        case APIMetricsPhaseTotal:
+            return @"total";
+        case APIMetricsPhaseDNS:
+            return @"dns";
+        case APIMetricsPhaseConnect:
+            return @"connect";
+        case APIMetricsPhaseTLS:
+            return @"tls";
+        case APIMetricsPhaseTTFB:
+            return @"ttfb";
+        case APIMetricsPhaseTransfer:
+            return @"transfer";
+        case APIMetricsPhaseDecode:
+            return @"decode";
+        case APIMetricsPhaseMapping:
+            return @"mapping";
+        case APIMetricsPhaseInterceptor:
+            return @"interceptor";
+        case APIMetricsPhaseCallback:
+            return @"callback";
+        case APIMetricsPhaseCount:
+            break;
+    }
+    return @"unknown";
+}
+
+#pragma mark - APIMetricsHistogram
+
+@interface APIMetricsHistogram () {
+    uint32_t *_counts;
+}
+
+@property (nonatomic, assign, readwrite) NSUInteger count;
+@property (nonatomic, assign, readwrite) NSTimeInterval minValue;
+@property (nonatomic, assign, readwrite) NSTimeInterval maxValue;
+@property (nonatomic, assign) NSTimeInterval totalValue;
+
+@end
+
+@implementation APIMetricsHistogram
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _counts = calloc(kAPIMetricsBucketCount, sizeof(uint32_t));
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_counts);
+}
+
+- (NSTimeInterval)mean {
+    return self.count > 0 ? self.totalValue / self.count : 0;
+}
+
+- (void)recordValue:(NSTimeInterval)value {
+    if (value < 0) {
+        return;
+    }
+    
+    uint64_t microseconds = MIN((uint64_t)llround(value * 1000000), kAPIMetricsMaxValue);
+    _counts[APIMetricsBucketIndex(microseconds)]++;
+    self.minValue = self.count == 0 ? value : MIN(self.minValue, value);
+    self.maxValue = MAX(self.maxValue, value);
+    self.totalValue += value;
+    self.count++;
+}
+
+- (NSTimeInterval)valueAtPercentile:(double)percentile {
+    if (self.count == 0) {
+        return 0;
+    }
+    
+    NSUInteger targetCount = MAX((NSUInteger)ceil(MIN(MAX(percentile, 0), 1) * self.count), 1);
+    NSUInteger cumulativeCount = 0;
+    for (NSUInteger index = 0; index < kAPIMetricsBucketCount; index++) {
+        cumulativeCount += _counts[index];
+        if (cumulativeCount >= targetCount) {
+            // 桶上界可能超过实际最大值，取较小者
+            return MIN(APIMetricsBucketUpperBound(index) / 1000000.0, self.maxValue);
+        }
+    }
+    return self.maxValue;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    APIMetricsHistogram *histogram = [[APIMetricsHistogram allocWithZone:zone] init];
+    memcpy(histogram->_counts, _counts, kAPIMetricsBucketCount * sizeof(uint32_t));
+    histogram.count = self.count;
+    histogram.minValue = self.minValue;
+    histogram.maxValue = self.maxValue;
+    histogram.totalValue = self.totalValue;
+    return histogram;
+}
+
+@end
+
+#pragma mark - APIPathMetricsEntry
+
+@interface APIPathMetricsEntry ()
+
+@property (nonatomic, copy, readwrite) NSString *pathName;
+@property (nonatomic, assign, readwrite) NSUInteger requestCount;
+@property (nonatomic, assign, readwrite) NSUInteger errorCount;
+@property (nonatomic, assign, readwrite) NSUInteger reusedConnectionCount;
+@property (nonatomic, strong, readwrite) NSDate *lastUpdateDate;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, APIMetricsHistogram *> *histograms; // 阶段 -> 直方图（首次记录时创建）
+
+@end
+
+@implementation APIPathMetricsEntry
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _histograms = [NSMutableDictionary dictionary];
+        _lastUpdateDate = [NSDate date];
+    }
+    return self;
+}
+
+- (nullable APIMetricsHistogram *)histogramForPhase:(APIMetricsPhase)phase {
+    return self.histograms[@(phase)];
+}
+
+- (void)recordDuration:(NSTimeInterval)duration phase:(APIMetricsPhase)phase {
+    APIMetricsHistogram *histogram = self.histograms[@(phase)];
+    if (!histogram) {
+        histogram = [[APIMetricsHistogram alloc] init];
+        self.histograms[@(phase)] = histogram;
+    }
+    [histogram recordValue:duration];
+    self.lastUpdateDate = [NSDate date];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    APIPathMetricsEntry *entry = [[APIPathMetricsEntry allocWithZone:zone] init];
+    entry.pathName = self.pathName;
+    entry.requestCount = self.requestCount;
+    entry.errorCount = self.errorCount;
+    entry.reusedConnectionCount = self.reusedConnectionCount;
+    entry.lastUpdateDate = self.lastUpdateDate;
+    [self.histograms enumerateKeysAndObjectsUsingBlock:^(NSNumber *phase, APIMetricsHistogram *histogram, BOOL *stop) {
+        entry.histograms[phase] = [histogram copy];
+    }];
+    return entry;
+}
+
+@end
+
+#pragma mark - APIMetricsStore
+
+@interface APIMetricsStore ()
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, APIPathMetricsEntry *> *entries; // 路径名称 -> 统计
+
+@end
+
+@implementation APIMetricsStore
+
++ (instancetype)sharedStore {
+    static APIMetricsStore *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[APIMetricsStore alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _entries = [NSMutableDictionary dictionary];
+        _maxPathCount = 64;
+    }
+    return self;
+}
+
+#pragma mark - Public Methods
+
+- (void)recordMetrics:(NSURLSessionTaskMetrics *)metrics forTask:(NSURLSessionTask *)task {
+    NSTimeInterval durations[APIMetricsPhaseCount] = {0};
+    BOOL recorded[APIMetricsPhaseCount] = {NO};
+    BOOL loadedFromNetwork = NO;
+    BOOL reusedConnection = NO;
+    
+    // 重定向时有多个网络传输，各阶段累加
+    for (NSURLSessionTaskTransactionMetrics *transaction in metrics.transactionMetrics) {
+        if (transaction.resourceFetchType != NSURLSessionTaskMetricsResourceFetchTypeNetworkLoad) {
+            continue;
+        }
+        loadedFromNetwork = YES;
+        reusedConnection = transaction.isReusedConnection;
+        
+        APIMetricsAddInterval(durations, recorded, APIMetricsPhaseDNS, transaction.domainLookupStartDate, transaction.domainLookupEndDate);
+        APIMetricsAddInterval(durations, recorded, APIMetricsPhaseConnect, transaction.connectStartDate, transaction.secureConnectionStartDate ?: transaction.connectEndDate);
+        APIMetricsAddInterval(durations, recorded, APIMetricsPhaseTLS, transaction.secureConnectionStartDate, transaction.secureConnectionEndDate);
+        APIMetricsAddInterval(durations, recorded, APIMetricsPhaseTTFB, transaction.requestStartDate, transaction.responseStartDate);
+        APIMetricsAddInterval(durations, recorded, APIMetricsPhaseTransfer, transaction.responseStartDate, transaction.responseEndDate);
+    }
+    if (!loadedFromNetwork) {
+        return;
+    }
+    durations[APIMetricsPhaseTotal] = metrics.taskInterval.duration;
+    recorded[APIMetricsPhaseTotal] = YES;
+    
+    NSHTTPURLResponse *response = [task.response isKindOfClass:[NSHTTPURLResponse class]] ? (NSHTTPURLResponse *)task.response : nil;
+    BOOL failed = task.error != nil || response.statusCode >= 400;
+    NSString *pathName = [self pathNameForURL:task.originalRequest.URL];
+    
+    @synchronized (self.entries) {
+        APIPathMetricsEntry *entry = [self entryForPathName:pathName];
+        entry.requestCount++;
+        if (failed) {
+            entry.errorCount++;
+        }
+        if (reusedConnection) {
+            entry.reusedConnectionCount++;
+        }
+        for (NSInteger phase = 0; phase < APIMetricsPhaseCount; phase++) {
+            if (recorded[phase]) {
+                [entry recordDuration:durations[phase] phase:phase];
+            }
+        }
+    }
+}
+
+- (void)recordDuration:(NSTimeInterval)duration phase:(APIMetricsPhase)phase forURL:(nullable NSURL *)URL {
+    if (!URL || phase < 0 || phase >= APIMetricsPhaseCount) {
+        return;
+    }
+    
+    NSString *pathName = [self pathNameForURL:URL];
+    @synchronized (self.entries) {
+        [[self entryForPathName:pathName] recordDuration:duration phase:phase];
+    }
+}
+
+- (NSArray<APIPathMetricsEntry *> *)allEntries {
+    NSMutableArray<APIPathMetricsEntry *> *entries = [NSMutableArray array];
+    @synchronized (self.entries) {
+        for (APIPathMetricsEntry *entry in self.entries.allValues) {
+            [entries addObject:[entry copy]];
+        }
+    }
+    
+    [entries sortUsingComparator:^NSComparisonResult(APIPathMetricsEntry *obj1, APIPathMetricsEntry *obj2) {
+        if (obj1.requestCount == obj2.requestCount) {
+            return [obj1.pathName compare:obj2.pathName];
+        }
+        return obj1.requestCount > obj2.requestCount ? NSOrderedAscending : NSOrderedDescending;
+    }];
+    return entries;
+}
+
+- (NSData *)JSONData {
+    NSMutableArray<NSDictionary *> *paths = [NSMutableArray array];
+    for (APIPathMetricsEntry *entry in [self allEntries]) {
+        NSMutableDictionary<NSString *, NSDictionary *> *phases = [NSMutableDictionary dictionary];
+        for (NSInteger phase = 0; phase < APIMetricsPhaseCount; phase++) {
+            APIMetricsHistogram *histogram = [entry histogramForPhase:phase];
+            if (!histogram) {
+                continue;
+            }
+            phases[APIMetricsPhaseKey(phase)] = @{
+                @"count": @(histogram.count),
+                @"min": [self millisecondsNumberForDuration:histogram.minValue],
+                @"mean": [self millisecondsNumberForDuration:histogram.mean],
+                @"p50": [self millisecondsNumberForDuration:[histogram valueAtPercentile:0.5]],
+                @"p90": [self millisecondsNumberForDuration:[histogram valueAtPercentile:0.9]],
+                @"p99": [self millisecondsNumberForDuration:[histogram valueAtPercentile:0.99]],
+                @"max": [self millisecondsNumberForDuration:histogram.maxValue]
+            };
+        }
+        [paths addObject:@{
+            @"pathName": entry.pathName,
+            @"requestCount": @(entry.requestCount),
+            @"errorCount": @(entry.errorCount),
+            @"reusedConnectionCount": @(entry.reusedConnectionCount),
+            @"lastUpdate": @((long long)(entry.lastUpdateDate.timeIntervalSince1970 * 1000)),
+            @"phases": phases
+        }];
+    }
+    
+    NSDictionary *root = @{
+        @"timestamp": @((long long)([NSDate date].timeIntervalSince1970 * 1000)),
+        @"unit": @"ms",
+        @"paths": paths
+    };
+    NSError *error = nil;
+    NSData *data = [NSJSONSerialization dataWithJSONObject:root options:NSJSONWritingPrettyPrinted | NSJSONWritingSortedKeys error:&error];
+    if (!data) {
+        NSLog(@"❌ 导出请求耗时统计失败: %@", error);
+    }
+    return data ?: [NSData data];
+}
+
+- (void)reset {
+    @synchronized (self.entries) {
+        [self.entries removeAllObjects];
+    }
+}
+
++ (NSString *)displayNameForPhase:(APIMetricsPhase)phase {
+    switch (phase) {
+        case APIMetricsPhaseTotal:
+            return @"总耗时";
+        case APIMetricsPhaseDNS:
+            return @"DNS";
+        case APIMetricsPhaseConnect:
+            return @"连接";
+        case APIMetricsPhaseTLS:
+            return @"TLS";
+        case APIMetricsPhaseTTFB:
+            return @"首字节";
+        case APIMetricsPhaseTransfer:
+            return @"传输";
+        case APIMetricsPhaseDecode:
+            return @"解析";
+        case APIMetricsPhaseMapping:
+            return @"模型映射";
+        case APIMetricsPhaseInterceptor:
+            return @"拦截器";
+        case APIMetricsPhaseCallback:
+            return @"回调";
+        case APIMetricsPhaseCount:
+            break;
+    }
+    return @"未知";
+}
+
+#pragma mark - Private Methods
+
+- (NSString *)pathNameForURL:(NSURL *)URL {
+    NSString *pathName = [[APIPathConfigManager sharedManager] pathConfigForURL:URL].name;
+    if (pathName.length == 0) {
+        pathName = URL.path.length > 0 ? URL.path : @"/";
+    }
+    return pathName;
+}
+
+/// 路径的统计（不存在时创建，超过上限时淘汰最久没有更新的路径；在锁内调用）
+- (APIPathMetricsEntry *)entryForPathName:(NSString *)pathName {
+    APIPathMetricsEntry *entry = self.entries[pathName];
+    if (entry) {
+        return entry;
+    }
+    
+    while (self.maxPathCount > 0 && self.entries.count >= self.maxPathCount) {
+        __block NSString *oldestPathName = nil;
+        __block NSDate *oldestDate = nil;
+        [self.entries enumerateKeysAndObjectsUsingBlock:^(NSString *key, APIPathMetricsEntry *obj, BOOL *stop) {
+            if (!oldestDate || [obj.lastUpdateDate compare:oldestDate] == NSOrderedAscending) {
+                oldestDate = obj.lastUpdateDate;
+                oldestPathName = key;
+            }
+        }];
+        [self.entries removeObjectForKey:oldestPathName];
+    }
+    
+    entry = [[APIPathMetricsEntry alloc] init];
+    entry.pathName = pathName;
+    self.entries[pathName] = entry;
+    return entry;
+}
+
+- (NSNumber *)millisecondsNumberForDuration:(NSTimeInterval)duration {
+    return @(round(duration * 1000000) / 1000);
+}
+
+@end
@@ -0,0 +1,143 @@
+//
+//  APIOutbox.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import "APIManager.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 写请求状态
+typedef NS_ENUM(NSInteger, APIOutboxEntryState) {
+    APIOutboxEntryStatePending = 0,  // 等待发送（排在前面的请求未完成，或断网中）
+    APIOutboxEntryStateSending,      // 发送中
+    APIOutboxEntryStateWaitingRetry, // 发送失败，等待退避后重试
+    APIOutboxEntryStateCompleted,    // 已完成
+    APIOutboxEntryStateFailed,       // 失败（服务端拒绝或超过最大尝试次数，不再重试）
+    APIOutboxEntryStateSuperseded,   // 被同一资源后来的写请求合并（结果随合并后的请求回调）
+    APIOutboxEntryStateCancelled     // 已移除
+};
+
+/// 写请求状态变化通知（主线程），object为 APIOutbox，userInfo包含 APIOutboxEntryKey，完成时包含 APIOutboxResponseObjectKey
+FOUNDATION_EXPORT NSString *const APIOutboxDidChangeNotification;
+/// 通知userInfo：状态变化的写请求（APIOutboxEntry）
+FOUNDATION_EXPORT NSString *const APIOutboxEntryKey;
+/// 通知userInfo：完成时的响应数据
+FOUNDATION_EXPORT NSString *const APIOutboxResponseObjectKey;
+
+/// 待发送的写请求
+@interface APIOutboxEntry : NSObject <NSSecureCoding>
+
+/// 本地标识
+@property (nonatomic, copy, readonly) NSString *identifier;
+
+/// 幂等键（每次发送都带上同一个值，服务端据此去重）
+@property (nonatomic, copy, readonly) NSString *idempotencyKey;
+
+/// 请求方法（POST/PUT/PATCH/DELETE）
+@property (nonatomic, assign, readonly) HTTPMethod method;
+
+/// 请求路径（相对路径在发送时拼接当时环境的Base URL）
+@property (nonatomic, copy, readonly) NSString *URLString;
+
+/// 请求参数（JSON对象）
+@property (copy, readonly, nullable) id parameters;
+
+/// 请求头
+@property (nonatomic, copy, readonly, nullable) NSDictionary<NSString *, NSString *> *headers;
+
+/// 资源标识（同一资源的写请求会合并），nil时不合并
+@property (nonatomic, copy, readonly, nullable) NSString *resourceKey;
+
+/// 入队时的用户（AuthManager.userIdentifier，未登录时为nil），只在该用户登录时发送
+@property (nonatomic, copy, readonly, nullable) NSString *userIdentifier;
+
+/// 创建时间
+@property (nonatomic, strong, readonly) NSDate *createdAt;
+
+/// 当前状态
+@property (assign, readonly) APIOutboxEntryState state;
+
+/// 已发送次数（断网导致的失败不计入）
+@property (assign, readonly) NSUInteger attemptCount;
+
+/// 下一次重试时间（等待重试时）
+@property (strong, readonly, nullable) NSDate *nextAttemptDate;
+
+/// 最近一次失败原因
+@property (strong, readonly, nullable) NSError *error;
+
+@end
+
+/// 离线写请求队列 - 写请求先持久化（Application Support）再按入队顺序逐个发送，断网或服务端暂时不可用时保留并在网络恢复、
+/// 回到前台或重新启动后以指数退避重放；每个请求带固定的幂等键，重放不会重复执行；
+/// 同一资源还未发出的写请求合并：PUT/DELETE 以最后一次为准，PATCH 合并到前一个 PUT/PATCH 的参数中（POST 不合并）。
+/// 写请求属于入队时的用户：切换账号后其他用户的写请求保留但不发送、不合并，该用户重新登录后继续发送。
+/// UI 可以先按入队的数据乐观更新，通过 pendingEntries 和 APIOutboxDidChangeNotification 展示同步状态
+@interface APIOutbox : NSObject
+
+/// 单例
++ (instancetype)sharedOutbox;
+
+/// 初始化方法
+/// @param storageName 持久化目录名（Application Support下），不同队列使用不同目录
+- (instancetype)initWithStorageName:(NSString *)storageName;
+
+/// 幂等键的请求头字段（默认：Idempotency-Key）
+@property (nonatomic, copy) NSString *idempotencyHeaderField;
+
+/// 单个请求的最大发送次数（默认：10，断网导致的失败不计入），超过后失败
+@property (nonatomic, assign) NSUInteger maxAttemptCount;
+
+/// 重放的退避策略（默认：2秒起，最长5分钟）
+@property (nonatomic, strong) id<APIRetryPolicy> retryPolicy;
+
+/// 写请求入队（立即持久化，网络可用时马上发送）
+/// PUT/PATCH/DELETE 默认以 URLString 作为资源标识
+/// @param method 请求方法（不支持GET）
+/// @param URLString 请求路径（相对或绝对）
+/// @param parameters 请求参数（必须是有效的JSON对象）
+/// @param headers 请求头（会与公共请求头合并）
+/// @param success 成功回调（主线程，只在本次启动中有效；重新启动后通过通知获取结果）
+/// @param failure 失败回调（主线程，只在不再重试时回调）
+/// @return 写请求，方法或参数无效时返回nil并回调failure
+- (nullable APIOutboxEntry *)enqueueRequestWithMethod:(HTTPMethod)method
+                                            URLString:(NSString *)URLString
+                                           parameters:(nullable id)parameters
+                                              headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                              success:(nullable APISuccessBlock)success
+                                              failure:(nullable APIFailureBlock)failure;
+
+/// 写请求入队（指定资源标识）
+/// @param resourceKey 资源标识（如：@"user/42/profile"），nil时不合并
+- (nullable APIOutboxEntry *)enqueueRequestWithMethod:(HTTPMethod)method
+                                            URLString:(NSString *)URLString
+                                           parameters:(nullable id)parameters
+                                              headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                          resourceKey:(nullable NSString *)resourceKey
+                                              success:(nullable APISuccessBlock)success
+                                              failure:(nullable APIFailureBlock)failure;
+
+/// 当前用户未完成的写请求（按发送顺序，包括上次启动留下的请求）
+- (NSArray<APIOutboxEntry *> *)pendingEntries;
+
+/// 当前用户在该资源上未完成的写请求
+/// @param resourceKey 资源标识
+- (NSArray<APIOutboxEntry *> *)pendingEntriesForResourceKey:(NSString *)resourceKey;
+
+/// 立即尝试发送（跳过退避等待）
+- (void)flush;
+
+/// 移除未发出的写请求（发送中的请求无法移除），回调取消错误
+/// @param entry 写请求
+- (void)removeEntry:(APIOutboxEntry *)entry;
+
+/// 移除所有未发出的写请求（包括其他用户的，如退出登录并放弃未同步的修改时）
+- (void)removeAllEntries;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,636 @@
+//
+//  APIOutbox.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIOutbox.h"
+#import "AuthManager.h"
+#import <AFNetworking/AFNetworking.h>
+#import <UIKit/UIKit.h>
+
+NSString *const APIOutboxDidChangeNotification = @"APIOutboxDidChangeNotification";
+NSString *const APIOutboxEntryKey = @"APIOutboxEntryKey";
+NSString *const APIOutboxResponseObjectKey = @"APIOutboxResponseObjectKey";
+
+/// 断网时探测网络恢复的间隔（系统可达性通知可能晚于实际恢复）
+static const NSTimeInterval kAPIOutboxNetworkProbeInterval = 10.0;
+
+#pragma mark - Helpers
+
+/// 底层错误（APIError包装的原始错误）
+static NSError *APIOutboxUnderlyingError(NSError *error) {
+    if ([error isKindOfClass:[APIError class]] && ((APIError *)error).underlyingError) {
+        return ((APIError *)error).underlyingError;
+    }
+    return error;
+}
+
+/// 响应状态码（没有响应时为0）
+static NSInteger APIOutboxStatusCode(NSError *error) {
+    NSHTTPURLResponse *response = APIOutboxUnderlyingError(error).userInfo[AFNetworkingOperationFailingURLResponseErrorKey];
+    return [response isKindOfClass:[NSHTTPURLResponse class]] ? response.statusCode : 0;
+}
+
+/// 是否为连接层面的错误（断网），这类错误等待网络恢复，不计入发送次数
+static BOOL APIOutboxIsConnectivityError(NSError *error) {
+    NSError *underlyingError = APIOutboxUnderlyingError(error);
+    if (![underlyingError.domain isEqualToString:NSURLErrorDomain]) {
+        return NO;
+    }
+    
+    switch (underlyingError.code) {
+        case NSURLErrorNotConnectedToInternet:
+        case NSURLErrorNetworkConnectionLost:
+        case NSURLErrorDataNotAllowed:
+        case NSURLErrorInternationalRoamingOff:
+        case NSURLErrorCallIsActive:
+            return YES;
+        default:
+            return NO;
+    }
+}
+
+/// 是否稍后重放：5xx、408、429和没有响应的错误（超时、熔断、取消）重放；其他4xx说明请求本身被拒绝，不再重试
+static BOOL APIOutboxShouldRetry(NSError *error) {
+    NSInteger statusCode = APIOutboxStatusCode(error);
+    if (statusCode > 0) {
+        return statusCode >= 500 || statusCode == 408 || statusCode == 429;
+    }
+    return [APIError errorFromNSError:error].code != APIErrorCodeDecodingFailed;
+}
+
+/// 写请求是否属于当前用户（都未登录时也视为同一用户）
+static BOOL APIOutboxIsCurrentUserEntry(APIOutboxEntry *entry) {
+    NSString *userIdentifier = [AuthManager sharedManager].userIdentifier;
+    if (entry.userIdentifier.length == 0 || userIdentifier.length == 0) {
+        return entry.userIdentifier.length == 0 && userIdentifier.length == 0;
+    }
+    return [entry.userIdentifier isEqualToString:userIdentifier];
+}
+
+static NSString *APIOutboxMethodString(HTTPMethod method) {
+    switch (method) {
+        case HTTPMethodGET:
+            return @"GET";
+        case HTTPMethodPOST:
+            return @"POST";
+        case HTTPMethodPUT:
+            return @"PUT";
+        case HTTPMethodDELETE:
+            return @"DELETE";
+        case HTTPMethodPATCH:
+            return @"PATCH";
+    }
+}
+
+#pragma mark - APIOutboxEntry
+
+@interface APIOutboxEntry ()
+
+@property (nonatomic, copy, readwrite) NSString *identifier;
+@property (nonatomic, copy, readwrite) NSString *idempotencyKey;
+@property (nonatomic, assign, readwrite) HTTPMethod method;
+@property (nonatomic, copy, readwrite) NSString *URLString;
+@property (copy, readwrite, nullable) id parameters;
+@property (nonatomic, copy, readwrite, nullable) NSDictionary<NSString *, NSString *> *headers;
+@property (nonatomic, copy, readwrite, nullable) NSString *resourceKey;
+@property (nonatomic, copy, readwrite, nullable) NSString *userIdentifier;
+@property (nonatomic, strong, readwrite) NSDate *createdAt;
+@property (assign, readwrite) APIOutboxEntryState state;
+@property (assign, readwrite) NSUInteger attemptCount;
+@property (strong, readwrite, nullable) NSDate *nextAttemptDate;
+@property (strong, readwrite, nullable) NSError *error;
+
+// 持久化字段
+@property (nonatomic, assign) int64_t sequence; // 入队顺序
+
+// 运行时状态（只在队列中访问）
+@property (nonatomic, assign) NSTimeInterval lastRetryDelay;
+@property (nonatomic, strong) NSMutableArray<APISuccessBlock> *successBlocks; // 包括被合并的请求的回调
+@property (nonatomic, strong) NSMutableArray<APIFailureBlock> *failureBlocks;
+
+@end
+
+@implementation APIOutboxEntry
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _identifier = [NSUUID UUID].UUIDString;
+        _idempotencyKey = [NSUUID UUID].UUIDString;
+        _createdAt = [NSDate date];
+        _successBlocks = [NSMutableArray array];
+        _failureBlocks = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder {
+    [coder encodeObject:self.identifier forKey:@"identifier"];
+    [coder encodeObject:self.idempotencyKey forKey:@"idempotencyKey"];
+    [coder encodeInteger:self.method forKey:@"method"];
+    [coder encodeObject:self.URLString forKey:@"URLString"];
+    [coder encodeObject:self.headers forKey:@"headers"];
+    [coder encodeObject:self.resourceKey forKey:@"resourceKey"];
+    [coder encodeObject:self.userIdentifier forKey:@"userIdentifier"];
+    [coder encodeObject:self.createdAt forKey:@"createdAt"];
+    [coder encodeInteger:(NSInteger)self.attemptCount forKey:@"attemptCount"];
+    [coder encodeInt64:self.sequence forKey:@"sequence"];
+    
+    // 参数以JSON保存（任意Foundation集合无法安全解档）
+    if (self.parameters) {
+        NSData *parametersData = [NSJSONSerialization dataWithJSONObject:self.parameters options:0 error:nil];
+        [coder encodeObject:parametersData forKey:@"parameters"];
+    }
+}
+
+- (nullable instancetype)initWithCoder:(NSCoder *)coder {
+    self = [self init];
+    if (self) {
+        _identifier = [coder decodeObjectOfClass:[NSString class] forKey:@"identifier"];
+        _idempotencyKey = [coder decodeObjectOfClass:[NSString class] forKey:@"idempotencyKey"];
+        _method = (HTTPMethod)[coder decodeIntegerForKey:@"method"];
+        _URLString = [coder decodeObjectOfClass:[NSString class] forKey:@"URLString"];
+        _headers = [coder decodeObjectOfClasses:[NSSet setWithObjects:[NSDictionary class], [NSString class], nil] forKey:@"headers"];
+        _resourceKey = [coder decodeObjectOfClass:[NSString class] forKey:@"resourceKey"];
+        _userIdentifier = [coder decodeObjectOfClass:[NSString class] forKey:@"userIdentifier"];
+        _createdAt = [coder decodeObjectOfClass:[NSDate class] forKey:@"createdAt"] ?: [NSDate date];
+        _attemptCount = (NSUInteger)[coder decodeIntegerForKey:@"attemptCount"];
+        _sequence = [coder decodeInt64ForKey:@"sequence"];
+        
+        NSData *parametersData = [coder decodeObjectOfClass:[NSData class] forKey:@"parameters"];
+        if (parametersData) {
+            _parameters = [NSJSONSerialization JSONObjectWithData:parametersData options:NSJSONReadingFragmentsAllowed error:nil];
+        }
+        
+        if (_identifier.length == 0 || _idempotencyKey.length == 0 || _URLString.length == 0 || _method == HTTPMethodGET) {
+            return nil;
+        }
+        _state = APIOutboxEntryStatePending;
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %@ %@, state=%ld, attempts=%lu>",
+            NSStringFromClass([self class]), APIOutboxMethodString(self.method), self.URLString, (long)self.state, (unsigned long)self.attemptCount];
+}
+
+@end
+
+#pragma mark - APIOutbox
+
+@interface APIOutbox ()
+
+@property (nonatomic, strong) dispatch_queue_t queue; // 队列状态和请求结果都在该串行队列中处理
+@property (nonatomic, copy) NSString *storagePath;
+@property (nonatomic, strong) NSMutableArray<APIOutboxEntry *> *entries; // 未完成的写请求，按发送顺序
+@property (nonatomic, assign) int64_t nextSequence;
+@property (nonatomic, assign) BOOL sending; // 同一时间只发送队首的请求，保证顺序
+@property (nonatomic, assign) NSUInteger timerGeneration; // 每次安排定时器时递增，旧定时器直接忽略
+
+@end
+
+@implementation APIOutbox
+
++ (instancetype)sharedOutbox {
+    static APIOutbox *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[APIOutbox alloc] initWithStorageName:@"APIOutbox"];
+    });
+    return instance;
+}
+
+- (instancetype)initWithStorageName:(NSString *)storageName {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("com.football.api.outbox", DISPATCH_QUEUE_SERIAL);
+        _entries = [NSMutableArray array];
+        _idempotencyHeaderField = @"Idempotency-Key";
+        _maxAttemptCount = 10;
+        _retryPolicy = [[APIBackoffRetryPolicy alloc] initWithBaseDelay:2.0 maxDelay:300.0];
+        
+        // 写请求放在Application Support（Caches可能被系统清理）
+        NSString *supportPath = NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES).firstObject;
+        _storagePath = [supportPath stringByAppendingPathComponent:storageName];
+        [[NSFileManager defaultManager] createDirectoryAtPath:_storagePath
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:nil];
+        [self restoreEntries];
+        
+        [[AFNetworkReachabilityManager sharedManager] startMonitoring];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(reachabilityDidChange:)
+                                                     name:AFNetworkingReachabilityDidChangeNotification
+                                                   object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationWillEnterForeground:)
+                                                     name:UIApplicationWillEnterForegroundNotification
+                                                   object:nil];
+        
+        dispatch_async(_queue, ^{
+            [self processNextEntry];
+        });
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void)setMaxAttemptCount:(NSUInteger)maxAttemptCount {
+    _maxAttemptCount = MAX(maxAttemptCount, (NSUInteger)1);
+}
+
+#pragma mark - Public Methods
+
+- (nullable APIOutboxEntry *)enqueueRequestWithMethod:(HTTPMethod)method
+                                            URLString:(NSString *)URLString
+                                           parameters:(nullable id)parameters
+                                              headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                              success:(nullable APISuccessBlock)success
+                                              failure:(nullable APIFailureBlock)failure {
+    NSString *resourceKey = method == HTTPMethodPOST ? nil : URLString;
+    return [self enqueueRequestWithMethod:method
+                                URLString:URLString
+                               parameters:parameters
+                                  headers:headers
+                              resourceKey:resourceKey
+                                  success:success
+                                  failure:failure];
+}
+
+- (nullable APIOutboxEntry *)enqueueRequestWithMethod:(HTTPMethod)method
+                                            URLString:(NSString *)URLString
+                                           parameters:(nullable id)parameters
+                                              headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                          resourceKey:(nullable NSString *)resourceKey
+                                              success:(nullable APISuccessBlock)success
+                                              failure:(nullable APIFailureBlock)failure {
+    NSString *message = nil;
+    if (method == HTTPMethodGET) {
+        message = @"离线写请求不支持GET";
+    } else if (URLString.length == 0) {
+        message = @"请求路径为空";
+    } else if (parameters && ![NSJSONSerialization isValidJSONObject:parameters]) {
+        message = @"请求参数不是有效的JSON对象";
+    }
+    if (message) {
+        APIError *error = [APIError errorWithCode:APIErrorCodeBadRequest message:message underlyingError:nil];
+        error.requestPath = URLString;
+        if (failure) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                failure(error);
+            });
+        }
+        return nil;
+    }
+    
+    APIOutboxEntry *entry = [[APIOutboxEntry alloc] init];
+    entry.method = method;
+    entry.URLString = URLString;
+    entry.parameters = parameters;
+    entry.headers = headers;
+    entry.resourceKey = resourceKey;
+    entry.userIdentifier = [AuthManager sharedManager].userIdentifier;
+    if (success) {
+        [entry.successBlocks addObject:success];
+    }
+    if (failure) {
+        [entry.failureBlocks addObject:failure];
+    }
+    
+    dispatch_sync(self.queue, ^{
+        [self coalesceEntry:entry];
+        entry.sequence = self.nextSequence++;
+        [self.entries addObject:entry];
+        [self saveEntry:entry];
+    });
+    NSLog(@"📮 写请求入队: %@ %@（待发送%lu个）", APIOutboxMethodString(method), URLString, (unsigned long)[self pendingEntries].count);
+    [self postChangeForEntry:entry responseObject:nil];
+    
+    dispatch_async(self.queue, ^{
+        [self processNextEntry];
+    });
+    return entry;
+}
+
+- (NSArray<APIOutboxEntry *> *)pendingEntries {
+    __block NSArray<APIOutboxEntry *> *entries = nil;
+    dispatch_sync(self.queue, ^{
+        entries = [self.entries filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(APIOutboxEntry *entry, NSDictionary *bindings) {
+            return APIOutboxIsCurrentUserEntry(entry);
+        }]];
+    });
+    return entries;
+}
+
+- (NSArray<APIOutboxEntry *> *)pendingEntriesForResourceKey:(NSString *)resourceKey {
+    return [[self pendingEntries] filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(APIOutboxEntry *entry, NSDictionary *bindings) {
+        return [entry.resourceKey isEqualToString:resourceKey];
+    }]];
+}
+
+- (void)flush {
+    dispatch_async(self.queue, ^{
+        for (APIOutboxEntry *entry in self.entries) {
+            entry.nextAttemptDate = nil;
+        }
+        [self processNextEntry];
+    });
+}
+
+- (void)removeEntry:(APIOutboxEntry *)entry {
+    dispatch_async(self.queue, ^{
+        if (![self.entries containsObject:entry]) {
+            return;
+        }
+        if (entry.state == APIOutboxEntryStateSending) {
+            NSLog(@"⚠️ 写请求发送中，无法移除: %@", entry.URLString);
+            return;
+        }
+        
+        APIError *error = [APIError errorWithCode:APIErrorCodeCancelled message:@"写请求已移除" underlyingError:nil];
+        error.requestPath = entry.URLString;
+        [self finishEntry:entry state:APIOutboxEntryStateCancelled responseObject:nil error:error];
+    });
+}
+
+- (void)removeAllEntries {
+    dispatch_async(self.queue, ^{
+        for (APIOutboxEntry *entry in [self.entries copy]) {
+            if (entry.state != APIOutboxEntryStateSending) {
+                APIError *error = [APIError errorWithCode:APIErrorCodeCancelled message:@"写请求已移除" underlyingError:nil];
+                error.requestPath = entry.URLString;
+                [self finishEntry:entry state:APIOutboxEntryStateCancelled responseObject:nil error:error];
+            }
+        }
+    });
+}
+
+#pragma mark - Private Methods
+
+/// 合并同一资源还未发出的写请求（在队列中调用）
+/// 只和当前用户在该资源上最后一个写请求合并，且它不能已经在发送中（发送结果未知时无法改写）；合并后的请求排到队尾
+- (void)coalesceEntry:(APIOutboxEntry *)entry {
+    if (!entry.resourceKey || entry.method == HTTPMethodPOST) {
+        return;
+    }
+    
+    APIOutboxEntry *previous = nil;
+    for (APIOutboxEntry *candidate in self.entries.reverseObjectEnumerator) {
+        if ([candidate.resourceKey isEqualToString:entry.resourceKey] && APIOutboxIsCurrentUserEntry(candidate)) {
+            previous = candidate;
+            break;
+        }
+    }
+    if (!previous || previous.state == APIOutboxEntryStateSending || previous.method == HTTPMethodPOST) {
+        return;
+    }
+    
+    if (entry.method == HTTPMethodPATCH) {
+        // PATCH 只修改部分字段，合并到前一个 PUT/PATCH 的参数中
+        BOOL mergeable = (previous.method == HTTPMethodPUT || previous.method == HTTPMethodPATCH) &&
+                         [previous.parameters isKindOfClass:[NSDictionary class]] &&
+                         (!entry.parameters || [entry.parameters isKindOfClass:[NSDictionary class]]);
+        if (!mergeable) {
+            return;
+        }
+        
+        NSMutableDictionary *parameters = [previous.parameters mutableCopy];
+        [parameters addEntriesFromDictionary:entry.parameters ?: @{}];
+        entry.method = previous.method;
+        entry.parameters = parameters;
+    }
+    
+    NSMutableDictionary<NSString *, NSString *> *headers = [previous.headers mutableCopy] ?: [NSMutableDictionary dictionary];
+    [headers addEntriesFromDictionary:entry.headers ?: @{}];
+    entry.headers = headers.count > 0 ? headers : nil;
+    [entry.successBlocks insertObjects:previous.successBlocks atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, previous.successBlocks.count)]];
+    [entry.failureBlocks insertObjects:previous.failureBlocks atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, previous.failureBlocks.count)]];
+    
+    previous.state = APIOutboxEntryStateSuperseded;
+    [self.entries removeObject:previous];
+    [self removeSavedEntry:previous];
+    [self postChangeForEntry:previous responseObject:nil];
+    NSLog(@"📮 写请求合并: %@ %@", APIOutboxMethodString(entry.method), entry.URLString);
+}
+
+/// 发送当前用户排在最前面的写请求（在队列中调用）
+/// 其他用户的写请求保留在队列中，不在当前用户的Token下重放（幂等键也无法跨用户去重）
+- (void)processNextEntry {
+    if (self.sending) {
+        return;
+    }
+    APIOutboxEntry *entry = nil;
+    for (APIOutboxEntry *candidate in self.entries) {
+        if (APIOutboxIsCurrentUserEntry(candidate)) {
+            entry = candidate;
+            break;
+        }
+    }
+    if (!entry) {
+        return;
+    }
+    
+    // 等待退避
+    NSTimeInterval delay = [entry.nextAttemptDate timeIntervalSinceNow];
+    if (entry.state == APIOutboxEntryStateWaitingRetry && delay > 0) {
+        [self scheduleProcessingAfterDelay:delay];
+        return;
+    }
+    
+    // 断网时等待网络恢复（可达性未知时照常尝试）
+    if ([AFNetworkReachabilityManager sharedManager].networkReachabilityStatus == AFNetworkReachabilityStatusNotReachable) {
+        entry.state = APIOutboxEntryStatePending;
+        [self scheduleProcessingAfterDelay:kAPIOutboxNetworkProbeInterval];
+        return;
+    }
+    
+    self.sending = YES;
+    self.timerGeneration++;
+    entry.state = APIOutboxEntryStateSending;
+    entry.nextAttemptDate = nil;
+    [self postChangeForEntry:entry responseObject:nil];
+    
+    NSMutableDictionary<NSString *, NSString *> *headers = [entry.headers mutableCopy] ?: [NSMutableDictionary dictionary];
+    headers[self.idempotencyHeaderField] = entry.idempotencyKey;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        // 切换到主线程期间用户已经变化：放回队列，等该用户登录后再发送
+        if (!APIOutboxIsCurrentUserEntry(entry)) {
+            dispatch_async(self.queue, ^{
+                self.sending = NO;
+                entry.state = APIOutboxEntryStatePending;
+                [self postChangeForEntry:entry responseObject:nil];
+                [self processNextEntry];
+            });
+            return;
+        }
+        [[APIManager sharedManager] requestWithMethod:entry.method
+                                            URLString:entry.URLString
+                                           parameters:entry.parameters
+                                              headers:headers
+                                              success:^(id  _Nullable responseObject) {
+            dispatch_async(self.queue, ^{
+                [self handleResponseObject:responseObject forEntry:entry];
+            });
+        } failure:^(NSError * _Nonnull error) {
+            dispatch_async(self.queue, ^{
+                [self handleError:error forEntry:entry];
+            });
+        }];
+    });
+}
+
+- (void)handleResponseObject:(nullable id)responseObject forEntry:(APIOutboxEntry *)entry {
+    self.sending = NO;
+    entry.attemptCount++;
+    NSLog(@"✅ 写请求已发送: %@ %@", APIOutboxMethodString(entry.method), entry.URLString);
+    [self finishEntry:entry state:APIOutboxEntryStateCompleted responseObject:responseObject error:nil];
+    [self processNextEntry];
+}
+
+- (void)handleError:(NSError *)error forEntry:(APIOutboxEntry *)entry {
+    self.sending = NO;
+    entry.error = error;
+    
+    // 断网：不计入发送次数，等待网络恢复
+    if (APIOutboxIsConnectivityError(error)) {
+        entry.state = APIOutboxEntryStatePending;
+        [self postChangeForEntry:entry responseObject:nil];
+        [self scheduleProcessingAfterDelay:kAPIOutboxNetworkProbeInterval];
+        return;
+    }
+    
+    entry.attemptCount++;
+    if (!APIOutboxShouldRetry(error) || entry.attemptCount >= self.maxAttemptCount) {
+        NSLog(@"❌ 写请求失败，不再重试: %@ %@ - %@", APIOutboxMethodString(entry.method), entry.URLString, error.localizedDescription);
+        [self finishEntry:entry state:APIOutboxEntryStateFailed responseObject:nil error:error];
+        [self processNextEntry];
+        return;
+    }
+    
+    // 队首等待退避，后面的请求继续排队（保证顺序）
+    entry.lastRetryDelay = [self.retryPolicy delayForRetryCount:(NSInteger)entry.attemptCount previousDelay:entry.lastRetryDelay];
+    entry.nextAttemptDate = [NSDate dateWithTimeIntervalSinceNow:entry.lastRetryDelay];
+    entry.state = APIOutboxEntryStateWaitingRetry;
+    [self saveEntry:entry];
+    [self postChangeForEntry:entry responseObject:nil];
+    NSLog(@"🔄 写请求%.1f秒后重试（第%lu次）: %@", entry.lastRetryDelay, (unsigned long)entry.attemptCount, entry.URLString);
+    [self scheduleProcessingAfterDelay:entry.lastRetryDelay];
+}
+
+/// 结束写请求：移出队列和磁盘，回调所有调用方（在队列中调用）
+- (void)finishEntry:(APIOutboxEntry *)entry state:(APIOutboxEntryState)state responseObject:(nullable id)responseObject error:(nullable NSError *)error {
+    entry.state = state;
+    entry.error = error;
+    [self.entries removeObject:entry];
+    [self removeSavedEntry:entry];
+    
+    NSArray<APISuccessBlock> *successBlocks = [entry.successBlocks copy];
+    NSArray<APIFailureBlock> *failureBlocks = [entry.failureBlocks copy];
+    [entry.successBlocks removeAllObjects];
+    [entry.failureBlocks removeAllObjects];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (error) {
+            for (APIFailureBlock failure in failureBlocks) {
+                failure(error);
+            }
+        } else {
+            for (APISuccessBlock success in successBlocks) {
+                success(responseObject);
+            }
+        }
+    });
+    [self postChangeForEntry:entry responseObject:responseObject];
+}
+
+/// 安排下一次处理（只保留最近一次安排的定时器）
+- (void)scheduleProcessingAfterDelay:(NSTimeInterval)delay {
+    NSUInteger generation = ++self.timerGeneration;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+        if (generation == self.timerGeneration) {
+            [self processNextEntry];
+        }
+    });
+}
+
+- (void)postChangeForEntry:(APIOutboxEntry *)entry responseObject:(nullable id)responseObject {
+    NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithObject:entry forKey:APIOutboxEntryKey];
+    userInfo[APIOutboxResponseObjectKey] = responseObject;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [[NSNotificationCenter defaultCenter] postNotificationName:APIOutboxDidChangeNotification object:self userInfo:userInfo];
+    });
+}
+
+#pragma mark - Network & Lifecycle
+
+- (void)reachabilityDidChange:(NSNotification *)notification {
+    AFNetworkReachabilityStatus status = [notification.userInfo[AFNetworkingReachabilityNotificationStatusItem] integerValue];
+    if (status == AFNetworkReachabilityStatusReachableViaWWAN || status == AFNetworkReachabilityStatusReachableViaWiFi) {
+        [self flush];
+    }
+}
+
+- (void)applicationWillEnterForeground:(NSNotification *)notification {
+    [self flush];
+}
+
+#pragma mark - Persistence
+
+- (NSString *)storageFilePathForEntry:(APIOutboxEntry *)entry {
+    return [self.storagePath stringByAppendingPathComponent:[entry.identifier stringByAppendingPathExtension:@"plist"]];
+}
+
+- (void)saveEntry:(APIOutboxEntry *)entry {
+    NSError *error = nil;
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:entry requiringSecureCoding:YES error:&error];
+    if (!data || ![data writeToFile:[self storageFilePathForEntry:entry] options:NSDataWritingAtomic error:&error]) {
+        NSLog(@"⚠️ 写请求保存失败: %@", error.localizedDescription);
+    }
+}
+
+- (void)removeSavedEntry:(APIOutboxEntry *)entry {
+    [[NSFileManager defaultManager] removeItemAtPath:[self storageFilePathForEntry:entry] error:nil];
+}
+
+/// 恢复上次启动留下的写请求（按入队顺序）
+- (void)restoreEntries {
+    NSArray<NSString *> *fileNames = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:self.storagePath error:nil];
+    for (NSString *fileName in fileNames) {
+        if (![fileName.pathExtension isEqualToString:@"plist"]) {
+            continue;
+        }
+        
+        NSString *filePath = [self.storagePath stringByAppendingPathComponent:fileName];
+        NSData *data = [NSData dataWithContentsOfFile:filePath];
+        NSError *error = nil;
+        APIOutboxEntry *entry = data ? [NSKeyedUnarchiver unarchivedObjectOfClass:[APIOutboxEntry class] fromData:data error:&error] : nil;
+        if (!entry) {
+            NSLog(@"⚠️ 写请求记录读取失败，已移除: %@", error.localizedDescription);
+            [[NSFileManager defaultManager] removeItemAtPath:filePath error:nil];
+            continue;
+        }
+        [self.entries addObject:entry];
+    }
+    
+    [self.entries sortUsingComparator:^NSComparisonResult(APIOutboxEntry *entry1, APIOutboxEntry *entry2) {
+        return entry1.sequence < entry2.sequence ? NSOrderedAscending : (entry1.sequence > entry2.sequence ? NSOrderedDescending : NSOrderedSame);
+    }];
+    self.nextSequence = self.entries.lastObject.sequence + 1;
+    
+    if (self.entries.count > 0) {
+        NSLog(@"📮 恢复%lu个未发送的写请求", (unsigned long)self.entries.count);
+    }
+}
+
+@end
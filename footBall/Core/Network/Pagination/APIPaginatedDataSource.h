@@ -0,0 +1,101 @@
+//
+//  APIPaginatedDataSource.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import "APIRequestOptions.h"
+#import "APIError.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 从响应中取出本页数据（如 ^(UserListModel *list) { return list.users; }）
+typedef NSArray * _Nullable (^APIPaginatedItemsBlock)(id responseObject);
+/// 页面加载完成回调（itemRange为该页数据在整个列表中的范围）
+typedef void(^APIPaginatedPageLoadedBlock)(NSInteger page, NSRange itemRange);
+/// 页面加载失败回调
+typedef void(^APIPaginatedFailureBlock)(NSInteger page, APIError *error);
+
+/// 分页数据源 - 按路径名称分页请求列表接口，由列表的可见范围驱动
+/// 可见范围接近已加载数据的末尾时预加载下一页（网络差时减少或不预加载，见 APINetworkQualityEstimator），
+/// 同一页同时只有一个请求；内存中最多保留 maxPagesInMemory 页，离可见范围最远的页先移出，滚动回来时重新加载；
+/// 快速滚走后，可见范围附近以外还在加载的页直接取消
+/// 非线程安全，在主线程使用，回调也在主线程
+@interface APIPaginatedDataSource : NSObject
+
+/// 路径名称
+@property (nonatomic, copy, readonly) NSString *pathName;
+
+/// 公共请求参数（如搜索关键字），分页参数会追加在其中
+@property (nonatomic, copy, readonly, nullable) NSDictionary<NSString *, id> *parameters;
+
+/// 每页数量（默认：20，最小1）
+@property (nonatomic, assign) NSUInteger pageSize;
+
+/// 第一页的页码（默认：1）
+@property (nonatomic, assign) NSInteger firstPage;
+
+/// 页码参数名（默认：@"page"）
+@property (nonatomic, copy) NSString *pageParameterName;
+
+/// 每页数量参数名（默认：@"pageSize"）
+@property (nonatomic, copy) NSString *pageSizeParameterName;
+
+/// 可见范围距已加载数据末尾不超过这个数量时预加载下一页（默认：5）
+@property (nonatomic, assign) NSUInteger prefetchThreshold;
+
+/// 内存中最多保留的页数（默认：5，至少2）
+@property (nonatomic, assign) NSUInteger maxPagesInMemory;
+
+/// 从响应中取出本页数据（默认：响应本身是数组时直接使用）
+@property (nonatomic, copy, nullable) APIPaginatedItemsBlock itemsBlock;
+
+/// 页面加载完成回调
+@property (nonatomic, copy, nullable) APIPaginatedPageLoadedBlock pageLoadedBlock;
+
+/// 页面加载失败回调
+@property (nonatomic, copy, nullable) APIPaginatedFailureBlock failureBlock;
+
+/// 列表总数（已加载到的最后一页为止，移出内存的页也计算在内）
+@property (nonatomic, assign, readonly) NSUInteger numberOfItems;
+
+/// 是否还有下一页（最后一页不满一页时为NO）
+@property (nonatomic, assign, readonly) BOOL hasMorePages;
+
+/// 正在加载的页数
+@property (nonatomic, assign, readonly) NSUInteger loadingPageCount;
+
+/// 初始化
+/// @param pathName 路径名称（如：APIPathNameUserList）
+/// @param parameters 公共请求参数（可选）
+/// @param options 请求选项（可选，如响应模型类；每页的优先级由数据源设置，每页的取消作用域是 options.cancellationScope 的子作用域，所有者离开时所有页一并取消）
+- (instancetype)initWithPathName:(NSString *)pathName
+                      parameters:(nullable NSDictionary<NSString *, id> *)parameters
+                         options:(nullable APIRequestOptions *)options NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// 指定位置的数据
+/// @param index 位置
+/// @return 所在页已移出内存或还未加载时返回nil（可见时会自动重新加载）
+- (nullable id)itemAtIndex:(NSUInteger)index;
+
+/// 更新可见范围（在 scrollViewDidScroll: 等位置调用）
+/// 加载可见范围内缺失的页、按阈值预加载下一页、取消已经滚走的页的请求，并移出离可见范围最远的页
+/// @param visibleRange 可见数据的范围
+- (void)updateVisibleRange:(NSRange)visibleRange;
+
+/// 加载下一页（已在加载或没有下一页时忽略）
+- (void)loadNextPage;
+
+/// 重新加载（取消所有进行中的请求，清空数据后加载第一页）
+- (void)reloadData;
+
+/// 取消所有进行中的请求
+- (void)cancelAllRequests;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,274 @@
+//
+//  APIPaginatedDataSource.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIPaginatedDataSource.h"
+#import "APIManager.h"
+#import "APINetworkQualityEstimator.h"
+
+@interface APIPaginatedDataSource ()
+
+@property (nonatomic, copy, readwrite) NSString *pathName;
+@property (nonatomic, copy, readwrite, nullable) NSDictionary<NSString *, id> *parameters;
+@property (nonatomic, copy, nullable) APIRequestOptions *options;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSArray *> *pages; // 页序号（从0开始） -> 数据
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, APICancellationScope *> *loadingScopes; // 页序号 -> 该页请求的取消作用域
+@property (nonatomic, assign) NSUInteger pageCount; // 已加载到的页数（移出内存的页也计算在内）
+@property (nonatomic, assign) NSUInteger lastPageItemCount; // 最后一页的数量
+@property (nonatomic, assign) BOOL reachedEnd;
+@property (nonatomic, assign) NSRange visibleRange;
+
+@end
+
+@implementation APIPaginatedDataSource
+
+- (instancetype)initWithPathName:(NSString *)pathName
+                      parameters:(nullable NSDictionary<NSString *, id> *)parameters
+                         options:(nullable APIRequestOptions *)options {
+    self = [super init];
+    if (self) {
+        _pathName = [pathName copy];
+        _parameters = [parameters copy];
+        _options = [options copy];
+        _pageSize = 20;
+        _firstPage = 1;
+        _pageParameterName = @"page";
+        _pageSizeParameterName = @"pageSize";
+        _prefetchThreshold = 5;
+        _maxPagesInMemory = 5;
+        _pages = [NSMutableDictionary dictionary];
+        _loadingScopes = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self cancelAllRequests];
+}
+
+#pragma mark - Public Methods
+
+- (void)setPageSize:(NSUInteger)pageSize {
+    // itemAtIndex: 和可见页的计算都按每页数量做除法
+    _pageSize = MAX(pageSize, (NSUInteger)1);
+}
+
+- (NSUInteger)numberOfItems {
+    if (self.pageCount == 0) {
+        return 0;
+    }
+    return (self.pageCount - 1) * self.pageSize + self.lastPageItemCount;
+}
+
+- (BOOL)hasMorePages {
+    return !self.reachedEnd;
+}
+
+- (NSUInteger)loadingPageCount {
+    return self.loadingScopes.count;
+}
+
+- (nullable id)itemAtIndex:(NSUInteger)index {
+    NSArray *items = self.pages[@(index / self.pageSize)];
+    NSUInteger offset = index % self.pageSize;
+    return offset < items.count ? items[offset] : nil;
+}
+
+- (void)updateVisibleRange:(NSRange)visibleRange {
+    self.visibleRange = visibleRange;
+    NSUInteger numberOfItems = self.numberOfItems;
+    if (numberOfItems == 0 || visibleRange.length == 0) {
+        return;
+    }
+    
+    NSUInteger lastVisibleIndex = MIN(NSMaxRange(visibleRange), numberOfItems) - 1;
+    NSRange visiblePages = [self visiblePageRange];
+    
+    // 接近末尾时预加载下一页；网络差时阈值减小，2G级别只在滚到最后一条时才加载
+    NSUInteger threshold = [[APINetworkQualityEstimator sharedEstimator] adjustedPrefetchCount:self.prefetchThreshold];
+    BOOL reachedLastItem = lastVisibleIndex + 1 >= numberOfItems;
+    BOOL needsNextPage = self.hasMorePages && lastVisibleIndex + 1 + threshold >= numberOfItems;
+    
+    // 快速滚走后，可见范围前后一页以外的请求不再需要
+    for (NSNumber *key in self.loadingScopes.allKeys) {
+        NSUInteger pageIndex = key.unsignedIntegerValue;
+        if ([self distanceOfPageIndex:pageIndex fromPageRange:visiblePages] <= 1 ||
+            (pageIndex == self.pageCount && needsNextPage)) {
+            continue;
+        }
+        NSLog(@"⏹️ 取消已滚走的分页请求: %@ 第%ld页", self.pathName, (long)(self.firstPage + pageIndex));
+        [self.loadingScopes[key] cancel];
+        [self.loadingScopes removeObjectForKey:key];
+    }
+    
+    // 可见范围内移出内存的页重新加载
+    for (NSUInteger pageIndex = visiblePages.location; pageIndex < NSMaxRange(visiblePages); pageIndex++) {
+        [self loadPageIndex:pageIndex priority:APIRequestPriorityVisibleContent];
+    }
+    
+    if (needsNextPage) {
+        [self loadPageIndex:self.pageCount
+                   priority:reachedLastItem ? APIRequestPriorityVisibleContent : APIRequestPriorityPrefetch];
+    }
+    
+    [self evictPages];
+}
+
+- (void)loadNextPage {
+    [self loadPageIndex:self.pageCount priority:APIRequestPriorityVisibleContent];
+}
+
+- (void)reloadData {
+    [self cancelAllRequests];
+    [self.pages removeAllObjects];
+    self.pageCount = 0;
+    self.lastPageItemCount = 0;
+    self.reachedEnd = NO;
+    self.visibleRange = NSMakeRange(0, 0);
+    [self loadNextPage];
+}
+
+- (void)cancelAllRequests {
+    for (APICancellationScope *scope in self.loadingScopes.allValues) {
+        [scope cancel];
+    }
+    [self.loadingScopes removeAllObjects];
+}
+
+#pragma mark - Private Methods
+
+/// 加载一页（已加载、正在加载、超出最后一页之后时忽略）
+/// @param pageIndex 页序号（从0开始）
+- (void)loadPageIndex:(NSUInteger)pageIndex priority:(APIRequestPriority)priority {
+    if (pageIndex > self.pageCount || (pageIndex == self.pageCount && self.reachedEnd)) {
+        return;
+    }
+    if (self.pages[@(pageIndex)]) {
+        return;
+    }
+    
+    // 正在加载；所有者的作用域取消后请求不再回调，作用域中没有进行中的请求时重新加载
+    APICancellationScope *loadingScope = self.loadingScopes[@(pageIndex)];
+    if (loadingScope && loadingScope.activeRequestCount > 0) {
+        return;
+    }
+    
+    // 每页一个取消作用域（所有者作用域的子作用域）：滚走时只取消这一页，所有者离开时所有页一并取消
+    APICancellationScope *ownerScope = self.options.cancellationScope;
+    APICancellationScope *scope = ownerScope ? [ownerScope childScope] : [[APICancellationScope alloc] init];
+    self.loadingScopes[@(pageIndex)] = scope;
+    
+    APIRequestOptions *options = [self.options copy] ?: [[APIRequestOptions alloc] init];
+    options.priority = priority;
+    options.cancellationScope = scope;
+    
+    NSMutableDictionary<NSString *, id> *parameters = [NSMutableDictionary dictionaryWithDictionary:self.parameters ?: @{}];
+    parameters[self.pageParameterName] = @(self.firstPage + pageIndex);
+    parameters[self.pageSizeParameterName] = @(self.pageSize);
+    
+    __weak typeof(self) weakSelf = self;
+    [[APIManager sharedManager] GETWithPathName:self.pathName
+                                        subPath:nil
+                                     parameters:parameters
+                                        headers:nil
+                                        options:options
+                                        success:^(id responseObject) {
+        [weakSelf didLoadPageIndex:pageIndex scope:scope responseObject:responseObject];
+    } failure:^(NSError *error) {
+        [weakSelf didFailToLoadPageIndex:pageIndex scope:scope error:error];
+    }];
+}
+
+- (void)didLoadPageIndex:(NSUInteger)pageIndex scope:(APICancellationScope *)scope responseObject:(id)responseObject {
+    // 重新加载后旧请求的结果不再使用
+    if (self.loadingScopes[@(pageIndex)] != scope) {
+        return;
+    }
+    [self.loadingScopes removeObjectForKey:@(pageIndex)];
+    
+    NSArray *items = self.itemsBlock ? self.itemsBlock(responseObject) : responseObject;
+    if (![items isKindOfClass:[NSArray class]]) {
+        items = @[];
+    }
+    
+    self.pages[@(pageIndex)] = items;
+    if (pageIndex + 1 >= self.pageCount) {
+        self.pageCount = pageIndex + 1;
+        self.lastPageItemCount = items.count;
+        self.reachedEnd = items.count < self.pageSize;
+    }
+    NSLog(@"📄 分页加载完成: %@ 第%ld页（%lu条）", self.pathName, (long)(self.firstPage + pageIndex), (unsigned long)items.count);
+    
+    [self evictPages];
+    
+    if (self.pageLoadedBlock) {
+        self.pageLoadedBlock(self.firstPage + pageIndex, NSMakeRange(pageIndex * self.pageSize, items.count));
+    }
+}
+
+- (void)didFailToLoadPageIndex:(NSUInteger)pageIndex scope:(APICancellationScope *)scope error:(NSError *)error {
+    if (self.loadingScopes[@(pageIndex)] != scope) {
+        return;
+    }
+    [self.loadingScopes removeObjectForKey:@(pageIndex)];
+    
+    NSLog(@"❌ 分页加载失败: %@ 第%ld页, %@", self.pathName, (long)(self.firstPage + pageIndex), error.localizedDescription);
+    if (self.failureBlock) {
+        APIError *apiError = [error isKindOfClass:[APIError class]] ? (APIError *)error : [APIError errorFromNSError:error];
+        self.failureBlock(self.firstPage + pageIndex, apiError);
+    }
+}
+
+/// 超出内存页数时，移出离可见范围最远的页（可见的页不移出）
+- (void)evictPages {
+    NSUInteger maxPages = MAX(self.maxPagesInMemory, (NSUInteger)2);
+    if (self.pages.count <= maxPages) {
+        return;
+    }
+    
+    NSRange visiblePages = [self visiblePageRange];
+    NSArray<NSNumber *> *pageIndexes = [self.pages.allKeys sortedArrayUsingComparator:^NSComparisonResult(NSNumber *obj1, NSNumber *obj2) {
+        NSUInteger distance1 = [self distanceOfPageIndex:obj1.unsignedIntegerValue fromPageRange:visiblePages];
+        NSUInteger distance2 = [self distanceOfPageIndex:obj2.unsignedIntegerValue fromPageRange:visiblePages];
+        return distance1 > distance2 ? NSOrderedAscending : (distance1 < distance2 ? NSOrderedDescending : NSOrderedSame);
+    }];
+    
+    for (NSNumber *key in pageIndexes) {
+        if (self.pages.count <= maxPages) {
+            break;
+        }
+        if ([self distanceOfPageIndex:key.unsignedIntegerValue fromPageRange:visiblePages] == 0) {
+            continue;
+        }
+        [self.pages removeObjectForKey:key];
+        NSLog(@"🗑️ 分页移出内存: %@ 第%ld页", self.pathName, (long)(self.firstPage + key.unsignedIntegerValue));
+    }
+}
+
+/// 可见范围所在的页（还没有可见范围时取最后一页）
+- (NSRange)visiblePageRange {
+    NSUInteger numberOfItems = self.numberOfItems;
+    if (self.visibleRange.length == 0 || numberOfItems == 0) {
+        return NSMakeRange(self.pageCount > 0 ? self.pageCount - 1 : 0, 1);
+    }
+    
+    NSUInteger firstIndex = MIN(self.visibleRange.location, numberOfItems - 1);
+    NSUInteger lastIndex = MIN(NSMaxRange(self.visibleRange), numberOfItems) - 1;
+    NSUInteger firstPageIndex = firstIndex / self.pageSize;
+    return NSMakeRange(firstPageIndex, lastIndex / self.pageSize - firstPageIndex + 1);
+}
+
+- (NSUInteger)distanceOfPageIndex:(NSUInteger)pageIndex fromPageRange:(NSRange)pageRange {
+    if (pageIndex < pageRange.location) {
+        return pageRange.location - pageIndex;
+    }
+    if (pageIndex >= NSMaxRange(pageRange)) {
+        return pageIndex - NSMaxRange(pageRange) + 1;
+    }
+    return 0;
+}
+
+@end
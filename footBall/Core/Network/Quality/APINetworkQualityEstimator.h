@@ -0,0 +1,90 @@
+//
+//  APINetworkQualityEstimator.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 网络质量等级变化通知（主线程发送，object为估算器）
+FOUNDATION_EXPORT NSString *const APINetworkQualityDidChangeNotification;
+
+/// 网络质量等级
+typedef NS_ENUM(NSInteger, APINetworkQuality) {
+    APINetworkQualityUnknown = 0,  // 样本不足（按良好处理）
+    APINetworkQualityPoor,         // 2G级别（HTTP RTT ≥ 1400ms 或 吞吐 ≤ 75kbps）
+    APINetworkQualityModerate,     // 3G级别（HTTP RTT ≥ 270ms 或 吞吐 ≤ 700kbps）
+    APINetworkQualityGood          // 4G/WiFi
+};
+
+/// 网络质量估算 - 被动地从请求的task metrics和WebSocket Ping中采样，不发送额外的探测请求
+/// HTTP RTT取请求发出到响应首字节减去服务端耗时（Server-Timing），再取每个主机最近几个样本的最小值，慢接口的服务端处理时间不计入；
+/// 传输层RTT取TCP握手和WebSocket Ping往返，吞吐取较大响应体的传输速率，丢包率取超时、连接中断和Ping无响应的比例；
+/// 各指标按指数加权平均，网络类型变化（WiFi/蜂窝）时清空重新采样；等级降低需要连续多次评估都更差，升高立即生效
+/// 超时、每个主机的并发数、预加载数量和图片尺寸都按 quality 调整
+@interface APINetworkQualityEstimator : NSObject
+
+/// 单例
++ (instancetype)sharedEstimator;
+
+/// 当前网络质量等级
+@property (nonatomic, assign, readonly) APINetworkQuality quality;
+
+/// HTTP RTT（秒，没有样本时为0）
+@property (nonatomic, assign, readonly) NSTimeInterval HTTPRoundTripTime;
+
+/// 传输层RTT（秒，没有样本时为0）
+@property (nonatomic, assign, readonly) NSTimeInterval transportRoundTripTime;
+
+/// 下行吞吐（kbps，没有样本时为0）
+@property (nonatomic, assign, readonly) double downstreamThroughput;
+
+/// 丢包率（0~1）
+@property (nonatomic, assign, readonly) double lossRate;
+
+/// 已采集的样本数（RTT、吞吐和丢包合计）
+@property (nonatomic, assign, readonly) NSUInteger sampleCount;
+
+/// 确定等级所需的最少RTT样本数（默认：3），不足时为 APINetworkQualityUnknown
+@property (nonatomic, assign) NSUInteger minimumSampleCount;
+
+/// 等级降低前需要连续评估为更差等级的次数（默认：3），单个慢请求或偶发超时不会立即降级
+@property (nonatomic, assign) NSUInteger downgradeConfirmationCount;
+
+/// 从请求的task metrics采样（在 APIManager 的metrics回调中调用）
+/// @param metrics task metrics
+/// @param task 对应的task
+- (void)recordMetrics:(NSURLSessionTaskMetrics *)metrics forTask:(NSURLSessionTask *)task;
+
+/// 记录一次Ping往返（WebSocket收到Pong时调用）
+/// @param roundTripTime 往返耗时（秒）
+- (void)recordPingRoundTripTime:(NSTimeInterval)roundTripTime;
+
+/// 记录一次Ping丢失（下一次心跳时上一次Ping仍未收到Pong）
+- (void)recordPingLoss;
+
+/// 按网络质量放大超时或等待间隔（良好和未知时不变，3G级别1.5倍，2G级别2倍）
+/// @param interval 基础超时或间隔（秒）
+- (NSTimeInterval)adjustedInterval:(NSTimeInterval)interval;
+
+/// 按网络质量限制并发数（3G级别2/3，2G级别1/3，至少1个）
+/// @param limit 配置的并发数
+- (NSUInteger)adjustedConcurrencyLimit:(NSUInteger)limit;
+
+/// 按网络质量限制预加载数量（3G级别减半，2G级别不预加载）
+/// @param count 计划预加载的数量
+- (NSUInteger)adjustedPrefetchCount:(NSUInteger)count;
+
+/// 重新采样
+- (void)reset;
+
+/// 等级显示名称
+/// @param quality 网络质量等级
++ (NSString *)displayNameForQuality:(APINetworkQuality)quality;
+
+@end
+
+NS_ASSUME_NONNULL_END
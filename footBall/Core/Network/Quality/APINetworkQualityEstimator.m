@@ -0,0 +1,376 @@
+//
+//  APINetworkQualityEstimator.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APINetworkQualityEstimator.h"
+#import <AFNetworking/AFNetworking.h>
+
+NSString *const APINetworkQualityDidChangeNotification = @"APINetworkQualityDidChangeNotification";
+
+/// 指数加权平均中新样本的权重
+static const double kAPINetworkQualitySmoothing = 0.2;
+
+/// 参与吞吐计算的最小响应体（字节），小响应的耗时主要是RTT，算出的吞吐偏低
+static const int64_t kAPINetworkQualityMinThroughputBytes = 16 * 1024;
+
+/// 每个主机保留的HTTP RTT样本数（取其中最小值，过滤服务端处理慢的接口）
+static const NSUInteger kAPINetworkQualityHostSampleCount = 5;
+
+/// 丢包率达到该值时等级降一级
+static const double kAPINetworkQualityLossRateThreshold = 0.1;
+
+/// 等级阈值（参考各代移动网络的典型值）
+static const NSTimeInterval kAPINetworkQualityPoorHTTPRTT = 1.4;
+static const NSTimeInterval kAPINetworkQualityPoorTransportRTT = 1.28;
+static const double kAPINetworkQualityPoorThroughput = 75;
+static const NSTimeInterval kAPINetworkQualityModerateHTTPRTT = 0.27;
+static const NSTimeInterval kAPINetworkQualityModerateTransportRTT = 0.2;
+static const double kAPINetworkQualityModerateThroughput = 700;
+
+/// 指数加权平均（第一个样本直接作为初值）
+static double APINetworkQualitySmooth(double average, NSUInteger count, double sample) {
+    return count == 0 ? sample : average + kAPINetworkQualitySmoothing * (sample - average);
+}
+
+@interface APINetworkQualityEstimator ()
+
+@property (nonatomic, assign, readwrite) APINetworkQuality quality;
+@property (nonatomic, assign, readwrite) NSTimeInterval HTTPRoundTripTime;
+@property (nonatomic, assign, readwrite) NSTimeInterval transportRoundTripTime;
+@property (nonatomic, assign, readwrite) double downstreamThroughput;
+@property (nonatomic, assign, readwrite) double lossRate;
+@property (nonatomic, assign) NSUInteger HTTPSampleCount;
+@property (nonatomic, assign) NSUInteger transportSampleCount;
+@property (nonatomic, assign) NSUInteger throughputSampleCount;
+@property (nonatomic, assign) NSUInteger lossSampleCount;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<NSNumber *> *> *hostHTTPRoundTripTimes; // 主机 -> 最近的HTTP RTT样本
+@property (nonatomic, assign) NSUInteger downgradeCount; // 连续评估为更差等级的次数
+
+@end
+
+@implementation APINetworkQualityEstimator
+
++ (instancetype)sharedEstimator {
+    static APINetworkQualityEstimator *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[APINetworkQualityEstimator alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _quality = APINetworkQualityUnknown;
+        _minimumSampleCount = 3;
+        _downgradeConfirmationCount = 3;
+        _hostHTTPRoundTripTimes = [NSMutableDictionary dictionary];
+        
+        // WiFi和蜂窝网络切换后，之前的样本不再代表当前链路
+        [[AFNetworkReachabilityManager sharedManager] startMonitoring];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(reachabilityDidChange:)
+                                                     name:AFNetworkingReachabilityDidChangeNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+#pragma mark - Public Methods
+
+- (APINetworkQuality)quality {
+    @synchronized (self) {
+        return _quality;
+    }
+}
+
+- (NSUInteger)sampleCount {
+    @synchronized (self) {
+        return self.HTTPSampleCount + self.transportSampleCount + self.throughputSampleCount + self.lossSampleCount;
+    }
+}
+
+- (void)recordMetrics:(NSURLSessionTaskMetrics *)metrics forTask:(NSURLSessionTask *)task {
+    // 取消的请求和离线时的失败不代表链路质量
+    NSError *error = task.error;
+    if ([error.domain isEqualToString:NSURLErrorDomain] &&
+        (error.code == NSURLErrorCancelled || error.code == NSURLErrorNotConnectedToInternet)) {
+        return;
+    }
+    
+    BOOL loadedFromNetwork = NO;
+    APINetworkQuality previousQuality;
+    @synchronized (self) {
+        previousQuality = _quality;
+        for (NSURLSessionTaskTransactionMetrics *transaction in metrics.transactionMetrics) {
+            if (transaction.resourceFetchType != NSURLSessionTaskMetricsResourceFetchTypeNetworkLoad) {
+                continue;
+            }
+            loadedFromNetwork = YES;
+            
+            // HTTP RTT：请求发出到响应首字节，减去服务端声明的处理时间，再按主机过滤
+            if (transaction.requestStartDate && transaction.responseStartDate) {
+                NSTimeInterval timeToFirstByte = [transaction.responseStartDate timeIntervalSinceDate:transaction.requestStartDate];
+                NSTimeInterval serverTime = [self serverTimeOfResponse:transaction.response];
+                NSTimeInterval roundTripTime = serverTime > 0 && serverTime < timeToFirstByte ? timeToFirstByte - serverTime : timeToFirstByte;
+                [self addHTTPRoundTripTime:roundTripTime host:transaction.request.URL.host];
+            }
+            
+            // 传输层RTT：新建连接的TCP握手（不含TLS）正好一个往返
+            if (!transaction.isReusedConnection && transaction.connectStartDate && transaction.connectEndDate) {
+                NSDate *handshakeEndDate = transaction.secureConnectionStartDate ?: transaction.connectEndDate;
+                [self addTransportRoundTripTime:[handshakeEndDate timeIntervalSinceDate:transaction.connectStartDate]];
+            }
+            
+            // 吞吐：只取足够大的响应体
+            NSTimeInterval transferDuration = [transaction.responseEndDate timeIntervalSinceDate:transaction.responseStartDate];
+            if (transaction.countOfResponseBodyBytesReceived >= kAPINetworkQualityMinThroughputBytes && transferDuration > 0) {
+                double throughput = transaction.countOfResponseBodyBytesReceived * 8.0 / 1000.0 / transferDuration;
+                self.downstreamThroughput = APINetworkQualitySmooth(self.downstreamThroughput, self.throughputSampleCount, throughput);
+                self.throughputSampleCount++;
+            }
+        }
+        
+        // 走网络的请求按是否超时/连接中断计入丢包率；连接都没建立就超时的请求没有网络传输，也要计入
+        BOOL lost = [error.domain isEqualToString:NSURLErrorDomain] &&
+            (error.code == NSURLErrorTimedOut || error.code == NSURLErrorNetworkConnectionLost);
+        if (loadedFromNetwork || lost) {
+            [self addLossSample:lost];
+        }
+        [self updateQuality];
+    }
+    [self notifyIfQualityChangedFrom:previousQuality];
+}
+
+- (void)recordPingRoundTripTime:(NSTimeInterval)roundTripTime {
+    if (roundTripTime <= 0) {
+        return;
+    }
+    
+    APINetworkQuality previousQuality;
+    @synchronized (self) {
+        previousQuality = _quality;
+        [self addTransportRoundTripTime:roundTripTime];
+        [self addLossSample:NO];
+        [self updateQuality];
+    }
+    [self notifyIfQualityChangedFrom:previousQuality];
+}
+
+- (void)recordPingLoss {
+    APINetworkQuality previousQuality;
+    @synchronized (self) {
+        previousQuality = _quality;
+        [self addLossSample:YES];
+        [self updateQuality];
+    }
+    [self notifyIfQualityChangedFrom:previousQuality];
+}
+
+- (NSTimeInterval)adjustedInterval:(NSTimeInterval)interval {
+    switch (self.quality) {
+        case APINetworkQualityPoor:
+            return interval * 2.0;
+        case APINetworkQualityModerate:
+            return interval * 1.5;
+        case APINetworkQualityUnknown:
+        case APINetworkQualityGood:
+            return interval;
+    }
+}
+
+- (NSUInteger)adjustedConcurrencyLimit:(NSUInteger)limit {
+    switch (self.quality) {
+        case APINetworkQualityPoor:
+            return MAX(limit / 3, (NSUInteger)1);
+        case APINetworkQualityModerate:
+            return MAX(limit * 2 / 3, (NSUInteger)1);
+        case APINetworkQualityUnknown:
+        case APINetworkQualityGood:
+            return limit;
+    }
+}
+
+- (NSUInteger)adjustedPrefetchCount:(NSUInteger)count {
+    switch (self.quality) {
+        case APINetworkQualityPoor:
+            return 0;
+        case APINetworkQualityModerate:
+            return (count + 1) / 2;
+        case APINetworkQualityUnknown:
+        case APINetworkQualityGood:
+            return count;
+    }
+}
+
+- (void)reset {
+    APINetworkQuality previousQuality;
+    @synchronized (self) {
+        previousQuality = _quality;
+        self.HTTPRoundTripTime = 0;
+        self.transportRoundTripTime = 0;
+        self.downstreamThroughput = 0;
+        self.lossRate = 0;
+        self.HTTPSampleCount = 0;
+        self.transportSampleCount = 0;
+        self.throughputSampleCount = 0;
+        self.lossSampleCount = 0;
+        self.downgradeCount = 0;
+        [self.hostHTTPRoundTripTimes removeAllObjects];
+        _quality = APINetworkQualityUnknown;
+    }
+    [self notifyIfQualityChangedFrom:previousQuality];
+}
+
++ (NSString *)displayNameForQuality:(APINetworkQuality)quality {
+    switch (quality) {
+        case APINetworkQualityUnknown:
+            return @"未知";
+        case APINetworkQualityPoor:
+            return @"差（2G）";
+        case APINetworkQualityModerate:
+            return @"一般（3G）";
+        case APINetworkQualityGood:
+            return @"良好";
+    }
+}
+
+#pragma mark - Private Methods
+
+/// 响应头 Server-Timing 中声明的服务端耗时（秒，取各项dur的最大值，没有时为0）
+/// 如 Server-Timing: db;dur=53, app;dur=47.2
+- (NSTimeInterval)serverTimeOfResponse:(nullable NSURLResponse *)response {
+    if (![response isKindOfClass:[NSHTTPURLResponse class]]) {
+        return 0;
+    }
+    NSString *serverTiming = [(NSHTTPURLResponse *)response valueForHTTPHeaderField:@"Server-Timing"];
+    if (serverTiming.length == 0) {
+        return 0;
+    }
+    
+    double maxDuration = 0;
+    for (NSString *metric in [serverTiming componentsSeparatedByString:@","]) {
+        for (NSString *parameter in [metric componentsSeparatedByString:@";"]) {
+            NSString *trimmed = [parameter stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+            if ([trimmed hasPrefix:@"dur="]) {
+                maxDuration = MAX(maxDuration, [[trimmed substringFromIndex:4] doubleValue]);
+            }
+        }
+    }
+    return maxDuration / 1000.0;
+}
+
+/// 以下方法调用方已加锁
+/// 同一主机取最近几个样本的最小值计入（服务端处理时间只会让样本偏大，最小值最接近网络往返）
+- (void)addHTTPRoundTripTime:(NSTimeInterval)roundTripTime host:(nullable NSString *)host {
+    if (roundTripTime <= 0) {
+        return;
+    }
+    
+    NSTimeInterval filteredRoundTripTime = roundTripTime;
+    if (host.length > 0) {
+        NSMutableArray<NSNumber *> *samples = self.hostHTTPRoundTripTimes[host];
+        if (!samples) {
+            samples = [NSMutableArray arrayWithCapacity:kAPINetworkQualityHostSampleCount];
+            self.hostHTTPRoundTripTimes[host] = samples;
+        }
+        [samples addObject:@(roundTripTime)];
+        if (samples.count > kAPINetworkQualityHostSampleCount) {
+            [samples removeObjectAtIndex:0];
+        }
+        filteredRoundTripTime = [[samples valueForKeyPath:@"@min.doubleValue"] doubleValue];
+    }
+    self.HTTPRoundTripTime = APINetworkQualitySmooth(self.HTTPRoundTripTime, self.HTTPSampleCount, filteredRoundTripTime);
+    self.HTTPSampleCount++;
+}
+
+- (void)addTransportRoundTripTime:(NSTimeInterval)roundTripTime {
+    if (roundTripTime <= 0) {
+        return;
+    }
+    self.transportRoundTripTime = APINetworkQualitySmooth(self.transportRoundTripTime, self.transportSampleCount, roundTripTime);
+    self.transportSampleCount++;
+}
+
+- (void)addLossSample:(BOOL)lost {
+    self.lossRate = APINetworkQualitySmooth(self.lossRate, self.lossSampleCount, lost ? 1.0 : 0.0);
+    self.lossSampleCount++;
+}
+
+- (void)updateQuality {
+    if (self.HTTPSampleCount + self.transportSampleCount < self.minimumSampleCount) {
+        self.downgradeCount = 0;
+        _quality = APINetworkQualityUnknown;
+        return;
+    }
+    
+    APINetworkQuality quality = [self estimatedQuality];
+    
+    // 降级需要连续多次评估都更差（单个慢请求或偶发超时不降级）；首次确定等级和升级立即生效
+    if (_quality != APINetworkQualityUnknown && quality < _quality) {
+        self.downgradeCount++;
+        if (self.downgradeCount < MAX(self.downgradeConfirmationCount, (NSUInteger)1)) {
+            return;
+        }
+    }
+    self.downgradeCount = 0;
+    _quality = quality;
+}
+
+/// 按当前各指标估算的等级（样本数已足够）
+- (APINetworkQuality)estimatedQuality {
+    BOOL hasHTTPRTT = self.HTTPSampleCount > 0;
+    BOOL hasTransportRTT = self.transportSampleCount > 0;
+    BOOL hasThroughput = self.throughputSampleCount > 0;
+    APINetworkQuality quality = APINetworkQualityGood;
+    if ((hasHTTPRTT && self.HTTPRoundTripTime >= kAPINetworkQualityPoorHTTPRTT) ||
+        (hasTransportRTT && self.transportRoundTripTime >= kAPINetworkQualityPoorTransportRTT) ||
+        (hasThroughput && self.downstreamThroughput <= kAPINetworkQualityPoorThroughput)) {
+        quality = APINetworkQualityPoor;
+    } else if ((hasHTTPRTT && self.HTTPRoundTripTime >= kAPINetworkQualityModerateHTTPRTT) ||
+               (hasTransportRTT && self.transportRoundTripTime >= kAPINetworkQualityModerateTransportRTT) ||
+               (hasThroughput && self.downstreamThroughput <= kAPINetworkQualityModerateThroughput)) {
+        quality = APINetworkQualityModerate;
+    }
+    
+    // 频繁超时、断连的链路即使RTT正常也按低一级处理
+    if (self.lossSampleCount >= self.minimumSampleCount &&
+        self.lossRate >= kAPINetworkQualityLossRateThreshold &&
+        quality > APINetworkQualityPoor) {
+        quality--;
+    }
+    return quality;
+}
+
+- (void)notifyIfQualityChangedFrom:(APINetworkQuality)previousQuality {
+    APINetworkQuality currentQuality = self.quality;
+    if (currentQuality == previousQuality) {
+        return;
+    }
+    
+    NSLog(@"📶 网络质量: %@ -> %@（HTTP RTT %.0fms  传输RTT %.0fms  吞吐 %.0fkbps  丢包 %.0f%%）",
+          [APINetworkQualityEstimator displayNameForQuality:previousQuality],
+          [APINetworkQualityEstimator displayNameForQuality:currentQuality],
+          self.HTTPRoundTripTime * 1000,
+          self.transportRoundTripTime * 1000,
+          self.downstreamThroughput,
+          self.lossRate * 100);
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [[NSNotificationCenter defaultCenter] postNotificationName:APINetworkQualityDidChangeNotification object:self];
+    });
+}
+
+- (void)reachabilityDidChange:(NSNotification *)notification {
+    [self reset];
+}
+
+@end
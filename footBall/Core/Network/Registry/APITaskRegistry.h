@@ -0,0 +1,85 @@
+//
+//  APITaskRegistry.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 文件上传请求的标签（uploadFile: 和分片上传）
+FOUNDATION_EXPORT NSString *const APITaskTagUpload;
+/// 文件下载请求的标签（APIDownloadManager 的HEAD和分段请求）
+FOUNDATION_EXPORT NSString *const APITaskTagDownload;
+/// 对冲请求的标签（同时带有主请求的标签）
+FOUNDATION_EXPORT NSString *const APITaskTagHedge;
+/// 图片预加载请求的标签
+FOUNDATION_EXPORT NSString *const APITaskTagImagePrefetch;
+
+/// 请求统计快照
+@interface APITaskRegistryStatistics : NSObject
+
+/// 已启动的请求数
+@property (nonatomic, assign, readonly) NSUInteger inflightCount;
+
+/// 排队中的请求数（已创建，等待调度器启动）
+@property (nonatomic, assign, readonly) NSUInteger queuedCount;
+
+/// 等待重试的请求数（失败后等待退避，还没有新的task）
+@property (nonatomic, assign, readonly) NSUInteger retryingCount;
+
+/// 进行中的请求已发送和已接收的字节数合计
+@property (nonatomic, assign, readonly) int64_t bytesInFlight;
+
+/// 各标签的请求数
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, NSNumber *> *tagCounts;
+
+@end
+
+/// 请求登记表 - 线程安全地记录进行中的task及其标签（如 @"imagePrefetch"、路径名称 @"user"）
+/// 以task对象为键（taskIdentifier只在单个会话内唯一），登记、移除和按标签查找都是O(1)；读操作并发，写操作互斥
+@interface APITaskRegistry : NSObject
+
+/// 登记task
+/// @param task 请求task
+/// @param tags 标签（可选）
+- (void)registerTask:(NSURLSessionTask *)task tags:(nullable NSSet<NSString *> *)tags;
+
+/// 移除task（task结束时调用）
+/// @param task 请求task
+- (void)unregisterTask:(nullable NSURLSessionTask *)task;
+
+/// task的标签
+/// @param task 请求task
+- (NSSet<NSString *> *)tagsForTask:(NSURLSessionTask *)task;
+
+/// 带指定标签的task
+/// @param tag 标签
+- (NSArray<NSURLSessionTask *> *)tasksWithTag:(NSString *)tag;
+
+/// 所有登记的task
+- (NSArray<NSURLSessionTask *> *)allTasks;
+
+/// 取消带指定标签的task
+/// @param tag 标签
+/// @return 取消的task数
+- (NSUInteger)cancelTasksWithTag:(NSString *)tag;
+
+/// 取消所有登记的task
+/// @return 取消的task数
+- (NSUInteger)cancelAllTasks;
+
+/// 请求开始等待重试（和 endWaitingRetry 成对调用）
+- (void)beginWaitingRetry;
+
+/// 请求结束等待重试
+- (void)endWaitingRetry;
+
+/// 当前统计快照
+- (APITaskRegistryStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,190 @@
+//
+//  APITaskRegistry.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APITaskRegistry.h"
+
+NSString *const APITaskTagUpload = @"upload";
+NSString *const APITaskTagDownload = @"download";
+NSString *const APITaskTagHedge = @"hedge";
+NSString *const APITaskTagImagePrefetch = @"imagePrefetch";
+
+@interface APITaskRegistryStatistics ()
+
+@property (nonatomic, assign, readwrite) NSUInteger inflightCount;
+@property (nonatomic, assign, readwrite) NSUInteger queuedCount;
+@property (nonatomic, assign, readwrite) NSUInteger retryingCount;
+@property (nonatomic, assign, readwrite) int64_t bytesInFlight;
+@property (nonatomic, copy, readwrite) NSDictionary<NSString *, NSNumber *> *tagCounts;
+
+@end
+
+@implementation APITaskRegistryStatistics
+
+@end
+
+@interface APITaskRegistry ()
+
+@property (nonatomic, strong) dispatch_queue_t queue; // 并发队列：读操作dispatch_sync，写操作barrier
+@property (nonatomic, strong) NSMapTable<NSURLSessionTask *, NSSet<NSString *> *> *tasks; // task -> 标签（按对象指针比较）
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSHashTable<NSURLSessionTask *> *> *tagIndex; // 标签 -> task
+@property (nonatomic, assign) NSUInteger retryingCount;
+
+@end
+
+@implementation APITaskRegistry
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("com.football.api.registry", DISPATCH_QUEUE_CONCURRENT);
+        _tasks = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                           valueOptions:NSPointerFunctionsStrongMemory
+                                               capacity:32];
+        _tagIndex = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark - Public Methods
+
+- (void)registerTask:(NSURLSessionTask *)task tags:(nullable NSSet<NSString *> *)tags {
+    NSSet<NSString *> *taskTags = [tags copy] ?: [NSSet set];
+    dispatch_barrier_sync(self.queue, ^{
+        [self.tasks setObject:taskTags forKey:task];
+        for (NSString *tag in taskTags) {
+            NSHashTable<NSURLSessionTask *> *tagTasks = self.tagIndex[tag];
+            if (!tagTasks) {
+                tagTasks = [NSHashTable hashTableWithOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality];
+                self.tagIndex[tag] = tagTasks;
+            }
+            [tagTasks addObject:task];
+        }
+    });
+}
+
+- (void)unregisterTask:(nullable NSURLSessionTask *)task {
+    if (!task) {
+        return;
+    }
+    dispatch_barrier_async(self.queue, ^{
+        [self removeTask:task];
+    });
+}
+
+- (NSSet<NSString *> *)tagsForTask:(NSURLSessionTask *)task {
+    __block NSSet<NSString *> *tags = nil;
+    dispatch_sync(self.queue, ^{
+        tags = [self.tasks objectForKey:task];
+    });
+    return tags ?: [NSSet set];
+}
+
+- (NSArray<NSURLSessionTask *> *)tasksWithTag:(NSString *)tag {
+    __block NSArray<NSURLSessionTask *> *tasks = nil;
+    dispatch_sync(self.queue, ^{
+        tasks = self.tagIndex[tag].allObjects;
+    });
+    return tasks ?: @[];
+}
+
+- (NSArray<NSURLSessionTask *> *)allTasks {
+    __block NSArray<NSURLSessionTask *> *tasks = nil;
+    dispatch_sync(self.queue, ^{
+        tasks = self.tasks.keyEnumerator.allObjects;
+    });
+    return tasks;
+}
+
+- (NSUInteger)cancelTasksWithTag:(NSString *)tag {
+    __block NSArray<NSURLSessionTask *> *tasks = nil;
+    dispatch_barrier_sync(self.queue, ^{
+        tasks = self.tagIndex[tag].allObjects;
+        for (NSURLSessionTask *task in tasks) {
+            [self removeTask:task];
+        }
+    });
+    
+    for (NSURLSessionTask *task in tasks) {
+        [task cancel];
+    }
+    if (tasks.count > 0) {
+        NSLog(@"🚫 取消标签[%@]的%lu个请求", tag, (unsigned long)tasks.count);
+    }
+    return tasks.count;
+}
+
+- (NSUInteger)cancelAllTasks {
+    __block NSArray<NSURLSessionTask *> *tasks = nil;
+    dispatch_barrier_sync(self.queue, ^{
+        tasks = self.tasks.keyEnumerator.allObjects;
+        [self.tasks removeAllObjects];
+        [self.tagIndex removeAllObjects];
+    });
+    
+    for (NSURLSessionTask *task in tasks) {
+        [task cancel];
+    }
+    return tasks.count;
+}
+
+- (void)beginWaitingRetry {
+    dispatch_barrier_async(self.queue, ^{
+        self.retryingCount++;
+    });
+}
+
+- (void)endWaitingRetry {
+    dispatch_barrier_async(self.queue, ^{
+        if (self.retryingCount > 0) {
+            self.retryingCount--;
+        }
+    });
+}
+
+- (APITaskRegistryStatistics *)statistics {
+    APITaskRegistryStatistics *statistics = [[APITaskRegistryStatistics alloc] init];
+    dispatch_sync(self.queue, ^{
+        for (NSURLSessionTask *task in self.tasks.keyEnumerator) {
+            // 调度器启动前task处于挂起状态
+            if (task.state == NSURLSessionTaskStateSuspended) {
+                statistics.queuedCount++;
+            } else if (task.state == NSURLSessionTaskStateRunning) {
+                statistics.inflightCount++;
+                statistics.bytesInFlight += task.countOfBytesSent + task.countOfBytesReceived;
+            }
+        }
+        
+        NSMutableDictionary<NSString *, NSNumber *> *tagCounts = [NSMutableDictionary dictionaryWithCapacity:self.tagIndex.count];
+        [self.tagIndex enumerateKeysAndObjectsUsingBlock:^(NSString *tag, NSHashTable<NSURLSessionTask *> *tasks, BOOL *stop) {
+            tagCounts[tag] = @(tasks.count);
+        }];
+        statistics.tagCounts = tagCounts;
+        statistics.retryingCount = self.retryingCount;
+    });
+    return statistics;
+}
+
+#pragma mark - Private Methods
+
+/// 移除task及其标签索引（在barrier中调用）
+- (void)removeTask:(NSURLSessionTask *)task {
+    NSSet<NSString *> *tags = [self.tasks objectForKey:task];
+    if (!tags) {
+        return;
+    }
+    
+    [self.tasks removeObjectForKey:task];
+    for (NSString *tag in tags) {
+        NSHashTable<NSURLSessionTask *> *tagTasks = self.tagIndex[tag];
+        [tagTasks removeObject:task];
+        if (tagTasks.count == 0) {
+            [self.tagIndex removeObjectForKey:tag];
+        }
+    }
+}
+
+@end
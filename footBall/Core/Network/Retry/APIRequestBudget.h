@@ -0,0 +1,50 @@
+//
+//  APIRequestBudget.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 请求预算 - 将额外请求（重试等）限制在正常流量的一定比例内
+/// 统计窗口内允许的额外请求数 = max(ratio * 窗口内请求数, minPerSecond * window)
+/// 后端故障时所有请求都在失败，预算耗尽后不再重试，避免重试风暴放大故障
+@interface APIRequestBudget : NSObject
+
+/// 额外请求占正常请求的比例（默认：0.1，即10%）
+@property (nonatomic, assign, readonly) double ratio;
+
+/// 流量较小时每秒保底的额外请求数（默认：0.5）
+@property (nonatomic, assign, readonly) double minPerSecond;
+
+/// 统计窗口（秒，默认：10）
+@property (nonatomic, assign, readonly) NSTimeInterval window;
+
+/// 累计记录的请求数
+@property (nonatomic, assign, readonly) NSUInteger requestCount;
+
+/// 累计获得预算的次数
+@property (nonatomic, assign, readonly) NSUInteger acquiredCount;
+
+/// 累计因预算耗尽被拒绝的次数
+@property (nonatomic, assign, readonly) NSUInteger rejectedCount;
+
+/// 初始化方法
+/// @param ratio 额外请求比例
+/// @param minPerSecond 每秒保底额外请求数
+/// @param window 统计窗口（秒）
+- (instancetype)initWithRatio:(double)ratio minPerSecond:(double)minPerSecond window:(NSTimeInterval)window;
+
+/// 记录一次正常请求（为预算充值）
+- (void)recordRequest;
+
+/// 尝试获取一次额外请求的预算
+/// @return 预算耗尽时返回NO
+- (BOOL)tryAcquire;
+
+@end
+
+NS_ASSUME_NONNULL_END
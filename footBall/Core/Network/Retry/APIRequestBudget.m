@@ -0,0 +1,79 @@
+//
+//  APIRequestBudget.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIRequestBudget.h"
+
+@interface APIRequestBudget ()
+
+@property (nonatomic, assign) NSUInteger requestCount;
+@property (nonatomic, assign) NSUInteger acquiredCount;
+@property (nonatomic, assign) NSUInteger rejectedCount;
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *requestTimestamps; // 窗口内的请求时间
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *acquiredTimestamps; // 窗口内获得预算的时间
+
+@end
+
+@implementation APIRequestBudget
+
+- (instancetype)init {
+    return [self initWithRatio:0.1 minPerSecond:0.5 window:10.0];
+}
+
+- (instancetype)initWithRatio:(double)ratio minPerSecond:(double)minPerSecond window:(NSTimeInterval)window {
+    self = [super init];
+    if (self) {
+        _ratio = MAX(ratio, 0);
+        _minPerSecond = MAX(minPerSecond, 0);
+        _window = MAX(window, 1.0);
+        _requestTimestamps = [NSMutableArray array];
+        _acquiredTimestamps = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)recordRequest {
+    @synchronized (self) {
+        CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+        [self pruneTimestampsBefore:now - self.window];
+        [self.requestTimestamps addObject:@(now)];
+        self.requestCount++;
+    }
+}
+
+- (BOOL)tryAcquire {
+    @synchronized (self) {
+        CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+        [self pruneTimestampsBefore:now - self.window];
+        
+        double allowance = MAX(self.ratio * self.requestTimestamps.count, self.minPerSecond * self.window);
+        if (self.acquiredTimestamps.count >= allowance) {
+            self.rejectedCount++;
+            return NO;
+        }
+        
+        [self.acquiredTimestamps addObject:@(now)];
+        self.acquiredCount++;
+        return YES;
+    }
+}
+
+#pragma mark - Private Methods
+
+/// 移除窗口外的时间记录（时间递增，只需从头部移除）
+- (void)pruneTimestampsBefore:(CFAbsoluteTime)threshold {
+    for (NSMutableArray<NSNumber *> *timestamps in @[self.requestTimestamps, self.acquiredTimestamps]) {
+        NSUInteger expiredCount = 0;
+        while (expiredCount < timestamps.count && [timestamps[expiredCount] doubleValue] < threshold) {
+            expiredCount++;
+        }
+        if (expiredCount > 0) {
+            [timestamps removeObjectsInRange:NSMakeRange(0, expiredCount)];
+        }
+    }
+}
+
+@end
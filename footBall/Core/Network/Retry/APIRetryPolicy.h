@@ -0,0 +1,51 @@
+//
+//  APIRetryPolicy.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+@class APIError;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 重试策略 - 决定失败请求是否重试以及重试前的等待时间
+@protocol APIRetryPolicy <NSObject>
+
+/// 计算下一次重试前的等待时间
+/// @param retryCount 即将进行的第几次重试（从1开始）
+/// @param previousDelay 上一次重试前的等待时间（首次重试为0）
+- (NSTimeInterval)delayForRetryCount:(NSInteger)retryCount previousDelay:(NSTimeInterval)previousDelay;
+
+@optional
+
+/// 是否重试该错误（未实现时使用 APIError.canRetry）
+/// @param error 错误
+- (BOOL)shouldRetryError:(APIError *)error;
+
+@end
+
+/// 指数退避重试策略（decorrelated jitter）
+/// 等待时间 = min(maxDelay, random(baseDelay, max(previousDelay, baseDelay) * 3))，首次重试按 baseDelay 计算上界，
+/// 多个客户端同时失败时（包括第一次重试）重试时间会被打散，避免同时打到服务器
+@interface APIBackoffRetryPolicy : NSObject <APIRetryPolicy>
+
+/// 基础等待时间（秒，默认：0.5）
+@property (nonatomic, assign) NSTimeInterval baseDelay;
+
+/// 最大等待时间（秒，默认：8）
+@property (nonatomic, assign) NSTimeInterval maxDelay;
+
+/// 是否加入随机抖动（默认：YES；NO时为标准指数退避 baseDelay * 2^(retryCount-1)）
+@property (nonatomic, assign) BOOL jitterEnabled;
+
+/// 初始化方法
+/// @param baseDelay 基础等待时间（秒）
+/// @param maxDelay 最大等待时间（秒）
+- (instancetype)initWithBaseDelay:(NSTimeInterval)baseDelay maxDelay:(NSTimeInterval)maxDelay;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,38 @@
+//
+//  APIRetryPolicy.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIRetryPolicy.h"
+
+@implementation APIBackoffRetryPolicy
+
+- (instancetype)init {
+    return [self initWithBaseDelay:0.5 maxDelay:8.0];
+}
+
+- (instancetype)initWithBaseDelay:(NSTimeInterval)baseDelay maxDelay:(NSTimeInterval)maxDelay {
+    self = [super init];
+    if (self) {
+        _baseDelay = MAX(baseDelay, 0);
+        _maxDelay = MAX(maxDelay, _baseDelay);
+        _jitterEnabled = YES;
+    }
+    return self;
+}
+
+- (NSTimeInterval)delayForRetryCount:(NSInteger)retryCount previousDelay:(NSTimeInterval)previousDelay {
+    if (!self.jitterEnabled) {
+        NSTimeInterval delay = self.baseDelay * pow(2, MAX(retryCount - 1, 0));
+        return MIN(delay, self.maxDelay);
+    }
+    
+    // decorrelated jitter：在 [baseDelay, max(previousDelay, baseDelay) * 3] 之间随机（首次重试previousDelay为0，按baseDelay计算）
+    NSTimeInterval upper = MAX(self.baseDelay, MAX(previousDelay, self.baseDelay) * 3);
+    NSTimeInterval delay = self.baseDelay + (upper - self.baseDelay) * ((double)arc4random() / UINT32_MAX);
+    return MIN(delay, self.maxDelay);
+}
+
+@end
@@ -0,0 +1,105 @@
+//
+//  APIRequestScheduler.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 请求优先级（数值越小优先级越高）
+typedef NS_ENUM(NSInteger, APIRequestPriority) {
+    APIRequestPriorityInteractive = 0,   // 用户操作触发（点击、提交、登录）
+    APIRequestPriorityVisibleContent,    // 当前页面可见内容（列表数据、可见图片）
+    APIRequestPriorityPrefetch,          // 预加载（图片预加载、下一页数据）
+    APIRequestPriorityBackground         // 后台任务（文件下载、上报）
+};
+
+/// 调度任务状态
+typedef NS_ENUM(NSInteger, APIScheduledJobState) {
+    APIScheduledJobStateQueued = 0,  // 排队中
+    APIScheduledJobStateRunning,     // 执行中
+    APIScheduledJobStateSuspended,   // 被高优先级任务抢占，已挂起并重新排队
+    APIScheduledJobStateFinished     // 已结束
+};
+
+@class APIScheduledJob;
+
+/// 任务开始回调（在调度线程调用，需要主线程的任务自行切换）
+typedef void(^APIScheduledJobStartHandler)(APIScheduledJob *job);
+
+/// 调度任务
+@interface APIScheduledJob : NSObject
+
+/// 主机（按主机限制并发）
+@property (nonatomic, copy, readonly) NSString *host;
+
+/// 优先级
+@property (nonatomic, assign, readonly) APIRequestPriority priority;
+
+/// 当前状态
+@property (nonatomic, assign, readonly) APIScheduledJobState state;
+
+/// 承载任务的task（设置后，低优先级任务可以被挂起让出名额，恢复时调用resume；任务结束后释放）
+@property (nonatomic, strong, nullable) NSURLSessionTask *task;
+
+/// 开始排队（jobWithTask:priority:startHandler: 创建的任务，先保存到task回调使用的变量中再调用）
+/// 已经排队或已结束时忽略
+- (void)start;
+
+/// 任务结束（成功、失败或取消都需要调用），释放并发名额；排队中调用时直接移出队列，还未开始排队时之后的 -start 不再生效
+/// 可以重复调用
+- (void)finish;
+
+@end
+
+/// 请求调度器 - 所有HTTP请求（API、图片、文件传输）统一排队
+/// 按优先级通道出队，按主机限制并发；高优先级任务到来而主机名额已满时，挂起正在执行的预加载/后台任务让出名额
+@interface APIRequestScheduler : NSObject
+
+/// 单例
++ (instancetype)sharedScheduler;
+
+/// 每个主机的最大并发数（默认：6）
+@property (nonatomic, assign) NSUInteger maxConcurrentRequestsPerHost;
+
+/// 每个主机预加载和后台任务的最大并发数（默认：2），保证始终有名额留给用户可见的请求
+@property (nonatomic, assign) NSUInteger maxConcurrentLowPriorityRequestsPerHost;
+
+/// 是否按网络质量收紧并发数（默认YES），网络差时同时进行的请求越多，每个请求越慢、越容易超时
+/// 3G级别时各并发数为配置值的2/3，2G级别时为1/3（至少1个），见 APINetworkQualityEstimator
+@property (nonatomic, assign) BOOL adaptsToNetworkQuality;
+
+/// 排队中的任务数
+@property (nonatomic, assign, readonly) NSUInteger queuedJobCount;
+
+/// 执行中的任务数
+@property (nonatomic, assign, readonly) NSUInteger runningJobCount;
+
+/// 调度一个任务
+/// @param host 主机（nil时所有无主机任务共享一组名额）
+/// @param priority 优先级
+/// @param startHandler 轮到该任务时调用（只调用一次）；任务结束后必须调用 -[APIScheduledJob finish]
+- (APIScheduledJob *)scheduleJobWithHost:(nullable NSString *)host
+                                priority:(APIRequestPriority)priority
+                            startHandler:(APIScheduledJobStartHandler)startHandler;
+
+/// 创建一个承载task的调度任务（尚未排队，调用 -[APIScheduledJob start] 后才排队；轮到时resume，可以被抢占挂起）
+/// 调用方先把返回的任务保存到task回调使用的变量中再start，task很快结束（缓存、快速失败、取消）时回调中的 -finish 也能释放名额
+/// @param task 未resume的task
+/// @param priority 优先级
+/// @param startHandler 轮到该任务、task已resume后调用（可选，只调用一次，被抢占后恢复时不再调用）
+/// @note task结束后调用方仍需调用 -[APIScheduledJob finish]
+- (APIScheduledJob *)jobWithTask:(NSURLSessionTask *)task
+                        priority:(APIRequestPriority)priority
+                    startHandler:(nullable APIScheduledJobStartHandler)startHandler;
+
+/// 优先级显示名称
+/// @param priority 优先级
++ (NSString *)displayNameForPriority:(APIRequestPriority)priority;
+
+@end
+
+NS_ASSUME_NONNULL_END
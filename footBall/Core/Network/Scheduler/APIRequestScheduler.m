@@ -0,0 +1,332 @@
+//
+//  APIRequestScheduler.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIRequestScheduler.h"
+#import "APINetworkQualityEstimator.h"
+
+/// 优先级通道数量
+static const NSInteger kAPIRequestPriorityCount = APIRequestPriorityBackground + 1;
+
+@interface APIScheduledJob ()
+
+@property (nonatomic, copy) NSString *host;
+@property (nonatomic, assign) APIRequestPriority priority;
+@property (nonatomic, assign) APIScheduledJobState state;
+@property (nonatomic, copy, nullable) APIScheduledJobStartHandler startHandler;
+@property (nonatomic, weak) APIRequestScheduler *scheduler;
+@property (nonatomic, assign, getter=isEnqueued) BOOL enqueued; // 是否已经排队（start只生效一次）
+
+@end
+
+@interface APIRequestScheduler ()
+
+@property (nonatomic, strong) NSArray<NSMutableArray<APIScheduledJob *> *> *queues; // 按优先级分通道的排队任务
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<APIScheduledJob *> *> *runningJobs; // 主机 -> 执行中的任务
+
+- (void)enqueueJob:(APIScheduledJob *)job;
+- (void)finishJob:(APIScheduledJob *)job;
+
+@end
+
+@implementation APIScheduledJob
+
+- (void)start {
+    [self.scheduler enqueueJob:self];
+}
+
+- (void)finish {
+    [self.scheduler finishJob:self];
+}
+
+@end
+
+@implementation APIRequestScheduler
+
++ (instancetype)sharedScheduler {
+    static APIRequestScheduler *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[APIRequestScheduler alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _maxConcurrentRequestsPerHost = 6;
+        _maxConcurrentLowPriorityRequestsPerHost = 2;
+        _adaptsToNetworkQuality = YES;
+        _runningJobs = [NSMutableDictionary dictionary];
+        
+        NSMutableArray *queues = [NSMutableArray arrayWithCapacity:kAPIRequestPriorityCount];
+        for (NSInteger i = 0; i < kAPIRequestPriorityCount; i++) {
+            [queues addObject:[NSMutableArray array]];
+        }
+        _queues = [queues copy];
+        
+        // 网络质量变好后放宽并发数，排队的任务可以开始执行
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(networkQualityDidChange:)
+                                                     name:APINetworkQualityDidChangeNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+#pragma mark - Public Methods
+
+- (APIScheduledJob *)scheduleJobWithHost:(nullable NSString *)host
+                                priority:(APIRequestPriority)priority
+                            startHandler:(APIScheduledJobStartHandler)startHandler {
+    APIScheduledJob *job = [self jobWithHost:host priority:priority task:nil startHandler:startHandler];
+    [self enqueueJob:job];
+    return job;
+}
+
+- (APIScheduledJob *)jobWithTask:(NSURLSessionTask *)task
+                        priority:(APIRequestPriority)priority
+                    startHandler:(nullable APIScheduledJobStartHandler)startHandler {
+    // 低优先级task交给系统时也降低网络优先级
+    task.priority = [self taskPriorityForPriority:priority];
+    
+    return [self jobWithHost:task.originalRequest.URL.host
+                    priority:priority
+                        task:task
+                startHandler:^(APIScheduledJob *job) {
+        [job.task resume];
+        if (startHandler) {
+            startHandler(job);
+        }
+    }];
+}
+
+- (NSUInteger)queuedJobCount {
+    @synchronized (self) {
+        NSUInteger count = 0;
+        for (NSMutableArray<APIScheduledJob *> *queue in self.queues) {
+            count += queue.count;
+        }
+        return count;
+    }
+}
+
+- (NSUInteger)runningJobCount {
+    @synchronized (self) {
+        NSUInteger count = 0;
+        for (NSMutableArray<APIScheduledJob *> *jobs in self.runningJobs.allValues) {
+            count += jobs.count;
+        }
+        return count;
+    }
+}
+
++ (NSString *)displayNameForPriority:(APIRequestPriority)priority {
+    switch (priority) {
+        case APIRequestPriorityInteractive:
+            return @"交互";
+        case APIRequestPriorityVisibleContent:
+            return @"可见内容";
+        case APIRequestPriorityPrefetch:
+            return @"预加载";
+        case APIRequestPriorityBackground:
+            return @"后台";
+    }
+}
+
+#pragma mark - Private Methods
+
+/// 创建任务（尚未排队）
+- (APIScheduledJob *)jobWithHost:(nullable NSString *)host
+                        priority:(APIRequestPriority)priority
+                            task:(nullable NSURLSessionTask *)task
+                    startHandler:(APIScheduledJobStartHandler)startHandler {
+    APIScheduledJob *job = [[APIScheduledJob alloc] init];
+    job.host = host.lowercaseString ?: @"";
+    job.priority = MIN(MAX(priority, APIRequestPriorityInteractive), APIRequestPriorityBackground);
+    job.state = APIScheduledJobStateQueued;
+    job.task = task;
+    job.startHandler = startHandler;
+    job.scheduler = self;
+    return job;
+}
+
+/// 排队（只排队一次，已结束的任务不再排队）
+- (void)enqueueJob:(APIScheduledJob *)job {
+    @synchronized (self) {
+        if (job.isEnqueued || job.state == APIScheduledJobStateFinished) {
+            return;
+        }
+        job.enqueued = YES;
+        [self.queues[job.priority] addObject:job];
+    }
+    
+    [self drain];
+}
+
+- (void)finishJob:(APIScheduledJob *)job {
+    @synchronized (self) {
+        if (job.state == APIScheduledJobStateFinished) {
+            return;
+        }
+        
+        [self.queues[job.priority] removeObjectIdenticalTo:job];
+        [self.runningJobs[job.host] removeObjectIdenticalTo:job];
+        job.state = APIScheduledJobStateFinished;
+        job.startHandler = nil;
+        job.task = nil;
+    }
+    
+    [self drain];
+}
+
+/// 出队：先为高优先级任务抢占名额，再按优先级启动可以执行的任务
+- (void)drain {
+    NSMutableArray<APIScheduledJob *> *jobsToSuspend = [NSMutableArray array];
+    NSMutableArray<APIScheduledJob *> *jobsToStart = [NSMutableArray array];
+    
+    @synchronized (self) {
+        [self preemptForQueuedJobs:jobsToSuspend];
+        
+        for (NSMutableArray<APIScheduledJob *> *queue in self.queues) {
+            for (APIScheduledJob *job in [queue copy]) {
+                if (![self canStartJob:job]) {
+                    continue;
+                }
+                
+                [queue removeObjectIdenticalTo:job];
+                [self runningJobsForHost:job.host addJob:job];
+                [jobsToStart addObject:job];
+            }
+        }
+    }
+    
+    for (APIScheduledJob *job in jobsToSuspend) {
+        NSLog(@"⏸️ 挂起%@任务，让出名额: %@", [APIRequestScheduler displayNameForPriority:job.priority], job.task.originalRequest.URL.absoluteString);
+        [job.task suspend];
+    }
+    
+    for (APIScheduledJob *job in jobsToStart) {
+        [self startJob:job];
+    }
+}
+
+/// 高优先级（交互、可见内容）任务因主机名额已满而排队时，挂起该主机上执行中的低优先级任务并重新排到其通道最前面
+- (void)preemptForQueuedJobs:(NSMutableArray<APIScheduledJob *> *)jobsToSuspend {
+    for (NSInteger priority = APIRequestPriorityInteractive; priority < APIRequestPriorityPrefetch; priority++) {
+        for (APIScheduledJob *queuedJob in self.queues[priority]) {
+            if ([self canStartJob:queuedJob]) {
+                continue;
+            }
+            
+            APIScheduledJob *victim = [self preemptibleJobForHost:queuedJob.host belowPriority:queuedJob.priority];
+            if (!victim) {
+                continue;
+            }
+            
+            [self.runningJobs[victim.host] removeObjectIdenticalTo:victim];
+            victim.state = APIScheduledJobStateSuspended;
+            [self.queues[victim.priority] insertObject:victim atIndex:0];
+            [jobsToSuspend addObject:victim];
+        }
+    }
+}
+
+/// 查找可以被抢占的任务（优先级最低、最晚开始、可以挂起的预加载/后台任务）
+- (nullable APIScheduledJob *)preemptibleJobForHost:(NSString *)host belowPriority:(APIRequestPriority)priority {
+    APIScheduledJob *victim = nil;
+    for (APIScheduledJob *job in self.runningJobs[host]) {
+        if (job.priority < APIRequestPriorityPrefetch || job.priority <= priority || !job.task) {
+            continue;
+        }
+        if (!victim || job.priority >= victim.priority) {
+            victim = job;
+        }
+    }
+    return victim;
+}
+
+- (BOOL)canStartJob:(APIScheduledJob *)job {
+    NSArray<APIScheduledJob *> *runningJobs = self.runningJobs[job.host];
+    if (runningJobs.count >= [self concurrencyLimitForLimit:self.maxConcurrentRequestsPerHost]) {
+        return NO;
+    }
+    
+    if (job.priority >= APIRequestPriorityPrefetch) {
+        NSUInteger lowPriorityCount = 0;
+        for (APIScheduledJob *runningJob in runningJobs) {
+            if (runningJob.priority >= APIRequestPriorityPrefetch) {
+                lowPriorityCount++;
+            }
+        }
+        if (lowPriorityCount >= [self concurrencyLimitForLimit:self.maxConcurrentLowPriorityRequestsPerHost]) {
+            return NO;
+        }
+    }
+    
+    return YES;
+}
+
+/// 按网络质量收紧后的并发数
+- (NSUInteger)concurrencyLimitForLimit:(NSUInteger)limit {
+    if (!self.adaptsToNetworkQuality) {
+        return limit;
+    }
+    return [[APINetworkQualityEstimator sharedEstimator] adjustedConcurrencyLimit:limit];
+}
+
+- (void)networkQualityDidChange:(NSNotification *)notification {
+    [self drain];
+}
+
+- (void)runningJobsForHost:(NSString *)host addJob:(APIScheduledJob *)job {
+    NSMutableArray<APIScheduledJob *> *runningJobs = self.runningJobs[host];
+    if (!runningJobs) {
+        runningJobs = [NSMutableArray array];
+        self.runningJobs[host] = runningJobs;
+    }
+    [runningJobs addObject:job];
+}
+
+- (void)startJob:(APIScheduledJob *)job {
+    APIScheduledJobStartHandler startHandler = nil;
+    BOOL resumesSuspendedTask = NO;
+    @synchronized (self) {
+        if (job.state == APIScheduledJobStateFinished) {
+            return;
+        }
+        resumesSuspendedTask = (job.state == APIScheduledJobStateSuspended);
+        startHandler = job.startHandler;
+        job.startHandler = nil;
+        job.state = APIScheduledJobStateRunning;
+    }
+    
+    // 被抢占的任务恢复执行；首次执行调用startHandler
+    if (resumesSuspendedTask) {
+        [job.task resume];
+    } else if (startHandler) {
+        startHandler(job);
+    }
+}
+
+- (float)taskPriorityForPriority:(APIRequestPriority)priority {
+    switch (priority) {
+        case APIRequestPriorityInteractive:
+            return NSURLSessionTaskPriorityHigh;
+        case APIRequestPriorityVisibleContent:
+            return NSURLSessionTaskPriorityDefault;
+        case APIRequestPriorityPrefetch:
+        case APIRequestPriorityBackground:
+            return NSURLSessionTaskPriorityLow;
+    }
+}
+
+@end
@@ -0,0 +1,46 @@
+//
+//  APIJSONStreamParser.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 流式解析的列表元素批次回调（在调用 appendData: 的线程）
+typedef void(^APIJSONStreamBatchBlock)(NSArray *items);
+
+/// 增量JSON解析器 - 边接收边解析响应中的一个数组，按批次输出数组元素
+/// 只缓存当前未完成的元素，已输出的元素和数组之外的数据不保留，峰值内存与响应总大小无关
+@interface APIJSONStreamParser : NSObject
+
+/// 初始化
+/// @param keyPath 数组在响应中的路径（如：@"list"、@"data.list"），nil或空字符串表示响应本身就是数组
+- (instancetype)initWithKeyPath:(nullable NSString *)keyPath NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// 每批元素数量（默认：20）
+@property (nonatomic, assign) NSUInteger batchSize;
+
+/// 批次回调
+@property (nonatomic, copy, nullable) APIJSONStreamBatchBlock batchHandler;
+
+/// 已输出的元素数量
+@property (nonatomic, assign, readonly) NSUInteger itemCount;
+
+/// 追加收到的数据（满一批时回调batchHandler）
+/// @param data 新收到的数据
+/// @param error 数据格式错误时返回错误
+/// @return 数据格式错误时返回NO，之后不应再追加数据
+- (BOOL)appendData:(NSData *)data error:(NSError **)error;
+
+/// 数据接收完成，输出最后不足一批的元素
+/// @param error 响应不完整或没有找到数组时返回错误
+- (BOOL)finishWithError:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,276 @@
+//
+//  APIJSONStreamParser.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIJSONStreamParser.h"
+
+static NSString *const APIJSONStreamParserErrorDomain = @"APIJSONStreamParserErrorDomain";
+
+/// 容器层级（对象或数组）
+@interface APIJSONStreamFrame : NSObject
+
+@property (nonatomic, assign, getter=isObject) BOOL object;
+@property (nonatomic, assign) BOOL expectsKey; // 对象中下一个字符串是key
+@property (nonatomic, copy, nullable) NSString *key; // 对象中当前值对应的key
+
+@end
+
+@implementation APIJSONStreamFrame
+@end
+
+@interface APIJSONStreamParser ()
+
+@property (nonatomic, copy) NSArray<NSString *> *keyPathComponents;
+@property (nonatomic, strong) NSMutableData *buffer; // 尚未处理完的数据（只保留当前元素或当前key）
+@property (nonatomic, assign) NSUInteger scanOffset; // buffer中下一个待扫描的位置
+@property (nonatomic, strong) NSMutableArray<APIJSONStreamFrame *> *frames;
+@property (nonatomic, assign) BOOL inString;
+@property (nonatomic, assign) BOOL escaped;
+@property (nonatomic, assign) BOOL stringIsKey;
+@property (nonatomic, assign) NSInteger stringStart;
+@property (nonatomic, assign) NSUInteger arrayDepth; // 目标数组所在层级（0表示不在目标数组中）
+@property (nonatomic, assign) NSInteger elementStart; // 当前元素在buffer中的起始位置（-1表示没有）
+@property (nonatomic, assign) BOOL arrayFound;
+@property (nonatomic, assign) BOOL failed;
+@property (nonatomic, strong) NSMutableArray *pendingItems;
+@property (nonatomic, assign) NSUInteger itemCount;
+
+@end
+
+@implementation APIJSONStreamParser
+
+- (instancetype)initWithKeyPath:(nullable NSString *)keyPath {
+    self = [super init];
+    if (self) {
+        _keyPathComponents = keyPath.length > 0 ? [keyPath componentsSeparatedByString:@"."] : @[];
+        _batchSize = 20;
+        _buffer = [NSMutableData data];
+        _frames = [NSMutableArray array];
+        _elementStart = -1;
+        _pendingItems = [NSMutableArray array];
+    }
+    return self;
+}
+
+#pragma mark - Public Methods
+
+- (BOOL)appendData:(NSData *)data error:(NSError **)error {
+    if (_failed) {
+        return NO;
+    }
+    
+    [_buffer appendData:data];
+    const uint8_t *bytes = _buffer.bytes;
+    NSUInteger length = _buffer.length;
+    
+    // 逐字节扫描（热路径直接访问实例变量）
+    for (NSUInteger i = _scanOffset; i < length; i++) {
+        uint8_t c = bytes[i];
+        
+        if (_inString) {
+            if (_escaped) {
+                _escaped = NO;
+            } else if (c == '\\') {
+                _escaped = YES;
+            } else if (c == '"') {
+                _inString = NO;
+                if (_stringIsKey && ![self finishKeyInRange:NSMakeRange(_stringStart, i + 1 - _stringStart) error:error]) {
+                    return NO;
+                }
+            }
+            continue;
+        }
+        
+        if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+            continue;
+        }
+        
+        // 目标数组中一个元素的第一个字符
+        BOOL atElementLevel = _arrayDepth > 0 && _frames.count == _arrayDepth;
+        if (atElementLevel && _elementStart < 0 && c != ',' && c != ']') {
+            _elementStart = i;
+        }
+        
+        switch (c) {
+            case '"': {
+                APIJSONStreamFrame *top = _frames.lastObject;
+                _inString = YES;
+                _stringStart = i;
+                _stringIsKey = top.isObject && top.expectsKey;
+                break;
+            }
+                
+            case '{':
+            case '[': {
+                BOOL isTargetArray = (c == '[' && !_arrayFound && [self isAtKeyPath]);
+                APIJSONStreamFrame *frame = [[APIJSONStreamFrame alloc] init];
+                frame.object = (c == '{');
+                frame.expectsKey = frame.isObject;
+                [_frames addObject:frame];
+                if (isTargetArray) {
+                    _arrayFound = YES;
+                    _arrayDepth = _frames.count;
+                }
+                break;
+            }
+                
+            case '}':
+            case ']': {
+                APIJSONStreamFrame *top = _frames.lastObject;
+                if (!top || top.isObject != (c == '}')) {
+                    return [self failWithMessage:@"响应数据格式错误（括号不匹配）" error:error];
+                }
+                
+                // 目标数组结束：输出最后一个标量元素
+                if (atElementLevel) {
+                    if (_elementStart >= 0 && ![self emitElementInRange:NSMakeRange(_elementStart, i - _elementStart) error:error]) {
+                        return NO;
+                    }
+                    _elementStart = -1;
+                    _arrayDepth = 0;
+                }
+                
+                [_frames removeLastObject];
+                
+                // 一个对象/数组元素结束
+                if (_arrayDepth > 0 && _frames.count == _arrayDepth && _elementStart >= 0) {
+                    if (![self emitElementInRange:NSMakeRange(_elementStart, i + 1 - _elementStart) error:error]) {
+                        return NO;
+                    }
+                    _elementStart = -1;
+                }
+                break;
+            }
+                
+            case ',': {
+                APIJSONStreamFrame *top = _frames.lastObject;
+                if (top.isObject) {
+                    top.expectsKey = YES;
+                }
+                // 一个标量元素结束
+                if (atElementLevel && _elementStart >= 0) {
+                    if (![self emitElementInRange:NSMakeRange(_elementStart, i - _elementStart) error:error]) {
+                        return NO;
+                    }
+                    _elementStart = -1;
+                }
+                break;
+            }
+                
+            default:
+                break;
+        }
+    }
+    
+    [self compactBuffer];
+    return YES;
+}
+
+- (BOOL)finishWithError:(NSError **)error {
+    if (_failed) {
+        return NO;
+    }
+    if (_inString || _frames.count > 0) {
+        return [self failWithMessage:@"响应数据不完整" error:error];
+    }
+    if (!_arrayFound) {
+        return [self failWithMessage:@"响应中未找到列表数据" error:error];
+    }
+    
+    [self flushPendingItems];
+    return YES;
+}
+
+#pragma mark - Private Methods
+
+/// 当前位置是否是目标数组的路径（所有上层都是对象，且key依次匹配）
+- (BOOL)isAtKeyPath {
+    if (_frames.count != _keyPathComponents.count) {
+        return NO;
+    }
+    for (NSUInteger i = 0; i < _frames.count; i++) {
+        APIJSONStreamFrame *frame = _frames[i];
+        if (!frame.isObject || ![frame.key isEqualToString:_keyPathComponents[i]]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+- (BOOL)finishKeyInRange:(NSRange)range error:(NSError **)error {
+    NSData *keyData = [_buffer subdataWithRange:range];
+    id key = [NSJSONSerialization JSONObjectWithData:keyData options:NSJSONReadingFragmentsAllowed error:nil];
+    if (![key isKindOfClass:[NSString class]]) {
+        return [self failWithMessage:@"响应数据格式错误（无效的key）" error:error];
+    }
+    
+    APIJSONStreamFrame *top = _frames.lastObject;
+    top.key = key;
+    top.expectsKey = NO;
+    return YES;
+}
+
+- (BOOL)emitElementInRange:(NSRange)range error:(NSError **)error {
+    NSData *elementData = [_buffer subdataWithRange:range];
+    NSError *parseError = nil;
+    id item = [NSJSONSerialization JSONObjectWithData:elementData options:NSJSONReadingFragmentsAllowed error:&parseError];
+    if (!item) {
+        return [self failWithMessage:parseError.localizedDescription ?: @"响应数据格式错误" error:error];
+    }
+    
+    [_pendingItems addObject:item];
+    _itemCount++;
+    if (_pendingItems.count >= MAX(_batchSize, 1)) {
+        [self flushPendingItems];
+    }
+    return YES;
+}
+
+- (void)flushPendingItems {
+    if (_pendingItems.count == 0) {
+        return;
+    }
+    NSArray *items = [_pendingItems copy];
+    [_pendingItems removeAllObjects];
+    if (self.batchHandler) {
+        self.batchHandler(items);
+    }
+}
+
+/// 丢弃已处理的数据，只保留当前未完成的元素或key
+- (void)compactBuffer {
+    NSUInteger length = _buffer.length;
+    NSUInteger keepFrom = length;
+    if (_elementStart >= 0) {
+        keepFrom = MIN(keepFrom, (NSUInteger)_elementStart);
+    }
+    if (_inString && _stringIsKey) {
+        keepFrom = MIN(keepFrom, (NSUInteger)_stringStart);
+    }
+    
+    if (keepFrom > 0) {
+        [_buffer replaceBytesInRange:NSMakeRange(0, keepFrom) withBytes:NULL length:0];
+    }
+    _scanOffset = length - keepFrom;
+    if (_elementStart >= 0) {
+        _elementStart -= keepFrom;
+    }
+    if (_inString && _stringIsKey) {
+        _stringStart -= keepFrom;
+    }
+}
+
+- (BOOL)failWithMessage:(NSString *)message error:(NSError **)error {
+    _failed = YES;
+    if (error) {
+        *error = [NSError errorWithDomain:APIJSONStreamParserErrorDomain
+                                     code:-1
+                                 userInfo:@{NSLocalizedDescriptionKey: message}];
+    }
+    return NO;
+}
+
+@end
@@ -0,0 +1,37 @@
+//
+//  APIStreamingSession.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import "APIJSONStreamParser.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 流式请求完成回调（在会话的代理队列调用）
+typedef void(^APIStreamingCompletionBlock)(NSHTTPURLResponse * _Nullable response, NSError * _Nullable error);
+
+/// 流式请求会话 - 收到的数据直接交给解析器，不缓存整个响应体
+/// AFNetworking会把响应体完整缓存后再解析，大列表改用该会话
+@interface APIStreamingSession : NSObject
+
+/// 初始化
+/// @param configuration 会话配置
+- (instancetype)initWithConfiguration:(NSURLSessionConfiguration *)configuration NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// 创建流式请求（未resume）
+/// 非2xx响应以 AFNetworkingOperationFailingURLResponseErrorKey 附带响应失败，可以由 APIError 按状态码转换
+/// @param request 请求
+/// @param parser 解析器（batchHandler在会话的代理队列调用）
+/// @param completion 完成回调
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                                       parser:(APIJSONStreamParser *)parser
+                                   completion:(APIStreamingCompletionBlock)completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,125 @@
+//
+//  APIStreamingSession.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIStreamingSession.h"
+#import <AFNetworking/AFNetworking.h>
+#import "APICompressionStatistics.h"
+
+/// 单个流式请求的状态
+@interface APIStreamingTaskState : NSObject
+
+@property (nonatomic, strong) APIJSONStreamParser *parser;
+@property (nonatomic, copy) APIStreamingCompletionBlock completion;
+@property (nonatomic, strong, nullable) NSError *error;
+
+@end
+
+@implementation APIStreamingTaskState
+@end
+
+@interface APIStreamingSession () <NSURLSessionDataDelegate>
+
+@property (nonatomic, strong) NSURLSession *session;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, APIStreamingTaskState *> *taskStates;
+
+@end
+
+@implementation APIStreamingSession
+
+- (instancetype)initWithConfiguration:(NSURLSessionConfiguration *)configuration {
+    self = [super init];
+    if (self) {
+        _taskStates = [NSMutableDictionary dictionary];
+        
+        // 代理队列串行，同一请求的数据按顺序交给解析器
+        NSOperationQueue *delegateQueue = [[NSOperationQueue alloc] init];
+        delegateQueue.name = @"com.football.api.streaming";
+        delegateQueue.maxConcurrentOperationCount = 1;
+        _session = [NSURLSession sessionWithConfiguration:configuration delegate:self delegateQueue:delegateQueue];
+    }
+    return self;
+}
+
+#pragma mark - Public Methods
+
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                                       parser:(APIJSONStreamParser *)parser
+                                   completion:(APIStreamingCompletionBlock)completion {
+    NSURLSessionDataTask *task = [self.session dataTaskWithRequest:request];
+    
+    APIStreamingTaskState *state = [[APIStreamingTaskState alloc] init];
+    state.parser = parser;
+    state.completion = completion;
+    @synchronized (self.taskStates) {
+        self.taskStates[@(task.taskIdentifier)] = state;
+    }
+    return task;
+}
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+didReceiveResponse:(NSURLResponse *)response
+ completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler {
+    NSHTTPURLResponse *HTTPResponse = (NSHTTPURLResponse *)response;
+    if ([HTTPResponse isKindOfClass:[NSHTTPURLResponse class]] &&
+        (HTTPResponse.statusCode < 200 || HTTPResponse.statusCode >= 300)) {
+        NSString *message = [NSString stringWithFormat:@"请求失败: %ld", (long)HTTPResponse.statusCode];
+        [self stateForTask:dataTask].error = [NSError errorWithDomain:@"APIManagerErrorDomain"
+                                                                 code:HTTPResponse.statusCode
+                                                             userInfo:@{NSLocalizedDescriptionKey: message,
+                                                                        AFNetworkingOperationFailingURLResponseErrorKey: HTTPResponse}];
+        completionHandler(NSURLSessionResponseCancel);
+        return;
+    }
+    completionHandler(NSURLSessionResponseAllow);
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data {
+    APIStreamingTaskState *state = [self stateForTask:dataTask];
+    if (!state || state.error) {
+        return;
+    }
+    
+    NSError *error = nil;
+    if (![state.parser appendData:data error:&error]) {
+        state.error = error;
+        [dataTask cancel];
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error {
+    APIStreamingTaskState *state = nil;
+    @synchronized (self.taskStates) {
+        state = self.taskStates[@(task.taskIdentifier)];
+        [self.taskStates removeObjectForKey:@(task.taskIdentifier)];
+    }
+    if (!state) {
+        return;
+    }
+    
+    NSError *finalError = state.error ?: error;
+    if (!finalError) {
+        [state.parser finishWithError:&finalError];
+    }
+    state.completion((NSHTTPURLResponse *)task.response, finalError);
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics {
+    [[APICompressionStatistics sharedStatistics] recordMetrics:metrics forTask:task];
+}
+
+#pragma mark - Private Methods
+
+- (nullable APIStreamingTaskState *)stateForTask:(NSURLSessionTask *)task {
+    @synchronized (self.taskStates) {
+        return self.taskStates[@(task.taskIdentifier)];
+    }
+}
+
+@end
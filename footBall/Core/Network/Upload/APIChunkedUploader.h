@@ -0,0 +1,141 @@
+//
+//  APIChunkedUploader.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import <AFNetworking/AFNetworking.h>
+#import "APIRequestScheduler.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 分片上传状态
+typedef NS_ENUM(NSInteger, APIChunkedUploadState) {
+    APIChunkedUploadStatePending = 0,   // 等待开始
+    APIChunkedUploadStateUploading,     // 上传中
+    APIChunkedUploadStatePaused,        // 已暂停（手动暂停、断网、App挂起，或App重新启动后等待恢复）
+    APIChunkedUploadStateCompleted,     // 已完成
+    APIChunkedUploadStateFailed,        // 失败（可以调用 resumeTask: 从已确认的分片继续）
+    APIChunkedUploadStateCancelled      // 已取消
+};
+
+/// 分片上传任务
+@interface APIChunkedUploadTask : NSObject <NSSecureCoding>
+
+/// 本地标识（用于App重新启动后找回任务）
+@property (nonatomic, copy, readonly) NSString *identifier;
+
+/// 文件地址
+@property (nonatomic, strong, readonly) NSURL *fileURL;
+
+/// 文件名
+@property (nonatomic, copy, readonly) NSString *fileName;
+
+/// MIME类型
+@property (nonatomic, copy, readonly) NSString *mimeType;
+
+/// 文件大小（字节）
+@property (nonatomic, assign, readonly) unsigned long long fileSize;
+
+/// 分片大小（字节）
+@property (nonatomic, assign, readonly) NSUInteger chunkSize;
+
+/// 分片数量
+@property (nonatomic, assign, readonly) NSUInteger chunkCount;
+
+/// 创建上传时附带的业务参数
+@property (nonatomic, copy, readonly, nullable) NSDictionary *parameters;
+
+/// 服务端上传标识（创建上传后才有）
+@property (nonatomic, copy, readonly, nullable) NSString *uploadId;
+
+/// 服务端已确认的分片
+@property (copy, readonly) NSIndexSet *acknowledgedChunks;
+
+/// 当前状态
+@property (assign, readonly) APIChunkedUploadState state;
+
+/// 上传进度（字节）
+@property (nonatomic, strong, readonly) NSProgress *progress;
+
+/// 失败原因
+@property (nonatomic, strong, readonly, nullable) NSError *error;
+
+@end
+
+/// 分片上传器 - 从文件按分片流式读取（内存中只有正在上传的分片），每个分片带SHA256校验，多个分片并行上传；
+/// 断网或App挂起时暂停并把已确认的分片持久化，网络恢复、回到前台或重新启动后从已确认的分片继续
+///
+/// 服务端分片协议（base为 APIPathNameUploadChunked 对应的路径，响应字段可以在顶层或data中）：
+/// 1. POST base                            创建上传，JSON：fileName、fileSize、chunkSize、chunkCount、mimeType及业务参数 → {"uploadId": "...", "uploadedChunks": []}
+/// 2. GET  base/{uploadId}                 查询已确认的分片（恢复上传时） → {"uploadedChunks": [0, 1, 3]}，404表示上传已过期，重新创建
+/// 3. PUT  base/{uploadId}/chunks/{index}  上传分片，请求体为分片数据，请求头 X-Chunk-Index、X-Chunk-Offset、X-Chunk-SHA256 → 2xx表示确认；校验失败返回4xx，分片重传
+/// 4. POST base/{uploadId}/complete        所有分片确认后合并，JSON：chunkCount、fileSize → 业务响应（回调给success）
+/// 请求同样经过 APIManager 的公共请求头和拦截器（认证），并由请求调度器排队；返回401时经 APIManager 刷新Token后重放一次
+/// 进行中的请求登记在 APIManager 的请求登记表（标签 APITaskTagUpload 和路径名称），被外部取消（如 cancelAllRequests）时任务暂停
+@interface APIChunkedUploader : NSObject
+
+/// 单例（使用 APIManager 的会话，与API请求共用连接）
++ (instancetype)sharedUploader;
+
+/// 初始化方法
+/// @param sessionManager 会话（一般为 [APIManager sharedManager].sessionManager，测试时可以传入使用模拟服务端的会话）
+/// @param storageName 持久化目录名（Application Support下），不同上传器使用不同目录
+- (instancetype)initWithSessionManager:(AFHTTPSessionManager *)sessionManager storageName:(NSString *)storageName;
+
+/// 分片协议的路径名称（默认：APIPathNameUploadChunked）
+@property (nonatomic, copy) NSString *pathName;
+
+/// 分片大小（字节，默认：1MB，最小64KB），只影响新建的任务
+@property (nonatomic, assign) NSUInteger chunkSize;
+
+/// 每个任务同时上传的分片数（默认：3）
+@property (nonatomic, assign) NSUInteger maxConcurrentChunks;
+
+/// 单个分片的最大重传次数（默认：3），超过后任务失败
+@property (nonatomic, assign) NSUInteger maxChunkRetryCount;
+
+/// 分片请求的调度优先级（默认：APIRequestPriorityVisibleContent）
+@property (nonatomic, assign) APIRequestPriority priority;
+
+/// 上传文件
+/// @param fileURL 文件地址
+/// @param mimeType MIME类型
+/// @param parameters 创建上传时附带的业务参数
+/// @param progress 进度回调（主线程）
+/// @param success 成功回调（主线程，合并接口的响应）
+/// @param failure 失败回调（主线程）
+/// @return 上传任务，文件不存在时返回nil并回调failure
+- (nullable APIChunkedUploadTask *)uploadFileAtURL:(NSURL *)fileURL
+                                          mimeType:(NSString *)mimeType
+                                        parameters:(nullable NSDictionary *)parameters
+                                          progress:(nullable void(^)(NSProgress *progress))progress
+                                           success:(nullable void(^)(id _Nullable responseObject))success
+                                           failure:(nullable void(^)(NSError *error))failure;
+
+/// 未完成的任务（包括上次启动时留下的任务，重新启动后为暂停状态，通过 resumeTask: 继续）
+- (NSArray<APIChunkedUploadTask *> *)pendingTasks;
+
+/// 继续上传（暂停、失败或上次启动留下的任务），先向服务端同步已确认的分片
+/// @param task 任务
+/// @param progress 进度回调（nil时沿用之前的回调）
+/// @param success 成功回调（nil时沿用之前的回调）
+/// @param failure 失败回调（nil时沿用之前的回调）
+- (void)resumeTask:(APIChunkedUploadTask *)task
+          progress:(nullable void(^)(NSProgress *progress))progress
+           success:(nullable void(^)(id _Nullable responseObject))success
+           failure:(nullable void(^)(NSError *error))failure;
+
+/// 暂停上传（取消进行中的分片，已确认的分片保留）
+/// @param task 任务
+- (void)pauseTask:(APIChunkedUploadTask *)task;
+
+/// 取消上传并删除本地记录（服务端未合并的分片由服务端过期清理）
+/// @param task 任务
+- (void)cancelTask:(APIChunkedUploadTask *)task;
+
+@end
+
+NS_ASSUME_NONNULL_END
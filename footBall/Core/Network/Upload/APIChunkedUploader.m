@@ -0,0 +1,1030 @@
+//
+//  APIChunkedUploader.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "APIChunkedUploader.h"
+#import "APIManager.h"
+#import "APIEnvironmentManager.h"
+#import "APIPathNames.h"
+#import <AFNetworking/AFNetworking.h>
+#import <CommonCrypto/CommonDigest.h>
+#import <UIKit/UIKit.h>
+
+/// 默认分片大小
+static const NSUInteger kAPIChunkedUploadDefaultChunkSize = 1024 * 1024;
+/// 最小分片大小
+static const NSUInteger kAPIChunkedUploadMinimumChunkSize = 64 * 1024;
+/// 断网暂停后探测网络恢复的间隔（系统可达性通知可能晚于实际恢复，或服务端不可达时可达性不变）
+static const NSTimeInterval kAPIChunkedUploadNetworkProbeInterval = 5.0;
+
+/// 暂停原因（决定由谁恢复）
+typedef NS_ENUM(NSInteger, APIChunkedUploadPauseReason) {
+    APIChunkedUploadPauseReasonNone = 0,  // 未暂停
+    APIChunkedUploadPauseReasonUser,      // 手动暂停或上次启动留下的任务，调用 resumeTask: 恢复
+    APIChunkedUploadPauseReasonNetwork,   // 断网，网络恢复后自动继续
+    APIChunkedUploadPauseReasonSuspended  // App挂起，回到前台后自动继续
+};
+
+#pragma mark - Helpers
+
+/// 数据的SHA256十六进制摘要（分片校验）
+static NSString *APIChunkedUploadSHA256(NSData *data) {
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+    
+    NSMutableString *hex = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [hex appendFormat:@"%02x", digest[i]];
+    }
+    return hex;
+}
+
+/// 读取响应字段（顶层或data中）
+static id APIChunkedUploadResponseField(id responseObject, NSString *key) {
+    if (![responseObject isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    
+    id value = responseObject[key];
+    if (value && value != [NSNull null]) {
+        return value;
+    }
+    id data = responseObject[@"data"];
+    if ([data isKindOfClass:[NSDictionary class]]) {
+        value = data[key];
+        return value != [NSNull null] ? value : nil;
+    }
+    return nil;
+}
+
+/// 是否为连接层面的错误（断网、连接中断），这类错误暂停等待网络恢复，不计入重传次数
+static BOOL APIChunkedUploadIsConnectivityError(NSError *error) {
+    if (![error.domain isEqualToString:NSURLErrorDomain]) {
+        return NO;
+    }
+    
+    switch (error.code) {
+        case NSURLErrorNotConnectedToInternet:
+        case NSURLErrorNetworkConnectionLost:
+        case NSURLErrorDataNotAllowed:
+        case NSURLErrorInternationalRoamingOff:
+        case NSURLErrorCallIsActive:
+            return YES;
+        default:
+            return NO;
+    }
+}
+
+/// 响应状态码
+static NSInteger APIChunkedUploadStatusCode(NSURLResponse *response) {
+    return [response isKindOfClass:[NSHTTPURLResponse class]] ? ((NSHTTPURLResponse *)response).statusCode : 0;
+}
+
+#pragma mark - APIChunkedUploadTask
+
+@interface APIChunkedUploadTask ()
+
+@property (nonatomic, copy, readwrite) NSString *identifier;
+@property (nonatomic, strong, readwrite) NSURL *fileURL;
+@property (nonatomic, copy, readwrite) NSString *fileName;
+@property (nonatomic, copy, readwrite) NSString *mimeType;
+@property (nonatomic, assign, readwrite) unsigned long long fileSize;
+@property (nonatomic, assign, readwrite) NSUInteger chunkSize;
+@property (nonatomic, assign, readwrite) NSUInteger chunkCount;
+@property (nonatomic, copy, readwrite, nullable) NSDictionary *parameters;
+@property (nonatomic, copy, readwrite, nullable) NSString *uploadId;
+@property (copy, readwrite) NSIndexSet *acknowledgedChunks;
+@property (assign, readwrite) APIChunkedUploadState state;
+@property (nonatomic, strong, readwrite) NSProgress *progress;
+@property (nonatomic, strong, readwrite, nullable) NSError *error;
+
+// 持久化字段
+@property (nonatomic, copy) NSString *filePath; // 在Home目录下时保存相对路径（重新安装/更新后沙盒路径会变化）
+@property (nonatomic, strong, nullable) NSDate *fileModificationDate; // 恢复时校验文件未被修改
+@property (nonatomic, copy) NSString *pathName;
+
+// 运行时状态（只在上传器队列中访问）
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, id> *inflightChunks; // 分片序号 -> 上传task，NSNull表示等待重传
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSNumber *> *inflightBytes; // 分片序号 -> 已发送字节数
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSNumber *> *chunkRetryCounts; // 分片序号（控制请求为NSNotFound） -> 重传次数
+@property (nonatomic, strong) NSMutableSet<NSNumber *> *authReplayedKeys; // 已因401刷新Token重放过的分片序号（控制请求为NSNotFound），每个请求只重放一次
+@property (nonatomic, assign) APIChunkedUploadPauseReason pauseReason;
+@property (nonatomic, assign) NSUInteger generation; // 每次开始/暂停/结束时递增，旧请求的回调直接忽略
+@property (nonatomic, assign) BOOL synchronized; // 本次开始后是否已向服务端同步已确认的分片
+@property (nonatomic, strong, nullable) NSURLSessionTask *controlTask; // 创建/查询/合并请求
+@property (nonatomic, copy, nullable) void(^progressBlock)(NSProgress *progress);
+@property (nonatomic, copy, nullable) void(^successBlock)(id _Nullable responseObject);
+@property (nonatomic, copy, nullable) void(^failureBlock)(NSError *error);
+
+@end
+
+@implementation APIChunkedUploadTask
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _identifier = [NSUUID UUID].UUIDString;
+        _acknowledgedChunks = [NSIndexSet indexSet];
+        _inflightChunks = [NSMutableDictionary dictionary];
+        _inflightBytes = [NSMutableDictionary dictionary];
+        _chunkRetryCounts = [NSMutableDictionary dictionary];
+        _authReplayedKeys = [NSMutableSet set];
+    }
+    return self;
+}
+
+- (NSURL *)fileURL {
+    if (self.filePath.isAbsolutePath) {
+        return [NSURL fileURLWithPath:self.filePath];
+    }
+    return [NSURL fileURLWithPath:[NSHomeDirectory() stringByAppendingPathComponent:self.filePath]];
+}
+
+- (void)setFileURL:(NSURL *)fileURL {
+    NSString *path = fileURL.URLByResolvingSymlinksInPath.path;
+    NSString *homePath = [NSHomeDirectory() stringByResolvingSymlinksInPath];
+    if ([path hasPrefix:[homePath stringByAppendingString:@"/"]]) {
+        path = [path substringFromIndex:homePath.length + 1];
+    }
+    self.filePath = path;
+}
+
+/// 分片字节数（最后一个分片可能不足chunkSize）
+- (NSUInteger)lengthOfChunkAtIndex:(NSUInteger)index {
+    unsigned long long offset = (unsigned long long)index * self.chunkSize;
+    if (offset >= self.fileSize) {
+        return 0;
+    }
+    return (NSUInteger)MIN((unsigned long long)self.chunkSize, self.fileSize - offset);
+}
+
+/// 已确认分片加进行中分片的已发送字节数
+- (int64_t)completedBytes {
+    __block int64_t completedBytes = 0;
+    [self.acknowledgedChunks enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL * _Nonnull stop) {
+        completedBytes += [self lengthOfChunkAtIndex:idx];
+    }];
+    for (NSNumber *bytes in self.inflightBytes.allValues) {
+        completedBytes += bytes.longLongValue;
+    }
+    return MIN(completedBytes, (int64_t)self.fileSize);
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder {
+    [coder encodeObject:self.identifier forKey:@"identifier"];
+    [coder encodeObject:self.filePath forKey:@"filePath"];
+    [coder encodeObject:self.fileName forKey:@"fileName"];
+    [coder encodeObject:self.mimeType forKey:@"mimeType"];
+    [coder encodeInt64:(int64_t)self.fileSize forKey:@"fileSize"];
+    [coder encodeObject:self.fileModificationDate forKey:@"fileModificationDate"];
+    [coder encodeInteger:(NSInteger)self.chunkSize forKey:@"chunkSize"];
+    [coder encodeInteger:(NSInteger)self.chunkCount forKey:@"chunkCount"];
+    [coder encodeObject:self.pathName forKey:@"pathName"];
+    [coder encodeObject:self.uploadId forKey:@"uploadId"];
+    [coder encodeObject:self.acknowledgedChunks forKey:@"acknowledgedChunks"];
+    
+    // 业务参数以JSON保存（任意Foundation集合无法安全解档）
+    if (self.parameters) {
+        NSData *parametersData = [NSJSONSerialization dataWithJSONObject:self.parameters options:0 error:nil];
+        [coder encodeObject:parametersData forKey:@"parameters"];
+    }
+}
+
+- (nullable instancetype)initWithCoder:(NSCoder *)coder {
+    self = [self init];
+    if (self) {
+        _identifier = [coder decodeObjectOfClass:[NSString class] forKey:@"identifier"];
+        _filePath = [coder decodeObjectOfClass:[NSString class] forKey:@"filePath"];
+        _fileName = [coder decodeObjectOfClass:[NSString class] forKey:@"fileName"];
+        _mimeType = [coder decodeObjectOfClass:[NSString class] forKey:@"mimeType"];
+        _fileSize = (unsigned long long)[coder decodeInt64ForKey:@"fileSize"];
+        _fileModificationDate = [coder decodeObjectOfClass:[NSDate class] forKey:@"fileModificationDate"];
+        _chunkSize = (NSUInteger)[coder decodeIntegerForKey:@"chunkSize"];
+        _chunkCount = (NSUInteger)[coder decodeIntegerForKey:@"chunkCount"];
+        _pathName = [coder decodeObjectOfClass:[NSString class] forKey:@"pathName"];
+        _uploadId = [coder decodeObjectOfClass:[NSString class] forKey:@"uploadId"];
+        _acknowledgedChunks = [coder decodeObjectOfClass:[NSIndexSet class] forKey:@"acknowledgedChunks"] ?: [NSIndexSet indexSet];
+        
+        NSData *parametersData = [coder decodeObjectOfClass:[NSData class] forKey:@"parameters"];
+        if (parametersData) {
+            id parameters = [NSJSONSerialization JSONObjectWithData:parametersData options:0 error:nil];
+            _parameters = [parameters isKindOfClass:[NSDictionary class]] ? parameters : nil;
+        }
+        
+        if (_identifier.length == 0 || _filePath.length == 0 || _pathName.length == 0 || _chunkSize == 0 || _chunkCount == 0) {
+            return nil;
+        }
+        _state = APIChunkedUploadStatePaused;
+        _pauseReason = APIChunkedUploadPauseReasonUser;
+        _progress = [NSProgress progressWithTotalUnitCount:(int64_t)_fileSize];
+        _progress.completedUnitCount = [self completedBytes];
+    }
+    return self;
+}
+
+@end
+
+#pragma mark - APIChunkedUploader
+
+@interface APIChunkedUploader ()
+
+@property (nonatomic, strong) AFHTTPSessionManager *sessionManager; // 请求回调在会话的回调队列，转到 queue 处理
+@property (nonatomic, strong) dispatch_queue_t queue; // 任务状态和请求回调都在该串行队列中处理
+@property (nonatomic, copy) NSString *storagePath;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, APIChunkedUploadTask *> *tasks; // 本地标识 -> 未完成的任务
+@property (nonatomic, assign) BOOL networkProbeScheduled;
+@property (nonatomic, assign) UIBackgroundTaskIdentifier backgroundTaskIdentifier; // 只在主线程访问
+
+@end
+
+@implementation APIChunkedUploader
+
++ (instancetype)sharedUploader {
+    static APIChunkedUploader *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[APIChunkedUploader alloc] initWithSessionManager:[APIManager sharedManager].sessionManager
+                                                          storageName:@"APIChunkedUploads"];
+    });
+    return instance;
+}
+
+- (instancetype)initWithSessionManager:(AFHTTPSessionManager *)sessionManager storageName:(NSString *)storageName {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("com.football.api.upload", DISPATCH_QUEUE_SERIAL);
+        _sessionManager = sessionManager;
+        
+        _pathName = APIPathNameUploadChunked;
+        _chunkSize = kAPIChunkedUploadDefaultChunkSize;
+        _maxConcurrentChunks = 3;
+        _maxChunkRetryCount = 3;
+        _priority = APIRequestPriorityVisibleContent;
+        _tasks = [NSMutableDictionary dictionary];
+        _backgroundTaskIdentifier = UIBackgroundTaskInvalid;
+        
+        // 任务记录放在Application Support（Caches可能被系统清理）
+        NSString *supportPath = NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES).firstObject;
+        _storagePath = [supportPath stringByAppendingPathComponent:storageName];
+        [[NSFileManager defaultManager] createDirectoryAtPath:_storagePath
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:nil];
+        [self restoreTasks];
+        
+        [[AFNetworkReachabilityManager sharedManager] startMonitoring];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(reachabilityDidChange:)
+                                                     name:AFNetworkingReachabilityDidChangeNotification
+                                                   object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationDidEnterBackground:)
+                                                     name:UIApplicationDidEnterBackgroundNotification
+                                                   object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationWillEnterForeground:)
+                                                     name:UIApplicationWillEnterForegroundNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void)setChunkSize:(NSUInteger)chunkSize {
+    _chunkSize = MAX(chunkSize, kAPIChunkedUploadMinimumChunkSize);
+}
+
+- (void)setMaxConcurrentChunks:(NSUInteger)maxConcurrentChunks {
+    _maxConcurrentChunks = MAX(maxConcurrentChunks, (NSUInteger)1);
+}
+
+#pragma mark - Public Methods
+
+- (nullable APIChunkedUploadTask *)uploadFileAtURL:(NSURL *)fileURL
+                                          mimeType:(NSString *)mimeType
+                                        parameters:(nullable NSDictionary *)parameters
+                                          progress:(nullable void(^)(NSProgress *progress))progress
+                                           success:(nullable void(^)(id _Nullable responseObject))success
+                                           failure:(nullable void(^)(NSError *error))failure {
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:fileURL.path error:nil];
+    unsigned long long fileSize = [attributes fileSize];
+    NSString *message = nil;
+    if (!attributes || ![attributes.fileType isEqualToString:NSFileTypeRegular]) {
+        message = [NSString stringWithFormat:@"文件不存在: %@", fileURL.lastPathComponent];
+    } else if (fileSize == 0) {
+        message = [NSString stringWithFormat:@"文件为空: %@", fileURL.lastPathComponent];
+    } else if (parameters && ![NSJSONSerialization isValidJSONObject:parameters]) {
+        message = @"上传参数不是有效的JSON对象";
+    }
+    if (message) {
+        NSLog(@"❌ 分片上传失败: %@", message);
+        if (failure) {
+            APIError *error = [APIError errorWithCode:APIErrorCodeBadRequest message:message underlyingError:nil];
+            dispatch_async(dispatch_get_main_queue(), ^{
+                failure(error);
+            });
+        }
+        return nil;
+    }
+    
+    APIChunkedUploadTask *task = [[APIChunkedUploadTask alloc] init];
+    task.fileURL = fileURL;
+    task.fileName = fileURL.lastPathComponent;
+    task.mimeType = mimeType;
+    task.fileSize = fileSize;
+    task.fileModificationDate = attributes.fileModificationDate;
+    task.chunkSize = self.chunkSize;
+    task.chunkCount = (NSUInteger)((fileSize + self.chunkSize - 1) / self.chunkSize);
+    task.parameters = parameters;
+    task.pathName = self.pathName;
+    task.state = APIChunkedUploadStatePending;
+    task.progress = [NSProgress progressWithTotalUnitCount:(int64_t)fileSize];
+    task.progressBlock = progress;
+    task.successBlock = success;
+    task.failureBlock = failure;
+    
+    dispatch_async(self.queue, ^{
+        self.tasks[task.identifier] = task;
+        [self saveTask:task];
+        NSLog(@"📤 分片上传开始: %@（%llu字节，%lu个分片）", task.fileName, task.fileSize, (unsigned long)task.chunkCount);
+        [self startTask:task];
+    });
+    return task;
+}
+
+- (NSArray<APIChunkedUploadTask *> *)pendingTasks {
+    __block NSArray<APIChunkedUploadTask *> *tasks = nil;
+    dispatch_sync(self.queue, ^{
+        tasks = self.tasks.allValues;
+    });
+    return tasks;
+}
+
+- (void)resumeTask:(APIChunkedUploadTask *)task
+          progress:(nullable void(^)(NSProgress *progress))progress
+           success:(nullable void(^)(id _Nullable responseObject))success
+           failure:(nullable void(^)(NSError *error))failure {
+    dispatch_async(self.queue, ^{
+        if (progress) {
+            task.progressBlock = progress;
+        }
+        if (success) {
+            task.successBlock = success;
+        }
+        if (failure) {
+            task.failureBlock = failure;
+        }
+        
+        if (self.tasks[task.identifier] != task) {
+            return;
+        }
+        if (task.state == APIChunkedUploadStatePaused || task.state == APIChunkedUploadStateFailed || task.state == APIChunkedUploadStatePending) {
+            NSLog(@"▶️ 分片上传继续: %@（已确认%lu/%lu）", task.fileName, (unsigned long)task.acknowledgedChunks.count, (unsigned long)task.chunkCount);
+            [self startTask:task];
+        }
+    });
+}
+
+- (void)pauseTask:(APIChunkedUploadTask *)task {
+    dispatch_async(self.queue, ^{
+        [self pauseTask:task reason:APIChunkedUploadPauseReasonUser];
+    });
+}
+
+- (void)cancelTask:(APIChunkedUploadTask *)task {
+    dispatch_async(self.queue, ^{
+        if (self.tasks[task.identifier] != task) {
+            return;
+        }
+        
+        [self stopRequestsOfTask:task];
+        task.state = APIChunkedUploadStateCancelled;
+        [self.tasks removeObjectForKey:task.identifier];
+        [self removeSavedTask:task];
+        NSLog(@"🚫 分片上传取消: %@", task.fileName);
+        
+        APIError *error = [APIError errorWithCode:APIErrorCodeCancelled message:@"上传已取消" underlyingError:nil];
+        void (^failure)(NSError *) = task.failureBlock;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (failure) {
+                failure(error);
+            }
+        });
+        [self endBackgroundTaskIfIdle];
+    });
+}
+
+#pragma mark - Private Methods
+
+/// 开始（或重新开始）上传：校验文件 → 创建上传或同步已确认的分片 → 并行上传剩余分片 → 合并
+- (void)startTask:(APIChunkedUploadTask *)task {
+    [self stopRequestsOfTask:task];
+    [task.chunkRetryCounts removeAllObjects];
+    task.state = APIChunkedUploadStateUploading;
+    task.pauseReason = APIChunkedUploadPauseReasonNone;
+    task.error = nil;
+    task.synchronized = NO;
+    
+    NSError *fileError = [self validateFileOfTask:task];
+    if (fileError) {
+        [self failTask:task error:fileError];
+        return;
+    }
+    [self advanceTask:task];
+}
+
+/// 推进到下一步
+- (void)advanceTask:(APIChunkedUploadTask *)task {
+    if (task.state != APIChunkedUploadStateUploading) {
+        return;
+    }
+    
+    if (!task.uploadId) {
+        [self createUploadForTask:task];
+    } else if (!task.synchronized) {
+        [self synchronizeTask:task];
+    } else {
+        [self uploadNextChunksOfTask:task];
+    }
+}
+
+/// 文件不存在或已被修改时返回错误（已上传的分片不再对应该文件）
+- (nullable NSError *)validateFileOfTask:(APIChunkedUploadTask *)task {
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:task.fileURL.path error:nil];
+    NSString *message = nil;
+    if (!attributes) {
+        message = [NSString stringWithFormat:@"文件不存在: %@", task.fileName];
+    } else if ([attributes fileSize] != task.fileSize ||
+               (task.fileModificationDate && ![attributes.fileModificationDate isEqualToDate:task.fileModificationDate])) {
+        message = [NSString stringWithFormat:@"文件已被修改，无法继续上传: %@", task.fileName];
+    }
+    if (!message) {
+        return nil;
+    }
+    
+    // 已上传的分片失效，重新上传需要新建任务
+    task.uploadId = nil;
+    task.acknowledgedChunks = [NSIndexSet indexSet];
+    return [APIError errorWithCode:APIErrorCodeBadRequest message:message underlyingError:nil];
+}
+
+/// 创建上传
+- (void)createUploadForTask:(APIChunkedUploadTask *)task {
+    NSMutableDictionary *body = [NSMutableDictionary dictionaryWithDictionary:task.parameters ?: @{}];
+    body[@"fileName"] = task.fileName;
+    body[@"fileSize"] = @(task.fileSize);
+    body[@"chunkSize"] = @(task.chunkSize);
+    body[@"chunkCount"] = @(task.chunkCount);
+    body[@"mimeType"] = task.mimeType;
+    
+    [self sendControlRequestForTask:task method:@"POST" subPath:nil JSONObject:body completion:^(NSURLResponse *response, id responseObject) {
+        id uploadId = APIChunkedUploadResponseField(responseObject, @"uploadId");
+        if (![uploadId isKindOfClass:[NSString class]] && ![uploadId isKindOfClass:[NSNumber class]]) {
+            APIError *error = [APIError errorWithCode:APIErrorCodeDecodingFailed message:@"创建上传的响应缺少uploadId" underlyingError:nil];
+            [self failTask:task error:error];
+            return;
+        }
+        
+        task.uploadId = [uploadId description];
+        task.acknowledgedChunks = [self chunkIndexesFromResponseObject:responseObject task:task];
+        task.synchronized = YES;
+        [self saveTask:task];
+        NSLog(@"📤 分片上传已创建: %@ uploadId=%@", task.fileName, task.uploadId);
+        [self advanceTask:task];
+    }];
+}
+
+/// 向服务端同步已确认的分片（本地记录可能落后于服务端）
+- (void)synchronizeTask:(APIChunkedUploadTask *)task {
+    NSString *subPath = [NSString stringWithFormat:@"/%@", task.uploadId];
+    [self sendControlRequestForTask:task method:@"GET" subPath:subPath JSONObject:nil completion:^(NSURLResponse *response, id responseObject) {
+        task.acknowledgedChunks = [self chunkIndexesFromResponseObject:responseObject task:task];
+        task.synchronized = YES;
+        [self saveTask:task];
+        [self advanceTask:task];
+    }];
+}
+
+/// 合并分片
+- (void)completeTask:(APIChunkedUploadTask *)task {
+    NSString *subPath = [NSString stringWithFormat:@"/%@/complete", task.uploadId];
+    NSDictionary *body = @{@"chunkCount": @(task.chunkCount), @"fileSize": @(task.fileSize)};
+    [self sendControlRequestForTask:task method:@"POST" subPath:subPath JSONObject:body completion:^(NSURLResponse *response, id responseObject) {
+        task.generation++;
+        task.state = APIChunkedUploadStateCompleted;
+        task.progress.completedUnitCount = task.progress.totalUnitCount;
+        [self.tasks removeObjectForKey:task.identifier];
+        [self removeSavedTask:task];
+        NSLog(@"✅ 分片上传完成: %@", task.fileName);
+        
+        void (^success)(id) = task.successBlock;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (success) {
+                success(responseObject);
+            }
+        });
+        [self endBackgroundTaskIfIdle];
+    }];
+}
+
+/// 补满并发名额；全部分片确认后合并
+- (void)uploadNextChunksOfTask:(APIChunkedUploadTask *)task {
+    if (task.state != APIChunkedUploadStateUploading || task.controlTask) {
+        return;
+    }
+    
+    if (task.acknowledgedChunks.count >= task.chunkCount) {
+        if (task.inflightChunks.count == 0) {
+            [self completeTask:task];
+        }
+        return;
+    }
+    
+    for (NSUInteger index = 0; index < task.chunkCount && task.inflightChunks.count < self.maxConcurrentChunks; index++) {
+        if ([task.acknowledgedChunks containsIndex:index] || task.inflightChunks[@(index)]) {
+            continue;
+        }
+        if (![self uploadChunkAtIndex:index task:task]) {
+            return;
+        }
+    }
+}
+
+/// 上传一个分片
+/// @return 读取文件或构建请求失败（任务已失败）时返回NO
+- (BOOL)uploadChunkAtIndex:(NSUInteger)index task:(APIChunkedUploadTask *)task {
+    // 只读取该分片的数据，内存占用与文件大小无关
+    unsigned long long offset = (unsigned long long)index * task.chunkSize;
+    NSUInteger length = [task lengthOfChunkAtIndex:index];
+    NSError *readError = nil;
+    NSData *chunkData = nil;
+    NSFileHandle *fileHandle = [NSFileHandle fileHandleForReadingFromURL:task.fileURL error:&readError];
+    if (fileHandle && [fileHandle seekToOffset:offset error:&readError]) {
+        chunkData = [fileHandle readDataUpToLength:length error:&readError];
+    }
+    [fileHandle closeAndReturnError:nil];
+    if (chunkData.length != length) {
+        NSString *message = [NSString stringWithFormat:@"读取文件失败: %@", task.fileName];
+        [self failTask:task error:[APIError errorWithCode:APIErrorCodeUnknown message:message underlyingError:readError]];
+        return NO;
+    }
+    
+    NSString *subPath = [NSString stringWithFormat:@"/%@/chunks/%lu", task.uploadId, (unsigned long)index];
+    NSDictionary *headers = @{
+        @"X-Chunk-Index": [NSString stringWithFormat:@"%lu", (unsigned long)index],
+        @"X-Chunk-Offset": [NSString stringWithFormat:@"%llu", offset],
+        @"X-Chunk-SHA256": APIChunkedUploadSHA256(chunkData)
+    };
+    NSError *requestError = nil;
+    NSMutableURLRequest *request = [self requestForTask:task method:@"PUT" subPath:subPath headers:headers error:&requestError];
+    if (!request) {
+        [self failTask:task error:requestError];
+        return NO;
+    }
+    [request setValue:@"application/octet-stream" forHTTPHeaderField:@"Content-Type"];
+    
+    NSNumber *key = @(index);
+    NSUInteger generation = task.generation;
+    APITaskRegistry *taskRegistry = [APIManager sharedManager].taskRegistry;
+    __block APIScheduledJob *job = nil;
+    __block NSURLSessionUploadTask *uploadTask = nil;
+    uploadTask = [self.sessionManager uploadTaskWithRequest:request fromData:chunkData progress:^(NSProgress * _Nonnull uploadProgress) {
+        int64_t sentBytes = uploadProgress.completedUnitCount;
+        dispatch_async(self.queue, ^{
+            if (task.generation != generation || task.inflightChunks[key] != uploadTask) {
+                return;
+            }
+            task.inflightBytes[key] = @(sentBytes);
+            [self notifyProgressOfTask:task];
+        });
+    } completionHandler:^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
+        [job finish];
+        [taskRegistry unregisterTask:uploadTask];
+        dispatch_async(self.queue, ^{
+            if (task.generation != generation || task.inflightChunks[key] != uploadTask) {
+                return;
+            }
+            [task.inflightChunks removeObjectForKey:key];
+            [task.inflightBytes removeObjectForKey:key];
+            
+            // 2xx即确认；校验失败等4xx按普通错误重传该分片
+            if (error) {
+                [self handleError:error request:request response:response task:task chunkIndex:index];
+                return;
+            }
+            
+            NSMutableIndexSet *acknowledgedChunks = [task.acknowledgedChunks mutableCopy];
+            [acknowledgedChunks addIndex:index];
+            task.acknowledgedChunks = acknowledgedChunks;
+            [task.chunkRetryCounts removeObjectForKey:key];
+            [task.authReplayedKeys removeObject:key];
+            [self saveTask:task];
+            [self notifyProgressOfTask:task];
+            [self uploadNextChunksOfTask:task];
+        });
+    }];
+    
+    task.inflightChunks[key] = uploadTask;
+    [taskRegistry registerTask:uploadTask tags:[NSSet setWithObjects:APITaskTagUpload, task.pathName, nil]];
+    job = [[APIRequestScheduler sharedScheduler] jobWithTask:uploadTask priority:self.priority startHandler:nil];
+    [job start];
+    return YES;
+}
+
+/// 发送控制请求（创建/查询/合并），失败时按统一规则处理
+- (void)sendControlRequestForTask:(APIChunkedUploadTask *)task
+                           method:(NSString *)method
+                          subPath:(nullable NSString *)subPath
+                       JSONObject:(nullable id)JSONObject
+                       completion:(void(^)(NSURLResponse *response, id _Nullable responseObject))completion {
+    NSError *requestError = nil;
+    NSMutableURLRequest *request = [self requestForTask:task method:method subPath:subPath headers:nil error:&requestError];
+    if (request && JSONObject) {
+        request.HTTPBody = [NSJSONSerialization dataWithJSONObject:JSONObject options:0 error:&requestError];
+        [request setValue:@"application/json" forHTTPHeaderField:@"Content-Type"];
+    }
+    if (!request || requestError) {
+        [self failTask:task error:requestError];
+        return;
+    }
+    
+    NSUInteger generation = task.generation;
+    APITaskRegistry *taskRegistry = [APIManager sharedManager].taskRegistry;
+    __block APIScheduledJob *job = nil;
+    __block NSURLSessionDataTask *dataTask = nil;
+    dataTask = [self.sessionManager dataTaskWithRequest:request uploadProgress:nil downloadProgress:nil completionHandler:^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
+        [job finish];
+        [taskRegistry unregisterTask:dataTask];
+        dispatch_async(self.queue, ^{
+            if (task.generation != generation || task.controlTask != dataTask) {
+                return;
+            }
+            task.controlTask = nil;
+            
+            if (error) {
+                [self handleError:error request:request response:response task:task chunkIndex:NSNotFound];
+                return;
+            }
+            [task.chunkRetryCounts removeObjectForKey:@(NSNotFound)];
+            [task.authReplayedKeys removeObject:@(NSNotFound)];
+            completion(response, responseObject);
+        });
+    }];
+    
+    task.controlTask = dataTask;
+    [taskRegistry registerTask:dataTask tags:[NSSet setWithObjects:APITaskTagUpload, task.pathName, nil]];
+    job = [[APIRequestScheduler sharedScheduler] jobWithTask:dataTask priority:self.priority startHandler:nil];
+    [job start];
+}
+
+/// 构建请求：路径名称对应的地址 + 子路径，经过 APIManager 的公共请求头和拦截器
+- (nullable NSMutableURLRequest *)requestForTask:(APIChunkedUploadTask *)task
+                                          method:(NSString *)method
+                                         subPath:(nullable NSString *)subPath
+                                         headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                           error:(NSError **)error {
+    APIEnvironmentManager *envManager = [APIEnvironmentManager sharedManager];
+    if ([envManager pathForPathName:task.pathName].length == 0) {
+        *error = [APIError errorWithCode:APIErrorCodeBadRequest
+                                 message:[NSString stringWithFormat:@"未找到路径名称: %@", task.pathName]
+                         underlyingError:nil];
+        return nil;
+    }
+    
+    NSString *URLString = [envManager fullURLForPathName:task.pathName];
+    if (subPath.length > 0) {
+        URLString = [URLString stringByAppendingString:subPath];
+    }
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:URLString]];
+    request.HTTPMethod = method;
+    request.timeoutInterval = [APIManager sharedManager].effectiveTimeoutInterval;
+    
+    NSURLRequest *interceptedRequest = [[APIManager sharedManager] interceptedRequestForRequest:request headers:headers];
+    if (!interceptedRequest) {
+        APIError *cancelledError = [APIError errorWithCode:APIErrorCodeCancelled message:@"请求被拦截器取消" underlyingError:nil];
+        cancelledError.requestPath = URLString;
+        *error = cancelledError;
+        return nil;
+    }
+    return [interceptedRequest mutableCopy];
+}
+
+/// 请求失败：断网时暂停等待网络恢复，401时刷新Token后重放，其他错误按次数重传，超过次数后任务失败
+- (void)handleError:(NSError *)error
+            request:(NSURLRequest *)request
+           response:(NSURLResponse *)response
+               task:(APIChunkedUploadTask *)task
+         chunkIndex:(NSUInteger)chunkIndex {
+    // 上传器自己取消的请求回调已失效，到这里的取消来自外部（如 cancelAllRequests、按标签取消）：暂停，调用 resumeTask: 继续
+    if ([error.domain isEqualToString:NSURLErrorDomain] && error.code == NSURLErrorCancelled) {
+        NSLog(@"⏹️ 分片上传请求被取消，暂停任务: %@", task.fileName);
+        [self pauseTask:task reason:APIChunkedUploadPauseReasonUser];
+        return;
+    }
+    
+    if (APIChunkedUploadIsConnectivityError(error)) {
+        NSLog(@"📵 分片上传网络中断，等待网络恢复: %@", task.fileName);
+        [self pauseTask:task reason:APIChunkedUploadPauseReasonNetwork];
+        return;
+    }
+    
+    // 服务端已没有该上传（过期清理），重新创建
+    if (chunkIndex == NSNotFound && task.uploadId && !task.synchronized && APIChunkedUploadStatusCode(response) == 404) {
+        NSLog(@"⚠️ 分片上传在服务端已过期，重新上传: %@", task.fileName);
+        task.uploadId = nil;
+        task.acknowledgedChunks = [NSIndexSet indexSet];
+        [self saveTask:task];
+        [self advanceTask:task];
+        return;
+    }
+    
+    NSNumber *key = @(chunkIndex);
+    if (APIChunkedUploadStatusCode(response) == 401) {
+        [self handleUnauthorizedError:error request:request response:response task:task chunkIndex:chunkIndex];
+        return;
+    }
+    
+    NSUInteger retryCount = task.chunkRetryCounts[key].unsignedIntegerValue + 1;
+    if (retryCount > self.maxChunkRetryCount) {
+        APIError *apiError = [APIError errorFromNSError:error];
+        apiError.requestPath = response.URL.path;
+        [self failTask:task error:apiError];
+        return;
+    }
+    task.chunkRetryCounts[key] = @(retryCount);
+    if (chunkIndex != NSNotFound) {
+        // 占住该分片的名额，避免等待期间被重新调度
+        task.inflightChunks[key] = [NSNull null];
+    }
+    
+    NSTimeInterval delay = retryCount * 1.0;
+    NSLog(@"🔄 分片上传重传（%@ 第%lu次，%.0f秒后）: %@", chunkIndex == NSNotFound ? @"控制请求" : [NSString stringWithFormat:@"分片%lu", (unsigned long)chunkIndex], (unsigned long)retryCount, delay, error.localizedDescription);
+    NSUInteger generation = task.generation;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+        if (task.generation != generation) {
+            return;
+        }
+        if (chunkIndex != NSNotFound) {
+            [task.inflightChunks removeObjectForKey:key];
+        }
+        [self advanceTask:task];
+    });
+}
+
+/// 401：经 APIManager 刷新Token（和其他请求共用一次刷新）后重放一次；重放后仍然401或刷新失败时任务失败
+- (void)handleUnauthorizedError:(NSError *)error
+                        request:(NSURLRequest *)request
+                       response:(NSURLResponse *)response
+                           task:(APIChunkedUploadTask *)task
+                     chunkIndex:(NSUInteger)chunkIndex {
+    NSNumber *key = @(chunkIndex);
+    APIError *unauthorizedError = [APIError errorWithCode:APIErrorCodeUnauthorized message:@"登录已过期，请重新登录" underlyingError:error];
+    unauthorizedError.requestPath = response.URL.path;
+    if ([task.authReplayedKeys containsObject:key]) {
+        [self failTask:task error:unauthorizedError];
+        return;
+    }
+    [task.authReplayedKeys addObject:key];
+    if (chunkIndex != NSNotFound) {
+        // 占住该分片的名额，避免等待刷新期间被重新调度
+        task.inflightChunks[key] = [NSNull null];
+    }
+    
+    NSLog(@"🔑 分片上传返回401，等待Token刷新后重放: %@", task.fileName);
+    NSUInteger generation = task.generation;
+    [[APIManager sharedManager] refreshAuthorizationForRequest:request completion:^(BOOL success, NSError * _Nullable refreshError) {
+        dispatch_async(self.queue, ^{
+            if (task.generation != generation) {
+                return;
+            }
+            if (chunkIndex != NSNotFound) {
+                [task.inflightChunks removeObjectForKey:key];
+            }
+            
+            // 重放时重新构建请求，带上新Token
+            if (success) {
+                [self advanceTask:task];
+                return;
+            }
+            [self failTask:task error:refreshError ?: unauthorizedError];
+        });
+    }];
+}
+
+/// 暂停：取消进行中的请求，已确认的分片保留
+- (void)pauseTask:(APIChunkedUploadTask *)task reason:(APIChunkedUploadPauseReason)reason {
+    if (task.state != APIChunkedUploadStateUploading && task.state != APIChunkedUploadStatePending) {
+        return;
+    }
+    
+    [self stopRequestsOfTask:task];
+    task.state = APIChunkedUploadStatePaused;
+    task.pauseReason = reason;
+    [self saveTask:task];
+    [self notifyProgressOfTask:task];
+    NSLog(@"⏸️ 分片上传暂停: %@（已确认%lu/%lu）", task.fileName, (unsigned long)task.acknowledgedChunks.count, (unsigned long)task.chunkCount);
+    
+    if (reason == APIChunkedUploadPauseReasonNetwork) {
+        [self scheduleNetworkProbe];
+    }
+    if (reason != APIChunkedUploadPauseReasonSuspended) {
+        [self endBackgroundTaskIfIdle];
+    }
+}
+
+/// 失败：已确认的分片保留，可以调用 resumeTask: 继续
+- (void)failTask:(APIChunkedUploadTask *)task error:(NSError *)error {
+    [self stopRequestsOfTask:task];
+    task.state = APIChunkedUploadStateFailed;
+    task.error = error;
+    [self saveTask:task];
+    NSLog(@"❌ 分片上传失败: %@ - %@", task.fileName, error.localizedDescription);
+    
+    void (^failure)(NSError *) = task.failureBlock;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (failure) {
+            failure(error);
+        }
+    });
+    [self endBackgroundTaskIfIdle];
+}
+
+/// 取消进行中的请求，并使等待中的回调失效
+- (void)stopRequestsOfTask:(APIChunkedUploadTask *)task {
+    task.generation++;
+    for (id inflightTask in task.inflightChunks.allValues) {
+        if ([inflightTask isKindOfClass:[NSURLSessionTask class]]) {
+            [(NSURLSessionTask *)inflightTask cancel];
+        }
+    }
+    [task.controlTask cancel];
+    task.controlTask = nil;
+    [task.inflightChunks removeAllObjects];
+    [task.inflightBytes removeAllObjects];
+    [task.authReplayedKeys removeAllObjects];
+}
+
+- (void)notifyProgressOfTask:(APIChunkedUploadTask *)task {
+    task.progress.completedUnitCount = [task completedBytes];
+    void (^progress)(NSProgress *) = task.progressBlock;
+    if (progress) {
+        NSProgress *taskProgress = task.progress;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            progress(taskProgress);
+        });
+    }
+}
+
+- (NSIndexSet *)chunkIndexesFromResponseObject:(nullable id)responseObject task:(APIChunkedUploadTask *)task {
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    id uploadedChunks = APIChunkedUploadResponseField(responseObject, @"uploadedChunks");
+    if ([uploadedChunks isKindOfClass:[NSArray class]]) {
+        for (id index in uploadedChunks) {
+            if ([index isKindOfClass:[NSNumber class]] && [index integerValue] >= 0 && [index unsignedIntegerValue] < task.chunkCount) {
+                [indexes addIndex:[index unsignedIntegerValue]];
+            }
+        }
+    }
+    return indexes;
+}
+
+#pragma mark - Network & Lifecycle
+
+/// 断网暂停后定时探测：可达性不是“不可达”时重新开始（失败会再次暂停，不消耗重传次数）
+- (void)scheduleNetworkProbe {
+    if (self.networkProbeScheduled) {
+        return;
+    }
+    
+    self.networkProbeScheduled = YES;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kAPIChunkedUploadNetworkProbeInterval * NSEC_PER_SEC)), self.queue, ^{
+        self.networkProbeScheduled = NO;
+        if ([AFNetworkReachabilityManager sharedManager].networkReachabilityStatus != AFNetworkReachabilityStatusNotReachable) {
+            [self resumeTasksPausedForReason:APIChunkedUploadPauseReasonNetwork];
+        }
+    });
+}
+
+- (void)resumeTasksPausedForReason:(APIChunkedUploadPauseReason)reason {
+    for (APIChunkedUploadTask *task in self.tasks.allValues) {
+        if (task.state == APIChunkedUploadStatePaused && task.pauseReason == reason) {
+            [self startTask:task];
+        }
+    }
+}
+
+- (void)reachabilityDidChange:(NSNotification *)notification {
+    AFNetworkReachabilityStatus status = [notification.userInfo[AFNetworkingReachabilityNotificationStatusItem] integerValue];
+    if (status != AFNetworkReachabilityStatusReachableViaWWAN && status != AFNetworkReachabilityStatusReachableViaWiFi) {
+        return;
+    }
+    
+    dispatch_async(self.queue, ^{
+        [self resumeTasksPausedForReason:APIChunkedUploadPauseReasonNetwork];
+    });
+}
+
+/// 进入后台时申请后台执行时间继续上传，时间用完前暂停并保存进度
+- (void)applicationDidEnterBackground:(NSNotification *)notification {
+    __block BOOL uploading = NO;
+    dispatch_sync(self.queue, ^{
+        for (APIChunkedUploadTask *task in self.tasks.allValues) {
+            uploading = uploading || task.state == APIChunkedUploadStateUploading;
+        }
+    });
+    if (!uploading || self.backgroundTaskIdentifier != UIBackgroundTaskInvalid) {
+        return;
+    }
+    
+    UIApplication *application = [UIApplication sharedApplication];
+    self.backgroundTaskIdentifier = [application beginBackgroundTaskWithName:@"APIChunkedUploader" expirationHandler:^{
+        dispatch_sync(self.queue, ^{
+            for (APIChunkedUploadTask *task in self.tasks.allValues) {
+                [self pauseTask:task reason:APIChunkedUploadPauseReasonSuspended];
+            }
+        });
+        [self endBackgroundTask];
+    }];
+}
+
+- (void)applicationWillEnterForeground:(NSNotification *)notification {
+    [self endBackgroundTask];
+    dispatch_async(self.queue, ^{
+        [self resumeTasksPausedForReason:APIChunkedUploadPauseReasonSuspended];
+    });
+}
+
+- (void)endBackgroundTask {
+    if (self.backgroundTaskIdentifier == UIBackgroundTaskInvalid) {
+        return;
+    }
+    [[UIApplication sharedApplication] endBackgroundTask:self.backgroundTaskIdentifier];
+    self.backgroundTaskIdentifier = UIBackgroundTaskInvalid;
+}
+
+/// 没有上传中的任务时提前结束后台执行
+- (void)endBackgroundTaskIfIdle {
+    for (APIChunkedUploadTask *task in self.tasks.allValues) {
+        if (task.state == APIChunkedUploadStateUploading) {
+            return;
+        }
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self endBackgroundTask];
+    });
+}
+
+#pragma mark - Persistence
+
+- (NSString *)storageFilePathForTask:(APIChunkedUploadTask *)task {
+    return [self.storagePath stringByAppendingPathComponent:[task.identifier stringByAppendingPathExtension:@"plist"]];
+}
+
+- (void)saveTask:(APIChunkedUploadTask *)task {
+    NSError *error = nil;
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:task requiringSecureCoding:YES error:&error];
+    if (!data || ![data writeToFile:[self storageFilePathForTask:task] options:NSDataWritingAtomic error:&error]) {
+        NSLog(@"⚠️ 分片上传进度保存失败: %@", error.localizedDescription);
+    }
+}
+
+- (void)removeSavedTask:(APIChunkedUploadTask *)task {
+    [[NSFileManager defaultManager] removeItemAtPath:[self storageFilePathForTask:task] error:nil];
+}
+
+/// 恢复上次启动留下的任务（暂停状态，等待 resumeTask:）
+- (void)restoreTasks {
+    NSArray<NSString *> *fileNames = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:self.storagePath error:nil];
+    for (NSString *fileName in fileNames) {
+        if (![fileName.pathExtension isEqualToString:@"plist"]) {
+            continue;
+        }
+        
+        NSString *filePath = [self.storagePath stringByAppendingPathComponent:fileName];
+        NSData *data = [NSData dataWithContentsOfFile:filePath];
+        NSError *error = nil;
+        APIChunkedUploadTask *task = data ? [NSKeyedUnarchiver unarchivedObjectOfClass:[APIChunkedUploadTask class] fromData:data error:&error] : nil;
+        if (!task) {
+            NSLog(@"⚠️ 分片上传记录读取失败，已移除: %@", error.localizedDescription);
+            [[NSFileManager defaultManager] removeItemAtPath:filePath error:nil];
+            continue;
+        }
+        self.tasks[task.identifier] = task;
+    }
+    
+    if (self.tasks.count > 0) {
+        NSLog(@"📤 恢复%lu个未完成的分片上传", (unsigned long)self.tasks.count);
+    }
+}
+
+@end
@@ -7,6 +7,7 @@
 
 #import <Foundation/Foundation.h>
 #import "APIServerConfig.h"
+#import "APIPayloadCodec.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -20,6 +21,8 @@ typedef NS_ENUM(NSInteger, WebSocketStatus) {
 
 /// WebSocket消息回调
 typedef void(^WebSocketMessageBlock)(id message);
+/// WebSocket解码后的消息回调
+typedef void(^WebSocketObjectBlock)(id object);
 /// WebSocket连接状态变化回调
 typedef void(^WebSocketStatusBlock)(WebSocketStatus status);
 /// WebSocket错误回调
@@ -40,6 +43,9 @@ typedef void(^WebSocketErrorBlock)(NSError *error);
 /// 重连间隔（默认3秒）
 @property (nonatomic, assign) NSTimeInterval reconnectInterval;
 
+/// 是否按网络质量放宽重连间隔和连接超时（默认YES，3G级别1.5倍，2G级别2倍，见 APINetworkQualityEstimator）
+@property (nonatomic, assign) BOOL adaptsToNetworkQuality;
+
 /// 最大重连次数（默认5次，0表示无限重连）
 @property (nonatomic, assign) NSInteger maxReconnectCount;
 
@@ -58,9 +64,20 @@ typedef void(^WebSocketErrorBlock)(NSError *error);
 /// 最大缓存消息数（默认100条）
 @property (nonatomic, assign) NSInteger maxCachedMessages;
 
-/// 消息回调
+/// 消息编解码器（默认：nil，不协商子协议，sendObject:使用JSON）
+/// 设置后连接时在Sec-WebSocket-Protocol中追加该编解码器和JSON的子协议（如：msgpack, json），
+/// 按服务端选择的子协议编码sendObject:发送的消息、解码收到的消息
+@property (nonatomic, strong, nullable) id<APIPayloadCodec> payloadCodec;
+
+/// 当前连接协商的编解码器（服务端未选择编解码子协议时为JSON）
+@property (nonatomic, strong, readonly) id<APIPayloadCodec> negotiatedCodec;
+
+/// 消息回调（原始消息：NSString或NSData）
 @property (nonatomic, copy, nullable) WebSocketMessageBlock messageBlock;
 
+/// 解码后的消息回调（按negotiatedCodec解码为Foundation对象，与messageBlock同时生效；解码失败的消息只回调messageBlock）
+@property (nonatomic, copy, nullable) WebSocketObjectBlock objectBlock;
+
 /// 连接状态变化回调
 @property (nonatomic, copy, nullable) WebSocketStatusBlock statusBlock;
 
@@ -118,7 +135,14 @@ typedef void(^WebSocketErrorBlock)(NSError *error);
 /// @return 是否发送成功
 - (BOOL)sendJSON:(id)jsonObject;
 
+/// 发送对象消息（按negotiatedCodec编码，JSON以文本帧发送，二进制格式以二进制帧发送）
+/// @param object Foundation对象（字典或数组）
+/// @return 是否发送成功
+/// @note 断开时缓存的是编码后的消息，重连后按原格式发送
+- (BOOL)sendObject:(id)object;
+
 /// 发送Ping（心跳包）
+/// 同时发送WebSocket Ping帧，收到Pong的往返耗时作为网络质量样本；下一次Ping时仍未收到Pong记为一次丢包
 - (void)sendPing;
 
 /// 手动重连
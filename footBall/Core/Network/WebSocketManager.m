@@ -7,18 +7,21 @@
 
 #import "WebSocketManager.h"
 #import "WebSocketEnvironmentManager.h"
+#import "APINetworkQualityEstimator.h"
 #import <SocketRocket/SocketRocket.h>
 
 @interface WebSocketManager () <SRWebSocketDelegate>
 
 @property (nonatomic, strong) SRWebSocket *webSocket;
 @property (nonatomic, assign) WebSocketStatus status;
+@property (nonatomic, strong) id<APIPayloadCodec> negotiatedCodec;
 @property (nonatomic, strong) NSString *URLString;
 @property (nonatomic, strong) NSArray<NSString *> *protocols;
 @property (nonatomic, strong) NSDictionary<NSString *, NSString *> *headers;
 @property (nonatomic, assign) NSInteger reconnectCount;
 @property (nonatomic, strong) NSTimer *reconnectTimer;
 @property (nonatomic, strong) NSTimer *heartbeatTimer;
+@property (nonatomic, assign) CFAbsoluteTime pingSentTime; // 等待Pong的Ping发送时间（0表示没有）
 @property (nonatomic, strong) NSMutableArray<id> *messageQueue; // 消息队列
 @property (nonatomic, strong) NSMutableArray<id> *cachedMessages; // 缓存的消息
 
@@ -41,6 +44,7 @@
         _status = WebSocketStatusDisconnected;
         _autoReconnect = YES;
         _reconnectInterval = 3.0;
+        _adaptsToNetworkQuality = YES;
         _maxReconnectCount = 5;
         _reconnectCount = 0;
         _enableHeartbeat = NO;
@@ -50,6 +54,7 @@
         _maxCachedMessages = 100;
         _messageQueue = [NSMutableArray array];
         _cachedMessages = [NSMutableArray array];
+        _negotiatedCodec = [APIJSONCodec sharedCodec];
     }
     return self;
 }
@@ -130,7 +135,7 @@
     
     // 创建WebSocket请求
     NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
-    request.timeoutInterval = self.connectTimeout;
+    request.timeoutInterval = [self adjustedInterval:self.connectTimeout];
     
     // 设置请求头
     if (self.headers && self.headers.count > 0) {
@@ -140,8 +145,9 @@
     }
     
     // 创建WebSocket
-    if (self.protocols && self.protocols.count > 0) {
-        self.webSocket = [[SRWebSocket alloc] initWithURLRequest:request protocols:self.protocols];
+    NSArray<NSString *> *protocols = [self protocolsIncludingCodecSubprotocols];
+    if (protocols.count > 0) {
+        self.webSocket = [[SRWebSocket alloc] initWithURLRequest:request protocols:protocols];
     } else {
         self.webSocket = [[SRWebSocket alloc] initWithURLRequest:request];
     }
@@ -236,6 +242,40 @@
     return [self sendMessage:jsonData];
 }
 
+- (BOOL)sendObject:(id)object {
+    if (!object) {
+        NSLog(@"消息对象为空");
+        return NO;
+    }
+    
+    id<APIPayloadCodec> codec = self.negotiatedCodec;
+    NSError *error = nil;
+    NSData *data = [codec encodeObject:object error:&error];
+    if (!data) {
+        NSLog(@"%@编码失败: %@", codec.name, error.localizedDescription);
+        return NO;
+    }
+    
+    // JSON使用文本帧，二进制格式使用二进制帧
+    if ([codec isKindOfClass:[APIJSONCodec class]]) {
+        return [self sendMessage:[[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding]];
+    }
+    return [self sendMessage:data];
+}
+
+/// 调用方指定的子协议 + 编解码子协议（按优先级排列，服务端选择其中一个）
+- (NSArray<NSString *> *)protocolsIncludingCodecSubprotocols {
+    NSMutableArray<NSString *> *protocols = [NSMutableArray arrayWithArray:self.protocols ?: @[]];
+    if (self.payloadCodec) {
+        for (NSString *subprotocol in @[self.payloadCodec.webSocketSubprotocol, [APIJSONCodec sharedCodec].webSocketSubprotocol]) {
+            if (![protocols containsObject:subprotocol]) {
+                [protocols addObject:subprotocol];
+            }
+        }
+    }
+    return protocols;
+}
+
 - (void)cacheMessage:(id)message {
     if (self.cachedMessages.count >= self.maxCachedMessages) {
         [self.cachedMessages removeObjectAtIndex:0];
@@ -256,6 +296,12 @@
         } else {
             NSLog(@"发送心跳成功");
         }
+        
+        // Ping帧由协议层直接回Pong，往返耗时不含服务端业务处理，用于估算网络质量
+        if (self.pingSentTime > 0) {
+            [[APINetworkQualityEstimator sharedEstimator] recordPingLoss];
+        }
+        self.pingSentTime = [self.webSocket sendPing:nil error:nil] ? CFAbsoluteTimeGetCurrent() : 0;
     }
 }
 
@@ -279,13 +325,21 @@
     [self stopReconnectTimer];
     
     __weak typeof(self) weakSelf = self;
-    self.reconnectTimer = [NSTimer scheduledTimerWithTimeInterval:self.reconnectInterval
+    self.reconnectTimer = [NSTimer scheduledTimerWithTimeInterval:[self adjustedInterval:self.reconnectInterval]
                                                            repeats:NO
                                                              block:^(NSTimer * _Nonnull timer) {
         [weakSelf reconnect];
     }];
 }
 
+/// 按网络质量放宽重连间隔和连接超时
+- (NSTimeInterval)adjustedInterval:(NSTimeInterval)interval {
+    if (!self.adaptsToNetworkQuality) {
+        return interval;
+    }
+    return [[APINetworkQualityEstimator sharedEstimator] adjustedInterval:interval];
+}
+
 - (void)stopReconnectTimer {
     if (self.reconnectTimer) {
         [self.reconnectTimer invalidate];
@@ -300,6 +354,12 @@
     
     self.status = WebSocketStatusConnected;
     self.reconnectCount = 0;
+    
+    // 按服务端选择的子协议确定编解码器
+    self.negotiatedCodec = [[APIPayloadCodecRegistry sharedRegistry] codecForWebSocketSubprotocol:webSocket.protocol] ?: [APIJSONCodec sharedCodec];
+    if (self.payloadCodec) {
+        NSLog(@"WebSocket消息格式: %@", self.negotiatedCodec.name);
+    }
     [self stopReconnectTimer];
     
     // 启动心跳
@@ -331,6 +391,7 @@
         [self.heartbeatTimer invalidate];
         self.heartbeatTimer = nil;
     }
+    self.pingSentTime = 0;
 }
 
 - (void)sendCachedMessages {
@@ -352,6 +413,32 @@
     if (self.messageBlock) {
         self.messageBlock(message);
     }
+    
+    if (self.objectBlock) {
+        id object = [self decodedObjectForMessage:message];
+        if (object) {
+            self.objectBlock(object);
+        }
+    }
+}
+
+- (nullable id)decodedObjectForMessage:(id)message {
+    // 文本帧只可能是JSON，二进制帧按协商的编解码器解码
+    id<APIPayloadCodec> codec = self.negotiatedCodec;
+    NSData *data = message;
+    if ([message isKindOfClass:[NSString class]]) {
+        codec = [APIJSONCodec sharedCodec];
+        data = [message dataUsingEncoding:NSUTF8StringEncoding];
+    } else if (![message isKindOfClass:[NSData class]]) {
+        return nil;
+    }
+    
+    NSError *error = nil;
+    id object = [codec decodeData:data error:&error];
+    if (!object) {
+        NSLog(@"%@消息解码失败: %@", codec.name, error.localizedDescription);
+    }
+    return object;
 }
 
 - (void)webSocket:(SRWebSocket *)webSocket didFailWithError:(NSError *)error {
@@ -400,6 +487,11 @@
 
 - (void)webSocket:(SRWebSocket *)webSocket didReceivePong:(NSData *)pongData {
     NSLog(@"WebSocket收到Pong");
+    
+    if (self.pingSentTime > 0) {
+        [[APINetworkQualityEstimator sharedEstimator] recordPingRoundTripTime:CFAbsoluteTimeGetCurrent() - self.pingSentTime];
+        self.pingSentTime = 0;
+    }
 }
 
 - (void)clearCachedMessages {
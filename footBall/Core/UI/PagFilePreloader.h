@@ -22,6 +22,13 @@ NS_ASSUME_NONNULL_BEGIN
 /// @param fileName 文件名（不含扩展名）
 - (void)preloadPagFile:(NSString *)fileName;
 
+/// 下载并预加载远程 PAG 文件（资源包），已下载过时直接加载
+/// 通过 APIDownloadManager 下载（断点续传、SHA256校验），保存在Caches/PAG目录
+/// @param fileName 文件名（不含扩展名），加载后通过 getPagFile: 获取
+/// @param URLString 下载地址
+/// @param SHA256 文件的SHA256（nil时不校验）
+- (void)preloadRemotePagFile:(NSString *)fileName URLString:(NSString *)URLString SHA256:(nullable NSString *)SHA256;
+
 /// 获取已加载的 PAG 文件
 /// @param fileName 文件名（不含扩展名）
 /// @return PAGFile 对象，如果未加载则返回 nil
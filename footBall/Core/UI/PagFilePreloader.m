@@ -8,6 +8,7 @@
 
 #import "PagFilePreloader.h"
 #import <libpag/PAGView.h>
+#import "APIDownloadManager.h"
 
 @interface PagFilePreloader ()
 
@@ -51,23 +52,47 @@
     dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
         NSString *filePath = [[NSBundle mainBundle] pathForResource:fileName ofType:@"pag"];
         if (filePath) {
-            // 在后台线程加载文件（PAGFile.Load 是线程安全的）
-            PAGFile *pagFile = [PAGFile Load:filePath];
-            if (pagFile) {
-                // 回到主线程缓存（确保线程安全）
-                dispatch_async(dispatch_get_main_queue(), ^{
-                    self.pagFileCache[fileName] = pagFile;
-                    NSLog(@"✅ PAG 文件预加载成功: %@", fileName);
-                });
-            } else {
-                NSLog(@"⚠️ PAG 文件加载失败: %@.pag", fileName);
-            }
+            [self loadPagFileAtPath:filePath fileName:fileName];
         } else {
             NSLog(@"⚠️ PAG 文件不存在: %@.pag", fileName);
         }
     });
 }
 
+- (void)preloadRemotePagFile:(NSString *)fileName URLString:(NSString *)URLString SHA256:(nullable NSString *)SHA256 {
+    if (!fileName || fileName.length == 0 || URLString.length == 0) {
+        return;
+    }
+    
+    // 如果已经加载，直接返回
+    if ([self isPagFileLoaded:fileName]) {
+        return;
+    }
+    
+    NSString *cachesPath = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+    NSString *filePath = [[cachesPath stringByAppendingPathComponent:@"PAG"] stringByAppendingPathComponent:[fileName stringByAppendingPathExtension:@"pag"]];
+    if ([[NSFileManager defaultManager] fileExistsAtPath:filePath]) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
+            [self loadPagFileAtPath:filePath fileName:fileName];
+        });
+        return;
+    }
+    
+    // 下载完成的回调在主线程，加载放到后台线程
+    [[APIDownloadManager sharedManager] downloadURLString:URLString
+                                          destinationPath:filePath
+                                           expectedSHA256:SHA256
+                                                  headers:nil
+                                                 progress:nil
+                                                  success:^(NSURL * _Nonnull downloadedPath) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
+            [self loadPagFileAtPath:downloadedPath.path fileName:fileName];
+        });
+    } failure:^(NSError * _Nonnull error) {
+        NSLog(@"⚠️ PAG 文件下载失败: %@ - %@", fileName, error.localizedDescription);
+    }];
+}
+
 - (nullable PAGFile *)getPagFile:(NSString *)fileName {
     if (!fileName || fileName.length == 0) {
         return nil;
@@ -84,6 +109,22 @@
     return self.pagFileCache[fileName] != nil;
 }
 
+#pragma mark - Private Methods
+
+/// 在后台线程加载文件（PAGFile.Load 是线程安全的），回到主线程缓存
+- (void)loadPagFileAtPath:(NSString *)filePath fileName:(NSString *)fileName {
+    PAGFile *pagFile = [PAGFile Load:filePath];
+    if (pagFile) {
+        // 回到主线程缓存（确保线程安全）
+        dispatch_async(dispatch_get_main_queue(), ^{
+            self.pagFileCache[fileName] = pagFile;
+            NSLog(@"✅ PAG 文件预加载成功: %@", fileName);
+        });
+    } else {
+        NSLog(@"⚠️ PAG 文件加载失败: %@.pag", fileName);
+    }
+}
+
 - (void)preloadRefreshHeaderFiles {
     // 预加载刷新头部所需的文件
     [self preloadPagFile:@"loading_1"];
@@ -80,6 +80,10 @@
             [[DoraemonManager shareInstance] addPluginWithTitle:@"切换环境" icon:@"doraemon_default" desc:@"切换app环境" pluginName:@"BVDebugNetworkSwitchPlugin" atModule:@"业务专区"];
             
             [[DoraemonManager shareInstance] addPluginWithTitle:@"内存检测弹窗" icon:@"doraemon_default" desc:@"检查内存泄露,循环引用" pluginName:@"BVDebugMemoryLeakPlugin" atModule:@"业务专区"];
+            
+            [[DoraemonManager shareInstance] addPluginWithTitle:@"网络状态" icon:@"doraemon_default" desc:@"接口熔断器状态和缓存统计" pluginName:@"BVDebugNetworkStatsPlugin" atModule:@"业务专区"];
+            
+            [[DoraemonManager shareInstance] addPluginWithTitle:@"分片上传" icon:@"doraemon_default" desc:@"模拟服务端验证分片上传和断点续传" pluginName:@"BVDebugChunkUploadPlugin" atModule:@"业务专区"];
         
             [BVAPPDebugTool setupCustomLogoStyle];
         });
@@ -0,0 +1,17 @@
+//
+//  BVDebugChunkUploadController.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 分片上传调试页 - 通过模拟服务端上传一个随机文件，可以模拟断网、暂停后继续，并校验合并后的文件完整
+@interface BVDebugChunkUploadController : UIViewController
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,284 @@
+//
+//  BVDebugChunkUploadController.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#ifdef DEBUG
+#import "BVDebugChunkUploadController.h"
+#import "BVDebugChunkUploadServer.h"
+#import "APIChunkedUploader.h"
+#import "APIConnectionManager.h"
+#import "APICodecSerializer.h"
+#import <CommonCrypto/CommonDigest.h>
+@import DoraemonKit;
+
+/// 测试文件大小
+static const unsigned long long kBVDebugChunkUploadFileSize = 8 * 1024 * 1024 + 12345;
+/// 测试分片大小
+static const NSUInteger kBVDebugChunkUploadChunkSize = 512 * 1024;
+
+@interface BVDebugChunkUploadController ()
+@property (nonatomic, strong) UIProgressView *progressView;
+@property (nonatomic, strong) UILabel *progressLabel;
+@property (nonatomic, strong) UITextView *logTextView;
+@property (nonatomic, strong) UIButton *uploadButton;
+@property (nonatomic, strong) UIButton *pauseButton;
+@property (nonatomic, strong) UIButton *networkButton;
+
+@property (nonatomic, strong, nullable) APIChunkedUploadTask *task;
+@property (nonatomic, copy, nullable) NSString *expectedSHA256;
+@end
+
+@implementation BVDebugChunkUploadController
+
+/// 使用模拟服务端的上传器（独立的持久化目录，不影响正式上传）
++ (APIChunkedUploader *)uploader {
+    static APIChunkedUploader *uploader = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSURLSessionConfiguration *configuration = [[APIConnectionManager sharedManager] sessionConfiguration];
+        configuration.protocolClasses = [@[[BVDebugChunkUploadServer class]] arrayByAddingObjectsFromArray:configuration.protocolClasses ?: @[]];
+        AFHTTPSessionManager *sessionManager = [[AFHTTPSessionManager alloc] initWithSessionConfiguration:configuration];
+        sessionManager.responseSerializer = [APICodecResponseSerializer serializer];
+        uploader = [[APIChunkedUploader alloc] initWithSessionManager:sessionManager storageName:@"BVDebugChunkUploads"];
+        uploader.chunkSize = kBVDebugChunkUploadChunkSize;
+        BVDebugChunkUploadServer.failureRate = 0.1;
+    });
+    return uploader;
+}
+
+- (void)viewDidLayoutSubviews {
+    [super viewDidLayoutSubviews];
+    CGFloat width = CGRectGetWidth(self.view.bounds);
+    CGFloat top = self.view.safeAreaInsets.top + 12;
+    CGFloat buttonWidth = (width - 16 * 4) / 3;
+    self.uploadButton.frame = CGRectMake(16, top, buttonWidth, 36);
+    self.pauseButton.frame = CGRectMake(16 * 2 + buttonWidth, top, buttonWidth, 36);
+    self.networkButton.frame = CGRectMake(16 * 3 + buttonWidth * 2, top, buttonWidth, 36);
+    self.progressView.frame = CGRectMake(16, top + 52, width - 32, 4);
+    self.progressLabel.frame = CGRectMake(16, top + 62, width - 32, 20);
+    self.logTextView.frame = CGRectMake(16, top + 90, width - 32, CGRectGetHeight(self.view.bounds) - top - 90 - self.view.safeAreaInsets.bottom);
+}
+
+- (void)viewDidLoad {
+    [super viewDidLoad];
+    self.title = @"分片上传";
+    self.view.backgroundColor = UIColor.whiteColor;
+    
+    self.uploadButton = [self buttonWithTitle:@"开始上传" action:@selector(startUpload)];
+    self.pauseButton = [self buttonWithTitle:@"暂停" action:@selector(togglePause)];
+    self.networkButton = [self buttonWithTitle:@"模拟断网" action:@selector(toggleNetwork)];
+    [self.view addSubview:self.uploadButton];
+    [self.view addSubview:self.pauseButton];
+    [self.view addSubview:self.networkButton];
+    [self.view addSubview:self.progressView];
+    [self.view addSubview:self.progressLabel];
+    [self.view addSubview:self.logTextView];
+    
+    // 上次未完成的任务（页面关闭或App重新启动后）
+    self.task = [[[self class] uploader] pendingTasks].firstObject;
+    if (self.task) {
+        [self appendLog:[NSString stringWithFormat:@"发现未完成的任务：%@（已确认%lu/%lu个分片），点击“继续”恢复", self.task.fileName, (unsigned long)self.task.acknowledgedChunks.count, (unsigned long)self.task.chunkCount]];
+        [self updateProgress:self.task.progress];
+    } else {
+        [self appendLog:[NSString stringWithFormat:@"点击“开始上传”生成%@随机文件，按%@分片上传；模拟服务端10%%的分片请求返回503",
+                         [NSByteCountFormatter stringFromByteCount:(long long)kBVDebugChunkUploadFileSize countStyle:NSByteCountFormatterCountStyleBinary],
+                         [NSByteCountFormatter stringFromByteCount:kBVDebugChunkUploadChunkSize countStyle:NSByteCountFormatterCountStyleBinary]]];
+    }
+    [self updateButtons];
+}
+
+#pragma mark - Actions
+
+- (void)startUpload {
+    if (self.task && self.task.state != APIChunkedUploadStateCompleted) {
+        [[[self class] uploader] cancelTask:self.task];
+    }
+    self.task = nil;
+    [BVDebugChunkUploadServer reset];
+    [self appendLog:@"生成测试文件..."];
+    
+    __weak typeof(self) weakSelf = self;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        NSString *SHA256 = nil;
+        NSURL *fileURL = [weakSelf createTestFileWithSHA256:&SHA256];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (!fileURL) {
+                [weakSelf appendLog:@"❌ 测试文件生成失败"];
+                return;
+            }
+            weakSelf.expectedSHA256 = SHA256;
+            [weakSelf appendLog:[NSString stringWithFormat:@"文件sha256：%@", SHA256]];
+            weakSelf.task = [[[weakSelf class] uploader] uploadFileAtURL:fileURL
+                                                                mimeType:@"application/octet-stream"
+                                                              parameters:@{@"scene": @"debug"}
+                                                                progress:[weakSelf progressBlock]
+                                                                 success:[weakSelf successBlock]
+                                                                 failure:[weakSelf failureBlock]];
+            [weakSelf updateButtons];
+        });
+    });
+}
+
+- (void)togglePause {
+    if (!self.task) {
+        return;
+    }
+    
+    if (self.task.state == APIChunkedUploadStateUploading) {
+        [[[self class] uploader] pauseTask:self.task];
+        [self appendLog:@"⏸️ 已暂停"];
+    } else {
+        [[[self class] uploader] resumeTask:self.task
+                                   progress:[self progressBlock]
+                                    success:[self successBlock]
+                                    failure:[self failureBlock]];
+        [self appendLog:@"▶️ 继续上传"];
+    }
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.1 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [self updateButtons];
+    });
+}
+
+- (void)toggleNetwork {
+    BVDebugChunkUploadServer.offline = !BVDebugChunkUploadServer.isOffline;
+    [self appendLog:BVDebugChunkUploadServer.isOffline ? @"📵 模拟断网（任务应暂停并定时探测）" : @"📶 恢复网络（任务应自动继续）"];
+    [self updateButtons];
+}
+
+#pragma mark - Private Methods
+
+- (void (^)(NSProgress *))progressBlock {
+    __weak typeof(self) weakSelf = self;
+    return ^(NSProgress *progress) {
+        [weakSelf updateProgress:progress];
+    };
+}
+
+- (void (^)(id))successBlock {
+    __weak typeof(self) weakSelf = self;
+    return ^(id responseObject) {
+        NSDictionary *data = [responseObject isKindOfClass:[NSDictionary class]] ? responseObject[@"data"] : nil;
+        NSString *SHA256 = [data isKindOfClass:[NSDictionary class]] ? data[@"sha256"] : nil;
+        if (weakSelf.expectedSHA256 && ![SHA256 isEqualToString:weakSelf.expectedSHA256]) {
+            [weakSelf appendLog:[NSString stringWithFormat:@"❌ 合并后的文件不一致：%@", SHA256]];
+        } else {
+            [weakSelf appendLog:[NSString stringWithFormat:@"✅ 上传完成，服务端sha256：%@", SHA256]];
+        }
+        [weakSelf updateButtons];
+    };
+}
+
+- (void (^)(NSError *))failureBlock {
+    __weak typeof(self) weakSelf = self;
+    return ^(NSError *error) {
+        [weakSelf appendLog:[NSString stringWithFormat:@"❌ 上传失败：%@（点击“继续”从已确认的分片恢复）", error.localizedDescription]];
+        [weakSelf updateButtons];
+    };
+}
+
+/// 生成随机内容的测试文件（按1MB写入，不一次性占用内存）
+- (nullable NSURL *)createTestFileWithSHA256:(NSString **)SHA256 {
+    NSURL *fileURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:@"BVDebugChunkUpload.bin"]];
+    [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+    if (![[NSFileManager defaultManager] createFileAtPath:fileURL.path contents:nil attributes:nil]) {
+        return nil;
+    }
+    NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingToURL:fileURL error:nil];
+    if (!fileHandle) {
+        return nil;
+    }
+    
+    CC_SHA256_CTX context;
+    CC_SHA256_Init(&context);
+    NSMutableData *buffer = [NSMutableData dataWithLength:1024 * 1024];
+    unsigned long long remaining = kBVDebugChunkUploadFileSize;
+    while (remaining > 0) {
+        NSUInteger length = (NSUInteger)MIN((unsigned long long)buffer.length, remaining);
+        arc4random_buf(buffer.mutableBytes, length);
+        NSData *data = [NSData dataWithBytesNoCopy:buffer.mutableBytes length:length freeWhenDone:NO];
+        if (![fileHandle writeData:data error:nil]) {
+            [fileHandle closeAndReturnError:nil];
+            return nil;
+        }
+        CC_SHA256_Update(&context, data.bytes, (CC_LONG)length);
+        remaining -= length;
+    }
+    [fileHandle closeAndReturnError:nil];
+    
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(digest, &context);
+    NSMutableString *hex = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [hex appendFormat:@"%02x", digest[i]];
+    }
+    *SHA256 = hex;
+    return fileURL;
+}
+
+- (void)updateProgress:(NSProgress *)progress {
+    self.progressView.progress = progress.totalUnitCount > 0 ? (float)progress.completedUnitCount / progress.totalUnitCount : 0;
+    self.progressLabel.text = [NSString stringWithFormat:@"%@ / %@  已确认分片 %lu/%lu",
+                               [NSByteCountFormatter stringFromByteCount:progress.completedUnitCount countStyle:NSByteCountFormatterCountStyleBinary],
+                               [NSByteCountFormatter stringFromByteCount:progress.totalUnitCount countStyle:NSByteCountFormatterCountStyleBinary],
+                               (unsigned long)self.task.acknowledgedChunks.count,
+                               (unsigned long)self.task.chunkCount];
+}
+
+- (void)updateButtons {
+    BOOL uploading = self.task.state == APIChunkedUploadStateUploading || self.task.state == APIChunkedUploadStatePending;
+    BOOL resumable = self.task.state == APIChunkedUploadStatePaused || self.task.state == APIChunkedUploadStateFailed;
+    self.pauseButton.enabled = uploading || resumable;
+    [self.pauseButton setTitle:uploading ? @"暂停" : @"继续" forState:UIControlStateNormal];
+    [self.networkButton setTitle:BVDebugChunkUploadServer.isOffline ? @"恢复网络" : @"模拟断网" forState:UIControlStateNormal];
+}
+
+- (void)appendLog:(NSString *)log {
+    NSDateFormatter *formatter = [[NSDateFormatter alloc] init];
+    formatter.dateFormat = @"HH:mm:ss";
+    NSString *line = [NSString stringWithFormat:@"[%@] %@\n", [formatter stringFromDate:[NSDate date]], log];
+    self.logTextView.text = [self.logTextView.text stringByAppendingString:line];
+    [self.logTextView scrollRangeToVisible:NSMakeRange(self.logTextView.text.length, 0)];
+}
+
+- (UIButton *)buttonWithTitle:(NSString *)title action:(SEL)action {
+    UIButton *button = [UIButton buttonWithType:UIButtonTypeSystem];
+    [button setTitle:title forState:UIControlStateNormal];
+    button.layer.borderColor = UIColor.systemBlueColor.CGColor;
+    button.layer.borderWidth = 1;
+    button.layer.cornerRadius = 6;
+    [button addTarget:self action:action forControlEvents:UIControlEventTouchUpInside];
+    return button;
+}
+
+- (UIProgressView *)progressView {
+    if (!_progressView) {
+        _progressView = [[UIProgressView alloc] initWithProgressViewStyle:UIProgressViewStyleDefault];
+    }
+    return _progressView;
+}
+
+- (UILabel *)progressLabel {
+    if (!_progressLabel) {
+        _progressLabel = [[UILabel alloc] init];
+        _progressLabel.font = [UIFont systemFontOfSize:12];
+        _progressLabel.textColor = UIColor.grayColor;
+    }
+    return _progressLabel;
+}
+
+- (UITextView *)logTextView {
+    if (!_logTextView) {
+        _logTextView = [[UITextView alloc] init];
+        _logTextView.editable = NO;
+        _logTextView.font = [UIFont fontWithName:@"Menlo" size:11];
+        _logTextView.text = @"";
+    }
+    return _logTextView;
+}
+
+@end
+
+#endif
@@ -0,0 +1,26 @@
+//
+//  BVDebugChunkUploadPlugin.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#ifdef DEBUG
+
+#import "BVDebugChunkUploadPlugin.h"
+#import "BVDebugChunkUploadController.h"
+@import DoraemonKit;
+
+@interface BVDebugChunkUploadPlugin()<DoraemonPluginProtocol>
+@end
+
+@implementation BVDebugChunkUploadPlugin
+
+- (void)pluginDidLoad {
+    BVDebugChunkUploadController *vc = [[BVDebugChunkUploadController alloc] init];
+    [[DoraemonHomeWindow shareInstance].nav pushViewController:vc animated:YES];
+}
+
+@end
+
+#endif
@@ -0,0 +1,30 @@
+//
+//  BVDebugChunkUploadServer.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 分片上传模拟服务端 - 加入会话配置的protocolClasses后，在内存中实现 APIChunkedUploader 的分片协议
+/// 校验每个分片的SHA256（不一致返回422），合并时返回整个文件的sha256，用于验证断点续传后文件完整
+@interface BVDebugChunkUploadServer : NSURLProtocol
+
+/// 分片请求随机失败（503）的比例（默认：0），用于验证分片重传
+@property (class, nonatomic, assign) double failureRate;
+
+/// 模拟断网（所有请求返回 NSURLErrorNotConnectedToInternet），用于验证断网暂停和恢复
+@property (class, nonatomic, assign, getter=isOffline) BOOL offline;
+
+/// 模拟网络延迟（秒，默认：0.05）
+@property (class, nonatomic, assign) NSTimeInterval latency;
+
+/// 清空服务端保存的所有上传
++ (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
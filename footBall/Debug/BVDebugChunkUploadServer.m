@@ -0,0 +1,257 @@
+//
+//  BVDebugChunkUploadServer.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#ifdef DEBUG
+#import "BVDebugChunkUploadServer.h"
+#import "APIPathConfig.h"
+#import "APIPathNames.h"
+#import <CommonCrypto/CommonDigest.h>
+
+/// 服务端保存的一次上传
+@interface BVDebugChunkUpload : NSObject
+
+@property (nonatomic, assign) NSUInteger chunkCount;
+@property (nonatomic, assign) unsigned long long fileSize;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSData *> *chunks;
+
+@end
+
+@implementation BVDebugChunkUpload
+
+@end
+
+static double BVDebugChunkUploadFailureRate = 0;
+static BOOL BVDebugChunkUploadOffline = NO;
+static NSTimeInterval BVDebugChunkUploadLatency = 0.05;
+
+static NSString *BVDebugChunkUploadSHA256(NSData *data) {
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+    
+    NSMutableString *hex = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [hex appendFormat:@"%02x", digest[i]];
+    }
+    return hex;
+}
+
+@interface BVDebugChunkUploadServer ()
+
+@property (atomic, assign, getter=isStopped) BOOL stopped;
+@property (nonatomic, strong) NSThread *clientThread; // 客户端回调必须在开始加载的线程上调用
+@property (nonatomic, copy) NSArray<NSString *> *runLoopModes;
+
+@end
+
+@implementation BVDebugChunkUploadServer
+
++ (NSMutableDictionary<NSString *, BVDebugChunkUpload *> *)uploads {
+    static NSMutableDictionary<NSString *, BVDebugChunkUpload *> *uploads = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        uploads = [NSMutableDictionary dictionary];
+    });
+    return uploads;
+}
+
++ (double)failureRate {
+    return BVDebugChunkUploadFailureRate;
+}
+
++ (void)setFailureRate:(double)failureRate {
+    BVDebugChunkUploadFailureRate = MIN(MAX(failureRate, 0), 1);
+}
+
++ (BOOL)isOffline {
+    return BVDebugChunkUploadOffline;
+}
+
++ (void)setOffline:(BOOL)offline {
+    BVDebugChunkUploadOffline = offline;
+}
+
++ (NSTimeInterval)latency {
+    return BVDebugChunkUploadLatency;
+}
+
++ (void)setLatency:(NSTimeInterval)latency {
+    BVDebugChunkUploadLatency = MAX(latency, 0);
+}
+
++ (void)reset {
+    @synchronized (self) {
+        [[self uploads] removeAllObjects];
+    }
+}
+
++ (nullable NSString *)basePath {
+    return [[APIPathConfigManager sharedManager] pathForPathName:APIPathNameUploadChunked];
+}
+
+#pragma mark - NSURLProtocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request {
+    NSString *basePath = [self basePath];
+    return basePath.length > 0 && [request.URL.path hasPrefix:basePath];
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request {
+    return request;
+}
+
+- (void)startLoading {
+    self.clientThread = [NSThread currentThread];
+    NSString *mode = [NSRunLoop currentRunLoop].currentMode;
+    self.runLoopModes = mode ? @[NSDefaultRunLoopMode, mode] : @[NSDefaultRunLoopMode];
+    
+    NSError *error = nil;
+    NSInteger statusCode = 200;
+    id responseObject = nil;
+    if (BVDebugChunkUploadOffline) {
+        error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNotConnectedToInternet userInfo:@{NSLocalizedDescriptionKey: @"模拟断网"}];
+    } else {
+        responseObject = [self handleRequest:self.request statusCode:&statusCode];
+    }
+    
+    NSDictionary *result = error ? @{@"error": error} : @{@"statusCode": @(statusCode), @"object": responseObject ?: @{}};
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(BVDebugChunkUploadLatency * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        [self performSelector:@selector(deliverResult:)
+                     onThread:self.clientThread
+                   withObject:result
+                waitUntilDone:NO
+                        modes:self.runLoopModes];
+    });
+}
+
+- (void)stopLoading {
+    self.stopped = YES;
+}
+
+#pragma mark - Private Methods
+
+- (void)deliverResult:(NSDictionary *)result {
+    if (self.isStopped) {
+        return;
+    }
+    
+    NSError *error = result[@"error"];
+    if (error) {
+        [self.client URLProtocol:self didFailWithError:error];
+        return;
+    }
+    
+    NSData *data = [NSJSONSerialization dataWithJSONObject:result[@"object"] options:0 error:nil];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL
+                                                              statusCode:[result[@"statusCode"] integerValue]
+                                                             HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{@"Content-Type": @"application/json",
+                                                                           @"Content-Length": [NSString stringWithFormat:@"%lu", (unsigned long)data.length]}];
+    [self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    [self.client URLProtocol:self didLoadData:data];
+    [self.client URLProtocolDidFinishLoading:self];
+}
+
+/// 上传任务的请求体在NSURLProtocol中以HTTPBodyStream提供
+- (NSData *)bodyOfRequest:(NSURLRequest *)request {
+    if (request.HTTPBody) {
+        return request.HTTPBody;
+    }
+    
+    NSMutableData *body = [NSMutableData data];
+    NSInputStream *stream = request.HTTPBodyStream;
+    uint8_t buffer[16 * 1024];
+    NSInteger length = 0;
+    [stream open];
+    while ((length = [stream read:buffer maxLength:sizeof(buffer)]) > 0) {
+        [body appendBytes:buffer length:(NSUInteger)length];
+    }
+    [stream close];
+    return body;
+}
+
+/// 按分片协议处理请求
+- (id)handleRequest:(NSURLRequest *)request statusCode:(NSInteger *)statusCode {
+    NSString *relativePath = [request.URL.path substringFromIndex:[[self class] basePath].length];
+    NSArray<NSString *> *components = [relativePath.pathComponents filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"SELF != '/'"]];
+    NSString *method = request.HTTPMethod;
+    NSData *body = [self bodyOfRequest:request];
+    
+    @synchronized ([self class]) {
+        NSMutableDictionary<NSString *, BVDebugChunkUpload *> *uploads = [[self class] uploads];
+        
+        // POST base：创建上传
+        if (components.count == 0 && [method isEqualToString:@"POST"]) {
+            NSDictionary *parameters = [NSJSONSerialization JSONObjectWithData:body options:0 error:nil];
+            BVDebugChunkUpload *upload = [[BVDebugChunkUpload alloc] init];
+            upload.chunkCount = [parameters[@"chunkCount"] unsignedIntegerValue];
+            upload.fileSize = [parameters[@"fileSize"] unsignedLongLongValue];
+            upload.chunks = [NSMutableDictionary dictionary];
+            if (upload.chunkCount == 0) {
+                *statusCode = 400;
+                return @{@"code": @400, @"message": @"chunkCount无效"};
+            }
+            
+            NSString *uploadId = [NSUUID UUID].UUIDString;
+            uploads[uploadId] = upload;
+            return @{@"code": @0, @"data": @{@"uploadId": uploadId, @"uploadedChunks": @[]}};
+        }
+        
+        BVDebugChunkUpload *upload = components.count > 0 ? uploads[components[0]] : nil;
+        if (!upload) {
+            *statusCode = 404;
+            return @{@"code": @404, @"message": @"上传不存在"};
+        }
+        
+        // GET base/{uploadId}：查询已确认的分片
+        if (components.count == 1 && [method isEqualToString:@"GET"]) {
+            NSArray *uploadedChunks = [upload.chunks.allKeys sortedArrayUsingSelector:@selector(compare:)];
+            return @{@"code": @0, @"data": @{@"uploadId": components[0], @"uploadedChunks": uploadedChunks}};
+        }
+        
+        // PUT base/{uploadId}/chunks/{index}：上传分片
+        if (components.count == 3 && [components[1] isEqualToString:@"chunks"] && [method isEqualToString:@"PUT"]) {
+            NSUInteger index = (NSUInteger)components[2].integerValue;
+            if (BVDebugChunkUploadFailureRate > 0 && arc4random_uniform(10000) < BVDebugChunkUploadFailureRate * 10000) {
+                *statusCode = 503;
+                return @{@"code": @503, @"message": @"模拟服务端错误"};
+            }
+            if (index >= upload.chunkCount) {
+                *statusCode = 400;
+                return @{@"code": @400, @"message": @"分片序号越界"};
+            }
+            if (![[request valueForHTTPHeaderField:@"X-Chunk-SHA256"] isEqualToString:BVDebugChunkUploadSHA256(body)]) {
+                *statusCode = 422;
+                return @{@"code": @422, @"message": @"分片校验失败"};
+            }
+            
+            upload.chunks[@(index)] = body;
+            return @{@"code": @0, @"data": @{@"index": @(index)}};
+        }
+        
+        // POST base/{uploadId}/complete：合并
+        if (components.count == 2 && [components[1] isEqualToString:@"complete"] && [method isEqualToString:@"POST"]) {
+            if (upload.chunks.count != upload.chunkCount) {
+                *statusCode = 409;
+                return @{@"code": @409, @"message": @"分片不完整"};
+            }
+            
+            NSMutableData *fileData = [NSMutableData dataWithCapacity:(NSUInteger)upload.fileSize];
+            for (NSUInteger index = 0; index < upload.chunkCount; index++) {
+                [fileData appendData:upload.chunks[@(index)]];
+            }
+            [uploads removeObjectForKey:components[0]];
+            return @{@"code": @0, @"data": @{@"fileSize": @(fileData.length), @"sha256": BVDebugChunkUploadSHA256(fileData)}};
+        }
+    }
+    
+    *statusCode = 405;
+    return @{@"code": @405, @"message": @"不支持的请求"};
+}
+
+@end
+
+#endif
@@ -0,0 +1,45 @@
+//
+//  BVDebugCodecBenchmark.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 单项对比结果
+@interface BVDebugCodecBenchmarkResult : NSObject
+
+/// 数据名称（如：用户、用户列表、比赛列表）
+@property (nonatomic, copy) NSString *payloadName;
+
+/// 编解码器名称
+@property (nonatomic, copy) NSString *codecName;
+
+/// 编码后字节数
+@property (nonatomic, assign) NSUInteger byteCount;
+
+/// 单次编码平均耗时（秒）
+@property (nonatomic, assign) NSTimeInterval encodeTime;
+
+/// 单次解码平均耗时（秒）
+@property (nonatomic, assign) NSTimeInterval decodeTime;
+
+/// 解码结果是否与原始对象相等
+@property (nonatomic, assign) BOOL roundTripEqual;
+
+@end
+
+/// 编解码性能对比 - 在代表性的用户和比赛数据上对比各编解码器的编码/解码耗时和传输字节数
+@interface BVDebugCodecBenchmark : NSObject
+
+/// 执行对比（耗时操作，请在后台线程调用）
+/// @param iterations 每项重复次数
+/// @return 按数据、编解码器排列的结果
++ (NSArray<BVDebugCodecBenchmarkResult *> *)runWithIterations:(NSUInteger)iterations;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,128 @@
+//
+//  BVDebugCodecBenchmark.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#ifdef DEBUG
+#import "BVDebugCodecBenchmark.h"
+#import "APIPayloadCodec.h"
+
+@implementation BVDebugCodecBenchmarkResult
+
+@end
+
+@implementation BVDebugCodecBenchmark
+
+#pragma mark - Public Methods
+
++ (NSArray<BVDebugCodecBenchmarkResult *> *)runWithIterations:(NSUInteger)iterations {
+    iterations = MAX(iterations, 1);
+    
+    NSArray<NSArray *> *payloads = @[
+        @[@"用户", [self userPayload]],
+        @[@"用户列表(100)", [self userListPayloadWithCount:100]],
+        @[@"比赛列表(200)", [self matchListPayloadWithCount:200]]
+    ];
+    
+    NSMutableArray<BVDebugCodecBenchmarkResult *> *results = [NSMutableArray array];
+    for (NSArray *payload in payloads) {
+        for (id<APIPayloadCodec> codec in [APIPayloadCodecRegistry sharedRegistry].codecs) {
+            BVDebugCodecBenchmarkResult *result = [self measureCodec:codec object:payload[1] iterations:iterations];
+            result.payloadName = payload[0];
+            [results addObject:result];
+        }
+    }
+    return results;
+}
+
+#pragma mark - Private Methods
+
++ (BVDebugCodecBenchmarkResult *)measureCodec:(id<APIPayloadCodec>)codec object:(id)object iterations:(NSUInteger)iterations {
+    BVDebugCodecBenchmarkResult *result = [[BVDebugCodecBenchmarkResult alloc] init];
+    result.codecName = codec.name;
+    
+    NSData *data = nil;
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    for (NSUInteger i = 0; i < iterations; i++) {
+        @autoreleasepool {
+            data = [codec encodeObject:object error:nil];
+        }
+    }
+    result.encodeTime = (CFAbsoluteTimeGetCurrent() - start) / iterations;
+    result.byteCount = data.length;
+    
+    id decodedObject = nil;
+    start = CFAbsoluteTimeGetCurrent();
+    for (NSUInteger i = 0; i < iterations; i++) {
+        @autoreleasepool {
+            decodedObject = [codec decodeData:data error:nil];
+        }
+    }
+    result.decodeTime = (CFAbsoluteTimeGetCurrent() - start) / iterations;
+    result.roundTripEqual = [decodedObject isEqual:object];
+    
+    return result;
+}
+
++ (NSDictionary *)userWithIndex:(NSUInteger)index {
+    return @{
+        @"id": @(100000 + index),
+        @"name": [NSString stringWithFormat:@"球迷%lu", (unsigned long)index],
+        @"email": [NSString stringWithFormat:@"fan%lu@example.com", (unsigned long)index],
+        @"avatar": [NSString stringWithFormat:@"https://img.example.com/avatar/%lu.jpg", (unsigned long)index],
+        @"level": @(index % 30),
+        @"followers": @(index * 37),
+        @"isVip": @(index % 3 == 0),
+        @"registerTime": @(1760000000000 + index * 86400000),
+        @"favoriteTeams": @[@(index % 20), @(index % 20 + 20)]
+    };
+}
+
++ (NSDictionary *)userPayload {
+    return @{@"code": @0, @"msg": @"success", @"data": [self userWithIndex:1]};
+}
+
++ (NSDictionary *)userListPayloadWithCount:(NSUInteger)count {
+    NSMutableArray *users = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [users addObject:[self userWithIndex:i]];
+    }
+    return @{@"code": @0, @"msg": @"success", @"data": @{@"list": users, @"total": @(count), @"page": @1}};
+}
+
++ (NSDictionary *)matchListPayloadWithCount:(NSUInteger)count {
+    NSArray *leagues = @[@"英超", @"西甲", @"意甲", @"德甲", @"法甲", @"中超"];
+    NSMutableArray *matches = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        NSMutableArray *events = [NSMutableArray array];
+        for (NSUInteger j = 0; j < i % 5; j++) {
+            [events addObject:@{
+                @"type": j % 2 == 0 ? @"goal" : @"yellowCard",
+                @"minute": @(10 + j * 17),
+                @"playerName": [NSString stringWithFormat:@"球员%lu", (unsigned long)(i * 10 + j)]
+            }];
+        }
+        
+        [matches addObject:@{
+            @"matchId": @(5000000 + i),
+            @"leagueId": @(i % leagues.count + 1),
+            @"leagueName": leagues[i % leagues.count],
+            @"homeTeam": @{@"id": @(i * 2), @"name": [NSString stringWithFormat:@"主队%lu", (unsigned long)i], @"logo": [NSString stringWithFormat:@"https://img.example.com/team/%lu.png", (unsigned long)(i * 2)], @"score": @(i % 4)},
+            @"awayTeam": @{@"id": @(i * 2 + 1), @"name": [NSString stringWithFormat:@"客队%lu", (unsigned long)i], @"logo": [NSString stringWithFormat:@"https://img.example.com/team/%lu.png", (unsigned long)(i * 2 + 1)], @"score": @(i % 3)},
+            @"status": @(i % 4),
+            @"minute": @(i % 90),
+            @"startTime": @(1760000000000 + i * 5400000),
+            @"odds": @[@(1.5 + (i % 10) * 0.25), @3.25, @(2.0 + (i % 7) * 0.5)],
+            @"handicap": @(-0.25 * (i % 5)),
+            @"isHot": @(i % 7 == 0),
+            @"events": events
+        }];
+    }
+    return @{@"code": @0, @"msg": @"success", @"data": @{@"list": matches, @"total": @(count)}};
+}
+
+@end
+
+#endif
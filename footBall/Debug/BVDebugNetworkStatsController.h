@@ -0,0 +1,17 @@
+//
+//  BVDebugNetworkStatsController.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 网络状态调试页 - 展示各接口熔断器状态、响应缓存统计、压缩统计和编解码性能对比
+@interface BVDebugNetworkStatsController : UIViewController
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,363 @@
+//
+//  BVDebugNetworkStatsController.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#ifdef DEBUG
+#import "BVDebugNetworkStatsController.h"
+#import "APIPathConfig.h"
+#import "APICircuitBreaker.h"
+#import "APIResponseCache.h"
+#import "BVDebugCodecBenchmark.h"
+#import "APICompressionStatistics.h"
+#import "APIManager.h"
+#import "APIInterceptorChain.h"
+#import "APIMetricsStore.h"
+#import "APINetworkQualityEstimator.h"
+@import DoraemonKit;
+
+typedef NS_ENUM(NSInteger, BVDebugNetworkStatsSection) {
+    BVDebugNetworkStatsSectionRequests = 0,
+    BVDebugNetworkStatsSectionLatency,
+    BVDebugNetworkStatsSectionNetworkQuality,
+    BVDebugNetworkStatsSectionCircuitBreaker,
+    BVDebugNetworkStatsSectionInterceptor,
+    BVDebugNetworkStatsSectionResponseCache,
+    BVDebugNetworkStatsSectionCompression,
+    BVDebugNetworkStatsSectionCodecBenchmark,
+    BVDebugNetworkStatsSectionCount
+};
+
+@interface BVDebugNetworkStatsController () <UITableViewDelegate, UITableViewDataSource>
+@property (nonatomic, strong) UITableView *tableView;
+
+@property (nonatomic, strong) NSTimer *refreshTimer; // 页面可见时每秒刷新请求统计
+@property (nonatomic, strong) APITaskRegistryStatistics *registryStatistics;
+@property (nonatomic, strong) NSArray<NSString *> *registryTags;
+@property (nonatomic, strong) NSArray<APIPathMetricsEntry *> *metricsEntries;
+@property (nonatomic, strong) NSArray<APIPathConfig *> *pathConfigs;
+@property (nonatomic, strong) NSArray<NSString *> *cacheStatisticKeys;
+@property (nonatomic, strong) NSDictionary<NSString *, NSNumber *> *cacheStatistics;
+@property (nonatomic, strong) NSArray<APICompressionStatisticsEntry *> *compressionEntries;
+@property (nonatomic, strong) NSArray<APIInterceptorStatisticsEntry *> *interceptorEntries;
+@property (nonatomic, strong) NSArray<BVDebugCodecBenchmarkResult *> *benchmarkResults;
+@property (nonatomic, assign, getter=isBenchmarkRunning) BOOL benchmarkRunning;
+@end
+
+@implementation BVDebugNetworkStatsController
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void)viewDidLayoutSubviews {
+    [super viewDidLayoutSubviews];
+    self.tableView.frame = self.view.frame;
+}
+
+- (void)viewDidLoad {
+    [super viewDidLoad];
+    self.title = @"网络状态";
+    self.view.backgroundColor = UIColor.whiteColor;
+    
+    [self.view addSubview:self.tableView];
+    
+    self.navigationItem.rightBarButtonItem = [[UIBarButtonItem alloc] initWithTitle:@"刷新"
+                                                                              style:UIBarButtonItemStylePlain
+                                                                             target:self
+                                                                             action:@selector(reloadData)];
+    
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(reloadData)
+                                                 name:APICircuitBreakerStateDidChangeNotification
+                                               object:nil];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(reloadData)
+                                                 name:APINetworkQualityDidChangeNotification
+                                               object:nil];
+}
+
+- (void)viewWillAppear:(BOOL)animated {
+    [super viewWillAppear:animated];
+    [self reloadData];
+    
+    __weak typeof(self) weakSelf = self;
+    self.refreshTimer = [NSTimer scheduledTimerWithTimeInterval:1 repeats:YES block:^(NSTimer *timer) {
+        [weakSelf reloadRegistryStatistics];
+    }];
+}
+
+- (void)viewWillDisappear:(BOOL)animated {
+    [super viewWillDisappear:animated];
+    [self.refreshTimer invalidate];
+    self.refreshTimer = nil;
+}
+
+- (void)reloadRegistryStatistics {
+    [self updateRegistryStatistics];
+    [self.tableView reloadSections:[NSIndexSet indexSetWithIndex:BVDebugNetworkStatsSectionRequests] withRowAnimation:UITableViewRowAnimationNone];
+}
+
+- (void)updateRegistryStatistics {
+    self.registryStatistics = [[APIManager sharedManager].taskRegistry statistics];
+    self.registryTags = [self.registryStatistics.tagCounts.allKeys sortedArrayUsingSelector:@selector(compare:)];
+}
+
+- (void)reloadData {
+    [self updateRegistryStatistics];
+    self.metricsEntries = [[APIMetricsStore sharedStore] allEntries];
+    self.pathConfigs = [[[APIPathConfigManager sharedManager] allPathConfigs].allValues sortedArrayUsingComparator:^NSComparisonResult(APIPathConfig *obj1, APIPathConfig *obj2) {
+        return [obj1.name compare:obj2.name];
+    }];
+    self.cacheStatistics = [[APIResponseCache sharedCache] statistics];
+    self.cacheStatisticKeys = [self.cacheStatistics.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    self.compressionEntries = [[APICompressionStatistics sharedStatistics] allEntries];
+    self.interceptorEntries = [[APIInterceptorStatistics sharedStatistics] allEntries];
+    [self.tableView reloadData];
+}
+
+- (void)runCodecBenchmark {
+    if (self.isBenchmarkRunning) {
+        return;
+    }
+    self.benchmarkRunning = YES;
+    [self.tableView reloadData];
+    
+    __weak typeof(self) weakSelf = self;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        NSArray<BVDebugCodecBenchmarkResult *> *results = [BVDebugCodecBenchmark runWithIterations:100];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            weakSelf.benchmarkResults = results;
+            weakSelf.benchmarkRunning = NO;
+            [weakSelf.tableView reloadData];
+        });
+    });
+}
+
+- (UITableView *)tableView {
+    if (!_tableView) {
+        _tableView = [[UITableView alloc] initWithFrame:CGRectZero style:UITableViewStyleGrouped];
+        _tableView.estimatedRowHeight = 60;
+        _tableView.delegate = self;
+        _tableView.dataSource = self;
+    }
+    return _tableView;
+}
+
+- (NSString *)byteStringForCount:(int64_t)count {
+    return [NSByteCountFormatter stringFromByteCount:count countStyle:NSByteCountFormatterCountStyleBinary];
+}
+
+- (void)copyMetricsJSON {
+    NSString *JSONString = [[NSString alloc] initWithData:[[APIMetricsStore sharedStore] JSONData] encoding:NSUTF8StringEncoding];
+    [UIPasteboard generalPasteboard].string = JSONString;
+    NSLog(@"📋 请求耗时统计已复制到剪贴板:\n%@", JSONString);
+}
+
+#pragma mark - UITableViewDataSource
+
+- (NSInteger)numberOfSectionsInTableView:(UITableView *)tableView {
+    return BVDebugNetworkStatsSectionCount;
+}
+
+- (NSString *)tableView:(UITableView *)tableView titleForHeaderInSection:(NSInteger)section {
+    switch (section) {
+        case BVDebugNetworkStatsSectionRequests:
+            return @"请求（点击标签取消）";
+        case BVDebugNetworkStatsSectionLatency:
+            return @"请求耗时 p50/p90/p99（点击复制JSON）";
+        case BVDebugNetworkStatsSectionNetworkQuality:
+            return @"网络质量（点击重新采样）";
+        case BVDebugNetworkStatsSectionCircuitBreaker:
+            return @"熔断器（点击重置）";
+        case BVDebugNetworkStatsSectionInterceptor:
+            return @"拦截器耗时（点击清空）";
+        case BVDebugNetworkStatsSectionResponseCache:
+            return @"响应缓存";
+        case BVDebugNetworkStatsSectionCompression:
+            return @"压缩统计（原始/实际传输）";
+        case BVDebugNetworkStatsSectionCodecBenchmark:
+            return @"编解码对比（每项100次取平均）";
+        default:
+            return nil;
+    }
+}
+
+- (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
+    switch (section) {
+        case BVDebugNetworkStatsSectionRequests:
+            return self.registryTags.count + 1;
+        case BVDebugNetworkStatsSectionLatency:
+            return self.metricsEntries.count;
+        case BVDebugNetworkStatsSectionNetworkQuality:
+            return 1;
+        case BVDebugNetworkStatsSectionCircuitBreaker:
+            return self.pathConfigs.count;
+        case BVDebugNetworkStatsSectionInterceptor:
+            return self.interceptorEntries.count;
+        case BVDebugNetworkStatsSectionResponseCache:
+            return self.cacheStatisticKeys.count;
+        case BVDebugNetworkStatsSectionCompression:
+            return self.compressionEntries.count;
+        case BVDebugNetworkStatsSectionCodecBenchmark:
+            return self.benchmarkResults.count + 1;
+        default:
+            return 0;
+    }
+}
+
+- (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath {
+    UITableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:@"BVDebugNetworkStatsCell"];
+    if (!cell) {
+        cell = [[UITableViewCell alloc] initWithStyle:UITableViewCellStyleSubtitle reuseIdentifier:@"BVDebugNetworkStatsCell"];
+        cell.detailTextLabel.numberOfLines = 0;
+        cell.detailTextLabel.textColor = UIColor.grayColor;
+    }
+    
+    if (indexPath.section == BVDebugNetworkStatsSectionRequests) {
+        cell.textLabel.textColor = UIColor.blackColor;
+        if (indexPath.row == 0) {
+            APITaskRegistryStatistics *statistics = self.registryStatistics;
+            cell.textLabel.text = [NSString stringWithFormat:@"进行中 %lu  排队 %lu  等待重试 %lu",
+                                   (unsigned long)statistics.inflightCount,
+                                   (unsigned long)statistics.queuedCount,
+                                   (unsigned long)statistics.retryingCount];
+            cell.detailTextLabel.text = [NSString stringWithFormat:@"已传输 %@", [self byteStringForCount:statistics.bytesInFlight]];
+        } else {
+            NSString *tag = self.registryTags[indexPath.row - 1];
+            cell.textLabel.text = tag;
+            cell.detailTextLabel.text = [NSString stringWithFormat:@"%@ 个请求", self.registryStatistics.tagCounts[tag]];
+        }
+    } else if (indexPath.section == BVDebugNetworkStatsSectionLatency) {
+        APIPathMetricsEntry *entry = self.metricsEntries[indexPath.row];
+        APIMetricsHistogram *total = [entry histogramForPhase:APIMetricsPhaseTotal];
+        cell.textLabel.text = [NSString stringWithFormat:@"%@  %.0f / %.0f / %.0f ms",
+                               entry.pathName,
+                               [total valueAtPercentile:0.5] * 1000,
+                               [total valueAtPercentile:0.9] * 1000,
+                               [total valueAtPercentile:0.99] * 1000];
+        cell.textLabel.textColor = UIColor.blackColor;
+        
+        // 各阶段的p50
+        NSMutableArray<NSString *> *phases = [NSMutableArray array];
+        for (NSInteger phase = APIMetricsPhaseDNS; phase < APIMetricsPhaseCount; phase++) {
+            APIMetricsHistogram *histogram = [entry histogramForPhase:phase];
+            if (histogram) {
+                [phases addObject:[NSString stringWithFormat:@"%@ %.1f", [APIMetricsStore displayNameForPhase:phase], [histogram valueAtPercentile:0.5] * 1000]];
+            }
+        }
+        cell.detailTextLabel.text = [NSString stringWithFormat:@"%lu 次请求  失败 %lu  复用连接 %lu\n各阶段p50（ms）：%@",
+                                     (unsigned long)entry.requestCount,
+                                     (unsigned long)entry.errorCount,
+                                     (unsigned long)entry.reusedConnectionCount,
+                                     [phases componentsJoinedByString:@"  "]];
+    } else if (indexPath.section == BVDebugNetworkStatsSectionNetworkQuality) {
+        APINetworkQualityEstimator *estimator = [APINetworkQualityEstimator sharedEstimator];
+        cell.textLabel.text = [APINetworkQualityEstimator displayNameForQuality:estimator.quality];
+        cell.textLabel.textColor = estimator.quality == APINetworkQualityPoor ? UIColor.redColor : UIColor.blackColor;
+        cell.detailTextLabel.text = [NSString stringWithFormat:@"HTTP RTT %.0f ms  传输RTT %.0f ms\n吞吐 %.0f kbps  丢包 %.0f%%  样本 %lu\n超时 %.0f 秒  每个主机并发 %lu",
+                                     estimator.HTTPRoundTripTime * 1000,
+                                     estimator.transportRoundTripTime * 1000,
+                                     estimator.downstreamThroughput,
+                                     estimator.lossRate * 100,
+                                     (unsigned long)estimator.sampleCount,
+                                     [APIManager sharedManager].effectiveTimeoutInterval,
+                                     (unsigned long)[estimator adjustedConcurrencyLimit:[APIRequestScheduler sharedScheduler].maxConcurrentRequestsPerHost]];
+    } else if (indexPath.section == BVDebugNetworkStatsSectionCircuitBreaker) {
+        APIPathConfig *config = self.pathConfigs[indexPath.row];
+        APICircuitBreaker *breaker = config.circuitBreaker;
+        cell.textLabel.text = [NSString stringWithFormat:@"%@  [%@]", config.name, [APICircuitBreaker displayNameForState:breaker.state]];
+        cell.detailTextLabel.text = [NSString stringWithFormat:@"%@\n失败率 %.0f%%（%lu 次请求）  快速失败 %lu 次  打开 %lu 次",
+                                     config.path,
+                                     breaker.failureRate * 100,
+                                     (unsigned long)breaker.sampleCount,
+                                     (unsigned long)breaker.rejectedCount,
+                                     (unsigned long)breaker.openedCount];
+        switch (breaker.state) {
+            case APICircuitBreakerStateClosed:
+                cell.textLabel.textColor = UIColor.blackColor;
+                break;
+            case APICircuitBreakerStateOpen:
+                cell.textLabel.textColor = UIColor.redColor;
+                break;
+            case APICircuitBreakerStateHalfOpen:
+                cell.textLabel.textColor = UIColor.orangeColor;
+                break;
+        }
+    } else if (indexPath.section == BVDebugNetworkStatsSectionInterceptor) {
+        APIInterceptorStatisticsEntry *entry = self.interceptorEntries[indexPath.row];
+        cell.textLabel.text = [NSString stringWithFormat:@"%@ - %@", entry.interceptorName, [APIInterceptorStatistics displayNameForPhase:entry.phase]];
+        cell.textLabel.textColor = UIColor.blackColor;
+        cell.detailTextLabel.text = [NSString stringWithFormat:@"%lu 次  平均 %.2f ms  最大 %.2f ms  合计 %.1f ms",
+                                     (unsigned long)entry.count,
+                                     entry.averageDuration * 1000,
+                                     entry.maxDuration * 1000,
+                                     entry.totalDuration * 1000];
+    } else if (indexPath.section == BVDebugNetworkStatsSectionCompression) {
+        APICompressionStatisticsEntry *entry = self.compressionEntries[indexPath.row];
+        NSMutableArray<NSString *> *encodings = [NSMutableArray array];
+        [entry.responseEncodingCounts enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSNumber *obj, BOOL *stop) {
+            [encodings addObject:[NSString stringWithFormat:@"%@×%@", key, obj]];
+        }];
+        cell.textLabel.text = [NSString stringWithFormat:@"%@  节省 %@", entry.pathName, [self byteStringForCount:entry.savedBytes]];
+        cell.textLabel.textColor = UIColor.blackColor;
+        cell.detailTextLabel.text = [NSString stringWithFormat:@"%lu 次请求\n请求体 %@ / %@  响应体 %@ / %@\n蜂窝网络节省 %@  响应编码 %@",
+                                     (unsigned long)entry.requestCount,
+                                     [self byteStringForCount:entry.requestRawBytes],
+                                     [self byteStringForCount:entry.requestEncodedBytes],
+                                     [self byteStringForCount:entry.responseRawBytes],
+                                     [self byteStringForCount:entry.responseEncodedBytes],
+                                     [self byteStringForCount:entry.cellularSavedBytes],
+                                     [[encodings sortedArrayUsingSelector:@selector(compare:)] componentsJoinedByString:@" "]];
+    } else if (indexPath.section == BVDebugNetworkStatsSectionCodecBenchmark) {
+        cell.textLabel.textColor = UIColor.blackColor;
+        if (indexPath.row == 0) {
+            cell.textLabel.text = self.isBenchmarkRunning ? @"运行中..." : @"点击运行";
+            cell.detailTextLabel.text = nil;
+        } else {
+            BVDebugCodecBenchmarkResult *result = self.benchmarkResults[indexPath.row - 1];
+            cell.textLabel.text = [NSString stringWithFormat:@"%@ - %@", result.payloadName, result.codecName];
+            cell.detailTextLabel.text = [NSString stringWithFormat:@"%lu 字节  编码 %.3f ms  解码 %.3f ms  %@",
+                                         (unsigned long)result.byteCount,
+                                         result.encodeTime * 1000,
+                                         result.decodeTime * 1000,
+                                         result.roundTripEqual ? @"还原一致" : @"⚠️ 还原不一致"];
+        }
+    } else {
+        NSString *key = self.cacheStatisticKeys[indexPath.row];
+        cell.textLabel.text = key;
+        cell.textLabel.textColor = UIColor.blackColor;
+        cell.detailTextLabel.text = [self.cacheStatistics[key] stringValue];
+    }
+    return cell;
+}
+
+#pragma mark - UITableViewDelegate
+
+- (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath {
+    [tableView deselectRowAtIndexPath:indexPath animated:YES];
+    
+    if (indexPath.section == BVDebugNetworkStatsSectionRequests && indexPath.row > 0) {
+        [[APIManager sharedManager] cancelRequestsWithTag:self.registryTags[indexPath.row - 1]];
+        [self reloadRegistryStatistics];
+    } else if (indexPath.section == BVDebugNetworkStatsSectionLatency) {
+        [self copyMetricsJSON];
+    } else if (indexPath.section == BVDebugNetworkStatsSectionNetworkQuality) {
+        [[APINetworkQualityEstimator sharedEstimator] reset];
+        [self reloadData];
+    } else if (indexPath.section == BVDebugNetworkStatsSectionCircuitBreaker) {
+        [self.pathConfigs[indexPath.row].circuitBreaker reset];
+        [self reloadData];
+    } else if (indexPath.section == BVDebugNetworkStatsSectionInterceptor) {
+        [[APIInterceptorStatistics sharedStatistics] reset];
+        [self reloadData];
+    } else if (indexPath.section == BVDebugNetworkStatsSectionCodecBenchmark && indexPath.row == 0) {
+        [self runCodecBenchmark];
+    }
+}
+
+@end
+
+#endif
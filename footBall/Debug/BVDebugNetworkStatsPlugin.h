@@ -0,0 +1,16 @@
+//
+//  BVDebugNetworkStatsPlugin.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface BVDebugNetworkStatsPlugin : NSObject
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,26 @@
+//
+//  BVDebugNetworkStatsPlugin.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#ifdef DEBUG
+
+#import "BVDebugNetworkStatsPlugin.h"
+#import "BVDebugNetworkStatsController.h"
+@import DoraemonKit;
+
+@interface BVDebugNetworkStatsPlugin()<DoraemonPluginProtocol>
+@end
+
+@implementation BVDebugNetworkStatsPlugin
+
+- (void)pluginDidLoad {
+    BVDebugNetworkStatsController *vc = [[BVDebugNetworkStatsController alloc] init];
+    [[DoraemonHomeWindow shareInstance].nav pushViewController:vc animated:YES];
+}
+
+@end
+
+#endif
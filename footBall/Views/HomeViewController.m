@@ -12,7 +12,9 @@
 #import "APIManager.h"
 #import "APIPathNames.h"
 #import "APIError.h"
+#import "APIPaginatedDataSource.h"
 #import "RefreshPagHeader.h"
+#import "UserModel.h"
 #import <Masonry/Masonry.h>
 #import <DoraemonKit/DoraemonManager.h>
 
@@ -25,6 +27,7 @@
 @property (nonatomic, strong) UIButton *loadUserInfoButton; // 加载用户信息按钮
 @property (nonatomic, strong) UILabel *userInfoLabel; // 显示用户信息
 @property (nonatomic, strong) UIImageView *img;
+@property (nonatomic, strong) APIPaginatedDataSource *userListDataSource; // 用户列表分页数据源
 
 @end
 
@@ -237,6 +240,33 @@
     return _userInfoLabel;
 }
 
+- (APIPaginatedDataSource *)userListDataSource {
+    if (!_userListDataSource) {
+        // 列表在后台队列映射为模型，主线程只负责更新UI
+        APIRequestOptions *options = [APIRequestOptions optionsWithResponseModelClass:[UserListModel class] keyPath:nil];
+        // 页面离开时取消所有页的请求
+        options.cancellationScope = self.requestScope;
+        _userListDataSource = [[APIPaginatedDataSource alloc] initWithPathName:APIPathNameUserList
+                                                                    parameters:@{@"keyword": @""}
+                                                                       options:options];
+        _userListDataSource.pageSize = 20;
+        _userListDataSource.itemsBlock = ^NSArray *(id responseObject) {
+            return [responseObject isKindOfClass:[UserListModel class]] ? ((UserListModel *)responseObject).users : nil;
+        };
+        
+        __weak typeof(self) weakSelf = self;
+        _userListDataSource.pageLoadedBlock = ^(NSInteger page, NSRange itemRange) {
+            [[LoadingManager sharedManager] hideLoadingInView:weakSelf.view];
+            [weakSelf handleUserListUpdate];
+        };
+        _userListDataSource.failureBlock = ^(NSInteger page, APIError *error) {
+            [[LoadingManager sharedManager] hideLoadingInView:weakSelf.view];
+            [weakSelf handleUserInfoError:error];
+        };
+    }
+    return _userListDataSource;
+}
+
 #pragma mark - Refresh
 
 /// 下拉刷新数据
@@ -255,8 +285,10 @@
 }
 
 /// 请求用户信息接口
+/// 先展示本地缓存的用户信息，再用网络数据刷新；拿到本地数据后隐藏加载提示
+/// 请求绑定到当前页面，离开页面后取消，不再回调
 - (void)loadUserInfo {
-    // 显示加载提示
+    // 本地数据在后台读取，先显示加载提示
     [[LoadingManager sharedManager] showLoadingWithMessage:@"加载中..." inView:self.view];
     
     // 使用路径名称常量发起请求（推荐方式）
@@ -264,15 +296,23 @@
                                         subPath:nil  // 如果需要子路径，如：@"/profile"
                                      parameters:nil  // 请求参数，如：@{@"userId": @"123"}
                                         headers:nil  // 请求头，如：@{@"Authorization": @"Bearer token"}
-                                        success:^(id responseObject) {
+                                        options:[APIRequestOptions optionsWithOwner:self]
+                                         cached:^(id responseObject) {
+        // 本地数据：立即渲染
+        [[LoadingManager sharedManager] hideLoadingInView:self.view];
+        [self handleUserInfoSuccess:responseObject];
+        
+    } refreshed:^(id responseObject, BOOL changed) {
         // 隐藏加载提示
         [[LoadingManager sharedManager] hideLoadingInView:self.view];
         
         // 结束下拉刷新
         [self.scrollView.mj_header endRefreshing];
         
-        // 处理成功响应
-        [self handleUserInfoSuccess:responseObject];
+        // 数据有变化时才重新渲染
+        if (changed) {
+            [self handleUserInfoSuccess:responseObject];
+        }
         
     } failure:^(NSError *error) {
 //        // 隐藏加载提示
@@ -296,6 +336,7 @@
                                         subPath:@"/profile"  // 子路径
                                      parameters:nil
                                         headers:nil
+                                        options:[APIRequestOptions optionsWithOwner:self]
                                         success:^(id responseObject) {
         [[LoadingManager sharedManager] hideLoadingInView:self.view];
         [self handleUserProfileSuccess:responseObject];
@@ -306,30 +347,13 @@
     }];
 }
 
-/// 请求用户列表接口（带参数示例）
+/// 请求用户列表接口（分页示例）
+/// 第一页由 reloadData 加载，之后的页由列表的可见范围驱动：滚动时调用 updateVisibleRange:，接近末尾时预加载下一页
 - (void)loadUserList {
     // 显示加载提示
     [[LoadingManager sharedManager] showLoadingWithMessage:@"加载用户列表..." inView:self.view];
     
-    // 使用路径名称 + 参数
-    NSDictionary *parameters = @{
-        @"page": @1,
-        @"pageSize": @20,
-        @"keyword": @""
-    };
-    
-    [[APIManager sharedManager] GETWithPathName:APIPathNameUserList
-                                        subPath:nil
-                                     parameters:parameters
-                                        headers:nil
-                                        success:^(id responseObject) {
-        [[LoadingManager sharedManager] hideLoadingInView:self.view];
-        [self handleUserListSuccess:responseObject];
-        
-    } failure:^(NSError *error) {
-        [[LoadingManager sharedManager] hideLoadingInView:self.view];
-        [self handleUserInfoError:error];
-    }];
+    [self.userListDataSource reloadData];
 }
 
 /// 处理用户信息请求成功
@@ -362,16 +386,14 @@
     }
 }
 
-/// 处理用户列表请求成功
-- (void)handleUserListSuccess:(id)responseObject {
-    if ([responseObject isKindOfClass:[NSDictionary class]]) {
-        NSDictionary *data = responseObject;
-        NSArray *userList = data[@"list"] ?: data[@"data"] ?: @[];
-        NSString *listText = [NSString stringWithFormat:@"用户列表（共 %ld 条）", 
-                              (long)userList.count];
-        self.userInfoLabel.text = listText;
-        self.userInfoLabel.textColor = [UIColor systemGreenColor];
-    }
+/// 处理用户列表页面加载完成
+- (void)handleUserListUpdate {
+    APIPaginatedDataSource *dataSource = self.userListDataSource;
+    NSString *listText = [NSString stringWithFormat:@"用户列表（已加载 %lu 条%@）",
+                          (unsigned long)dataSource.numberOfItems,
+                          dataSource.hasMorePages ? @"，还有更多" : @""];
+    self.userInfoLabel.text = listText;
+    self.userInfoLabel.textColor = [UIColor systemGreenColor];
 }
 
 /// 处理用户信息请求错误
@@ -0,0 +1,37 @@
+//
+//  UserModel.h
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 用户模型
+@interface UserModel : NSObject
+
+/// 用户ID（对应字段id）
+@property (nonatomic, copy, nullable) NSString *userId;
+
+/// 姓名
+@property (nonatomic, copy, nullable) NSString *name;
+
+/// 邮箱
+@property (nonatomic, copy, nullable) NSString *email;
+
+/// 头像URL
+@property (nonatomic, copy, nullable) NSString *avatar;
+
+@end
+
+/// 用户列表模型
+@interface UserListModel : NSObject
+
+/// 用户列表（对应字段list，兼容data）
+@property (nonatomic, copy, nullable) NSArray<UserModel *> *users;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,29 @@
+//
+//  UserModel.m
+//  footBall
+//
+//  Created on 2026/10/18.
+//
+
+#import "UserModel.h"
+#import <MJExtension/MJExtension.h>
+
+@implementation UserModel
+
++ (NSDictionary *)mj_replacedKeyFromPropertyName {
+    return @{@"userId": @"id"};
+}
+
+@end
+
+@implementation UserListModel
+
++ (NSDictionary *)mj_replacedKeyFromPropertyName {
+    return @{@"users": @[@"list", @"data"]};
+}
+
++ (NSDictionary *)mj_objectClassInArray {
+    return @{@"users": [UserModel class]};
+}
+
+@end